@@ -0,0 +1,105 @@
+/*
+ * FileWriteBench.cpp
+ *
+ * Compares the throughput of the ofstream based FileOps writer against the
+ * preallocated, memory mapped MmapFileOps segment writer.
+ *
+ * Usage: ./bin/FileWriteBench [lines] [line length] [segment size in MB]
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "FileOps.hpp"
+#include "MmapFileOps.hpp"
+#include "Clock.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <functional>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief Write the lines through the sink and report the throughput
+     *
+     * @param [in] name Name of the run to be printed
+     * @param [in] makeSink Creates the sink to be measured
+     * @param [in] lineCnt Number of lines to be written
+     * @param [in] line The line to be written
+     */
+    void runBench(const std::string_view name,
+                  const std::function<std::unique_ptr<FileOps>()>& makeSink,
+                  const size_t lineCnt,
+                  const std::string& line)
+    {
+        std::filesystem::path filePathObj;
+        Clock clock;
+        clock.start();
+        {
+            auto sink = makeSink();
+            filePathObj = sink->getFilePathObj();
+            for (size_t cnt = 0; cnt < lineCnt; ++cnt)
+                sink->write(line);
+        }   // Destruction drains whatever is still queued
+        clock.stop();
+
+        auto elapsedSec = clock.getElapsedTime(TimeUnits::MICROSECONDS) / 1000000.0;
+        auto totalMB = static_cast<double>(lineCnt * (line.size() + 1)) / (1024 * 1024);
+        std::cout << std::left << std::setw(24) << name
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(10) << elapsedSec << " s"
+                  << std::setw(14) << static_cast<double>(lineCnt) / elapsedSec << " lines/s"
+                  << std::setw(10) << totalMB / elapsedSec << " MB/s" << std::endl;
+
+        // Remove the file along with any segment rolled over from it
+        auto stem = filePathObj.stem().string();
+        for (const auto& entry : std::filesystem::directory_iterator(filePathObj.parent_path()))
+        {
+            if (entry.path().filename().string().starts_with(stem))
+                FileOps::removeFile(entry.path());
+        }
+    }
+};
+
+int main(int argc, char** argv)
+{
+    size_t lineCnt = (argc > 1) ? std::stoul(argv[1]) : 10000;
+    size_t lineLen = (argc > 2) ? std::stoul(argv[2]) : 128;
+    std::uintmax_t segmentSize = ((argc > 3) ? std::stoul(argv[3]) : 64) * 1024 * 1024;
+    std::string line(lineLen, 'x');
+
+    std::cout << "Writing " << lineCnt << " lines of " << lineLen << " bytes each" << std::endl;
+    runBench("FileOps (ofstream)", [segmentSize]()
+        { return std::make_unique<FileOps>(segmentSize, "FileWriteBench_ofstream.log"); }, lineCnt, line);
+    runBench("MmapFileOps (NONE)", [segmentSize]()
+        { return std::make_unique<MmapFileOps>(segmentSize, "FileWriteBench_mmap.log"); }, lineCnt, line);
+    runBench("MmapFileOps (RANGE)", [segmentSize]()
+        { return std::make_unique<MmapFileOps>(segmentSize, "FileWriteBench_range.log", "", "", MmapSyncPolicy::RANGE); }, lineCnt, line);
+    runBench("MmapFileOps (SYNC)", [segmentSize]()
+        { return std::make_unique<MmapFileOps>(segmentSize, "FileWriteBench_sync.log", "", "", MmapSyncPolicy::SYNC); }, lineCnt, line);
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * LineCountBench.cpp
+ *
+ * Counts the lines of a log file with std::getline, as the FileOps read paths
+ * used to, against the LineScanner kernels over a memory mapped file.
+ *
+ * Usage: ./bin/LineCountBench [size in MB of the generated log | existing log file]
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "LineScanner.hpp"
+#include "MappedFile.hpp"
+#include "Clock.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <functional>
+#include <filesystem>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief Write a log of about the given size, with lines of varying length
+     *
+     * @param [in] file The file to be written
+     * @param [in] sizeMB Size of the file in MB
+     */
+    void generateLog(const std::filesystem::path& file, const size_t sizeMB)
+    {
+        const std::string prefix = "|20250825_155051| 140245563983680| FileWriteBench.cpp  |   42|INF>  ";
+        std::ofstream ofile(file, std::ios::binary | std::ios::trunc);
+        std::string line;
+        size_t written = 0;
+        for (size_t cnt = 0; written < sizeMB * 1024 * 1024; ++cnt)
+        {
+            line = prefix + std::string(cnt % 160, static_cast<char>('a' + cnt % 26)) + '\n';
+            ofile << line;
+            written += line.size();
+        }
+    }
+
+    /**
+     * @brief Time a line counting function and report its throughput
+     *
+     * @param [in] name Name of the run to be printed
+     * @param [in] fileSize Size of the file, for the throughput
+     * @param [in] countLines Counts and returns the lines of the file
+     */
+    void runBench(const std::string_view name, const std::uintmax_t fileSize, const std::function<size_t()>& countLines)
+    {
+        Clock clock;
+        clock.start();
+        auto lineCnt = countLines();
+        clock.stop();
+
+        auto elapsedSec = clock.getElapsedTime(TimeUnits::MICROSECONDS) / 1000000.0;
+        std::cout << std::left << std::setw(28) << name
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(10) << elapsedSec << " s"
+                  << std::setw(12) << lineCnt << " lines"
+                  << std::setw(10) << static_cast<double>(fileSize) / (1024 * 1024 * 1024) / elapsedSec << " GB/s" << std::endl;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    std::filesystem::path file = "LineCountBench.log";
+    auto generated = true;
+    if (argc > 1 && std::filesystem::exists(argv[1]))
+    {
+        file = argv[1];
+        generated = false;
+    }
+    else
+    {
+        size_t sizeMB = (argc > 1) ? std::stoul(argv[1]) : 1024;
+        std::cout << "Generating a " << sizeMB << " MB log..." << std::endl;
+        generateLog(file, sizeMB);
+    }
+    auto fileSize = std::filesystem::file_size(file);
+    std::cout << "Counting the lines of " << file.string() << " (" << fileSize << " bytes), "
+              << "runtime pick: " << LineScanner::getIsaName(LineScanner::getIsa()) << std::endl;
+
+    runBench("std::getline", fileSize, [&file]()
+    {
+        std::ifstream ifile(file, std::ios::binary);
+        std::string line;
+        size_t lineCnt = 0;
+        while (std::getline(ifile, line))
+            ++lineCnt;
+        return lineCnt;
+    });
+
+    for (auto isa : { LineScanner::Isa::SCALAR, LineScanner::Isa::SSE2, LineScanner::Isa::AVX2 })
+    {
+        if (!LineScanner::isSupported(isa))
+            continue;
+
+        runBench("mmap + " + LineScanner::getIsaName(isa) + " count", fileSize, [&file, isa]()
+        {
+            MappedFile mappedFile(file);
+            auto view = mappedFile.view();
+            return LineScanner::countNewLines(view.data(), view.data() + view.size(), isa);
+        });
+    }
+
+    runBench("mmap + line iterator", fileSize, [&file]()
+    {
+        return MappedFile::forEachLine(file, [](std::string_view) { return true; });
+    });
+
+    if (generated)
+        std::filesystem::remove(file);
+
+    return 0;
+}
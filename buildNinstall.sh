@@ -10,6 +10,11 @@ FILE_SIZE="10MB"
 LOG_FILE_PATH=""
 LOG_FILE_NAME=""
 LOG_FILE_EXTN=""
+FILE_LOG_LEVEL=""
+FILE_LOG_FORMAT="text"
+CONSOLE_LOGGING="no"
+CONSOLE_LOG_LEVEL=""
+CONSOLE_STDERR="no"
 
 print_global_help() {
   cat <<EOF
@@ -43,6 +48,23 @@ Optional arguments (case insensitive):
   -LOG_FILE_EXTN=<extension>      (optional)
       Export LOG_FILE_EXTN.
 
+  -FILE_LOG_LEVEL=<level>         (optional)
+      Least severe log type written to the file (default: all).
+
+  -FILE_LOG_FORMAT=<text|binary|json>  (default: text)
+      Write compact binary records, to be read with tools/LogDecode,
+      or JSON Lines, for log indexers.
+
+  -CONSOLE_LOGGING=<yes|no>      (default: no)
+      Log to the console as well, along with FILE_LOGGING=yes.
+
+  -CONSOLE_LOG_LEVEL=<level>      (optional)
+      Least severe log type written to the console
+      (default: WARN along with file logging, otherwise all).
+
+  -CONSOLE_STDERR=<yes|no>       (default: no)
+      Write the ERR, ASRT and FATAL records to stderr instead of stdout.
+
 Help options:
 
   --help, -h                     Show this help message.
@@ -52,6 +74,7 @@ Help options:
 Examples:
 
   $0 -BUILD_TYPE=debug -BUILD_TEST=yes -FILE_LOGGING=yes -FILE_SIZE=20MB
+  $0 -FILE_LOGGING=yes -CONSOLE_LOGGING=yes -CONSOLE_LOG_LEVEL=ERR
   $0 --help
   $0 -FILE_LOGGING --help
 EOF
@@ -124,6 +147,43 @@ EOF
 -LOG_FILE_EXTN:
 
   Optional file extension to export as LOG_FILE_EXTN.
+EOF
+      ;;
+    FILE_LOG_LEVEL|CONSOLE_LOG_LEVEL)
+      cat <<EOF
+-$arg possible values (case insensitive), from the least to the most severe:
+
+  DBG, INF, IMP, WARN, ERR, ASRT, FATAL
+
+  Records less severe than the given one are not written.
+EOF
+      ;;
+    FILE_LOG_FORMAT)
+      cat <<EOF
+-FILE_LOG_FORMAT possible values (case insensitive):
+
+  text      - Plain text lines, rotated at FILE_SIZE (default).
+  binary    - Binary records, the strings of each call site written once.
+              Not rotated. Render them as text with ./bin/LogDecode <file>.
+  json      - JSON Lines, one object per record with its fields, for log
+              indexers. Not rotated.
+EOF
+      ;;
+    CONSOLE_LOGGING)
+      cat <<EOF
+-CONSOLE_LOGGING possible values (case insensitive):
+
+  yes       - Log to the console along with the file, when FILE_LOGGING=yes.
+              Each gets its own queue and level threshold.
+  no        - Log to the file only, when FILE_LOGGING=yes (default).
+EOF
+      ;;
+    CONSOLE_STDERR)
+      cat <<EOF
+-CONSOLE_STDERR possible values (case insensitive):
+
+  yes       - Write the ERR, ASRT and FATAL records to stderr, the rest to stdout.
+  no        - Write every record to stdout (default).
 EOF
       ;;
     *)
@@ -273,6 +333,43 @@ else
         LOG_FILE_EXTN)
           LOG_FILE_EXTN="$value"
           ;;
+        FILE_LOG_LEVEL|CONSOLE_LOG_LEVEL)
+          value_upper=$(echo "$value" | tr '[:lower:]' '[:upper:]')
+          if [[ "$value_upper" =~ ^(DBG|INF|IMP|WARN|ERR|ASRT|FATAL)$ ]]; then
+            printf -v "$key_upper" '%s' "$value_upper"
+          else
+            echo "Error: Invalid value for $key_upper: $value"
+            echo "Use -$key_upper --help for valid options."
+            exit 1
+          fi
+          ;;
+        FILE_LOG_FORMAT)
+          if [[ "$value_lower" == "text" || "$value_lower" == "binary" || "$value_lower" == "json" ]]; then
+            FILE_LOG_FORMAT="$value_lower"
+          else
+            echo "Error: Invalid value for FILE_LOG_FORMAT: $value"
+            echo "Use -FILE_LOG_FORMAT --help for valid options."
+            exit 1
+          fi
+          ;;
+        CONSOLE_LOGGING)
+          if [[ "$value_lower" == "yes" || "$value_lower" == "no" ]]; then
+            CONSOLE_LOGGING="$value_lower"
+          else
+            echo "Error: Invalid value for CONSOLE_LOGGING: $value"
+            echo "Use -CONSOLE_LOGGING --help for valid options."
+            exit 1
+          fi
+          ;;
+        CONSOLE_STDERR)
+          if [[ "$value_lower" == "yes" || "$value_lower" == "no" ]]; then
+            CONSOLE_STDERR="$value_lower"
+          else
+            echo "Error: Invalid value for CONSOLE_STDERR: $value"
+            echo "Use -CONSOLE_STDERR --help for valid options."
+            exit 1
+          fi
+          ;;
         *)
           echo "Warning: Unknown argument '$key'. Ignored."
           ;;
@@ -300,6 +397,21 @@ if [[ "$FILE_LOGGING" == "yes" ]]; then
   if [[ -n "$LOG_FILE_EXTN" ]]; then
     export LOG_FILE_EXTN
   fi
+  if [[ -n "$FILE_LOG_LEVEL" ]]; then
+    export FILE_LOG_LEVEL
+  fi
+  if [[ "$FILE_LOG_FORMAT" == "binary" || "$FILE_LOG_FORMAT" == "json" ]]; then
+    export FILE_LOG_FORMAT
+  fi
+  if [[ "$CONSOLE_LOGGING" == "yes" ]]; then
+    export CONSOLE_LOGGING
+  fi
+fi
+if [[ -n "$CONSOLE_LOG_LEVEL" ]]; then
+  export CONSOLE_LOG_LEVEL
+fi
+if [[ "$CONSOLE_STDERR" == "yes" ]]; then
+  export CONSOLE_STDERR
 fi
 
 # Print the final values (for demonstration)
@@ -311,6 +423,11 @@ echo "FILE_SIZE=$FILE_SIZE"
 echo "LOG_FILE_PATH=${LOG_FILE_PATH:-<not set>}"
 echo "LOG_FILE_NAME=${LOG_FILE_NAME:-<not set>}"
 echo "LOG_FILE_EXTN=${LOG_FILE_EXTN:-<not set>}"
+echo "FILE_LOG_LEVEL=${FILE_LOG_LEVEL:-<not set>}"
+echo "FILE_LOG_FORMAT=$FILE_LOG_FORMAT"
+echo "CONSOLE_LOGGING=$CONSOLE_LOGGING"
+echo "CONSOLE_LOG_LEVEL=${CONSOLE_LOG_LEVEL:-<not set>}"
+echo "CONSOLE_STDERR=$CONSOLE_STDERR"
 
 echo ""
 echo ""
@@ -0,0 +1,220 @@
+/**
+ * @file BatchSinkOps.hpp
+ * @brief Declaration of the BatchSinkOps class, which plugs a LogSink into the
+ *        logging ops, handing it the records with their metadata a batch at a time.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BATCH_SINK_OPS_HPP
+#define BATCH_SINK_OPS_HPP
+
+#include "LoggingOps.hpp"
+#include "LogSink.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace logger
+{
+    class BatchSinkOps : public LoggingOps
+    {
+        public:
+            static constexpr size_t defaultMaxBatchSize = 256;
+            static constexpr std::chrono::milliseconds defaultMaxLatency{100};
+
+            /**
+             * @brief Construct a new BatchSinkOps object
+             * The records are handed over to the sink by the shared I/O executor.
+             *
+             * @param [in] sink The sink, owned by this object from now on
+             * @param [in] maxBatchSize A batch is handed over as soon as it has
+             *             that many records (default 256, like the other sinks)
+             * @param [in] maxLatency Whatever is queued is handed over at the
+             *             latest after this long, even a batch not full yet
+             * @throws std::invalid_argument If the sink is null
+             */
+            explicit BatchSinkOps(std::unique_ptr<LogSink> sink,
+                                  const size_t maxBatchSize = defaultMaxBatchSize,
+                                  const std::chrono::milliseconds maxLatency = defaultMaxLatency);
+
+            /**
+             * @brief Destructor for BatchSinkOps class
+             * Hands whatever is still queued over to the sink and flushes it.
+             */
+            virtual ~BatchSinkOps();
+
+            /**
+             * @brief Deleted copy constructor and move constructor
+             * to prevent copying and moving of BatchSinkOps objects
+             */
+            BatchSinkOps(const BatchSinkOps& rhs) = delete;
+            BatchSinkOps(BatchSinkOps&& rhs) = delete;
+            BatchSinkOps& operator=(const BatchSinkOps& rhs) = delete;
+            BatchSinkOps& operator=(BatchSinkOps&& rhs) = delete;
+
+            using LoggingOps::writeRecord;
+
+            /**
+             * @brief Queue a record for the sink
+             * The text, the call site and the fields are copied, so that the
+             * record can be handed over later with all of its metadata. The
+             * severe ones take the priority lane, handed over first.
+             *
+             * @param [in] record The record, its text and its metadata
+             */
+            void writeRecord(const LogRecord& record) override;
+
+            /**
+             * @brief Hand what is queued over to the sink and have it flushed
+             * Waits for LogSink::flush() to return, called from the I/O executor.
+             */
+            void commitCritical() override;
+
+            /**
+             * @brief Get the sink
+             *
+             * @return LogSink& The sink records are handed over to
+             */
+            inline LogSink& getSink() const                                 { return *m_sink;           }
+
+            /**
+             * @brief Get the number of batches handed over so far
+             *
+             * @return size_t The number of calls to LogSink::consume()
+             */
+            inline size_t getBatchCount() const noexcept                    { return m_batchCnt;        }
+
+            /**
+             * @brief Get the Class Id for the object
+             *
+             * @return std::string The name of the sink
+             * @see LogSink::getName()
+             */
+            inline const std::string getClassId() const override            { return m_sink->getName(); }
+
+        protected:
+            /**
+             * @brief Queue data written without metadata, e.g. with operator<<
+             * It goes to the sink as a LOG_DEFAULT record, whatever the
+             * level threshold, as there is no log type to filter on.
+             *
+             * @param [in] data The data to be written
+             */
+            void writeDataTo(const std::string_view data) override;
+
+            /**
+             * @brief Hand the pending batch over to the sink, a drain turn
+             * @see LoggingOps::drainBatch()
+             */
+            bool drainBatch() override;
+
+            /**
+             * @brief Checks if there is nothing to hand over, nor a sink flush pending
+             * @see LoggingOps::isQueueEmpty()
+             */
+            bool isQueueEmpty() const override;
+
+            /**
+             * @brief Checks if there is nothing to hand over in the priority lane
+             * @see LoggingOps::isPriorityQueueEmpty()
+             */
+            bool isPriorityQueueEmpty() const override;
+
+        private:
+            /**
+             * @brief A queued record, its strings kept as offsets into the batch arena
+             */
+            struct Entry
+            {
+                LogRecord meta;     ///< The string views left empty
+                size_t fileNameOff;
+                size_t funcNameOff;
+                size_t markerOff;
+                size_t textOff;
+                size_t endOff;
+                size_t fieldsOff;   ///< The first of its fields in Batch::fields
+            };
+
+            /**
+             * @brief A queued field, its key and string value kept as offsets into the batch arena
+             */
+            struct FieldEntry
+            {
+                LogField meta;      ///< The key and the string value left empty
+                size_t keyOff;
+                size_t valueOff;
+                size_t endOff;
+            };
+
+            /**
+             * @brief The records queued between two hand overs
+             * All the strings go to a single arena, which keeps its
+             * capacity from batch to batch like the entries do.
+             */
+            struct Batch
+            {
+                std::string arena;
+                std::vector<Entry> entries;
+                std::vector<FieldEntry> fields;
+
+                void clear() noexcept                                       { arena.clear(); entries.clear(); fields.clear(); }
+            };
+
+            /**
+             * @brief Copy a record into the pending batch
+             *
+             * @param [in] record The record to be queued
+             * @param [in] priority Whether it goes to the priority lane
+             */
+            void queueRecord(const LogRecord& record, const bool priority);
+
+            /**
+             * @brief Hand a batch over to the sink
+             *
+             * @param [in] batch The batch to be handed over
+             * @param [in] flushSink Whether the sink has to be flushed afterwards
+             */
+            void consumeBatch(const Batch& batch, const bool flushSink);
+
+            std::unique_ptr<LogSink> m_sink;
+            /// Guarded by m_DataRecordsMtx, like the data records queue
+            Batch m_pending;
+            /// The priority lane, guarded by m_DataRecordsMtx as well
+            Batch m_priorityPending;
+            /// Touched by the drain turns only
+            Batch m_inFlight;
+            std::vector<LogRecord> m_records;
+            std::vector<LogField> m_fields;
+            /// Guarded by m_DataRecordsMtx
+            bool m_sinkFlushRequested;
+            /// When the timed drain turn armed for a batch not full yet is due, max
+            /// if none is armed. Guarded by m_DataRecordsMtx
+            std::chrono::steady_clock::time_point m_drainTimerDue;
+            std::atomic<size_t> m_batchCnt;
+    };
+};  // logger namespace
+
+#endif  // BATCH_SINK_OPS_HPP
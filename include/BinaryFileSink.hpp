@@ -0,0 +1,187 @@
+/**
+ * @file BinaryFileSink.hpp
+ * @brief Declaration of the BinaryFileSink class, a LogSink writing compact
+ *        binary records to a file, with the static strings of each call site
+ *        written only once. Read back with BinaryLogDecoder or tools/LogDecode.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BINARY_FILE_SINK_HPP
+#define BINARY_FILE_SINK_HPP
+
+#include "LogSink.hpp"
+#include "Logger.hpp"
+
+#include <filesystem>
+#include <unordered_map>
+
+namespace logger
+{
+    class BinaryFileSink : public LogSink
+    {
+        public:
+            /**
+             * @brief Construct a new BinaryFileSink object
+             * Opens the file for appending, writes the magic if it is empty
+             * and starts a new session in it.
+             *
+             * @param [in] file The file to be written
+             * @param [in] timeFormat The strftime format the decoder renders
+             *             the time stamps with, the one of the Logger by default
+             * @throws std::runtime_error If the file can't be opened or written,
+             *         or is not empty and not a binary log
+             */
+            explicit BinaryFileSink(const std::filesystem::path& file,
+                                    const std::string_view timeFormat = LOG_TIME_FORMAT);
+
+            /**
+             * @brief Destructor for BinaryFileSink class
+             * Closes the file.
+             */
+            ~BinaryFileSink() override;
+
+            /**
+             * @brief Deleted copy constructor and move constructor
+             * to prevent copying and moving of BinaryFileSink objects
+             */
+            BinaryFileSink(const BinaryFileSink& rhs) = delete;
+            BinaryFileSink(BinaryFileSink&& rhs) = delete;
+            BinaryFileSink& operator=(const BinaryFileSink& rhs) = delete;
+            BinaryFileSink& operator=(BinaryFileSink&& rhs) = delete;
+
+            /**
+             * @brief Encode a batch of records and write it with a single write(2)
+             * A record rendered by the Logger is written as its call site id,
+             * time stamp delta, log type, thread id and formatted message.
+             * Its key/value fields, if any, go natively in a frame before it.
+             * The call sites, the threads and the field keys not seen before
+             * in this session get a dictionary frame of their own first.
+             *
+             * @param [in] records The batch
+             * @throws std::runtime_error If the file can't be written
+             */
+            void consume(std::span<const LogRecord> records) override;
+
+            /**
+             * @brief Make what got written so far durable, with fdatasync(2)
+             * @throws std::runtime_error If the file can't be synced
+             */
+            void flush() override;
+
+            /**
+             * @brief Get the name of the sink
+             *
+             * @return std::string "BinaryFileSink"
+             */
+            inline std::string getName() const override                     { return "BinaryFileSink";  }
+
+            /**
+             * @brief Get the path of the file
+             *
+             * @return const std::filesystem::path& The file written
+             */
+            inline const std::filesystem::path& getFilePath() const noexcept { return m_file;           }
+
+            /**
+             * @brief Get the number of call sites in the dictionary of this session
+             *
+             * @return size_t The number of call sites seen so far
+             */
+            inline size_t getCallSiteCount() const noexcept                 { return m_callSites.size(); }
+
+            /**
+             * @brief Get the number of bytes written in this session
+             *
+             * @return uintmax_t The bytes written, the header of the session included
+             */
+            inline std::uintmax_t getBytesWritten() const noexcept          { return m_bytesWritten;    }
+
+        private:
+            /**
+             * @brief Encode a record into m_buffer
+             *
+             * @param [in] record The record to be encoded
+             */
+            void encodeRecord(const LogRecord& record);
+
+            /**
+             * @brief Get the dictionary id of a call site, adding it if new
+             *
+             * @param [in] record A record of the call site
+             * @param [in] context The "[Class : function]" part of its text
+             * @return uint64_t The id of the call site
+             */
+            uint64_t getCallSiteId(const LogRecord& record, const std::string_view context);
+
+            /**
+             * @brief Get the dictionary id of a thread, adding it if new
+             *
+             * @param [in] threadId The thread
+             * @return uint64_t The id of the thread
+             */
+            uint64_t getThreadId(const std::thread::id& threadId);
+
+            /**
+             * @brief Get the dictionary id of a field key, adding it if new
+             *
+             * @param [in] key The key
+             * @return uint64_t The id of the key
+             */
+            uint64_t getKeyId(const std::string_view key);
+
+            /**
+             * @brief Encode the fields of a record into m_buffer
+             *
+             * @param [in] fields The fields, not empty
+             */
+            void encodeFields(const std::span<const LogField> fields);
+
+            /**
+             * @brief Start a new session in m_buffer, with empty dictionaries
+             */
+            void startSession();
+
+            /**
+             * @brief Write out m_buffer and clear it
+             */
+            void writeBuffer();
+
+            std::filesystem::path m_file;
+            const std::string m_timeFormat;
+            int m_fd;
+            std::string m_buffer;
+            /// The call sites, keyed by their static strings and line
+            std::unordered_map<std::string, uint64_t> m_callSites;
+            std::string m_callSiteKey;
+            std::unordered_map<std::thread::id, uint64_t> m_threads;
+            std::unordered_map<std::string, uint64_t> m_keys;
+            std::string m_keyScratch;
+            std::vector<uint64_t> m_keyIds;
+            int64_t m_lastTimestamp;
+            int64_t m_utcOffset;
+            std::uintmax_t m_bytesWritten;
+    };
+};  //logger namespace
+
+#endif // BINARY_FILE_SINK_HPP
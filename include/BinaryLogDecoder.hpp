@@ -0,0 +1,83 @@
+/**
+ * @file BinaryLogDecoder.hpp
+ * @brief Declaration of the BinaryLogDecoder class, which renders the records
+ *        of a binary log written by BinaryFileSink back into the text lines
+ *        the Logger would have written.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BINARY_LOG_DECODER_HPP
+#define BINARY_LOG_DECODER_HPP
+
+#include <string_view>
+#include <functional>
+#include <filesystem>
+#include <cstddef>
+
+namespace logger
+{
+    class BinaryLogDecoder
+    {
+        public:
+            /**
+             * @brief Checks if a file is a binary log
+             *
+             * @param [in] file The file to be checked
+             * @return true If it starts with the magic of a binary log, otherwise
+             * @return false
+             */
+            static bool isBinaryLog(const std::filesystem::path& file);
+
+            /**
+             * @brief Visit the records of a binary log file as text lines
+             * The file gets memory mapped and decoded in one go. A record cut
+             * short at the end, e.g. by a crash in the middle of a write, ends
+             * the decoding quietly, as it would end a text log.
+             *
+             * @param [in] file The binary log file
+             * @param [in] func Called with each line, without a new line at its
+             *             end, the view being valid for the call only. Returns
+             *             false to stop the decoding
+             * @return size_t The number of lines visited
+             * @throws std::runtime_error If the file can't be read, is not a
+             *         binary log or has a malformed frame
+             */
+            static size_t forEachLine(const std::filesystem::path& file,
+                                      const std::function<bool(std::string_view)>& func);
+
+            /**
+             * @brief Visit the records of a binary log in memory as text lines
+             *
+             * @param [in] data The content of a binary log, its magic included
+             * @param [in] func Called with each line, returns false to stop the decoding
+             * @return size_t The number of lines visited
+             * @throws std::runtime_error If it is not a binary log or has a malformed frame
+             * @see forEachLine(const std::filesystem::path&, const std::function<bool(std::string_view)>&)
+             */
+            static size_t forEachLineInBuffer(std::string_view data,
+                                              const std::function<bool(std::string_view)>& func);
+    };
+};  //logger namespace
+
+#endif // BINARY_LOG_DECODER_HPP
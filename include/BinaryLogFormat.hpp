@@ -0,0 +1,226 @@
+/**
+ * @file BinaryLogFormat.hpp
+ * @brief Declaration of the BinaryLogFormat class, the frame layout of the
+ *        binary log files written by BinaryFileSink and read back by
+ *        BinaryLogDecoder, along with its varint helpers.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BINARY_LOG_FORMAT_HPP
+#define BINARY_LOG_FORMAT_HPP
+
+#include <array>
+#include <bit>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+namespace logger
+{
+    /**
+     * @brief The layout of a binary log file
+     * The file starts with the magic, followed by frames, each a tag byte
+     * and its fields. The integers are LEB128 varints (signed ones zigzag
+     * encoded), the strings a varint size followed by the bytes.
+     *
+     *   SESSION    time format                     Starts a new writer, forgets
+     *                                              the dictionaries and the time base
+     *   UTC_OFFSET offset (s, signed)              Of the local time from then on
+     *   CALL_SITE  id, line, file, function,       A call site, in the dictionary
+     *              marker, context                 once per session
+     *   THREAD     id, thread id as printed        A thread, in the dictionary
+     *                                              once per session
+     *   RECORD     time delta (us, signed),        A record of a known call site,
+     *              call site id, log type,         only its formatted message
+     *              thread id, message
+     *   TEXT       time delta (us, signed),        A record without a call site,
+     *              log type, thread id, text       e.g. written with operator<<
+     *   KEY        id, key                         A field key, in the dictionary
+     *                                              once per session
+     *   FIELDS     count, then per field key id,   The key/value fields of the
+     *              type (LogField::Type), value    RECORD or TEXT frame right after
+     *
+     * A field value is a byte for BOOL, a signed varint for INT, a varint
+     * for UINT, the 8 bytes of the IEEE 754 double, little endian, for DOUBLE
+     * and a string for STRING.
+     */
+    class BinaryLogFormat
+    {
+        public:
+            static constexpr std::array<char, 8> magic = { 'L', 'O', 'G', 'B', 'I', 'N', '0', '1' };
+
+            /**
+             * @brief The frame tags
+             */
+            enum class Tag : uint8_t
+            {
+                SESSION     = 1,
+                UTC_OFFSET  = 2,
+                CALL_SITE   = 3,
+                THREAD      = 4,
+                RECORD      = 5,
+                TEXT        = 6,
+                KEY         = 7,
+                FIELDS      = 8
+            };
+
+            /**
+             * @brief Append an unsigned varint
+             *
+             * @param [out] buffer The buffer to be appended to
+             * @param [in] value The value to be encoded
+             */
+            static inline void putVarint(std::string& buffer, uint64_t value)
+            {
+                while (value >= 0x80)
+                {
+                    buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                    value >>= 7;
+                }
+                buffer.push_back(static_cast<char>(value));
+            }
+
+            /**
+             * @brief Append a signed varint, zigzag encoded
+             *
+             * @param [out] buffer The buffer to be appended to
+             * @param [in] value The value to be encoded
+             */
+            static inline void putSignedVarint(std::string& buffer, const int64_t value)
+            {
+                putVarint(buffer, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+            }
+
+            /**
+             * @brief Append a string, its size first
+             *
+             * @param [out] buffer The buffer to be appended to
+             * @param [in] value The string to be encoded
+             */
+            static inline void putString(std::string& buffer, const std::string_view value)
+            {
+                putVarint(buffer, value.size());
+                buffer.append(value);
+            }
+
+            /**
+             * @brief Append a double, its 8 bytes little endian
+             *
+             * @param [out] buffer The buffer to be appended to
+             * @param [in] value The value to be encoded
+             */
+            static inline void putDouble(std::string& buffer, const double value)
+            {
+                auto bits = std::bit_cast<uint64_t>(value);
+                for (auto idx = 0; idx < 8; ++idx, bits >>= 8)
+                    buffer.push_back(static_cast<char>(bits & 0xFF));
+            }
+
+            /**
+             * @brief Read an unsigned varint
+             *
+             * @param [in,out] data What is left to be read, moved past the varint
+             * @param [out] value The value read
+             * @return true If a whole varint was there, otherwise
+             * @return false
+             */
+            static inline bool getVarint(std::string_view& data, uint64_t& value) noexcept
+            {
+                value = 0;
+                for (size_t idx = 0; idx < data.size() && idx < 10; ++idx)
+                {
+                    auto byte = static_cast<uint8_t>(data[idx]);
+                    value |= static_cast<uint64_t>(byte & 0x7F) << (7 * idx);
+                    if (!(byte & 0x80))
+                    {
+                        data.remove_prefix(idx + 1);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /**
+             * @brief Read a signed varint, zigzag encoded
+             *
+             * @param [in,out] data What is left to be read, moved past the varint
+             * @param [out] value The value read
+             * @return true If a whole varint was there, otherwise
+             * @return false
+             */
+            static inline bool getSignedVarint(std::string_view& data, int64_t& value) noexcept
+            {
+                uint64_t encoded = 0;
+                if (!getVarint(data, encoded))
+                    return false;
+
+                value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+                return true;
+            }
+
+            /**
+             * @brief Read a string, its size first
+             *
+             * @param [in,out] data What is left to be read, moved past the string
+             * @param [out] value A view of the string in data
+             * @return true If the whole string was there, otherwise
+             * @return false
+             */
+            static inline bool getString(std::string_view& data, std::string_view& value) noexcept
+            {
+                uint64_t size = 0;
+                auto rest = data;
+                if (!getVarint(rest, size) || size > rest.size())
+                    return false;
+
+                value = rest.substr(0, size);
+                data = rest.substr(size);
+                return true;
+            }
+
+            /**
+             * @brief Read a double, its 8 bytes little endian
+             *
+             * @param [in,out] data What is left to be read, moved past the double
+             * @param [out] value The value read
+             * @return true If all of its bytes were there, otherwise
+             * @return false
+             */
+            static inline bool getDouble(std::string_view& data, double& value) noexcept
+            {
+                if (data.size() < 8)
+                    return false;
+
+                uint64_t bits = 0;
+                for (auto idx = 7; idx >= 0; --idx)
+                    bits = (bits << 8) | static_cast<uint8_t>(data[idx]);
+                value = std::bit_cast<double>(bits);
+                data.remove_prefix(8);
+                return true;
+            }
+    };
+};  //logger namespace
+
+#endif // BINARY_LOG_FORMAT_HPP
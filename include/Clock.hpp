@@ -139,6 +139,15 @@ namespace logger
              * @return The current local time as a formatted string.
              */
             std::string getLocalTimeStr(const std::string_view format = "") const;
+            /**
+             * @brief Gets a given time as a local time formatted string.
+             * @param timePoint The time to be formatted.
+             * @param format The format for the time string (default: empty
+             *               which translates to class's default format).
+             * @return The given time as a local time formatted string.
+             */
+            std::string getLocalTimeStr(const std::chrono::system_clock::time_point& timePoint,
+                                        const std::string_view format = "") const;
             /**
              * @brief Gets the day of the week.
              * @return The day of the week as a string.
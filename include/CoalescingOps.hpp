@@ -0,0 +1,217 @@
+/**
+ * @file CoalescingOps.hpp
+ * @brief Declaration of the CoalescingOps class, which collapses a run of
+ *        repeated records into the first one and a "last message repeated
+ *        N times" record before they reach the sink it wraps.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef COALESCING_OPS_HPP
+#define COALESCING_OPS_HPP
+
+#include "LoggingOps.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace logger
+{
+    class CoalescingOps : public LoggingOps
+    {
+        public:
+            /**
+             * @brief Constructor for CoalescingOps class
+             * The records are collapsed as they come, the ones left over going
+             * straight to the sink it wraps. The shared I/O executor is only
+             * asked for a turn to write out a repeat count once its window is
+             * over.
+             *
+             * @param [in] sink The sink the records go to, owned by this object
+             * @param [in] window How long after its first occurrence a message
+             *             gets its repeats collapsed, 0 for none
+             * @throws std::invalid_argument If the sink is null
+             */
+            CoalescingOps(std::unique_ptr<LoggingOps> sink, const std::chrono::milliseconds window);
+
+            /**
+             * @brief Destructor for CoalescingOps class
+             * Writes out the repeat count still pending, then destroys the sink.
+             */
+            virtual ~CoalescingOps();
+
+            /**
+             * @brief Deleted copy constructor and move constructor
+             * to prevent copying and moving of CoalescingOps objects
+             */
+            CoalescingOps(const CoalescingOps& rhs) = delete;
+            CoalescingOps(CoalescingOps&& rhs) = delete;
+            CoalescingOps& operator=(const CoalescingOps& rhs) = delete;
+            CoalescingOps& operator=(CoalescingOps&& rhs) = delete;
+
+            /**
+             * @brief Set the window repeats get collapsed within
+             *
+             * @param [in] window How long after its first occurrence a message
+             *             gets its repeats collapsed, 0 for none
+             */
+            inline void setWindow(const std::chrono::milliseconds window) noexcept  { m_window = window;    }
+
+            /**
+             * @brief Get the window repeats get collapsed within
+             *
+             * @return std::chrono::milliseconds The window, 0 for none
+             */
+            inline std::chrono::milliseconds getWindow() const noexcept             { return m_window;      }
+
+            /**
+             * @brief Get the sink the records go to
+             *
+             * @return LoggingOps& The sink wrapped
+             */
+            inline LoggingOps& getSink() const noexcept                             { return *m_pSink;      }
+
+            /**
+             * @brief Get the number of records collapsed so far
+             *
+             * @return uint64_t The repeats not written as such
+             */
+            inline uint64_t getCollapsedCount() const noexcept                      { return m_collapsedCnt; }
+
+            using LoggingOps::writeRecord;
+
+            /**
+             * @brief write a formatted log record.
+             * A record whose call site, log type, message and fields hash the
+             * same as the record before it, within the window of the first of
+             * them, is only counted. Any other one is handed over to the sink
+             * right away. The count goes out as a record of its own, "last
+             * message repeated N times", before the next record which differs,
+             * once the window is over or on a flush. The LOG_ERR, LOG_FATAL and
+             * LOG_ASSERT records are never collapsed.
+             *
+             * @param [in] record The record, its text and its metadata
+             */
+            void writeRecord(const LogRecord& record) override;
+
+            /**
+             * @brief Write out the repeat count pending and flush the sink
+             * @see LoggingOps::flush()
+             */
+            void flush() override;
+
+            /**
+             * @brief Write out the repeat count pending, flush the sink and wait for it
+             * @see LoggingOps::flushAndWait()
+             */
+            void flushAndWait() override;
+
+            /**
+             * @brief Make the records written so far durable
+             * The repeat count pending is left pending, the first occurrence
+             * being durable already and the critical records never collapsed.
+             * @see LoggingOps::commitCritical()
+             */
+            void commitCritical() override;
+
+            /**
+             * @brief Get the Class Id for the object
+             *
+             * @return std::string The class id of the object
+             * @see LoggingOps::getClassId()
+             */
+            inline const std::string getClassId() const override { return "CoalescingOps"; }
+
+            /**
+             * @brief Hash what makes two records repeats of each other
+             * A FNV-1a hash rolled over the call site, the log type, the text
+             * after the time stamp and thread id prefix, and the fields.
+             *
+             * @param [in] record The record
+             * @return uint64_t The hash
+             */
+            static uint64_t hashRecord(const LogRecord& record) noexcept;
+
+        protected:
+            /**
+             * @brief Hand data written without metadata, e.g. with operator<<, over to the sink
+             * It ends the run, the repeat count pending going out before it.
+             *
+             * @param [in] data The data to be written
+             */
+            void writeDataTo(const std::string_view data) override;
+
+            /**
+             * @brief Write out the repeat count pending once its window is over, a drain turn
+             * @see LoggingOps::drainBatch()
+             */
+            bool drainBatch() override;
+
+        private:
+            /**
+             * @brief Have a drain turn write out the repeat count once its window is over
+             * Unless one is armed already. To be called with m_runMtx held.
+             *
+             * @param [in] now The time being
+             */
+            void armRepeatTurn(const std::chrono::steady_clock::time_point now);
+
+            /**
+             * @brief Write out the repeat count pending, if any
+             * To be called with m_runMtx held.
+             */
+            void writeRepeatRecord();
+
+            std::unique_ptr<LoggingOps> m_pSink;
+            std::atomic<std::chrono::milliseconds> m_window;
+            std::atomic<uint64_t> m_collapsedCnt;
+
+            /// Guards the state of the run, held while a record is handed over so that the sink gets them in order
+            std::mutex m_runMtx;
+            /// The hash of the record the run is of
+            uint64_t m_lastHash;
+            /// When the first record of the run came
+            std::chrono::steady_clock::time_point m_runStart;
+            /// The repeats of the first record of the run so far
+            uint64_t m_repeatCnt;
+            /// When the turn armed to write out the repeat count is due, max if none is armed
+            std::chrono::steady_clock::time_point m_repeatDue;
+
+            // The last repeat, copied as its views don't outlive the call
+            LOG_TYPE m_repeatLogType;
+            std::chrono::system_clock::time_point m_repeatTimestamp;
+            std::thread::id m_repeatThreadId;
+            std::string m_repeatFileName;
+            std::string m_repeatFuncName;
+            size_t m_repeatLineNo;
+            std::string m_repeatMarker;
+            /// Its text up to the message, that of the repeat record
+            std::string m_repeatPrefix;
+            size_t m_repeatPrefixSize;
+    };
+};  // logger namespace
+
+#endif  // COALESCING_OPS_HPP
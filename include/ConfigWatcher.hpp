@@ -0,0 +1,153 @@
+/**
+ * @file ConfigWatcher.hpp
+ * @brief Declaration of the ConfigWatcher class, which reloads the config file
+ *        of a live process when it changes or on a SIGHUP, and applies the
+ *        levels, the batching and the rotation size it sets.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CONFIG_WATCHER_HPP
+#define CONFIG_WATCHER_HPP
+
+#include "LoggerConfig.hpp"
+#include "DirWatch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <filesystem>
+
+namespace logger
+{
+    class LoggingOps;
+    class LoggerRegistry;
+
+    class ConfigWatcher
+    {
+        public:
+            /**
+             * @brief Construct a new ConfigWatcher object
+             * Nothing is watched before start().
+             *
+             * @param [in] ops The LoggingOps object the settings are applied to, as made by Logger::makeLoggingOps()
+             * @param [in] configFile The config file
+             * @param [in] watchFile Reload when the config file changes
+             * @param [in] onSighup Reload on a SIGHUP as well
+             * @param [in] registry The registry the levels of the named loggers go to,
+             *             LoggerRegistry::getShared() if null
+             * @param [in] pollPeriod How often to look at the file if no event
+             *                        comes in (or without inotify, i.e. not on Linux)
+             */
+            ConfigWatcher(LoggingOps& ops,
+                          const std::filesystem::path& configFile,
+                          const bool watchFile = true,
+                          const bool onSighup = false,
+                          LoggerRegistry* registry = nullptr,
+                          const std::chrono::milliseconds pollPeriod = std::chrono::milliseconds(1000));
+
+            /**
+             * @brief Destroy the ConfigWatcher object, stopping it first
+             */
+            ~ConfigWatcher();
+
+            ConfigWatcher(const ConfigWatcher&) = delete;
+            ConfigWatcher(ConfigWatcher&&) = delete;
+            ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+            ConfigWatcher& operator=(ConfigWatcher&&) = delete;
+
+            /**
+             * @brief Start watching, from a thread of its own
+             * A SIGHUP handler gets installed if asked for, which only wakes
+             * that thread up, the reload being done there.
+             *
+             * @return true If it got started, otherwise
+             * @return false If it is running already, or another one handles SIGHUP
+             */
+            bool start();
+
+            /**
+             * @brief Stop watching, the former SIGHUP handler being put back
+             */
+            void stop();
+
+            /**
+             * @brief Reload the config file and apply it now
+             * The settings are applied with atomic stores only, so that the
+             * logging calls are not held up and no record queued gets lost.
+             * Each of them is published on its own, not the reload as a whole,
+             * see Logger::applySettings() and LoggerRegistry::applyLevels().
+             */
+            void reload();
+
+            /**
+             * @brief Get the number of reloads so far
+             *
+             * @return size_t The number of reloads
+             */
+            inline size_t getReloadCount() const noexcept                       { return m_reloadCnt;   }
+
+            /**
+             * @brief Get the config file watched
+             *
+             * @return const std::filesystem::path& The config file
+             */
+            inline const std::filesystem::path& getConfigFile() const noexcept  { return m_configFile;  }
+
+        private:
+            /**
+             * @brief The thread of the watcher, reloading on a change till stop()
+             */
+            void watch();
+
+            /**
+             * @brief Block until the config file may have changed, a SIGHUP
+             * comes in, stop() is called or the poll period elapses
+             *
+             * @return true If a reload is due, otherwise
+             * @return false
+             */
+            bool waitForChange();
+
+            /**
+             * @brief Checks if the modification time or the size of the file changed
+             * since it was looked at last
+             */
+            bool isModified();
+
+            LoggingOps& m_ops;
+            std::filesystem::path m_configFile;
+            bool m_watchFile;
+            bool m_onSighup;
+            LoggerRegistry* m_registry;
+            std::chrono::milliseconds m_pollPeriod;
+            std::filesystem::file_time_type m_lastWriteTime;   // Touched by the watcher thread only
+            std::uintmax_t m_lastSize;
+            DirWatch m_dirWatch;            // Wakes the watcher thread up, on a change, to stop or on a SIGHUP
+            std::atomic<size_t> m_reloadCnt;
+            std::atomic<bool> m_running;
+            std::thread m_watchThread;
+    };
+};  //logger namespace
+
+#endif // CONFIG_WATCHER_HPP
@@ -35,25 +35,33 @@
 
 #include "LoggingOps.hpp"
 
+#include <chrono>
 #include <string>
 #include <string_view>
 #include <sstream>
-#include <condition_variable>
 
 namespace logger
 {
     class ConsoleOps : public LoggingOps
     {
         public:
+            static constexpr std::chrono::milliseconds defaultMaxLatency{50};
+
             /**
              * @brief Default constructor for ConsoleOps class
              * Initializes the console operations object.
+             *
+             * @param [in] criticalToStderr Whether the LOG_ERR, LOG_FATAL and
+             *             LOG_ASSERT records go to stderr instead of stdout
+             * @param [in] maxLatency The records are written a batch at a time,
+             *             a batch not full yet at the latest after this long
              */
-            ConsoleOps();
+            explicit ConsoleOps(const bool criticalToStderr = false,
+                                const std::chrono::milliseconds maxLatency = defaultMaxLatency);
 
             /**
              * @brief Destructor for ConsoleOps class
-             * Cleans up the console operations object.
+             * Writes out what is still queued and cleans up the console operations object.
              */
             virtual ~ConsoleOps();
 
@@ -66,6 +74,50 @@ namespace logger
             ConsoleOps& operator=(const ConsoleOps& rhs) = delete;
             ConsoleOps& operator=(ConsoleOps&& rhs) = delete;
 
+            using LoggingOps::writeRecord;
+
+            /**
+             * @brief Write a record to the console
+             * A LOG_ERR, LOG_FATAL or LOG_ASSERT record goes to the stderr lane
+             * if setCriticalToStderr() says so, whatever else takes the priority
+             * lane stays on stdout.
+             *
+             * @param [in] record The record, its text and its metadata
+             * @see LoggingOps::writeRecord()
+             */
+            void writeRecord(const LogRecord& record) override;
+
+            /**
+             * @brief Set whether the critical records go to stderr
+             *
+             * @param [in] criticalToStderr true for stderr, false for stdout
+             */
+            inline void setCriticalToStderr(const bool criticalToStderr) noexcept  { m_criticalToStderr = criticalToStderr;  }
+
+            /**
+             * @brief Checks if the critical records go to stderr
+             *
+             * @return true If they go to stderr, otherwise
+             * @return false
+             */
+            inline bool isCriticalToStderr() const noexcept                         { return m_criticalToStderr;              }
+
+            /**
+             * @brief Checks if a record of a log type takes the priority lane
+             * The LOG_ERR, LOG_FATAL and LOG_ASSERT records always do, along
+             * with what setPriorityLevel() lets in. The lane is written out
+             * right away, ahead of the batch queued before it, to stdout. The
+             * critical records bound for stderr, if setCriticalToStderr() says
+             * so, take a lane of their own, written out ahead of it. A LOG_FATAL
+             * or LOG_ASSERT record is waited for by waitForFatal().
+             *
+             * @param [in] logType The log type of the record
+             * @return true If it skips the queue, otherwise
+             * @return false
+             * @see LoggingOps::isPriority()
+             */
+            bool isPriority(const LOG_TYPE logType) const noexcept override;
+
             /**
              * @brief Get the Class Id for the object
              * This function is used to get the class id of the object.
@@ -82,33 +134,78 @@ namespace logger
         protected:
             /**
              * @brief Write data to the out stream object
+             * Queues the data, to be written with the rest of its batch.
              *
              * @param [in] data The data to be written to the out stream object
-             * @note This function is pure virtual and must be implemented by the derived classes.
-             * It is used to write the data to the out stream object.
              */
             void writeDataTo(const std::string_view data) override;
 
             /**
              * @brief Write to the out stream object
+             * Assembles the whole batch, a line per record, in a buffer
+             * and writes it to stdout with a single write(2).
              *
              * @param [in] dataQueue The data queue to be written to the out stream object
              * @param [out] excpPtr The exception pointer to be used for exception handling
-             *
-             * @note This function is thread safe. It uses mutex and condition variable
-             * to ensure that only one thread can write to the outstream object at a time.
              */
             void writeToOutStreamObject(BufferQ&& dataQueue, std::exception_ptr& excpPtr) override;
 
+            /**
+             * @brief Write out one batch, a drain turn run by the I/O executor
+             * The stderr lane first, then the priority lane and the batch.
+             * @see LoggingOps::drainBatch()
+             */
+            bool drainBatch() override;
+
+            /**
+             * @brief Checks if there is nothing queued, the stderr lane included
+             * @see LoggingOps::isQueueEmpty()
+             */
+            bool isQueueEmpty() const override;
+
+            /**
+             * @brief Checks if there is nothing queued in the priority lane nor in the stderr lane
+             * @see LoggingOps::isPriorityQueueEmpty()
+             */
+            bool isPriorityQueueEmpty() const override;
+
+            /**
+             * @brief Write a buffer to the console, or to the test string streams
+             *
+             * @param [in] buffer The lines to be written, each with its new line
+             * @param [in] toStderr Whether to write to stderr instead of stdout
+             * @note Throws std::runtime_error if the write fails
+             */
+            void writeToConsole(const std::string_view buffer, const bool toStderr);
+
+            /**
+             * @brief Write a batch to the console, a line per record, with a single write(2)
+             *
+             * @param [in] dataQueue The records to be written
+             * @param [out] excpPtr The exception pointer to be used for exception handling
+             * @param [in] toStderr Whether to write to stderr instead of stdout
+             */
+            void writeBatch(BufferQ&& dataQueue, std::exception_ptr& excpPtr, const bool toStderr);
+
             std::atomic_bool m_testing;
             std::ostringstream m_testStringStream;
+            /// What would have gone to stderr, in testing mode
+            std::ostringstream m_testErrStringStream;
+
+            /// Keeps the writes to the console, or to the test string streams, from interleaving
+            std::mutex m_consoleMtx;
 
         private:
-            std::mutex m_mtx;
-            std::condition_variable m_cv;
-            std::atomic_bool m_isOpsRunning;
+            std::atomic_bool m_criticalToStderr;
+            /// Set (under m_DataRecordsMtx) while a timed drain turn is pending
+            bool m_drainTimerArmed;
+            /// The batch buffer, kept from batch to batch. Touched by the drain turns only
+            std::string m_batchBuffer;
+            /// The critical records bound for stderr, a line each, guarded by m_DataRecordsMtx
+            std::string m_stderrRecords;
+            /// The stderr lane out for writing, kept from turn to turn. Touched by the drain turns only
+            std::string m_stderrBatch;
     };
 };  // logger namespace
 
 #endif  //CONSOLE_OPS_HPP
-
@@ -0,0 +1,138 @@
+/**
+ * @file DirWatch.hpp
+ * @brief Declaration of the DirWatch class, which lets a thread of its own
+ *        wait for a file to change, for a wakeup or for a poll period.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DIR_WATCH_HPP
+#define DIR_WATCH_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <filesystem>
+
+namespace logger
+{
+    /**
+     * @brief The changes a DirWatch wakes up on
+     */
+    enum class DirWatchEvents : uint8_t
+    {
+        WRITTEN,            ///< The file written out and closed, or renamed over, not its creation
+        ANY                 ///< Any change of a file of the directory, e.g. a write, a rotation or a removal
+    };
+
+    /**
+     * @brief What a DirWatch::wait() came back with
+     */
+    struct DirWatchResult
+    {
+        bool timedOut = false;      ///< Nothing came in for the timeout
+        bool fileChanged = false;   ///< An event came in for the file watched
+        std::string wakeups;        ///< The bytes written by wakeup() meanwhile, in order
+    };
+
+    class DirWatch
+    {
+        public:
+            DirWatch();
+
+            /**
+             * @brief Destroy the DirWatch object, closing it first
+             */
+            ~DirWatch();
+
+            DirWatch(const DirWatch&) = delete;
+            DirWatch(DirWatch&&) = delete;
+            DirWatch& operator=(const DirWatch&) = delete;
+            DirWatch& operator=(DirWatch&&) = delete;
+
+            /**
+             * @brief Open the wakeup pipe, and watch the directory of a file
+             * The directory rather than the file, so that a file created or
+             * renamed over it gets caught as well. The events are watched
+             * with inotify, on Linux only. Without them the caller polls.
+             *
+             * @param [in] file The file, it need not exist yet
+             * @param [in] events The changes to wake up on
+             * @return true If the wakeup pipe got opened, otherwise
+             * @return false
+             */
+            bool open(const std::filesystem::path& file, const DirWatchEvents events);
+
+            /**
+             * @brief Open the wakeup pipe only, no file being watched
+             *
+             * @return true If the wakeup pipe got opened, otherwise
+             * @return false
+             */
+            bool open();
+
+            /**
+             * @brief Close the wakeup pipe and stop watching, once the waiting thread is gone
+             */
+            void close() noexcept;
+
+            /**
+             * @brief Wake the waiting thread up
+             * Async signal safe, e.g. from a signal handler given getWakeupFd().
+             *
+             * @param [in] wakeup The byte handed over in DirWatchResult::wakeups
+             */
+            void wakeup(const char wakeup = 1) noexcept;
+
+            /**
+             * @brief Wait for the file to change or for a wakeup
+             * The events of the other files of the directory get dropped.
+             *
+             * @param [in] timeout The poll period, negative to wait for an event or a wakeup only
+             * @return DirWatchResult What came in
+             */
+            DirWatchResult wait(const std::chrono::milliseconds timeout);
+
+            /**
+             * @brief Checks if the events of the file are watched, rather than polled for
+             *
+             * @return true If they are, otherwise
+             * @return false
+             */
+            inline bool isWatching() const noexcept                         { return m_notifyFd >= 0;   }
+
+            /**
+             * @brief Get the write end of the wakeup pipe, -1 if not open
+             *
+             * @return int The file descriptor
+             */
+            inline int getWakeupFd() const noexcept                         { return m_wakeupPipe[1];   }
+
+        private:
+            std::string m_fileName;         // The name of the file watched, within its directory
+            int m_notifyFd;                 // inotify (Linux only)
+            int m_wakeupPipe[2];            // Wakes the waiting thread up
+    };
+};  //logger namespace
+
+#endif // DIR_WATCH_HPP
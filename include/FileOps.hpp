@@ -34,15 +34,56 @@
 #define FILE_OPS_HPP
 
 #include "LoggingOps.hpp"
+#include "LineIndex.hpp"
+#include "MappedFile.hpp"
+#include "ReverseReader.hpp"
 
 #include <fstream>
 #include <string>
+#include <chrono>
+#include <memory>
 #include <filesystem>
 
 namespace logger
 {
     using DataQ = std::queue<std::string>;
 
+    /**
+     * @brief Durability policy of a file sink
+     *
+     * Decides when the data written to the file is pushed from the
+     * page cache down to the storage device with fdatasync.
+     */
+    enum class DurabilityPolicy
+    {
+        NO_SYNC,        ///< Leave it to the kernel, a power loss may lose whatever is in the page cache
+        PERIODIC,       ///< fdatasync every N milliseconds if something was written meanwhile
+        PER_BATCH,      ///< fdatasync after each batch of records is written (group commit)
+        ON_CRITICAL     ///< fdatasync before returning from a LOG_ERR, LOG_FATAL or LOG_ASSERT call
+    };
+
+    /**
+     * @brief Latency counters of the fdatasync calls made by a file sink
+     */
+    struct SyncStats
+    {
+        size_t syncCount = 0;                               ///< Number of syncs done
+        size_t failedCount = 0;                             ///< Number of syncs which failed
+        std::chrono::nanoseconds totalLatency{0};           ///< Time spent in all the syncs
+        std::chrono::nanoseconds maxLatency{0};             ///< The slowest sync
+        std::chrono::nanoseconds lastLatency{0};            ///< The latest sync
+
+        /**
+         * @brief Get the average latency of a sync
+         *
+         * @return std::chrono::nanoseconds The average, 0 if there was none
+         */
+        inline std::chrono::nanoseconds averageLatency() const
+        {
+            return syncCount ? totalLatency / static_cast<std::chrono::nanoseconds::rep>(syncCount) : std::chrono::nanoseconds(0);
+        }
+    };
+
     class FileOps : public LoggingOps
     {
         public:
@@ -142,15 +183,52 @@ namespace logger
                                         const std::streampos end,
                                         std::vector<char>& outBuff);
 
+            /**
+             * @brief Read a range of bytes from an already opened file
+             *
+             * Same as the above, but reads with pread(2) from a file descriptor
+             * the caller keeps open, e.g. to read a growing file again and again
+             * without opening it for every read. Reads less than asked for if
+             * the file ends before the end position.
+             *
+             * @param [in] fd The file descriptor, opened for reading
+             * @param [in] start The start position of the range
+             * @param [in] end The end position of the range
+             * @param [out] outBuff The output buffer, resized to the bytes read
+             *
+             * @return size_t Number of bytes read
+             * @throw std::runtime_error If the range is invalid or the read fails
+             */
+            static size_t readFileByteRange(const int fd,
+                                            const std::uintmax_t start,
+                                            const std::uintmax_t end,
+                                            std::vector<char>& outBuff);
+
+            /**
+             * @brief Write the whole data to a file descriptor
+             * Retries on a short write or an EINTR, e.g. for a drain turn
+             * writing its batch to a log file or to the console.
+             *
+             * @param [in] fd The file descriptor, opened for writing
+             * @param [in] data The data to write
+             *
+             * @return size_t Number of bytes written, less than the size of
+             *         the data if the write failed, errno telling why
+             */
+            static size_t writeAll(const int fd, const std::string_view data) noexcept;
+
             /**
              * @brief Read a range of lines from the file
              * Reads a range of lines from the file specified by the FileOps object.
-             * The range is specified by the start and end line numbers.
+             * The range is specified by the start and end line numbers. If the line
+             * index is enabled for the object, the read starts from the indexed line
+             * nearest to startLineNo rather than from the beginning of the file.
              *
              * @note Throws exceptions which is collected in the static
              *      std::vector<std::exception_ptr> m_excpPtrVec
              *      and can be accessed using getAllExceptions() function.
-             * @note This function is not thread safe. The caller must ensure thread safety.
+             * @note The other file operations, e.g. a clear or a rotation, wait
+             *       for the read to be over, the writes of the object as well.
              *
              * @param [in] file The FileOps object
              * @param [in] startLineNo The starting line number (1-based index)
@@ -202,8 +280,10 @@ namespace logger
             /**
              * @brief Destroy the File Ops object
              * Destructor for the FileOps class. It will
-             * stop the file watcher thread and clear the
-             * data records queue.
+             * have the data records queue drained to the
+             * file first. Unless the durability policy
+             * is DurabilityPolicy::NO_SYNC, the file is synced
+             * once the data records queue is drained.
              */
             ~FileOps();
 
@@ -266,6 +346,7 @@ namespace logger
              * the max line length allowed, which is 4096 bytes
              * or 4KB, defined as bufferSize to prevent truncation
              * if you are writing single line length to its full capacity.
+             * It can change any time, effective from the next batch written.
              * @return FileOps& Refrence to the current object
              */
             inline FileOps& setMaxFileSize(const std::uintmax_t fileSize)   { m_MaxFileSize = fileSize; return *this;           }
@@ -303,12 +384,13 @@ namespace logger
             /**
              * @brief Get the file content
              *
-             * @return DataQ The file content which is a queue of shared pointers
+             * @return const DataQ& The file content which is a queue of shared pointers
              *               to strings. The strings are the lines of the file.
              *               The queue is thread safe and can be accessed by multiple
              *               threads at the same time.
+             * @see mapFile() for a read which copies nothing
              */
-            inline DataQ getFileContent() const                             { return m_FileContent;                             }
+            inline const DataQ& getFileContent() const                      { return m_FileContent;                             }
             /**
              * @brief Checks if the file path is empty or not
              *
@@ -337,6 +419,7 @@ namespace logger
             inline const std::string getClassId() const override             { return "FileOps";                                 }
             /**
              * @brief Get the file size
+             * Waits for the records queued so far to be written first.
              *
              * @return std::uintmax_t The file size
              */
@@ -344,6 +427,81 @@ namespace logger
 
             bool isEmpty();
 
+            /**
+             * @brief Set the durability policy of the file
+             *
+             * @param [in] policy The new durability policy
+             * @param [in] syncPeriod The sync interval, used only by DurabilityPolicy::PERIODIC
+             * @return FileOps& Refrence to the current object
+             *
+             * @note The default policy is DurabilityPolicy::NO_SYNC
+             * @note The periodic sync is a timed drain turn of the shared I/O threads
+             */
+            FileOps& setDurabilityPolicy(const DurabilityPolicy policy,
+                                         const std::chrono::milliseconds syncPeriod = std::chrono::milliseconds(1000));
+            /**
+             * @brief Get the durability policy of the file
+             *
+             * @return DurabilityPolicy The current policy
+             */
+            inline DurabilityPolicy getDurabilityPolicy() const             { return m_durabilityPolicy;                        }
+            /**
+             * @brief Get the sync latency counters
+             *
+             * @return SyncStats A snapshot of the counters
+             */
+            SyncStats getSyncStats();
+
+            /**
+             * @brief Enable the line index of the file
+             * The writer keeps a sparse sidecar index (<file>.idx) of the offset
+             * of every stride-th line, which readFileLineRange uses to seek
+             * straight to the requested lines. An index which is missing or
+             * out of date is (re)built lazily, on the next write or read.
+             * Should the writer fail to update it, e.g. the .idx file can't be
+             * written, it gets disabled and the log itself is written on.
+             *
+             * @param [in] stride Record the offset of every stride-th line
+             * @return FileOps& Refrence to the current object
+             * @see LineIndex
+             */
+            FileOps& enableLineIndex(const size_t stride = LineIndex::defaultStride);
+            /**
+             * @brief Disable the line index of the file
+             * The sidecar index is left as it is, to be reused (or rebuilt
+             * if it goes out of date meanwhile) when enabled again.
+             *
+             * @return FileOps& Refrence to the current object
+             */
+            FileOps& disableLineIndex();
+            /**
+             * @brief Checks if the line index is enabled
+             *
+             * @return true If it is enabled, otherwise
+             * @return false
+             */
+            bool isLineIndexEnabled();
+
+            /**
+             * @brief Sync the file.
+             * Waits for everything queued so far to be written and
+             * then fdatasync's the file, irrespective of the policy.
+             *
+             * @return true If the file was synced successfully, otherwise
+             * @return false (the error is collected in m_excpPtrVec)
+             */
+            bool sync();
+
+            /**
+             * @brief Sync the file if the policy is DurabilityPolicy::ON_CRITICAL
+             * Takes a critical ticket and waits for the records queued so far
+             * to be written. The drain turn popping them after the ticket got
+             * taken syncs the file descriptor it wrote them to, else the file
+             * gets synced here, so concurrent critical records share a sync.
+             * @see LoggingOps::commitCritical()
+             */
+            void commitCritical() override;
+
             /**
              * @brief Rename the file.
              * Renames the file with the new name passed to it.
@@ -360,16 +518,57 @@ namespace logger
              * The file is opened in binary and read mode. The file is closed after reading the data.
              *
              * @note Before reading it makes sure if there is any data in the data records queue
-             * which is yet to be processed. If there is, then it signals the file watcher thread
-             * to process the data first before reading the file. Thread safe.
+             * which is yet to be processed. If there is, then it has the I/O executor
+             * process the data first before reading the file. Thread safe.
              *
-             * @see keepWatchAndPull
+             * @see drainBatch
              * @see writeToFile
              * @see pop
              * @see push
              */
             void readFile();
 
+            /**
+             * @brief Map the file for a zero copy read
+             * Waits for the data records queue to be written and then maps the
+             * whole file read only. Unlike readFile() nothing is copied, the
+             * lines are handed out as std::string_view into the mapping.
+             *
+             * @return MappedFile The mapped file, e.g. for (auto line : file.mapFile().lines())
+             * @note Throws std::runtime_error if the file can not be opened or mapped
+             * @see MappedFile
+             */
+            MappedFile mapFile();
+
+            /**
+             * @brief Visit the lines of the file through a sliding mapped window
+             * The streaming counterpart of mapFile() for files larger than the
+             * memory, as only about chunkSize bytes are mapped at a time.
+             *
+             * @param [in] func Called for every line, the view is valid only during
+             *                  the call. Returning false stops the iteration.
+             * @param [in] chunkSize Size of the mapped window
+             * @return size_t Number of lines visited
+             * @note Throws std::runtime_error if the file can not be opened or mapped
+             * @see MappedFile::forEachLine
+             */
+            size_t forEachLine(const std::function<bool(std::string_view)>& func,
+                               const size_t chunkSize = MappedFile::defaultChunkSize);
+
+            /**
+             * @brief Get a reader of the file from its end backwards
+             * Waits for the data records queue to be written first. Meant for
+             * the last few lines or records of a big file, e.g.
+             * file.reverseReader().lastLines(200), which read only about the
+             * bytes returned rather than the whole file.
+             *
+             * @param [in] blockSize Bytes read at a time, going backwards
+             * @return ReverseReader The reader, over the file as it is now
+             * @note Throws std::runtime_error if the file can not be opened
+             * @see ReverseReader
+             */
+            ReverseReader reverseReader(const size_t blockSize = ReverseReader::defaultBlockSize);
+
             /**
              * @brief Create a File object.
              * Creates a file if it does not exist.
@@ -407,6 +606,31 @@ namespace logger
             bool clearFile();
 
         protected:
+            /**
+             * @brief Write a batch, then sync the file if the periodic sync is due
+             * No thread of its own for DurabilityPolicy::PERIODIC, the shared
+             * I/O threads run the sync as a timed drain turn.
+             *
+             * @return true If there is more to be written right away, otherwise
+             * @return false
+             * @see LoggingOps::drainBatch()
+             */
+            bool drainBatch() override;
+
+            /**
+             * @brief Update the latency counters with a sync done by a derived class
+             *
+             * @param [in] success If the sync was successful
+             * @param [in] latency How long it took
+             */
+            void noteSync(const bool success, const std::chrono::nanoseconds latency);
+
+            /**
+             * @brief Note that the file has data not synced yet, for DurabilityPolicy::PERIODIC
+             * For the derived classes writing the file on their own.
+             */
+            inline void markUnsynced() noexcept                             { m_unsyncedData = true;                            }
+
             /**
              * @brief Write to the out stream object
              *
@@ -420,13 +644,25 @@ namespace logger
 
             /**
              * @brief Write data to the out stream object
+             * Queues it, the file being created by the first write. The drain
+             * turns keep track of its size along the batches they write, and
+             * rotate it once it reaches the max file size.
              *
              * @param [in] data The data to be written to the out stream object
-             * @note This function is pure virtual and must be implemented by the derived classes.
-             * It is used to write the data to the out stream object.
              */
             void writeDataTo(const std::string_view data) override;
 
+            /**
+             * @brief Get the name the current file should be renamed to on rotation
+             * The name is made of the file name, the current local time stamp
+             * and the file extension, e.g. Test_25082025_155051.log. If a file
+             * with that name already exists (more than one rotation within the
+             * same second) then a running counter is appended to it.
+             *
+             * @return std::string The new file name (without the path)
+             */
+            std::string getRotatedFileName() const;
+
         private:
             /**
              * @brief Populate the file path object.
@@ -439,16 +675,102 @@ namespace logger
              */
             void populateFilePathObj(const StdTupple& fileDetails);
 
+            /**
+             * @brief fdatasync a file descriptor and update the latency counters
+             *
+             * @param [in] fd The file descriptor of the file
+             * @return true If the sync was successful, otherwise
+             * @return false
+             */
+            bool syncFd(const int fd);
+
+            /**
+             * @brief Open the file and fdatasync it
+             * Throws std::runtime_error if the file can not be opened or synced.
+             */
+            void syncFile();
+
+            /**
+             * @brief Write out the records a drain turn gathered for the file
+             * And sync it if a group commit is due. To be called with the file
+             * operation in progress. Throws std::runtime_error if the file
+             * can not be written or synced.
+             *
+             * @param [in] fd The file, open to append to
+             * @param [in] batch The records, one a line
+             */
+            void writeBatch(const int fd, const std::string_view batch);
+
+            /**
+             * @brief Raise the last synced critical ticket up to the given one
+             * Left as it is if a sync already covered a later ticket.
+             *
+             * @param [in] ticket The critical ticket the sync covered
+             */
+            void raiseSyncedTicket(const uint64_t ticket);
+
+            /**
+             * @brief Rename the file which reached the max file size, along with its line index
+             * Whatever got written to it and not synced yet gets synced first.
+             * To be called with the file operation in progress, the caller then
+             * opens the new file. Throws std::runtime_error if the file can not
+             * be renamed.
+             *
+             * @param [in] fd The file, still open
+             */
+            void rotateFile(const int fd);
+
+            /**
+             * @brief Sync the file if the DurabilityPolicy::PERIODIC sync is due
+             * Run at the end of a drain turn, the one of the timer armed for it
+             * included, which gets armed again for the next period.
+             */
+            void syncIfDue();
+
+            /**
+             * @brief Bring the line index, if enabled, up to date with a batch just written
+             * Called without the file operation in progress, but for the part
+             * of a batch written before a rotation. An index which fails to be
+             * updated gets disabled, the failure being recorded.
+             *
+             * @param [in] batch The batch written, its records one a line
+             * @param [in] sizeBeforeWrite The size of the file before the batch
+             */
+            void updateLineIndex(const std::string_view batch, const std::uintmax_t sizeBeforeWrite) noexcept;
+
             /// Data members for file opening, closing, reading and writing
             std::string m_FileName;
             std::string m_FilePath;
             std::string m_FileExtension;
             DataQ m_FileContent;
             std::filesystem::path m_FilePathObj;
-            std::uintmax_t m_MaxFileSize;
+            std::atomic<std::uintmax_t> m_MaxFileSize;
             std::mutex m_FileOpsMutex;
             std::condition_variable m_FileOpsCv;
             std::atomic_bool m_isFileOpsRunning;
+            /// The file got created by a write, the next one after deleteFile() creates it again
+            std::atomic_bool m_fileCreated;
+
+            /// Data members for the durability policy
+            std::atomic<DurabilityPolicy> m_durabilityPolicy;
+            std::chrono::milliseconds m_syncPeriod;
+            std::atomic_bool m_unsyncedData;
+            /// Taken by each critical record once queued, for DurabilityPolicy::ON_CRITICAL
+            std::atomic<uint64_t> m_criticalTicket;
+            /// The last ticket whose record is known to be synced
+            std::atomic<uint64_t> m_syncedTicket;
+            /// The last ticket taken before the drain turn popped its records, touched by the drain turns only
+            uint64_t m_turnTicket;
+            /// The batches of the drain turn get synced for m_turnTicket
+            bool m_turnSyncDue;
+            SyncStats m_syncStats;
+            std::mutex m_syncMtx;
+            /// When the next DurabilityPolicy::PERIODIC sync is due, guarded by m_syncMtx
+            std::chrono::steady_clock::time_point m_nextSyncDue;
+
+            /// Data members for the line index
+            std::unique_ptr<LineIndex> m_lineIndex;
+            std::mutex m_lineIndexMtx;
     };
 };  //logger namespace
 
@@ -0,0 +1,370 @@
+/**
+ * @file IoExecutor.hpp
+ * @brief Declaration of the IoExecutor class, a fixed pool of I/O threads
+ *        draining the queues of all the sinks, in turns.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_EXECUTOR_HPP
+#define IO_EXECUTOR_HPP
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <condition_variable>
+
+#include <sys/types.h>
+
+namespace logger
+{
+    class LoggingOps;
+
+    /**
+     * @brief How an idle I/O thread waits for the next drain turn
+     */
+    enum class WaitStrategy : uint8_t
+    {
+        BLOCK,              ///< Parked on a condition variable, woken by the sinks (default)
+        SPIN_THEN_PARK,     ///< Polls for IoThreadOptions::spinTime after its last turn, then parks
+        BUSY_POLL           ///< Polls all the time and never parks, taking a core of its own
+    };
+
+    /**
+     * @brief Scheduling policy of the I/O threads, as the SCHED_ ones go
+     */
+    enum class SchedPolicy : uint8_t
+    {
+        OTHER,
+        BATCH,
+        IDLE,
+        FIFO,               ///< Real time, takes a priority and the privilege to (CAP_SYS_NICE)
+        RR                  ///< Real time, takes a priority and the privilege to (CAP_SYS_NICE)
+    };
+
+    /**
+     * @brief Placement, scheduling and wait strategy of the I/O threads
+     * What is not set is left as the threads have it.
+     */
+    struct IoThreadOptions
+    {
+        std::vector<int> cpus;                          ///< The cores to pin the threads to, one each round robin
+        std::optional<SchedPolicy> schedPolicy;         ///< The scheduling policy
+        int schedPriority = 0;                          ///< 1 to 99, for FIFO and RR
+        std::optional<int> niceLevel;                   ///< -20 to 19, for OTHER and BATCH
+        WaitStrategy waitStrategy = WaitStrategy::BLOCK;
+        std::chrono::microseconds spinTime{50};         ///< How long SPIN_THEN_PARK polls before parking
+    };
+
+    class IoExecutor
+    {
+        public:
+            static constexpr size_t defaultThreadCount = 2;
+
+            /**
+             * @brief Get the executor shared by all the sinks
+             * Created on first use with the IO_THREADS threads of the config
+             * loaded then, defaultThreadCount by default, e.g. more of them
+             * for the console sinks not to wait behind slow disks. It is
+             * never destroyed, so that sinks which are statics themselves
+             * can still be drained at exit.
+             *
+             * @return IoExecutor& The shared executor
+             */
+            static IoExecutor& getShared();
+
+            /**
+             * @brief Construct a new IoExecutor object
+             * Starts the threads, their number staying fixed from then on.
+             *
+             * @param [in] threadCnt The number of I/O threads (at least one)
+             */
+            explicit IoExecutor(const size_t threadCnt = defaultThreadCount);
+
+            /**
+             * @brief Destroy the IoExecutor object
+             * Runs the drain turns already scheduled and stops the threads.
+             * Timed ones not due yet are dropped.
+             */
+            ~IoExecutor();
+
+            IoExecutor(const IoExecutor&) = delete;
+            IoExecutor(IoExecutor&&) = delete;
+            IoExecutor& operator=(const IoExecutor&) = delete;
+            IoExecutor& operator=(IoExecutor&&) = delete;
+
+            /**
+             * @brief Checks if the calling thread runs a drain turn
+             * A drain turn must not wait for one of another sink, e.g. with a
+             * flushAndWait(), the thread to run it may well be busy just the same.
+             *
+             * @return true If it does, otherwise
+             * @return false
+             */
+            static bool isInDrainTurn() noexcept;
+
+            /**
+             * @brief Get the number of I/O threads
+             *
+             * @return size_t The number of threads, none while the drain
+             *         turns are driven externally
+             */
+            inline size_t getThreadCount() const noexcept                   { return m_workers.size(); }
+
+            /**
+             * @brief Pin and schedule the I/O threads, and set how they wait
+             * Applied to the running threads. While a thread polls, the sinks
+             * scheduling a drain turn don't notify anyone, which keeps the
+             * futex wake ups off the logging calls. Linux only for the pinning
+             * and the scheduling, the wait strategies work everywhere.
+             *
+             * @param [in] options The options, what is not set left as it is
+             * @throws std::runtime_error If the options are out of range, or a
+             *         thread can't be pinned or scheduled so, e.g. a real time
+             *         policy without the privilege to. The threads are put back
+             *         as they were then, and the options and the wait strategy
+             *         are left as they were
+             */
+            void setThreadOptions(const IoThreadOptions& options);
+
+            /**
+             * @brief Get the options last set with setThreadOptions()
+             *
+             * @return IoThreadOptions The options, the defaults if none were set
+             */
+            IoThreadOptions getThreadOptions() const;
+
+            /**
+             * @brief Get the wait strategy of the I/O threads
+             *
+             * @return WaitStrategy The wait strategy (default BLOCK)
+             */
+            inline WaitStrategy getWaitStrategy() const noexcept            { return m_waitStrategy;    }
+
+            /**
+             * @brief Have an application event loop drive the drain turns, instead of the I/O threads
+             * Stops the I/O threads and hands out an eventfd, readable whenever
+             * a drain turn is ready to run. The loop then calls drain(), and
+             * waits no longer than getDrainTimeout() for the timed turns, e.g.
+             * a batch not full yet or the load shedding checks. A wait for the
+             * records of a sink, e.g. flushAndWait() or a LOG_FATAL, runs the
+             * turns of that sink on the waiting thread.
+             *
+             * @return int The eventfd, owned by the executor, the same one till
+             *         stopExternalDrive()
+             * @throws std::runtime_error If no eventfd can be had (Linux only),
+             *         or if called from a drain turn, the I/O thread running
+             *         it having to be joined
+             */
+            int startExternalDrive();
+
+            /**
+             * @brief Have the I/O threads drive the drain turns again
+             * Starts as many threads as there were, with the thread options
+             * last set, and closes the eventfd.
+             *
+             * @throws std::runtime_error If called from a drain turn, or if the
+             *         thread options can't be applied again, the threads
+             *         running without them then, and getThreadOptions()
+             *         telling so, bar the wait strategy
+             */
+            void stopExternalDrive();
+
+            /**
+             * @brief Checks if an application event loop drives the drain turns
+             *
+             * @return true If it does, see startExternalDrive(), otherwise
+             * @return false
+             */
+            inline bool isExternallyDriven() const noexcept                 { return m_externalDrive;   }
+
+            /**
+             * @brief Run the drain turns which are due, a bounded number of them
+             * Clears the eventfd first, which is made readable again if turns
+             * are left over once the budget is spent. Each turn writes one
+             * batch of one sink, like an I/O thread does.
+             *
+             * @param [in] budget The most turns to be run
+             * @return size_t The number of turns run
+             */
+            size_t drain(const size_t budget = std::numeric_limits<size_t>::max());
+
+            /**
+             * @brief Get how long till the next timed drain turn is due
+             *
+             * @return int The time in milliseconds, rounded up as epoll_wait()
+             *         takes it, 0 if one is due already, -1 if there is none
+             */
+            int getDrainTimeout() const noexcept;
+
+            /**
+             * @brief Run the turns of a sink on the calling thread, till it has nothing left
+             * What a wait for its records does in place of waiting, while
+             * the drain turns are driven externally. Waits for a turn of the
+             * sink which runs elsewhere to be over first.
+             *
+             * @param [in] ops The sink to be drained
+             */
+            void drainSink(LoggingOps& ops);
+
+            /**
+             * @brief Schedule a drain turn of a sink
+             * A sink is queued at most once and its turns never overlap, so
+             * that its batches are written in order. A sink scheduled while
+             * its turn runs gets another one right after, at the back of the
+             * queue, behind the other sinks.
+             *
+             * @param [in] ops The sink to be drained
+             */
+            void schedule(LoggingOps& ops);
+
+            /**
+             * @brief Schedule a drain turn of a sink after a delay
+             *
+             * @param [in] ops The sink to be drained
+             * @param [in] delay How long from now
+             */
+            void scheduleAfter(LoggingOps& ops, const std::chrono::steady_clock::duration delay);
+
+            /**
+             * @brief Drain a sink a last time and forget about it
+             * Drops its timed turns, runs a turn and waits until the sink has
+             * nothing left to write and no turn running or queued. The timed
+             * turns armed by those last turns are dropped as well. Called by
+             * the sink as it goes away, it must not be scheduled afterwards.
+             *
+             * @param [in] ops The sink to be retired
+             */
+            void retire(LoggingOps& ops);
+
+        private:
+            /**
+             * @brief Scheduling state of a sink, present while it is queued or running
+             */
+            struct SinkState
+            {
+                bool queued = false;
+                bool running = false;
+                bool again = false;     ///< Scheduled while running
+            };
+
+            /**
+             * @brief Queue a drain turn, with m_mtx held
+             */
+            void scheduleLocked(LoggingOps& ops);
+
+            /**
+             * @brief Keep m_nextTimerDue up to date, with m_mtx held
+             */
+            void updateNextTimerDue() noexcept;
+
+            /**
+             * @brief Checks if an idle thread is to poll rather than to park
+             *
+             * @param [in] idleSince When the thread ran its last turn
+             * @param [in] now The time now
+             */
+            bool keepPolling(const std::chrono::steady_clock::time_point idleSince,
+                             const std::chrono::steady_clock::time_point now) const noexcept;
+
+            /**
+             * @brief Poll without m_mtx held, till a turn is ready, a timer is due, the polling is over
+             * or the threads are to stop, the turns being handed over to an event loop included
+             *
+             * @param [in] idleSince When the thread ran its last turn
+             */
+            void poll(const std::chrono::steady_clock::time_point idleSince) const noexcept;
+
+            /**
+             * @brief Schedule the timed turns which are due, with m_mtx held
+             *
+             * @param [in] now The time now
+             */
+            void scheduleDueTimers(const std::chrono::steady_clock::time_point now);
+
+            /**
+             * @brief Run the turn at the front of the ready queue, with m_mtx held
+             * The lock is released while the turn runs.
+             *
+             * @param [in] lock The lock of m_mtx
+             */
+            void runTurn(std::unique_lock<std::mutex>& lock);
+
+            /**
+             * @brief Make the eventfd readable, if the turns are driven externally
+             */
+            void signalEventFd() const noexcept;
+
+            /**
+             * @brief Start the I/O threads and wait for them to be up
+             *
+             * @param [in] threadCnt The number of threads
+             */
+            void startThreads(const size_t threadCnt);
+
+            /**
+             * @brief The I/O threads, run the drain turns one at a time
+             *
+             * @param [in] idx The index of the thread in m_workers
+             */
+            void run(const size_t idx);
+
+            std::mutex m_mtx;
+            std::condition_variable m_readyCv;
+            /// Notified whenever a drain turn is over
+            std::condition_variable m_idleCv;
+            std::deque<LoggingOps*> m_ready;
+            std::multimap<std::chrono::steady_clock::time_point, LoggingOps*> m_timers;
+            std::unordered_map<LoggingOps*, SinkState> m_states;
+            std::atomic_bool m_stop;
+            /// The size of m_ready and the first timer due, for the polling threads
+            std::atomic<size_t> m_readyCnt;
+            std::atomic<std::chrono::steady_clock::time_point> m_nextTimerDue;
+            /// The threads polling, guarded by m_mtx, nobody gets notified while there is one
+            size_t m_pollingCnt;
+            std::atomic<WaitStrategy> m_waitStrategy;
+            std::atomic<std::chrono::microseconds> m_spinTime;
+            /// Serializes setThreadOptions(), guards m_options
+            mutable std::mutex m_optionsMtx;
+            IoThreadOptions m_options;
+            /// The number of I/O threads, while they drive the drain turns
+            size_t m_threadCnt;
+            /// Set while an application event loop drives the drain turns
+            std::atomic_bool m_externalDrive;
+            /// Readable while a drain turn is ready, for the event loop, -1 if none
+            int m_eventFd;
+            /// The kernel ids of the threads, set as they start
+            std::vector<pid_t> m_threadIds;
+            std::vector<std::thread> m_workers;
+    };
+};  // logger namespace
+
+#endif  // IO_EXECUTOR_HPP
@@ -0,0 +1,79 @@
+/**
+ * @file JsonEscaper.hpp
+ * @brief Declaration of the JsonEscaper class, a vectorized JSON string
+ *        escaper (AVX2/SSE2 with a scalar fallback, picked at runtime like
+ *        the LineScanner ones) used by the JSON Lines output.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef JSON_ESCAPER_HPP
+#define JSON_ESCAPER_HPP
+
+#include "LineScanner.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace logger
+{
+    class JsonEscaper
+    {
+        public:
+            /**
+             * @brief Append a string escaped for a JSON string literal
+             * The quote, the backslash and the control characters get escaped,
+             * anything else, UTF-8 sequences included, is copied as it is.
+             * The runs without any of them are found a vector at a time and
+             * copied in one go.
+             *
+             * @param [out] out The buffer to be appended to
+             * @param [in] in The string to be escaped, without the quotes
+             */
+            static void escape(std::string& out, const std::string_view in);
+
+            /**
+             * @brief Append a string escaped for a JSON string literal with a given instruction set
+             * Meant for benchmarking and testing the implementations against
+             * each other. An unsupported instruction set falls back to LineScanner::getIsa().
+             *
+             * @param [out] out The buffer to be appended to
+             * @param [in] in The string to be escaped, without the quotes
+             * @param [in] isa The instruction set to be used
+             */
+            static void escape(std::string& out, const std::string_view in, const LineScanner::Isa isa);
+
+            /**
+             * @brief Find the first character which has to be escaped
+             *
+             * @param [in] begin Start of the range
+             * @param [in] end One past the end of the range
+             * @param [in] isa The instruction set to be used
+             * @return const char* The first quote, backslash or control
+             *         character, or end if there is none
+             */
+            static const char* findSpecial(const char* begin, const char* end, const LineScanner::Isa isa) noexcept;
+    };
+};  //logger namespace
+
+#endif // JSON_ESCAPER_HPP
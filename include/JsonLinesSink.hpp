@@ -0,0 +1,166 @@
+/**
+ * @file JsonLinesSink.hpp
+ * @brief Declaration of the JsonLinesSink class, a LogSink writing the records
+ *        to a file as JSON Lines, one object per record, for log indexers.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef JSON_LINES_SINK_HPP
+#define JSON_LINES_SINK_HPP
+
+#include "LogSink.hpp"
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+namespace logger
+{
+    class JsonLinesSink : public LogSink
+    {
+        public:
+            /**
+             * @brief Construct a new JsonLinesSink object
+             * Opens the file for appending.
+             *
+             * @param [in] file The file to be written
+             * @throws std::runtime_error If the file can't be opened
+             */
+            explicit JsonLinesSink(const std::filesystem::path& file);
+
+            /**
+             * @brief Destructor for JsonLinesSink class
+             * Closes the file.
+             */
+            ~JsonLinesSink() override;
+
+            /**
+             * @brief Deleted copy constructor and move constructor
+             * to prevent copying and moving of JsonLinesSink objects
+             */
+            JsonLinesSink(const JsonLinesSink& rhs) = delete;
+            JsonLinesSink(JsonLinesSink&& rhs) = delete;
+            JsonLinesSink& operator=(const JsonLinesSink& rhs) = delete;
+            JsonLinesSink& operator=(JsonLinesSink&& rhs) = delete;
+
+            /**
+             * @brief Render a batch of records and write it with a single write(2)
+             *
+             * @param [in] records The batch
+             * @throws std::runtime_error If the file can't be written
+             * @see render()
+             */
+            void consume(std::span<const LogRecord> records) override;
+
+            /**
+             * @brief Make what got written so far durable, with fdatasync(2)
+             * @throws std::runtime_error If the file can't be synced
+             */
+            void flush() override;
+
+            /**
+             * @brief Render a record as a JSON object, on a line of its own
+             * The fields are timestamp (UTC, RFC 3339 with microseconds),
+             * level, tid, file, line, class, function and message, the call
+             * site ones only if the record was rendered by the Logger, then
+             * the key/value fields of the record, if any, as the members of
+             * a "fields" object, their numbers and booleans as such. The
+             * call site fields are rendered once per call site, and the
+             * time stamp once per second, only the message is escaped
+             * for every record.
+             *
+             * @param [in] record The record to be rendered
+             * @param [out] out The buffer the line, new line included, is appended to
+             */
+            void render(const LogRecord& record, std::string& out);
+
+            /**
+             * @brief Get the name of the sink
+             *
+             * @return std::string "JsonLinesSink"
+             */
+            inline std::string getName() const override                     { return "JsonLinesSink";   }
+
+            /**
+             * @brief Get the path of the file
+             *
+             * @return const std::filesystem::path& The file written
+             */
+            inline const std::filesystem::path& getFilePath() const noexcept { return m_file;           }
+
+            /**
+             * @brief Get the number of call sites rendered so far
+             *
+             * @return size_t The number of call sites with their fields cached
+             */
+            inline size_t getCallSiteCount() const noexcept                 { return m_callSites.size(); }
+
+        private:
+            /**
+             * @brief Get the rendered call site fields of a record, rendering them if new
+             *
+             * @param [in] record A record of the call site
+             * @return const std::string& The ,"file":...,"function":"..." fields
+             */
+            const std::string& getCallSiteFields(const LogRecord& record);
+
+            /**
+             * @brief Get the rendered thread id, rendering it if new
+             *
+             * @param [in] threadId The thread
+             * @return const std::string& The thread id as the Logger prints it, escaped
+             */
+            const std::string& getThreadField(const std::thread::id& threadId);
+
+            /**
+             * @brief Append the time stamp of a record, its seconds rendered once per second
+             *
+             * @param [in] timestamp The time stamp
+             * @param [out] out The buffer to be appended to
+             */
+            void appendTimestamp(const std::chrono::system_clock::time_point& timestamp, std::string& out);
+
+            std::filesystem::path m_file;
+            int m_fd;
+            std::string m_buffer;
+            /**
+             * @brief A call site, its fields rendered
+             */
+            struct CallSite
+            {
+                std::string fileName;   ///< As the record has it, to tell the hash collisions apart
+                std::string funcName;
+                size_t lineNo = 0;
+                std::string fields;     ///< The ,"file":...,"function":"..." fields
+            };
+
+            /// The call sites, keyed by the hash of the file, function and line
+            std::unordered_map<size_t, CallSite> m_callSites;
+            std::unordered_map<std::thread::id, std::string> m_threads;
+            int64_t m_renderedSecond;
+            std::string m_secondStr;
+    };
+};  //logger namespace
+
+#endif // JSON_LINES_SINK_HPP
@@ -34,6 +34,7 @@
 #define LOGGER_MACROS_HPP
 
 #include "LogHelper.hpp"
+#include "LogHandle.hpp"
 
 namespace logger
 {
@@ -150,6 +151,184 @@ namespace logger
     #define LOG_DBG(fmt_str, ...)                                                        \
     log_dbg(__FILE__, __PRETTY_FUNCTION__, __LINE__, fmt_str __VA_OPT__(,) __VA_ARGS__);  \
 
+    /**
+     * @brief Macros to log a message along with typed key/value fields.
+     * e.g. LOG_INFO_KV("request done", kv("latency_us", latency), kv("status", code));
+     * The message is taken as it is, the fields are kept typed and rendered
+     * by the sinks: " key=value" after the message in the text logs, natively
+     * in the JSON and binary ones. LOG_DBG_KV is only compiled in debug mode.
+     * Like a function call, each one is a single statement ended by the
+     * caller's semicolon.
+     * It automatically includes the file name, function name, and line number in the log.
+     * @param msg The log message.
+     * @param ... The fields, made with kv().
+     */
+    #define LOG_INFO_KV(msg, ...)                                                                    \
+    log_kv(__FILE__, __PRETTY_FUNCTION__, __LINE__, LOG_TYPE::LOG_INFO, msg __VA_OPT__(,) __VA_ARGS__)   \
+
+    #define LOG_IMP_KV(msg, ...)                                                                     \
+    log_kv(__FILE__, __PRETTY_FUNCTION__, __LINE__, LOG_TYPE::LOG_IMP, msg __VA_OPT__(,) __VA_ARGS__)    \
+
+    #define LOG_WARN_KV(msg, ...)                                                                    \
+    log_kv(__FILE__, __PRETTY_FUNCTION__, __LINE__, LOG_TYPE::LOG_WARN, msg __VA_OPT__(,) __VA_ARGS__)   \
+
+    #define LOG_ERR_KV(msg, ...)                                                                     \
+    log_kv(__FILE__, __PRETTY_FUNCTION__, __LINE__, LOG_TYPE::LOG_ERR, msg __VA_OPT__(,) __VA_ARGS__)    \
+
+    #define LOG_DBG_KV(msg, ...)                                                                     \
+    log_dbg_kv(__FILE__, __PRETTY_FUNCTION__, __LINE__, msg __VA_OPT__(,) __VA_ARGS__)               \
+
+    /**
+     * @brief Macro to log through a named logger of the shared LoggerRegistry.
+     * The logger is looked up once per call site and kept in a static, so that
+     * afterwards its level is a single atomic read, done before the arguments
+     * get evaluated. The name must thus be the same every time at a call site.
+     * It automatically includes the file name, function name, and line number in the log.
+     * @param logger_name The dotted name of the logger, e.g. "db.pool".
+     * @param log_type The log type of the message.
+     * @param fmt_str The format string for the log message.
+     * @param ... Additional arguments for formatting the log message.
+     */
+    #define LOG_TO_NAMED(logger_name, log_type, fmt_str, ...)                                                   \
+    do                                                                                                           \
+    {                                                                                                             \
+        static const auto& namedLogger_ = logger::LoggerRegistry::getShared().get(logger_name);                    \
+        if (namedLogger_.isEnabled(log_type))                                                                       \
+            logger::log_to(namedLogger_, __FILE__, __PRETTY_FUNCTION__, __LINE__, log_type, fmt_str __VA_OPT__(,) __VA_ARGS__); \
+    } while (0)                                                                                                       \
+
+    /**
+     * @brief Macros to log an informational, important, warning, error or debug
+     * message through a named logger, e.g. LOG_INFO_TO("net", "Connected to {}", host);
+     * LOG_DBG_TO is only compiled in debug mode. Like a function call, each
+     * one is a single statement ended by the caller's semicolon.
+     * @param logger_name The dotted name of the logger, e.g. "db.pool".
+     * @param fmt_str The format string for the log message.
+     * @param ... Additional arguments for formatting the log message.
+     * @see LOG_TO_NAMED
+     */
+    #define LOG_INFO_TO(logger_name, fmt_str, ...)                                                  \
+    LOG_TO_NAMED(logger_name, logger::LOG_TYPE::LOG_INFO, fmt_str __VA_OPT__(,) __VA_ARGS__)        \
+
+    #define LOG_IMP_TO(logger_name, fmt_str, ...)                                                   \
+    LOG_TO_NAMED(logger_name, logger::LOG_TYPE::LOG_IMP, fmt_str __VA_OPT__(,) __VA_ARGS__)         \
+
+    #define LOG_WARN_TO(logger_name, fmt_str, ...)                                                  \
+    LOG_TO_NAMED(logger_name, logger::LOG_TYPE::LOG_WARN, fmt_str __VA_OPT__(,) __VA_ARGS__)        \
+
+    #define LOG_ERR_TO(logger_name, fmt_str, ...)                                                   \
+    LOG_TO_NAMED(logger_name, logger::LOG_TYPE::LOG_ERR, fmt_str __VA_OPT__(,) __VA_ARGS__)         \
+
+#if defined (DEBUG) || (__DEBUG__)
+    #define LOG_DBG_TO(logger_name, fmt_str, ...)                                                   \
+    LOG_TO_NAMED(logger_name, logger::LOG_TYPE::LOG_DBG, fmt_str __VA_OPT__(,) __VA_ARGS__)         \
+
+#else
+    #define LOG_DBG_TO(logger_name, fmt_str, ...)                                                   \
+    do {} while (0)                                                                                   \
+
+#endif
+
+    /**
+     * @brief Macro to log a message through a LogHandle of one's own.
+     * The level is checked before the arguments get evaluated. The LOG_*
+     * macros without a handle log through LogHandle::getDefault().
+     * @param handle The LogHandle, e.g. one owned by a library.
+     * @param log_type The log type of the message.
+     * @param fmt_str The format string for the log message.
+     * @param ... Additional arguments for formatting the log message.
+     */
+    #define LOG_ON(handle, log_type, fmt_str, ...)                                                    \
+    do                                                                                                 \
+    {                                                                                                   \
+        auto& logHandle_ = (handle);                                                                     \
+        if (logHandle_.isEnabled(log_type))                                                               \
+            logHandle_.log(__FILE__, __PRETTY_FUNCTION__, __LINE__, log_type, fmt_str __VA_OPT__(,) __VA_ARGS__); \
+    } while (0)                                                                                             \
+
+    /**
+     * @brief Macros to log an informational, important, warning, error or debug
+     * message through a LogHandle, e.g. LOG_INFO_ON(myHandle, "Connected to {}", host);
+     * LOG_DBG_ON is only compiled in debug mode. Like a function call, each
+     * one is a single statement ended by the caller's semicolon.
+     * @param handle The LogHandle.
+     * @param fmt_str The format string for the log message.
+     * @param ... Additional arguments for formatting the log message.
+     * @see LOG_ON
+     */
+    #define LOG_INFO_ON(handle, fmt_str, ...)                                                       \
+    LOG_ON(handle, logger::LOG_TYPE::LOG_INFO, fmt_str __VA_OPT__(,) __VA_ARGS__)                     \
+
+    #define LOG_IMP_ON(handle, fmt_str, ...)                                                        \
+    LOG_ON(handle, logger::LOG_TYPE::LOG_IMP, fmt_str __VA_OPT__(,) __VA_ARGS__)                      \
+
+    #define LOG_WARN_ON(handle, fmt_str, ...)                                                       \
+    LOG_ON(handle, logger::LOG_TYPE::LOG_WARN, fmt_str __VA_OPT__(,) __VA_ARGS__)                     \
+
+    #define LOG_ERR_ON(handle, fmt_str, ...)                                                        \
+    LOG_ON(handle, logger::LOG_TYPE::LOG_ERR, fmt_str __VA_OPT__(,) __VA_ARGS__)                      \
+
+#if defined (DEBUG) || (__DEBUG__)
+    #define LOG_DBG_ON(handle, fmt_str, ...)                                                        \
+    LOG_ON(handle, logger::LOG_TYPE::LOG_DBG, fmt_str __VA_OPT__(,) __VA_ARGS__)                      \
+
+#else
+    #define LOG_DBG_ON(handle, fmt_str, ...)                                                        \
+    do {} while (0)                                                                                   \
+
+#endif
+
+    /**
+     * @brief Macro to log a message if a per callsite sampler lets it through.
+     * The sampler is kept in a static of the call site, made once from its
+     * constructor arguments. A suppressed call costs the atomic operation of
+     * the sampler and nothing else, the arguments not even being evaluated.
+     * The calls suppressed since the last one logged are appended to the next
+     * one logged, as a "suppressed" field. The static is brace initialized from
+     * a sampler made of the arguments, so that variables as arguments are neither
+     * taken for a function declaration nor refused as narrowing conversions.
+     * @param sampler_type EveryN, FirstN, EveryInterval or TokenBucket.
+     * @param sampler_args The constructor arguments of the sampler, in parentheses.
+     * @param log_type The log type of the message.
+     * @param fmt_str The format string for the log message.
+     * @param ... Additional arguments for formatting the log message.
+     * @see LogSampler.hpp
+     */
+    #define LOG_SAMPLED(sampler_type, sampler_args, log_type, fmt_str, ...)                          \
+    do                                                                                                \
+    {                                                                                                  \
+        static logger::sampler_type sampler_{ logger::sampler_type sampler_args };                       \
+        uint64_t suppressed_ = 0;                                                                        \
+        if (sampler_.shouldLog(suppressed_))                                                              \
+            logger::logSampledTo(logger::loggingOps, __FILE__, __PRETTY_FUNCTION__, __LINE__,              \
+                                 log_type, suppressed_, fmt_str __VA_OPT__(,) __VA_ARGS__);                 \
+    } while (0)                                                                                             \
+
+    /**
+     * @brief Macros to log only some of the calls of a call site, e.g.
+     * LOG_EVERY_N(logger::LOG_TYPE::LOG_WARN, 1000, "Retrying {}", host);
+     * LOG_EVERY_N logs the first call and every n-th one after it, LOG_FIRST_N
+     * the first n calls, LOG_EVERY_MS at most one call per interval_ms and
+     * LOG_RATE_LIMITED per_second calls per second, with bursts of up to burst.
+     * Like a function call, each one is a single statement ended by the
+     * caller's semicolon.
+     * @param log_type The log type of the message.
+     * @param fmt_str The format string for the log message.
+     * @param ... Additional arguments for formatting the log message.
+     * @see LOG_SAMPLED
+     */
+    #define LOG_EVERY_N(log_type, n, fmt_str, ...)                                                   \
+    LOG_SAMPLED(EveryN, (n), log_type, fmt_str __VA_OPT__(,) __VA_ARGS__)                              \
+
+    #define LOG_FIRST_N(log_type, n, fmt_str, ...)                                                   \
+    LOG_SAMPLED(FirstN, (n), log_type, fmt_str __VA_OPT__(,) __VA_ARGS__)                              \
+
+    #define LOG_EVERY_MS(log_type, interval_ms, fmt_str, ...)                                        \
+    LOG_SAMPLED(EveryInterval, (std::chrono::milliseconds(interval_ms)), log_type, fmt_str __VA_OPT__(,) __VA_ARGS__) \
+
+    #define LOG_RATE_LIMITED(log_type, per_second, burst, fmt_str, ...)                              \
+    LOG_SAMPLED(TokenBucket, (per_second, burst), log_type, fmt_str __VA_OPT__(,) __VA_ARGS__)         \
+
     /**
      * @brief Macro to log an assertion failure message.
      * This macro logs an assertion failure message with the specified condition and format.
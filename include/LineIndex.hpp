@@ -0,0 +1,170 @@
+/**
+ * @file LineIndex.hpp
+ * @brief Declaration of the LineIndex class, a sparse line number to byte offset
+ *        index of a log file, kept in a sidecar file next to it.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LINE_INDEX_HPP
+#define LINE_INDEX_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <utility>
+#include <filesystem>
+
+namespace logger
+{
+    /**
+     * @brief Sparse index of the line start offsets of a file
+     *
+     * Records the byte offset of every Nth line (N being the stride), so that
+     * line L can be reached by seeking to the offset of line (L / N) * N and
+     * skipping less than N lines, instead of reading the file from its start.
+     *
+     * The index is persisted in a sidecar file named <file>.idx, which is
+     * only ever appended to, apart from its fixed size header:
+     * magic (8 bytes), stride, line count and indexed byte count (8 bytes each),
+     * followed by the offsets, all as 8 byte integers in host byte order.
+     *
+     * @note This class is not thread safe. The caller must ensure thread safety.
+     */
+    class LineIndex
+    {
+        public:
+            static constexpr size_t defaultStride = 1024;
+
+            /**
+             * @brief Get the sidecar index file of a file
+             *
+             * @param [in] file The indexed file
+             * @return std::filesystem::path The path of its index file (<file>.idx)
+             */
+            static std::filesystem::path getIndexFilePath(const std::filesystem::path& file);
+
+            /**
+             * @brief Construct a new LineIndex object
+             *
+             * @param [in] file The file to be indexed
+             * @param [in] stride Record the offset of every stride-th line (0 is taken as 1)
+             */
+            explicit LineIndex(const std::filesystem::path& file, const size_t stride = defaultStride);
+
+            /**
+             * @brief Bring the index up to date with the file
+             * Loads the sidecar index if it is there and matches the file, indexes
+             * whatever has been appended to the file after it and persists the result.
+             * A missing, corrupt or stale (e.g. the file got truncated) index is
+             * rebuilt from scratch. Throws std::runtime_error on any I/O failure.
+             */
+            void refresh();
+
+            /**
+             * @brief Index the data just appended to the file
+             * Used by the writer, which already has the data at hand, to keep the
+             * index current without reading the file back. Call persist() to
+             * write the new entries to the sidecar.
+             *
+             * @param [in] data The bytes appended to the end of the file
+             * @param [in] len Number of bytes
+             */
+            void append(const char* data, const size_t len);
+
+            /**
+             * @brief Write the entries added since the last persist to the sidecar
+             * Throws std::runtime_error on any I/O failure.
+             */
+            void persist();
+
+            /**
+             * @brief Forget everything indexed so far and remove the sidecar
+             */
+            void reset();
+
+            /**
+             * @brief Find where to start reading to reach a line
+             *
+             * @param [in] lineNo The line number (1-based index)
+             * @return std::pair<std::uintmax_t, size_t> The byte offset of the nearest
+             *         indexed line at or before lineNo, and its line number (1-based)
+             */
+            std::pair<std::uintmax_t, size_t> seekLine(const size_t lineNo) const;
+
+            /**
+             * @brief Get the indexed file
+             *
+             * @return const std::filesystem::path& The indexed file
+             */
+            inline const std::filesystem::path& getFilePath() const                 { return m_file;                    }
+            /**
+             * @brief Get the stride of the index
+             *
+             * @return size_t Offset of every stride-th line is recorded
+             */
+            inline size_t getStride() const                                         { return m_stride;                  }
+            /**
+             * @brief Get the number of complete (new line terminated) lines indexed so far
+             *
+             * @return size_t The line count
+             */
+            inline size_t getLineCount() const                                      { return m_lineCount;               }
+            /**
+             * @brief Get the number of bytes of the file indexed so far
+             *
+             * @return std::uintmax_t The byte count
+             */
+            inline std::uintmax_t getIndexedSize() const                            { return m_indexedSize;             }
+            /**
+             * @brief Get the recorded line start offsets
+             *
+             * @return const std::vector<std::uintmax_t>& Offsets of line 1, stride + 1, 2 * stride + 1 ...
+             */
+            inline const std::vector<std::uintmax_t>& getOffsets() const            { return m_offsets;                 }
+
+        private:
+            /**
+             * @brief Load the sidecar index, if there is a valid one
+             *
+             * @return true If it was loaded, otherwise
+             * @return false and the index is left empty
+             */
+            bool load();
+
+            /**
+             * @brief Index the file from m_indexedSize till its end
+             */
+            void scanFile();
+
+            std::filesystem::path m_file;
+            std::filesystem::path m_indexFile;
+            size_t m_stride;
+            size_t m_lineCount;
+            std::uintmax_t m_indexedSize;
+            std::vector<std::uintmax_t> m_offsets;
+            size_t m_persistedCnt;
+    };
+};  //logger namespace
+
+#endif // LINE_INDEX_HPP
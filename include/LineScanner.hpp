@@ -0,0 +1,119 @@
+/**
+ * @file LineScanner.hpp
+ * @brief Declaration of the LineScanner class, a vectorized new line scanner
+ *        (AVX2/SSE2 with a scalar fallback, picked at runtime) used by the
+ *        line oriented read paths.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LINE_SCANNER_HPP
+#define LINE_SCANNER_HPP
+
+#include <string>
+#include <cstddef>
+
+namespace logger
+{
+    class LineScanner
+    {
+        public:
+            /**
+             * @brief The instruction sets the scanner has an implementation for
+             */
+            enum class Isa
+            {
+                SCALAR,     ///< Plain C++, available everywhere
+                SSE2,       ///< 16 bytes at a time (x86 only)
+                AVX2        ///< 32 bytes at a time (x86 only, if the CPU has it)
+            };
+
+            /**
+             * @brief Get the instruction set picked for this CPU
+             * The best one supported by the CPU, detected once at runtime.
+             *
+             * @return Isa The instruction set in use
+             */
+            static Isa getIsa() noexcept;
+
+            /**
+             * @brief Checks if an instruction set can be used on this CPU
+             *
+             * @param [in] isa The instruction set to check for
+             * @return true If it can be used, otherwise
+             * @return false
+             */
+            static bool isSupported(const Isa isa) noexcept;
+
+            /**
+             * @brief Get the name of an instruction set
+             *
+             * @param [in] isa The instruction set
+             * @return std::string Its name, e.g. "AVX2"
+             */
+            static std::string getIsaName(const Isa isa);
+
+            /**
+             * @brief Find the first new line in a range
+             *
+             * @param [in] begin Start of the range
+             * @param [in] end One past the end of the range
+             * @return const char* The first '\n', or end if there is none
+             */
+            static const char* findNewLine(const char* begin, const char* end) noexcept;
+
+            /**
+             * @brief Count the new lines in a range
+             *
+             * @param [in] begin Start of the range
+             * @param [in] end One past the end of the range
+             * @return size_t Number of '\n' in the range
+             */
+            static size_t countNewLines(const char* begin, const char* end) noexcept;
+
+            /**
+             * @brief Count the new lines in a range with a given instruction set
+             * Meant for benchmarking and testing the implementations against
+             * each other. An unsupported instruction set falls back to getIsa().
+             *
+             * @param [in] begin Start of the range
+             * @param [in] end One past the end of the range
+             * @param [in] isa The instruction set to be used
+             * @return size_t Number of '\n' in the range
+             */
+            static size_t countNewLines(const char* begin, const char* end, const Isa isa) noexcept;
+
+            /**
+             * @brief Find the first new line in a range with a given instruction set
+             * An unsupported instruction set falls back to getIsa().
+             *
+             * @param [in] begin Start of the range
+             * @param [in] end One past the end of the range
+             * @param [in] isa The instruction set to be used
+             * @return const char* The first '\n', or end if there is none
+             */
+            static const char* findNewLine(const char* begin, const char* end, const Isa isa) noexcept;
+    };
+};  //logger namespace
+
+#endif // LINE_SCANNER_HPP
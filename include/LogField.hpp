@@ -0,0 +1,116 @@
+/**
+ * @file LogField.hpp
+ * @brief Declaration of the LogField struct, a typed key/value field of a record,
+ *        and of kv() which makes one.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LOG_FIELD_HPP
+#define LOG_FIELD_HPP
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <cstdint>
+#include <type_traits>
+
+namespace logger
+{
+    /**
+     * @brief A key/value field of a record, kept typed until a sink renders it
+     * The text sinks render it as key=value, the JSON and binary sinks encode
+     * the value natively. The key and a string value refer to memory owned by
+     * whoever hands the record over, like the other views of a LogRecord.
+     */
+    struct LogField
+    {
+        /**
+         * @brief The types of the values, in the order of the Value alternatives
+         */
+        enum class Type : uint8_t
+        {
+            BOOL,
+            INT,
+            UINT,
+            DOUBLE,
+            STRING
+        };
+
+        using Value = std::variant<bool, int64_t, uint64_t, double, std::string_view>;
+
+        std::string_view key;
+        Value value;
+
+        /**
+         * @brief Get the type of the value
+         *
+         * @return Type The type of the alternative held
+         */
+        inline Type getType() const noexcept                                { return static_cast<Type>(value.index()); }
+
+        /**
+         * @brief Append fields as text, each as " key=value"
+         * A string value gets quoted if it is empty or has a space, a '=', a
+         * quote or a control character in it, the quote, the backslash and
+         * the new lines, tabs and carriage returns being escaped in there.
+         *
+         * @param [out] out The buffer to be appended to
+         * @param [in] fields The fields to be rendered
+         */
+        static void appendText(std::string& out, const std::span<const LogField> fields);
+    };
+
+    /**
+     * @brief Make a field of a record, e.g. kv("latency_us", latency)
+     * Booleans, integers, floating points, enums (as their underlying
+     * integer) and strings are supported. A string value is not copied,
+     * it has to outlive the logging call, as a temporary does.
+     *
+     * @tparam T Type of the value
+     * @param [in] key The key, usually a literal
+     * @param [in] value The value
+     * @return LogField The field
+     */
+    template<typename T>
+    LogField kv(const std::string_view key, const T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return { key, LogField::Value(std::in_place_type<bool>, value) };
+        else if constexpr (std::is_enum_v<T>)
+            return kv(key, static_cast<std::underlying_type_t<T>>(value));
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            return { key, LogField::Value(std::in_place_type<int64_t>, value) };
+        else if constexpr (std::is_integral_v<T>)
+            return { key, LogField::Value(std::in_place_type<uint64_t>, value) };
+        else if constexpr (std::is_floating_point_v<T>)
+            return { key, LogField::Value(std::in_place_type<double>, value) };
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            return { key, LogField::Value(std::in_place_type<std::string_view>, std::string_view(value)) };
+        else
+            static_assert(!sizeof(T), "kv() takes a boolean, an integer, a floating point, an enum or a string");
+    }
+};  //logger namespace
+
+#endif // LOG_FIELD_HPP
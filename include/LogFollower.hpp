@@ -0,0 +1,228 @@
+/**
+ * @file LogFollower.hpp
+ * @brief Declaration of the LogFollower class, an in process `tail -F` of a
+ *        log file which follows it across rotations and resumes from a
+ *        checkpoint.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LOG_FOLLOWER_HPP
+#define LOG_FOLLOWER_HPP
+
+#include "DirWatch.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <filesystem>
+#include <string_view>
+
+namespace logger
+{
+    class FileOps;
+
+    /**
+     * @brief Where a LogFollower is in the log
+     * The file is identified by its inode, so that a checkpoint taken
+     * before a rotation still finds the rotated file after a restart.
+     */
+    struct FollowCheckpoint
+    {
+        std::uint64_t inode = 0;    ///< Inode of the file being read, 0 if unknown
+        std::uint64_t offset = 0;   ///< Offset just past the last line delivered
+
+        bool operator==(const FollowCheckpoint&) const = default;
+    };
+
+    class LogFollower
+    {
+        public:
+            using Checkpoint = FollowCheckpoint;
+
+            /**
+             * @brief Called for every new line, without its new line, along with the
+             * checkpoint to resume from once the line has been dealt with
+             */
+            using LineCallback = std::function<void(std::string_view, const Checkpoint&)>;
+
+            /**
+             * @brief Construct a new LogFollower object
+             *
+             * @param [in] file The log file to follow, it need not exist yet
+             * @param [in] callback Called for every new line, on the follower thread
+             * @param [in] checkpoint Where to resume from; the default starts from the
+             *                        beginning of the file
+             * @param [in] pollPeriod How often to look at the file if no event
+             *                        comes in (or without inotify, i.e. not on Linux)
+             */
+            LogFollower(const std::filesystem::path& file,
+                        LineCallback callback,
+                        const Checkpoint& checkpoint = Checkpoint(),
+                        const std::chrono::milliseconds pollPeriod = std::chrono::milliseconds(500));
+
+            /**
+             * @brief Construct a new LogFollower object to follow the file of a FileOps
+             *
+             * @param [in] fileOps The FileOps writing the log
+             * @param [in] callback Called for every new line, on the follower thread
+             * @param [in] checkpoint Where to resume from
+             * @param [in] pollPeriod How often to look at the file if no event comes in
+             */
+            LogFollower(FileOps& fileOps,
+                        LineCallback callback,
+                        const Checkpoint& checkpoint = Checkpoint(),
+                        const std::chrono::milliseconds pollPeriod = std::chrono::milliseconds(500));
+
+            /**
+             * @brief Destroy the LogFollower object, stopping it first
+             */
+            ~LogFollower();
+
+            LogFollower(const LogFollower&) = delete;
+            LogFollower& operator=(const LogFollower&) = delete;
+            LogFollower(LogFollower&&) = delete;
+            LogFollower& operator=(LogFollower&&) = delete;
+
+            /**
+             * @brief Start following the file on a thread of its own
+             *
+             * @return true If it started, otherwise
+             * @return false If it is already running or the notifications can't be set up
+             */
+            bool start();
+
+            /**
+             * @brief Stop following the file
+             * Lines not completed by a new line yet are not delivered.
+             */
+            void stop();
+
+            /**
+             * @brief Save a checkpoint to a file, to be resumed from after a restart
+             *
+             * @param [in] checkpointFile The file to save into, replaced atomically
+             * @param [in] checkpoint The checkpoint to be saved
+             * @return true If saved, otherwise
+             * @return false
+             */
+            static bool saveCheckpoint(const std::filesystem::path& checkpointFile, const Checkpoint& checkpoint) noexcept;
+
+            /**
+             * @brief Load a checkpoint saved by saveCheckpoint()
+             *
+             * @param [in] checkpointFile The file saved into
+             * @return Checkpoint The checkpoint, or the default one if there is none
+             */
+            static Checkpoint loadCheckpoint(const std::filesystem::path& checkpointFile) noexcept;
+
+            inline bool isRunning() const noexcept                                      { return m_running;                     }
+            inline const std::filesystem::path& getFilePath() const noexcept            { return m_filePath;                    }
+            Checkpoint getCheckpoint() const;
+            std::vector<std::exception_ptr> getAllExceptions() const;
+
+        private:
+            /**
+             * @brief The follower thread, waits for changes and reads the new lines
+             */
+            void follow();
+
+            /**
+             * @brief Open the file at the checkpoint, or its rotated archive
+             * if the checkpoint is from before a rotation
+             */
+            void openAtCheckpoint();
+
+            /**
+             * @brief Open the followed path, from its beginning
+             *
+             * @return true If the file is there and got opened
+             */
+            bool openFile();
+
+            /**
+             * @brief Open the followed path again once it is there, reading
+             * the archives rotated after the last file read first. The same
+             * file is taken up where it was left.
+             *
+             * @return true If the file got opened
+             */
+            bool reopenFile();
+
+            /**
+             * @brief Read the rest of the file last read, now a rotated archive,
+             * and of every archive rotated after it, in full as they won't grow
+             * any more
+             *
+             * @param [in] currentInode The inode of the file opened as the current
+             *             one, the archives are read up to it
+             * @return true If the archive of the file last read is there
+             */
+            bool readArchives(const std::uint64_t currentInode);
+            void closeFile() noexcept;
+
+            /**
+             * @brief Read up to the end of the open file, delivering the complete lines
+             *
+             * @param [in] finalRead The file won't grow any more, deliver the last
+             *                       line even without a new line
+             */
+            void readToEnd(const bool finalRead);
+
+            /**
+             * @brief Checks if the followed path now names another file than the
+             * open one, i.e. the file got rotated or removed
+             */
+            bool isRotated() const;
+
+            /**
+             * @brief Block until the file may have changed, stop() is called
+             * or the poll period elapses
+             */
+            void waitForChange();
+
+            std::filesystem::path m_filePath;
+            LineCallback m_callback;
+            std::chrono::milliseconds m_pollPeriod;
+            int m_fd;                       // The file being read
+            std::uint64_t m_inode;          // Its inode
+            std::uint64_t m_readOffset;     // Offset to read from next
+            std::vector<char> m_readBuff;
+            std::string m_partialLine;      // Read but not completed by a new line yet
+            Checkpoint m_checkpoint;
+            mutable std::mutex m_checkpointMtx;
+            std::vector<std::exception_ptr> m_excpPtrVec;
+            mutable std::mutex m_excpMtx;
+            DirWatch m_dirWatch;            // Wakes the follower thread up, on a change or to stop
+            std::atomic<bool> m_running;
+            std::thread m_followThread;
+    };
+};  //logger namespace
+
+#endif // LOG_FOLLOWER_HPP
@@ -0,0 +1,296 @@
+/**
+ * @file LogHandle.hpp
+ * @brief Declaration of the LogHandle class, a logger instance owning its
+ *        formatter and its sinks, so that a library or a test can have a
+ *        pipeline of its own next to the default one the LOG_* macros use.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LOG_HANDLE_HPP
+#define LOG_HANDLE_HPP
+
+#include "Logger.hpp"
+#include "LoggingOps.hpp"
+#include "LoggerConfig.hpp"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <string_view>
+
+namespace logger
+{
+    class LogHandle
+    {
+        public:
+            /**
+             * @brief Get the default instance
+             * The one the LOG_* macros log to. Made on first use out of
+             * LoggerConfig::load(), the console being the fallback if the log
+             * file can't be had. The config file gets watched for reloads if
+             * the settings ask for it. What goes wrong on the way, e.g. an I/O
+             * thread which can't be pinned or a config file which can't be
+             * watched, gets reported along with the write errors of the sink.
+             *
+             * @return LogHandle& The default instance
+             */
+            static LogHandle& getDefault() noexcept;
+
+            /**
+             * @brief Construct a new LogHandle object over a sink of its own
+             *
+             * @param [in] ops The sink, owned by the handle from now on
+             * @throws std::invalid_argument If the sink is null
+             */
+            explicit LogHandle(std::unique_ptr<LoggingOps> ops);
+
+            /**
+             * @brief Construct a new LogHandle object out of some settings
+             * The sinks are made by Logger::makeLoggingOps(), with a queue of
+             * their own, independent of the default instance.
+             *
+             * @param [in] config The settings
+             * @throws std::exception If the log file can't be had
+             */
+            explicit LogHandle(const LoggerConfig& config);
+
+            /**
+             * @brief Destructor for LogHandle class
+             * Destroys the sink, which writes out what it has queued.
+             */
+            ~LogHandle() = default;
+
+            LogHandle(const LogHandle&) = delete;
+            LogHandle(LogHandle&&) = delete;
+            LogHandle& operator=(const LogHandle&) = delete;
+            LogHandle& operator=(LogHandle&&) = delete;
+
+            /**
+             * @brief Get the sink of the handle
+             *
+             * @return LoggingOps& The sink
+             */
+            inline LoggingOps& getOps() const noexcept                      { return *m_pOps;   }
+
+            /**
+             * @brief Checks if a record of a log type would be written
+             * Meant to be checked before the arguments get evaluated.
+             *
+             * @param [in] logType The log type
+             * @return true If it passes the level threshold and the shed level of the sink, otherwise
+             * @return false
+             */
+            inline bool isEnabled(const LOG_TYPE logType) const noexcept
+            {
+                return isLogTypeAtLeast(logType, m_pOps->getLevelThreshold()) &&
+                       isLogTypeAtLeast(logType, m_pOps->getShedLevel());
+            }
+
+            /**
+             * @brief Log a message.
+             * Formats it with the formatter of the handle and hands the record
+             * over to its sink, the critical ones being committed right away.
+             *
+             * @tparam Args Variadic template parameters for the arguments to be formatted into the log message.
+             * @param [in] fileName The name of the file where the log is being generated.
+             * @param [in] funcName The name of the function where the log is being generated.
+             * @param [in] lineNo The line number in the source code where the log is being generated.
+             * @param [in] logType The type of log (e.g., info, error, debug).
+             * @param [in] format_str The format string for the log message.
+             * @param [in] args Additional arguments to be formatted into the log message.
+             */
+            template<typename ...Args>
+            void log(const std::string_view fileName,
+                     const std::string_view funcName,
+                     const size_t lineNo,
+                     const LOG_TYPE logType,
+                     const std::string_view format_str,
+                     Args&&... args)
+            {
+                logTo(*m_pOps, fileName, funcName, FORWARD_ANGLE, lineNo, std::this_thread::get_id(), logType, {},
+                      format_str, args...);
+            }
+
+            /**
+             * @brief Log a message along with typed key/value fields.
+             * The message is taken as it is, not as a format string.
+             *
+             * @tparam Fields LogField, as made by kv()
+             * @param [in] fileName The name of the file where the log is being generated.
+             * @param [in] funcName The name of the function where the log is being generated.
+             * @param [in] lineNo The line number in the source code where the log is being generated.
+             * @param [in] logType The type of log (e.g., info, error, debug).
+             * @param [in] message The log message.
+             * @param [in] fields The key/value fields, e.g. kv("status", code).
+             */
+            template<typename ...Fields>
+            void logKv(const std::string_view fileName,
+                       const std::string_view funcName,
+                       const size_t lineNo,
+                       const LOG_TYPE logType,
+                       const std::string_view message,
+                       const Fields&... fields)
+            {
+                static_assert((std::is_same_v<Fields, LogField> && ...), "The fields are to be made with kv()");
+                const std::array<LogField, sizeof...(Fields)> fieldArr = { fields... };
+                logTo(*m_pOps, fileName, funcName, FORWARD_ANGLE, lineNo, std::this_thread::get_id(), logType, fieldArr,
+                      "{}", message);
+            }
+
+            /**
+             * @brief Log a message to a given sink, formatted by the handle
+             * What the LOG_* macros without a handle come down to, the sink
+             * being the one of the handle, of a named logger, or the one a
+             * sampler is bound to. The critical records get committed once
+             * the formatter is let go.
+             *
+             * @tparam Args Variadic template parameters for the arguments to be formatted into the log message.
+             * @param [in] ops The sink.
+             * @param [in] fileName The name of the file where the log is being generated.
+             * @param [in] funcName The name of the function where the log is being generated.
+             * @param [in] marker A string marker to indicate the type of log (e.g., entry, exit).
+             * @param [in] lineNo The line number in the source code where the log is being generated.
+             * @param [in] tid The thread ID of the thread generating the log.
+             * @param [in] logType The type of log (e.g., info, error, debug).
+             * @param [in] fields The key/value fields of the record, if any.
+             * @param [in] format_str The format string for the log message.
+             * @param [in] args Additional arguments to be formatted into the log message.
+             */
+            template<typename ...Args>
+            void logTo(LoggingOps& ops,
+                       const std::string_view fileName,
+                       const std::string_view funcName,
+                       const std::string_view marker,
+                       const size_t lineNo,
+                       const std::thread::id& tid,
+                       const LOG_TYPE logType,
+                       const std::span<const LogField> fields,
+                       const std::string_view format_str,
+                       Args&&... args)
+            {
+                {
+                    std::lock_guard<std::mutex> formatLock(m_formatMtx);
+                    prepare(fileName, funcName, marker, lineNo, tid, logType);
+                    m_formatter.log(format_str, args...);
+                    submit(ops, fileName, funcName, marker, lineNo, tid, logType, fields);
+                }
+                commitIfCritical(ops, logType);
+            }
+
+            /**
+             * @brief Log an assertion failure to the sink of the handle
+             *
+             * @tparam Args Variadic template parameters for the arguments to be formatted into the log message.
+             * @param [in] fileName The name of the file where the log is being generated.
+             * @param [in] funcName The name of the function where the log is being generated.
+             * @param [in] lineNo The line number in the source code where the log is being generated.
+             * @param [in] cond The condition that failed.
+             * @param [in] format_str The format string for the log message.
+             * @param [in] args Additional arguments to be formatted into the log message.
+             */
+            template<typename ...Args>
+            void logAssert(const std::string_view fileName,
+                           const std::string_view funcName,
+                           const size_t lineNo,
+                           const std::string_view cond,
+                           const std::string_view format_str,
+                           Args&&... args)
+            {
+                const auto tid = std::this_thread::get_id();
+                {
+                    std::lock_guard<std::mutex> formatLock(m_formatMtx);
+                    m_formatter.setAssertCondition(std::string(cond));
+                    prepare(fileName, funcName, FORWARD_ANGLE, lineNo, tid, LOG_TYPE::LOG_ASSERT);
+                    m_formatter.log(format_str, args...);
+                    submit(*m_pOps, fileName, funcName, FORWARD_ANGLE, lineNo, tid, LOG_TYPE::LOG_ASSERT, {});
+                }
+                commitIfCritical(*m_pOps, LOG_TYPE::LOG_ASSERT);
+            }
+
+            /**
+             * @brief Get the formatter of the handle
+             * It keeps the last message formatted, to be read while no other
+             * one is being logged through the handle.
+             *
+             * @return Logger& The formatter
+             */
+            inline Logger& getFormatter() noexcept                         { return m_formatter;   }
+
+            /**
+             * @brief Flush the sink and wait for it
+             */
+            void flushAndWait();
+
+        private:
+            /**
+             * @brief Construct the default LogHandle object
+             *
+             * @param [in] config The settings, as loaded at startup
+             * @param [in] fallback Whether the console is to be taken if the sinks can't be made
+             */
+            LogHandle(const LoggerConfig& config, const bool fallback);
+
+            /**
+             * @brief Set the call site of the message about to be formatted
+             * To be called with m_formatMtx held.
+             */
+            void prepare(const std::string_view fileName,
+                         const std::string_view funcName,
+                         const std::string_view marker,
+                         const size_t lineNo,
+                         const std::thread::id& tid,
+                         const LOG_TYPE logType);
+
+            /**
+             * @brief Hand the message just formatted over to a sink
+             * To be called with m_formatMtx held.
+             */
+            void submit(LoggingOps& ops,
+                        const std::string_view fileName,
+                        const std::string_view funcName,
+                        const std::string_view marker,
+                        const size_t lineNo,
+                        const std::thread::id& tid,
+                        const LOG_TYPE logType,
+                        const std::span<const LogField> fields);
+
+            /**
+             * @brief Have a sink commit what it got so far after a critical record
+             * Waits for a LOG_FATAL or LOG_ASSERT one to be written first. To be
+             * called with m_formatMtx released, as a commit may take a flush and
+             * an fdatasync.
+             */
+            static void commitIfCritical(LoggingOps& ops, const LOG_TYPE logType);
+
+            std::unique_ptr<LoggingOps> m_pOps;
+            /// Guards the formatter, which keeps the message being formatted
+            std::mutex m_formatMtx;
+            Logger m_formatter;
+    };
+};  //logger namespace
+
+#endif // LOG_HANDLE_HPP
@@ -36,6 +36,11 @@
 #define LOGGER_HELPER_HPP
 
 #include "Logger.hpp"
+#include "LogHandle.hpp"
+#include "LoggerRegistry.hpp"
+#include "LogSampler.hpp"
+
+#include <array>
 
 namespace logger
 {
@@ -51,33 +56,54 @@ namespace logger
     template <typename T, typename Alloc>
     struct is_list<std::list<T, Alloc>> : std::true_type{};
 
-    /**
-     * @brief A global mutex to this file to protect
-     * the concurrency of logger property attributes
-     */
-    static std::mutex raceMtx;
-
     /**
      * @brief The logger object for the application.
-     * This object is used to construct log messages
-     * and write them to the log stream.
+     * This object is used to construct log messages. It is the formatter
+     * of LogHandle::getDefault(), the one all the macros without a handle
+     * format with, whichever translation unit they are in.
      *
      * @note inline because otherwise it will cause linker errors
      * when used in multiple translation units.
      */
-    inline static Logger loggerObj("%Y%m%d_%H%M%S");
+    inline static Logger& loggerObj = LogHandle::getDefault().getFormatter();
 
     /**
      * @brief The stream object for logging operations.
      * This object is used to write log messages
      * either to console or to a file, depending on the configuration.
-     * It is built using the Logger class's static method.
+     * It is the sink of LogHandle::getDefault(), the default instance the
+     * macros are bound to. A LogHandle of one's own has its own sink.
      *
      * @note inline because otherwise it will cause linker errors
      * when used in multiple translation units.
      */
     inline static auto& loggingOps = Logger::buildLoggingOpsObject();
 
+    /**
+     * @brief Log a message to a given sink.
+     *
+     * Like logMsg(), the message going to ops rather than to loggingOps.
+     * It is formatted by LogHandle::getDefault() all the same.
+     *
+     * @param [in] ops The sink, e.g. the one of a named logger.
+     * @see logMsg()
+     */
+    template<typename ...Args>
+    inline void logMsgTo
+    (   LoggingOps& ops,
+        const std::string_view fileName,
+        const std::string_view funcName,
+        const std::string_view marker,
+        const size_t lineNo,
+        const std::thread::id& tid,
+        const LOG_TYPE& logType,
+        const std::string_view format_str,
+        Args&&... args
+    )
+    {
+        LogHandle::getDefault().logTo(ops, fileName, funcName, marker, lineNo, tid, logType, {}, format_str, args...);
+    }
+
     /**
      * @brief Set the logger properties for the current log message.
      *
@@ -119,21 +145,143 @@ namespace logger
         Args&&... args
     )
     {
-        // Lock it as in case of a threadpool ops
-        // it might be very possible that multiple
-        // threads are just lurcking around to get
-        // a hold of this beautiful lady at the same
-        // point of time.
-        std::lock_guard<std::mutex> raceLock(raceMtx);
-        loggerObj.setFileName(fileName.data())
-                .setFunctionName(funcName.data())
-                .setLineNo(lineNo)
-                .setThreadId(tid)
-                .setMarker(marker.data())
-                .setLogType(logType);
+        logMsgTo(loggingOps, fileName, funcName, marker, lineNo, tid, logType, format_str, args...);
+    }
 
-        loggerObj.log(format_str, args...);
-        loggingOps << loggerObj.getLogStream().str();
+    /**
+     * @brief Log a message along with typed key/value fields.
+     *
+     * The message is taken as it is, not as a format string. The fields
+     * are not rendered here, they travel with the record and each sink
+     * renders them its own way: " key=value" after the message for the
+     * text logs, natively for the JSON and binary ones.
+     *
+     * @tparam Fields LogField, as made by kv()
+     * @param [in] fileName The name of the file where the log is being generated.
+     * @param [in] funcName The name of the function where the log is being generated.
+     * @param [in] lineNo The line number in the source code where the log is being generated.
+     * @param [in] logType The type of log (e.g., info, error, debug).
+     * @param [in] message The log message.
+     * @param [in] fields The key/value fields, e.g. kv("status", code).
+     */
+    template<typename ...Fields>
+    void log_kv
+    (
+        const std::string_view fileName,
+        const std::string_view funcName,
+        const size_t lineNo,
+        const LOG_TYPE logType,
+        const std::string_view message,
+        const Fields&... fields
+    )
+    {
+        LogHandle::getDefault().logKv(fileName, funcName, lineNo, logType, message, fields...);
+    }
+
+    /**
+     * @brief Log a debug message along with typed key/value fields.
+     *
+     * @note Like log_dbg(), only compiled and executed in debug mode.
+     * @see log_kv()
+     */
+    template<typename ...Fields>
+    void log_dbg_kv
+    (
+        [[maybe_unused]] const std::string_view fileName,
+        [[maybe_unused]] const std::string_view funcName,
+        [[maybe_unused]] const size_t lineNo,
+        [[maybe_unused]] const std::string_view message,
+        [[maybe_unused]] const Fields&... fields
+    )
+    {
+    #if defined (DEBUG) || (__DEBUG__)
+        log_kv(fileName, funcName, lineNo, LOG_TYPE::LOG_DBG, message, fields...);
+    #endif
+    }
+
+    /**
+     * @brief Log a message through a named logger.
+     *
+     * The message goes to the sink of the logger. Its level is not checked
+     * here, the LOG_*_TO macros check it before the arguments get evaluated.
+     *
+     * @tparam Args Variadic template parameters for additional arguments to be formatted into the log message.
+     * @param [in] namedLogger The logger, e.g. LoggerRegistry::getShared().get("db.pool").
+     * @param [in] fileName The name of the file where the log is being generated.
+     * @param [in] funcName The name of the function where the log is being generated.
+     * @param [in] lineNo The line number in the source code where the log is being generated.
+     * @param [in] logType The type of log (e.g., info, error, debug).
+     * @param [in] format_str The format string for the log message.
+     * @param [in] args Additional arguments to be formatted into the log message.
+     */
+    template<typename ...Args>
+    void log_to
+    (
+        const NamedLogger& namedLogger,
+        const std::string_view fileName,
+        const std::string_view funcName,
+        const size_t lineNo,
+        const LOG_TYPE logType,
+        const std::string_view format_str,
+        Args&&... args
+    )
+    {
+        // The sink can't be released by a LoggerRegistry::setOps() meanwhile
+        NamedLogger::OpsScope opsScope(namedLogger);
+        logMsgTo(opsScope.getOps(),
+                 fileName,
+                 funcName,
+                 FORWARD_ANGLE,
+                 lineNo,
+                 std::this_thread::get_id(),
+                 logType,
+                 format_str,
+                 args...);
+    }
+
+    /**
+     * @brief Log a message let through by a sampler to a given sink.
+     *
+     * Like logMsgTo(), the calls suppressed before it being appended to
+     * the record as a "suppressed" field, i.e. " suppressed=N" after the
+     * message in the text logs.
+     *
+     * @param [in] ops The sink, loggingOps for the sampling macros.
+     * @param [in] fileName The name of the file where the log is being generated.
+     * @param [in] funcName The name of the function where the log is being generated.
+     * @param [in] lineNo The line number in the source code where the log is being generated.
+     * @param [in] logType The type of log (e.g., info, error, debug).
+     * @param [in] suppressed The calls of the callsite suppressed since the last one logged.
+     * @param [in] format_str The format string for the log message.
+     * @param [in] args Additional arguments to be formatted into the log message.
+     * @see EveryN, FirstN, EveryInterval, TokenBucket
+     */
+    template<typename ...Args>
+    inline void logSampledTo
+    (
+        LoggingOps& ops,
+        const std::string_view fileName,
+        const std::string_view funcName,
+        const size_t lineNo,
+        const LOG_TYPE logType,
+        const uint64_t suppressed,
+        const std::string_view format_str,
+        Args&&... args
+    )
+    {
+    #if !defined (DEBUG) && !(__DEBUG__)
+        if (logType == LOG_TYPE::LOG_DBG)
+            return;
+    #endif
+        if (suppressed == 0)
+        {
+            logMsgTo(ops, fileName, funcName, FORWARD_ANGLE, lineNo, std::this_thread::get_id(), logType, format_str, args...);
+            return;
+        }
+
+        const std::array<LogField, 1> fieldArr = { kv("suppressed", suppressed) };
+        LogHandle::getDefault().logTo(ops, fileName, funcName, FORWARD_ANGLE, lineNo, std::this_thread::get_id(), logType, fieldArr,
+                                      format_str, args...);
     }
 
     /**
@@ -175,7 +323,6 @@ namespace logger
                     format_str,
                     args...);
 
-            std::lock_guard<std::mutex> raceLock(raceMtx);
             loggingOps << msgList;
         }
     }
@@ -487,21 +634,13 @@ namespace logger
         if (cond.empty())
             return;
 
-        loggerObj.setAssertCondition(cond.data()); // Set the assertion condition
-        logMsg( fileName,
-                funcName,
-                FORWARD_ANGLE,
-                lineNo,
-                std::this_thread::get_id(),
-                LOG_TYPE::LOG_ASSERT,
-                format_str,
-                args...);
+        auto& handle = LogHandle::getDefault();
+        handle.logAssert(fileName, funcName, lineNo, cond, format_str, args...);
 
-        std::lock_guard<std::mutex> lock(raceMtx);
         if (exitGracefuly)
         {
-            loggingOps.~LoggingOps();
-            loggerObj.~Logger();
+            // The statics, the default handle among them, get destroyed on the way out
+            handle.flushAndWait();
             std::exit(EXIT_FAILURE);
         }
         else
@@ -0,0 +1,69 @@
+/**
+ * @file LogLine.hpp
+ * @brief Declaration of the LogLine struct, a parsed view of a log line written
+ *        by Logger, i.e. |timestamp| tid| file| line|TYPE> message
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LOG_LINE_HPP
+#define LOG_LINE_HPP
+
+#include "Logger.hpp"
+
+#include <string_view>
+
+namespace logger
+{
+    /**
+     * @brief The fields of a log line, as views into the line
+     *
+     * A line looks like
+     * |20250825_155051| 140245563983680| LoggerTest.cpp      |   84|INF>> [Class : func] message
+     * i.e. the time stamp, thread id, source file and line number, each
+     * followed by a field separator, then the log type and marker.
+     */
+    struct LogLine
+    {
+        std::string_view timestamp;                 ///< As formatted by the Logger's clock
+        std::string_view threadId;                  ///< Without the padding
+        std::string_view fileName;                  ///< Without the padding
+        size_t lineNo = 0;                          ///< Source line number
+        LOG_TYPE logType = LOG_TYPE::LOG_DEFAULT;   ///< Log type, e.g. LOG_TYPE::LOG_INFO for INF
+        std::string_view marker;                    ///< >, >> or <<
+        std::string_view message;                   ///< Whatever follows the marker and its padding
+
+        /**
+         * @brief Parse the prefix of a log line
+         *
+         * @param [in] line The line to be parsed (without its new line)
+         * @param [out] out The parsed fields, views into line
+         * @return true If the line starts with a well formed prefix, otherwise
+         * @return false e.g. for the continuation of a record split over
+         * several lines, out being left in an unspecified state
+         */
+        static bool parse(const std::string_view line, LogLine& out) noexcept;
+    };
+};  //logger namespace
+
+#endif // LOG_LINE_HPP
@@ -0,0 +1,121 @@
+/**
+ * @file LogRecord.hpp
+ * @brief Defines the LogRecord structure, a formatted log record along with
+ *        the metadata it was built from, as handed over to the sinks.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LOG_RECORD_HPP
+#define LOG_RECORD_HPP
+
+#include "LogType.hpp"
+#include "LogField.hpp"
+
+#include <chrono>
+#include <span>
+#include <string>
+#include <thread>
+#include <string_view>
+
+namespace logger
+{
+    class Logger;
+
+    /**
+     * @brief A log record, its rendered text and its metadata
+     * The string views refer to memory owned by whoever hands the record
+     * over, they are valid only for the duration of that call.
+     */
+    struct LogRecord
+    {
+        LOG_TYPE logType = LOG_TYPE::LOG_DEFAULT;
+        std::chrono::system_clock::time_point timestamp;
+        std::thread::id threadId;
+        std::string_view fileName;      ///< Call site, empty if not known
+        std::string_view funcName;      ///< Call site, empty if not known
+        size_t lineNo = 0;              ///< Call site, 0 if not known
+        std::string_view marker;        ///< What follows the log type, e.g. ">>", empty if not known
+        std::string_view text;          ///< The record as rendered by the Logger
+        size_t prefixSize = 0;          ///< Size of the "|time| thread id| file| line|TYPE>" part of text, 0 if it has none
+        size_t msgOffset = 0;           ///< Where the formatted message starts in text, 0 if not known
+        std::span<const LogField> fields;   ///< Key/value fields, not part of text, rendered by the sinks
+
+        /**
+         * @brief Make the record of the message just rendered by a Logger
+         * The timestamp and the layout of the text are taken from the Logger,
+         * the call site from the caller.
+         *
+         * @param [in] logger The Logger which rendered the message
+         * @param [in] text The rendered message, logger.getLogStream().str(), to outlive the record
+         * @param [in] fileName The file where the log is being generated
+         * @param [in] funcName The function where the log is being generated
+         * @param [in] marker What follows the log type, e.g. ">>"
+         * @param [in] lineNo The line where the log is being generated
+         * @param [in] threadId The thread generating the log
+         * @param [in] logType The type of the log
+         * @param [in] fields The key/value fields of the record, if any
+         * @return LogRecord The record, referring to text and the call site
+         */
+        static LogRecord fromLogger(const Logger& logger,
+                                    const std::string_view text,
+                                    const std::string_view fileName,
+                                    const std::string_view funcName,
+                                    const std::string_view marker,
+                                    const size_t lineNo,
+                                    const std::thread::id threadId,
+                                    const LOG_TYPE logType,
+                                    const std::span<const LogField> fields = {}) noexcept;
+
+        /**
+         * @brief Checks if the record has a call site and a message of its own
+         * Only a record rendered by the Logger does, the prefix and the
+         * "[Class : function] " context coming before the message in text.
+         *
+         * @return true If prefixSize and msgOffset lay out text, otherwise
+         * @return false
+         */
+        inline bool hasCallSite() const noexcept
+        {
+            return prefixSize > 0 && prefixSize <= msgOffset && msgOffset <= text.size();
+        }
+
+        /**
+         * @brief Get the file name of the call site without its directories
+         * The way the Logger prints it.
+         *
+         * @return std::string_view The file name, referring to fileName
+         */
+        std::string_view getBaseFileName() const noexcept;
+
+        /**
+         * @brief Get a thread id the way the Logger prints it
+         *
+         * @param [in] threadId The thread id
+         * @return std::string The printed thread id
+         */
+        static std::string getThreadIdText(const std::thread::id threadId);
+    };
+};  //logger namespace
+
+#endif // LOG_RECORD_HPP
@@ -0,0 +1,239 @@
+/**
+ * @file LogSampler.hpp
+ * @brief Lock-free per-callsite samplers and rate limiters, the state
+ *        behind the LOG_EVERY_N, LOG_FIRST_N, LOG_EVERY_MS and
+ *        LOG_RATE_LIMITED macros.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LOG_SAMPLER_HPP
+#define LOG_SAMPLER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+
+namespace logger
+{
+    /**
+     * @brief Lets every n-th call of a callsite through, the first one included
+     * The state of a LOG_EVERY_N callsite, kept in a static of its own.
+     * A call costs a single relaxed fetch_add, whether it gets through or not.
+     */
+    class EveryN
+    {
+        public:
+            /**
+             * @brief Construct a new EveryN object
+             *
+             * @param [in] n Let one call in n through, 0 being taken as 1
+             */
+            explicit EveryN(const uint64_t n) noexcept
+                : m_n(n ? n : 1)
+                , m_calls(0)
+            {}
+
+            /**
+             * @brief Checks if this call is to be logged
+             *
+             * @param [out] suppressed Set to the calls suppressed since the
+             *              last one let through, if this one is let through
+             * @return true If it is to be logged, otherwise
+             * @return false
+             */
+            inline bool shouldLog(uint64_t& suppressed) noexcept
+            {
+                auto call = m_calls.fetch_add(1, std::memory_order_relaxed);
+                if (call % m_n != 0)
+                    return false;
+
+                suppressed = call ? m_n - 1 : 0;
+                return true;
+            }
+
+        private:
+            const uint64_t m_n;
+            std::atomic<uint64_t> m_calls;
+    };
+
+    /**
+     * @brief Lets the first n calls of a callsite through, and none after
+     * The state of a LOG_FIRST_N callsite. A call costs a single relaxed
+     * fetch_add. Nothing comes after the calls suppressed, so they are
+     * never reported.
+     */
+    class FirstN
+    {
+        public:
+            /**
+             * @brief Construct a new FirstN object
+             *
+             * @param [in] n The number of calls to be let through
+             */
+            explicit FirstN(const uint64_t n) noexcept
+                : m_n(n)
+                , m_calls(0)
+            {}
+
+            /**
+             * @brief Checks if this call is to be logged
+             *
+             * @param [out] suppressed Set to 0 if this one is let through
+             * @return true If it is to be logged, otherwise
+             * @return false
+             */
+            inline bool shouldLog(uint64_t& suppressed) noexcept
+            {
+                if (m_calls.fetch_add(1, std::memory_order_relaxed) >= m_n)
+                    return false;
+
+                suppressed = 0;
+                return true;
+            }
+
+        private:
+            const uint64_t m_n;
+            std::atomic<uint64_t> m_calls;
+    };
+
+    /**
+     * @brief Lets at most one call of a callsite through per interval
+     * The state of a LOG_EVERY_MS callsite. A suppressed call costs a relaxed
+     * load of the deadline and a relaxed fetch_add of the suppressed count.
+     * Of the calls racing past the deadline, the one winning the CAS gets
+     * through and the others count as suppressed.
+     */
+    class EveryInterval
+    {
+        public:
+            /**
+             * @brief Construct a new EveryInterval object
+             *
+             * @param [in] interval The least time between two calls let through
+             */
+            explicit EveryInterval(const std::chrono::milliseconds interval) noexcept
+                : m_intervalNs(std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count())
+                , m_deadlineNs(0)
+                , m_suppressed(0)
+            {}
+
+            /**
+             * @brief Checks if this call is to be logged
+             *
+             * @param [out] suppressed Set to the calls suppressed since the
+             *              last one let through, if this one is let through
+             * @return true If it is to be logged, otherwise
+             * @return false
+             */
+            inline bool shouldLog(uint64_t& suppressed) noexcept
+            {
+                auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+                auto deadline = m_deadlineNs.load(std::memory_order_relaxed);
+                if (now < deadline ||
+                    !m_deadlineNs.compare_exchange_strong(deadline, now + m_intervalNs, std::memory_order_relaxed))
+                {
+                    m_suppressed.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+                return true;
+            }
+
+        private:
+            const int64_t m_intervalNs;
+            /// steady_clock time in nanoseconds before which no call gets through
+            std::atomic<int64_t> m_deadlineNs;
+            std::atomic<uint64_t> m_suppressed;
+    };
+
+    /**
+     * @brief Lets the calls of a callsite through at a sustained rate, with bursts
+     * The state of a LOG_RATE_LIMITED callsite, a token bucket kept as the
+     * one timestamp of the generic cell rate algorithm: the time at which the
+     * bucket would be full again. A call takes a token by pushing it one
+     * emission interval ahead, and is suppressed if that would take it more
+     * than a burst ahead of now. A suppressed call costs a relaxed load of
+     * that time and a relaxed fetch_add of the suppressed count.
+     */
+    class TokenBucket
+    {
+        public:
+            /// The longest emission interval, a few hours, so that a burst of them fits an int64_t
+            static constexpr double maxEmissionNs = 1e13;
+            static constexpr uint64_t maxBurst = 1 << 16;
+
+            /**
+             * @brief Construct a new TokenBucket object
+             *
+             * @param [in] perSecond The calls let through per second in the long run,
+             *             down to one every maxEmissionNs
+             * @param [in] burst The calls let through back to back, from 1 to maxBurst
+             */
+            TokenBucket(const double perSecond, const uint64_t burst) noexcept
+                : m_emissionNs(static_cast<int64_t>(std::clamp(perSecond > 0 ? 1e9 / perSecond : maxEmissionNs, 1.0, maxEmissionNs)))
+                , m_burstNs(m_emissionNs * static_cast<int64_t>(std::clamp<uint64_t>(burst, 1, maxBurst)))
+                , m_fullAtNs(0)
+                , m_suppressed(0)
+            {}
+
+            /**
+             * @brief Checks if this call is to be logged
+             *
+             * @param [out] suppressed Set to the calls suppressed since the
+             *              last one let through, if this one is let through
+             * @return true If it is to be logged, otherwise
+             * @return false
+             */
+            inline bool shouldLog(uint64_t& suppressed) noexcept
+            {
+                auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+                auto fullAt = m_fullAtNs.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    auto newFullAt = std::max(fullAt, now) + m_emissionNs;
+                    if (newFullAt - now > m_burstNs)
+                    {
+                        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    if (m_fullAtNs.compare_exchange_weak(fullAt, newFullAt, std::memory_order_relaxed))
+                        break;
+                }
+
+                suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+                return true;
+            }
+
+        private:
+            const int64_t m_emissionNs;
+            const int64_t m_burstNs;
+            /// steady_clock time in nanoseconds at which the bucket is full again
+            std::atomic<int64_t> m_fullAtNs;
+            std::atomic<uint64_t> m_suppressed;
+    };
+};  //logger namespace
+
+#endif // LOG_SAMPLER_HPP
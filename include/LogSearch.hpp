@@ -0,0 +1,135 @@
+/**
+ * @file LogSearch.hpp
+ * @brief Declaration of the LogSearch class, which searches a log file and its
+ *        rotated archives in parallel, filtering on the fields of the log prefix.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LOG_SEARCH_HPP
+#define LOG_SEARCH_HPP
+
+#include "Logger.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <filesystem>
+
+namespace logger
+{
+    /**
+     * @brief What to look for. Empty fields do not filter.
+     */
+    struct SearchQuery
+    {
+        std::string pattern;            ///< Literal text, or an ECMAScript regex if regex is set
+        bool regex = false;             ///< Treat the pattern as a regex
+        bool ignoreCase = false;        ///< Case insensitive match of the pattern
+        std::vector<LOG_TYPE> levels;   ///< Log types to keep, all if empty
+        std::string since;              ///< Oldest time stamp to keep (inclusive), e.g. "20250825_155051"
+        std::string until;              ///< Newest time stamp to keep (inclusive), e.g. "20250825_160000"
+        std::string threadId;           ///< Thread id to keep
+        size_t maxResults = 0;          ///< Stop after these many matches (in time order), 0 for no limit
+    };
+
+    /**
+     * @brief A line which matched a SearchQuery
+     */
+    struct SearchMatch
+    {
+        std::filesystem::path file;     ///< File the line is from
+        size_t lineNo = 0;              ///< Line number within the file, 1 based
+        std::string timestamp;          ///< Time stamp of the record the line belongs to
+        std::string line;               ///< The whole line
+    };
+
+    class LogSearch
+    {
+        public:
+            /**
+             * @brief Construct a new LogSearch object
+             *
+             * @param [in] query What to look for
+             * @param [in] threadCnt Number of files searched at a time,
+             *                       0 for the number of hardware threads
+             * @throw std::regex_error If the pattern is not a valid regex
+             */
+            explicit LogSearch(const SearchQuery& query, const size_t threadCnt = 0);
+            ~LogSearch();
+
+            LogSearch(const LogSearch&) = delete;
+            LogSearch& operator=(const LogSearch&) = delete;
+
+            /**
+             * @brief Find the rotated archives of a log file
+             * FileOps renames a full log file to <name>_<ddmmyyyy>_<hhmmss>[_<n>]<extn>
+             * in the same directory.
+             *
+             * @param [in] baseFile The active log file, e.g. /tmp/app.log
+             * @return std::vector<std::filesystem::path> The archives, oldest first,
+             *         followed by the active file if it exists
+             */
+            static std::vector<std::filesystem::path> discoverFiles(const std::filesystem::path& baseFile);
+
+            /**
+             * @brief Search a log file along with its rotated archives
+             *
+             * @param [in] baseFile The active log file
+             * @return std::vector<SearchMatch> The matching lines in time stamp order
+             * @throw std::runtime_error If a file can't be read
+             */
+            std::vector<SearchMatch> search(const std::filesystem::path& baseFile);
+
+            /**
+             * @brief Search the given files
+             *
+             * @param [in] files The files to be searched, oldest first
+             * @return std::vector<SearchMatch> The matching lines in time stamp order,
+             *         lines with the same time stamp being kept in the order of
+             *         the files and then of the lines
+             * @throw std::runtime_error If a file can't be read
+             */
+            std::vector<SearchMatch> searchFiles(const std::vector<std::filesystem::path>& files);
+
+            inline const SearchQuery& getQuery() const                  { return m_query;       }
+            inline size_t getThreadCount() const                        { return m_threadCnt;   }
+
+        private:
+            struct Matcher;
+
+            /**
+             * @brief Search one file
+             *
+             * @param [in] file The file to be searched
+             * @return std::vector<SearchMatch> Its matching lines, in line order
+             */
+            std::vector<SearchMatch> searchFile(const std::filesystem::path& file) const;
+
+            SearchQuery m_query;
+            size_t m_threadCnt;
+            std::unique_ptr<Matcher> m_matcher;
+    };
+};  //logger namespace
+
+#endif // LOG_SEARCH_HPP
@@ -0,0 +1,72 @@
+/**
+ * @file LogSink.hpp
+ * @brief Declaration of the LogSink interface, for custom outputs which take
+ *        the log records a batch at a time. Plugged in through BatchSinkOps.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LOG_SINK_HPP
+#define LOG_SINK_HPP
+
+#include "LogRecord.hpp"
+
+#include <span>
+#include <string>
+
+namespace logger
+{
+    class LogSink
+    {
+        public:
+            virtual ~LogSink() = default;
+
+            /**
+             * @brief Take a batch of records
+             * Called from a single writer thread, never concurrently, with
+             * the records in the order they were written. The records and the
+             * memory their string views refer to are valid only for the call.
+             *
+             * @param [in] records The batch, contiguous in memory
+             * @note An exception thrown here is collected like those of the
+             * other sinks, see LoggingOps::getAllExceptions()
+             */
+            virtual void consume(std::span<const LogRecord> records) = 0;
+
+            /**
+             * @brief Make the records taken so far durable or visible
+             * Called after a LOG_ERR, LOG_FATAL or LOG_ASSERT record and once
+             * more after the last batch. Does nothing by default.
+             */
+            virtual void flush() {}
+
+            /**
+             * @brief Get the name of the sink
+             *
+             * @return std::string The name, used as the class id of the BatchSinkOps
+             */
+            virtual std::string getName() const                     { return "LogSink"; }
+    };
+};  //logger namespace
+
+#endif // LOG_SINK_HPP
@@ -0,0 +1,111 @@
+/**
+ * @file LogType.hpp
+ * @brief Defines the LOG_TYPE enumeration and the severity order of the
+ *        log types, used to filter the records per sink.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LOG_TYPE_HPP
+#define LOG_TYPE_HPP
+
+#include <cstdint>
+
+namespace logger
+{
+    /**
+     * @brief Enum class for different log types.
+     *
+     * This enum class defines various log types that can be used to categorize
+     * log messages. Each type corresponds to a specific logging level or purpose.
+     * The values are used to control the verbosity and importance of log messages.
+     */
+    enum class LOG_TYPE
+    {
+        LOG_ERR     = 0x01,
+        LOG_INFO    = 0x02,
+        LOG_DBG     = 0x03,
+        LOG_FATAL   = 0x04,
+        LOG_WARN    = 0x05,
+        LOG_IMP     = 0x06,
+        LOG_ASSERT  = 0x07,
+        // Any new type/entry should be added above this. Also update the maps
+        // m_stringToEnumMap & m_EnumToStringMap, accordingly in the CPP file,
+        // and getLogTypeSeverity() below.
+        LOG_DEFAULT = 0xFF
+    };
+
+    /**
+     * @brief Get the severity of a log type
+     * The enum values are not in the order of severity, so that they can't
+     * be compared as they are. LOG_DEFAULT ranks lowest, so that as a
+     * threshold it lets every record through.
+     *
+     * @param [in] type The log type
+     * @return uint8_t Its severity, higher is more severe
+     */
+    constexpr uint8_t getLogTypeSeverity(const LOG_TYPE type) noexcept
+    {
+        switch (type)
+        {
+            case LOG_TYPE::LOG_DBG:     return 1;
+            case LOG_TYPE::LOG_INFO:    return 2;
+            case LOG_TYPE::LOG_IMP:     return 3;
+            case LOG_TYPE::LOG_WARN:    return 4;
+            case LOG_TYPE::LOG_ERR:     return 5;
+            case LOG_TYPE::LOG_ASSERT:  return 6;
+            case LOG_TYPE::LOG_FATAL:   return 7;
+            case LOG_TYPE::LOG_DEFAULT: break;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Checks if a log type passes a level threshold
+     *
+     * @param [in] type The log type of the record
+     * @param [in] threshold The least severe log type to be let through
+     * @return true If the record is at least as severe as the threshold, otherwise
+     * @return false
+     */
+    constexpr bool isLogTypeAtLeast(const LOG_TYPE type, const LOG_TYPE threshold) noexcept
+    {
+        return getLogTypeSeverity(type) >= getLogTypeSeverity(threshold);
+    }
+
+    /**
+     * @brief Checks if a log type is a critical one
+     * The records which may well be the last ones before a crash, to be
+     * committed (e.g. synced) by the sinks right away.
+     *
+     * @param [in] type The log type of the record
+     * @return true If it is LOG_ERR, LOG_ASSERT or LOG_FATAL, otherwise
+     * @return false
+     */
+    constexpr bool isCriticalLogType(const LOG_TYPE type) noexcept
+    {
+        return type == LOG_TYPE::LOG_ERR || type == LOG_TYPE::LOG_FATAL || type == LOG_TYPE::LOG_ASSERT;
+    }
+};  //logger namespace
+
+#endif // LOG_TYPE_HPP
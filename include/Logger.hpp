@@ -36,7 +36,9 @@
 #define LOGGER_HPP
 
 #include "Clock.hpp"
+#include "LogType.hpp"
 #include "LoggingOps.hpp"
+#include "LoggerConfig.hpp"
 
 #include <cassert>
 #include <fmtmsg.h>
@@ -44,27 +46,6 @@
 
 namespace logger
 {
-    /**
-     * @brief Enum class for different log types.
-     *
-     * This enum class defines various log types that can be used to categorize
-     * log messages. Each type corresponds to a specific logging level or purpose.
-     * The values are used to control the verbosity and importance of log messages.
-     */
-    enum class LOG_TYPE
-    {
-        LOG_ERR     = 0x01,
-        LOG_INFO    = 0x02,
-        LOG_DBG     = 0x03,
-        LOG_FATAL   = 0x04,
-        LOG_WARN    = 0x05,
-        LOG_IMP     = 0x06,
-        LOG_ASSERT  = 0x07,
-        // Any new type/entry should be added above this. Also update the maps
-        // m_stringToEnumMap & m_EnumToStringMap, accordingly in the CPP file.
-        LOG_DEFAULT = 0xFF
-    };
-
     /**
      * @brief String constants for log formatting and separators.
      *
@@ -99,6 +80,7 @@ namespace logger
     inline static constexpr std::string_view DOUBLE_QUOTES        = "\"";
     inline static constexpr std::string_view SINGLE_QUOTE         = "'";
     inline static constexpr std::string_view FIELD_SEPARATOR      = VERTICAL_SEP;
+    inline static constexpr std::string_view LOG_TIME_FORMAT      = "%Y%m%d_%H%M%S";
 
     /**
      * @brief Type alias for amps used in logging.
@@ -139,18 +121,86 @@ namespace logger
              */
             static std::string covertLogTypeEnumToString(const LOG_TYPE& type) noexcept;
 
+            /**
+             * @brief Extracts the class and function names from the function name.
+             * This function extracts the class name and function name from the
+             * full function name string, which may include a scope resolution operator (::).
+             *
+             * @param [in] prettyFuncName The function name, as __PRETTY_FUNCTION__ has it.
+             * @param [out] className The extracted class name.
+             * @param [out] funcName The extracted function name.
+             * 
+             * @note If pretty function name is in the format "ClassName::FunctionName"
+             * then use ClassName : FunctionName.
+             * If it is not in that format, then just use the function name
+             * as it is, without any class name.
+             * This is useful for logging purposes, to identify which class
+             * and function the log message is coming from.
+             * For example, if the function name is "Logger::log", then
+             * the class name will be "Logger" and the function name will be "log".
+             * If the function name is "log", then the class name will be empty
+             * and the function name will be "log".
+             * If the function name is "Logger::log()", then the class name will be "Logger"
+             * and the function name will be "log".
+             * If the function name is "Logger::log(const std::string&)", then the
+             * class name will be "Logger" and the function name will be "log".
+             * 
+             * In case of lamda functions on clang/gcc
+             * the pretty function name comes as
+             * "auto LoggerTest_testDiffFuncSignatures_Test::TestBody()::(anonymous class)::operator()"
+             * In this case the targeted aim is class : operator()
+             */
+            static void extractClassAndFuncName(const std::string_view prettyFuncName,
+                                                std::string& className,
+                                                std::string& funcName) noexcept;
+
             /**
              * @brief Builds and returns a LoggingOps object.
              *
-             * This function creates and returns a reference to a
-             * LoggingOps object that is used for logging operations.
-             * It ensures that the LoggingOps object is initialized
-             * only once and can be reused across multiple Logger instances.
+             * This function returns a reference to the LoggingOps object
+             * of the default LogHandle, the one the LOG_* macros log to.
+             * It gets made on first use, out of LoggerConfig::load().
+             * Other LogHandle objects have sinks of their own.
              *
              * @return A reference to the LoggingOps object.
              */
             static LoggingOps& buildLoggingOpsObject() noexcept;
 
+            /**
+             * @brief Makes a LoggingOps object out of the given settings.
+             *
+             * The console, a file or both of them, as the settings go, behind a
+             * CoalescingOps if the repeats are to be collapsed. It is what
+             * buildLoggingOpsObject() makes, out of LoggerConfig::load().
+             * A binary or JSON log which can't be opened, or is not one,
+             * falls back to a text log, getAllExceptions() of which tells why.
+             *
+             * @param [in] config The settings
+             * @return std::unique_ptr<LoggingOps> The LoggingOps object
+             * @throws std::exception If the log file can't be had
+             */
+            static std::unique_ptr<LoggingOps> makeLoggingOps(const LoggerConfig& config);
+
+            /**
+             * @brief Applies the settings which can change on a live LoggingOps object.
+             *
+             * The level thresholds, the load shedding, the batching, the
+             * rotation size and the window the repeats get collapsed within
+             * of an object made by makeLoggingOps(), e.g. on a reload of the config.
+             * Where the records go and in which format is left as it is.
+             *
+             * Each setting of each sink is an atomic store of its own. A logging
+             * call or a drain turn running meanwhile may see some of the new
+             * ones along with some of the old ones, never a setting half
+             * written, and every one of them is in place once this returns.
+             * Publishing them all at once would take a lookup through a shared
+             * pointer on every logging call, not worth it for a reload.
+             *
+             * @param [in] ops The LoggingOps object, as made by makeLoggingOps()
+             * @param [in] config The settings
+             */
+            static void applySettings(LoggingOps& ops, const LoggerConfig& config) noexcept;
+
             Logger() = delete;
             Logger(const std::string_view timeFormat);
             virtual ~Logger() = default;
@@ -262,6 +312,31 @@ namespace logger
              */
             inline const std::stringstream& getLogStream() const noexcept { return m_logStream; }
 
+            /**
+             * @brief Get the time the last log message got stamped with
+             *
+             * @return std::chrono::system_clock::time_point The time in its prefix
+             */
+            inline std::chrono::system_clock::time_point getTimestamp() const noexcept { return m_timestamp; }
+
+            /**
+             * @brief Get the size of the prefix of the last log message
+             * The "|time| thread id| file| line|TYPE>" part, up to and
+             * including the space before the "[Class : function]" part.
+             *
+             * @return size_t The size of the prefix in the log stream
+             */
+            inline size_t getLogMsgPrefixSize() const noexcept { return m_prefixSize; }
+
+            /**
+             * @brief Get the offset of the formatted message in the last log message
+             * What comes after the "[Class : function]" part (and the assertion
+             * details, if any), the format string along with its arguments.
+             *
+             * @return size_t The offset of the message in the log stream
+             */
+            inline size_t getLogMsgOffset() const noexcept { return m_msgOffset; }
+
             /**
              * @brief Logs a message with the specified format and arguments.
              * This function formats the log message using the provided format string
@@ -336,36 +411,6 @@ namespace logger
             virtual void constructLogMsgPrefixSecondPart();
 
         private:
-            /**
-             * @brief Extracts the class and function names from the function name.
-             * This function extracts the class name and function name from the
-             * full function name string, which may include a scope resolution operator (::).
-             *
-             * @param [out] className The extracted class name.
-             * @param [out] funcName The extracted function name.
-             * 
-             * @note If pretty function name is in the format "ClassName::FunctionName"
-             * then use ClassName : FunctionName.
-             * If it is not in that format, then just use the function name
-             * as it is, without any class name.
-             * This is useful for logging purposes, to identify which class
-             * and function the log message is coming from.
-             * For example, if the function name is "Logger::log", then
-             * the class name will be "Logger" and the function name will be "log".
-             * If the function name is "log", then the class name will be empty
-             * and the function name will be "log".
-             * If the function name is "Logger::log()", then the class name will be "Logger"
-             * and the function name will be "log".
-             * If the function name is "Logger::log(const std::string&)", then the
-             * class name will be "Logger" and the function name will be "log".
-             * 
-             * In case of lamda functions on clang/gcc
-             * the pretty function name comes as
-             * "auto LoggerTest_testDiffFuncSignatures_Test::TestBody()::(anonymous class)::operator()"
-             * In this case the targeted aim is class : operator()
-             */
-            void extractClassAndFuncName(std::string& className, std::string& funcName) noexcept;
-
             /**
              * @brief Logs a message with the specified format and arguments.
              * This function formats the log message using the provided format string
@@ -404,6 +449,9 @@ namespace logger
             std::stringstream m_logStream;
             LOG_TYPE m_logType = LOG_TYPE::LOG_INFO;
             std::string m_assertCond;
+            std::chrono::system_clock::time_point m_timestamp;
+            size_t m_prefixSize = 0;
+            size_t m_msgOffset = 0;
     };
 };
 
@@ -0,0 +1,164 @@
+/**
+ * @file LoggerConfig.hpp
+ * @brief Declaration of the LoggerConfig struct, the settings the default
+ *        LoggingOps is built from, read once at startup from the compiled in
+ *        defaults, a config file and the environment.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LOGGER_CONFIG_HPP
+#define LOGGER_CONFIG_HPP
+
+#include "LogType.hpp"
+#include "IoExecutor.hpp"
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <filesystem>
+#include <cstdint>
+
+namespace logger
+{
+    /**
+     * @brief The settings the default LoggingOps gets built from
+     * It starts off with the values compiled in through ENV_VARS.hpp, which
+     * a config file and then the environment may override, so that the log
+     * destination or its size limit can change without a rebuild. Each
+     * setting goes by the name of its build option, e.g. FILE_SIZE, which
+     * is prefixed with LOGGER_ in the environment, e.g. LOGGER_FILE_SIZE.
+     * The levels, the batching and the rotation size can also change on a
+     * live process, see ConfigWatcher.
+     */
+    struct LoggerConfig
+    {
+        /**
+         * @brief The formats of the log file
+         */
+        enum class FileFormat : uint8_t
+        {
+            TEXT,       ///< Text lines, rotated by size (FileOps)
+            BINARY,     ///< Compact binary records (BinaryFileSink)
+            JSON        ///< JSON Lines (JsonLinesSink)
+        };
+
+        static constexpr std::string_view ENV_PREFIX = "LOGGER_";           ///< Prefix of the settings in the environment
+        static constexpr std::string_view CONFIG_FILE_ENV = "LOGGER_CONFIG";  ///< Environment variable naming the config file
+        static constexpr std::string_view LEVEL_PREFIX = "LEVEL.";          ///< Prefix of the level of a named logger, e.g. LEVEL.db.pool
+
+        /**
+         * @brief The levels of the named loggers, none meaning silenced (OFF)
+         */
+        using LoggerLevels = std::vector<std::pair<std::string, std::optional<LOG_TYPE>>>;
+
+        bool fileLogging = false;                   ///< FILE_LOGGING, yes or no
+        std::uintmax_t fileSize = 1024 * 1000;      ///< FILE_SIZE, e.g. 20MB
+        std::string filePath;                       ///< LOG_FILE_PATH
+        std::string fileName;                       ///< LOG_FILE_NAME
+        std::string fileExtn;                       ///< LOG_FILE_EXTN, the leading '.' included
+        LOG_TYPE fileLevel = LOG_TYPE::LOG_DEFAULT; ///< FILE_LOG_LEVEL
+        FileFormat fileFormat = FileFormat::TEXT;   ///< FILE_LOG_FORMAT, text, binary or json
+        bool consoleLogging = false;                ///< CONSOLE_LOGGING, along with the file
+        std::optional<LOG_TYPE> consoleLevel;       ///< CONSOLE_LOG_LEVEL, WARN along with a file if not set
+        bool consoleStderr = false;                 ///< CONSOLE_STDERR, yes or no
+        size_t maxBatchSize = 256;                  ///< BATCH_SIZE, records which make a batch
+        std::chrono::milliseconds maxLatency{100};  ///< BATCH_LATENCY_MS, the longest a record waits
+        std::chrono::milliseconds coalesceWindow{0};///< COALESCE_WINDOW_MS, repeats collapsed within, 0 for none
+        std::chrono::milliseconds maxBacklogDelay{0};   ///< SHED_BACKLOG_MS, the backlog delay records get shed beyond, 0 for never
+        LOG_TYPE priorityLevel = LOG_TYPE::LOG_ERR; ///< PRIORITY_LEVEL, the least severe log type written ahead of the queue
+        size_t ioThreadCnt = IoExecutor::defaultThreadCount;   ///< IO_THREADS, read once when the shared IoExecutor gets created
+        IoThreadOptions ioThreads;                  ///< IO_THREAD_CPUS (e.g. 2,3), IO_THREAD_SCHED (e.g. FIFO:50), IO_THREAD_NICE
+                                                    ///< and IO_WAIT (BLOCK, SPIN[:<us>] or BUSY_POLL), applied at startup
+        LoggerLevels loggerLevels;                  ///< LEVEL.<name>, config file only
+        bool watchConfig = false;                   ///< WATCH_CONFIG, reload the config file when it changes
+        bool reloadOnSighup = false;                ///< RELOAD_ON_SIGHUP, reload the config file on a SIGHUP
+
+        /**
+         * @brief Get the settings compiled in through ENV_VARS.hpp
+         *
+         * @return LoggerConfig The build time settings
+         */
+        static LoggerConfig getCompiledDefaults() noexcept;
+
+        /**
+         * @brief Get the settings to start up with
+         * The compiled in defaults, overridden by the config file named by
+         * LOGGER_CONFIG (if set), overridden in turn by the LOGGER_ prefixed
+         * environment variables. A setting with an invalid value is ignored.
+         *
+         * @return LoggerConfig The effective settings
+         */
+        static LoggerConfig load() noexcept;
+
+        /**
+         * @brief Get the settings out of a given config file
+         * Like load(), the config file being the given one.
+         *
+         * @param [in] configFile The config file, none if empty
+         * @return LoggerConfig The effective settings
+         */
+        static LoggerConfig load(const std::filesystem::path& configFile) noexcept;
+
+        /**
+         * @brief Parse a file size, as the FILE_SIZE build option takes it
+         *
+         * @param [in] value A number with an optional unit, B, K(B), M(B) or G(B), e.g. 20MB
+         * @return std::optional<std::uintmax_t> The size in bytes, none if it is not a valid one
+         */
+        static std::optional<std::uintmax_t> parseFileSize(const std::string_view value) noexcept;
+
+        /**
+         * @brief Set one setting by the name of its build option
+         *
+         * @param [in] key The name, e.g. LOG_FILE_NAME (case insensitive),
+         *             or LEVEL.<logger name>, taking a level or OFF
+         * @param [in] value Its value, e.g. App.log
+         * @return true If it got set, otherwise
+         * @return false If the name is unknown or the value is invalid, the setting being left as is
+         */
+        bool set(const std::string_view key, const std::string_view value) noexcept;
+
+        /**
+         * @brief Apply the settings of a config file
+         * One KEY=VALUE a line, the value optionally in double quotes. Blank
+         * lines and lines starting with a '#' are skipped.
+         *
+         * @param [in] file The config file
+         * @return size_t Number of settings applied, 0 if it can't be read
+         */
+        size_t applyFile(const std::filesystem::path& file) noexcept;
+
+        /**
+         * @brief Apply the settings set in the environment, e.g. LOGGER_FILE_SIZE
+         *
+         * @return size_t Number of settings applied
+         */
+        size_t applyEnvironment() noexcept;
+    };
+};  //logger namespace
+
+#endif // LOGGER_CONFIG_HPP
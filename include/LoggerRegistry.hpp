@@ -0,0 +1,320 @@
+/**
+ * @file LoggerRegistry.hpp
+ * @brief Declaration of the LoggerRegistry class, a registry of named loggers
+ *        (e.g. "net", "db.pool") with levels and sinks inherited down their
+ *        hierarchy, and of the NamedLogger class, one of its loggers.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LOGGER_REGISTRY_HPP
+#define LOGGER_REGISTRY_HPP
+
+#include "LogType.hpp"
+#include "LoggerConfig.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace logger
+{
+    class LoggingOps;
+
+    /**
+     * @brief Counts the logging calls on their way to a sink, so that a sink
+     * replaced by LoggerRegistry::setOps() is released once none can hold it
+     * A call is counted in the slot of the epoch it started in, over a few
+     * counters of their own, not to have all the threads contend on one.
+     */
+    class OpsEpochs
+    {
+        public:
+            /**
+             * @brief Count a logging call in, before its sink is read
+             *
+             * @return size_t The counter it is counted in, for leave()
+             */
+            inline size_t enter() noexcept
+            {
+                auto shard = std::hash<std::thread::id>()(std::this_thread::get_id()) % shardCnt;
+                while (true)
+                {
+                    auto epoch = m_epoch.load();
+                    auto counter = (epoch & 1) * shardCnt + shard;
+                    m_readers[counter].cnt.fetch_add(1, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    // Counted in the slot waitForReaders() waits for, unless a new epoch started meanwhile
+                    if (m_epoch.load() == epoch)
+                        return counter;
+                    m_readers[counter].cnt.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+
+            /**
+             * @brief Count a logging call out, once it is done with its sink
+             *
+             * @param [in] counter What enter() returned
+             */
+            inline void leave(const size_t counter) noexcept                { m_readers[counter].cnt.fetch_sub(1, std::memory_order_release); }
+
+            /**
+             * @brief Start a new epoch and wait for the calls started before it
+             * Those are the only ones which can hold a sink replaced before.
+             * Not to be called from a logging call.
+             */
+            void waitForReaders();
+
+        private:
+            static constexpr size_t shardCnt = 8;
+
+            /// A counter of its own cache line
+            struct alignas(64) Counter
+            {
+                std::atomic<size_t> cnt{0};
+            };
+
+            std::atomic<size_t> m_epoch{0};
+            std::array<Counter, 2 * shardCnt> m_readers;
+            /// Serializes waitForReaders(), a second epoch can't start while the calls of the first are waited for
+            std::mutex m_epochMtx;
+    };
+
+    class NamedLogger
+    {
+        public:
+            NamedLogger(const NamedLogger&) = delete;
+            NamedLogger(NamedLogger&&) = delete;
+            NamedLogger& operator=(const NamedLogger&) = delete;
+            NamedLogger& operator=(NamedLogger&&) = delete;
+
+            /**
+             * @brief Checks if a record of a log type is to be logged
+             * A single relaxed atomic read, the level being resolved along
+             * the hierarchy whenever it changes, not when it is read.
+             *
+             * @param [in] logType The log type of the record
+             * @return true If it passes the level of the logger, otherwise
+             * @return false
+             */
+            inline bool isEnabled(const LOG_TYPE logType) const noexcept
+            {
+                return getLogTypeSeverity(logType) >= m_minSeverity.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Get the sink the records of the logger go to
+             * Once replaced with LoggerRegistry::setOps(), it may be released,
+             * unless held by an OpsScope, or by a shared_ptr of the caller.
+             *
+             * @return LoggingOps& Its own sink, or the one of its closest ancestor which has one
+             */
+            inline LoggingOps& getOps() const noexcept                      { return *m_ops.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Keeps the sink of a logger from being released, for a scope, e.g. a logging call
+             */
+            class OpsScope
+            {
+                public:
+                    explicit OpsScope(const NamedLogger& namedLogger) noexcept
+                        : m_epochs(namedLogger.m_epochs)
+                        , m_counter(m_epochs.enter())
+                        , m_ops(namedLogger.getOps())
+                    {
+                    }
+                    ~OpsScope()                                             { m_epochs.leave(m_counter); }
+                    OpsScope(const OpsScope&) = delete;
+                    OpsScope& operator=(const OpsScope&) = delete;
+
+                    /**
+                     * @brief Get the sink, as it was when the scope started
+                     *
+                     * @return LoggingOps& The sink
+                     */
+                    inline LoggingOps& getOps() const noexcept              { return m_ops; }
+
+                private:
+                    OpsEpochs& m_epochs;
+                    const size_t m_counter;
+                    LoggingOps& m_ops;
+            };
+
+            /**
+             * @brief Get the name of the logger
+             *
+             * @return const std::string& Its dotted name, empty for the root
+             */
+            inline const std::string& getName() const noexcept              { return m_name;            }
+
+        private:
+            friend class LoggerRegistry;
+
+            NamedLogger(const std::string_view name, NamedLogger* parent, OpsEpochs& epochs);
+
+            const std::string m_name;
+            NamedLogger* const m_parent;
+            /// The logging calls of the registry, counted in by the OpsScopes
+            OpsEpochs& m_epochs;
+            /// The settings below are guarded by the mutex of the registry
+            std::vector<NamedLogger*> m_children;
+            std::optional<uint8_t> m_ownMinSeverity;
+            std::shared_ptr<LoggingOps> m_ownOps;
+            /// What the settings resolve to, read by the logging calls
+            std::atomic<uint8_t> m_minSeverity;
+            std::atomic<LoggingOps*> m_ops;
+    };
+
+    class LoggerRegistry
+    {
+        public:
+            /**
+             * @brief Get the registry used by the LOG_*_TO macros
+             * Created on first use, its root logging to the sink built by
+             * Logger::buildLoggingOpsObject(). It is never destroyed, so
+             * that the loggers can still be used by statics at exit.
+             *
+             * @return LoggerRegistry& The shared registry
+             */
+            static LoggerRegistry& getShared();
+
+            /**
+             * @brief Construct a new LoggerRegistry object
+             * The root logger lets everything through to rootOps.
+             *
+             * @param [in] rootOps The sink the loggers without a sink of their own
+             *             log to, which must outlive the registry
+             */
+            explicit LoggerRegistry(LoggingOps& rootOps);
+
+            /**
+             * @brief Destroy the LoggerRegistry object
+             * The loggers handed out must not be used any more.
+             */
+            ~LoggerRegistry();
+
+            LoggerRegistry(const LoggerRegistry&) = delete;
+            LoggerRegistry(LoggerRegistry&&) = delete;
+            LoggerRegistry& operator=(const LoggerRegistry&) = delete;
+            LoggerRegistry& operator=(LoggerRegistry&&) = delete;
+
+            /**
+             * @brief Get a logger, creating it along with its ancestors if new
+             * The reference stays valid as long as the registry, so that a
+             * call site can look it up once and keep it.
+             *
+             * @param [in] name The dotted name, e.g. "db.pool", empty for the root
+             * @return NamedLogger& The logger
+             * @throws std::invalid_argument If the name has an empty part, e.g. "db..pool"
+             */
+            NamedLogger& get(const std::string_view name);
+
+            /**
+             * @brief Set the level of a logger and of its descendants without one of their own
+             *
+             * @param [in] name The dotted name of the logger
+             * @param [in] threshold The least severe log type to be logged,
+             *             LOG_DEFAULT lets everything through
+             * @throws std::invalid_argument If the name is not valid
+             */
+            void setLevel(const std::string_view name, const LOG_TYPE threshold);
+
+            /**
+             * @brief Drop every record of a logger and of its descendants without a level of their own
+             *
+             * @param [in] name The dotted name of the logger
+             * @throws std::invalid_argument If the name is not valid
+             */
+            void silence(const std::string_view name);
+
+            /**
+             * @brief Have a logger inherit its level from its parent again
+             * The root gets back to letting everything through.
+             *
+             * @param [in] name The dotted name of the logger
+             * @throws std::invalid_argument If the name is not valid
+             */
+            void resetLevel(const std::string_view name);
+
+            /**
+             * @brief Apply the levels of a config, e.g. on a reload
+             * The loggers given a level by the former call and left out of
+             * this one inherit theirs again. The ones with an invalid name
+             * are skipped. The logging calls are not held up meanwhile: the
+             * level of each logger is published on its own, so that one of
+             * them may log at its new level while another one is still at
+             * its old one, until this returns.
+             *
+             * @param [in] levels The levels, none meaning silenced
+             * @see LoggerConfig::loggerLevels
+             */
+            void applyLevels(const LoggerConfig::LoggerLevels& levels);
+
+            /**
+             * @brief Route a logger and its descendants without a sink of their own to a sink
+             * A sink replaced is released once the logging calls which may
+             * still be on their way to it are over, waited for by the call.
+             * Not to be called from a logging call.
+             *
+             * @param [in] name The dotted name of the logger
+             * @param [in] ops The sink, null to inherit the one of the parent again
+             * @throws std::invalid_argument If the name is not valid
+             */
+            void setOps(const std::string_view name, std::shared_ptr<LoggingOps> ops);
+
+            /**
+             * @brief Get the number of loggers, the root included
+             *
+             * @return size_t The number of loggers created so far
+             */
+            size_t getLoggerCount() const;
+
+        private:
+            /**
+             * @brief Get a logger, creating it if new, with m_mtx held
+             */
+            NamedLogger& getLocked(const std::string_view name);
+
+            /**
+             * @brief Resolve the level and the sink of a logger and its descendants, with m_mtx held
+             */
+            void resolve(NamedLogger& namedLogger);
+
+            mutable std::mutex m_mtx;
+            LoggingOps& m_rootOps;
+            std::unordered_map<std::string, std::unique_ptr<NamedLogger>> m_loggers;
+            /// The logging calls on their way to a sink, for setOps() to release one
+            OpsEpochs m_epochs;
+            /// The loggers given a level by applyLevels()
+            std::vector<std::string> m_configuredNames;
+    };
+};  //logger namespace
+
+#endif // LOGGER_REGISTRY_HPP
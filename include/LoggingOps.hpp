@@ -29,6 +29,8 @@
 #ifndef LOGGING_OPS_HPP
 #define LOGGING_OPS_HPP
 
+#include "LogRecord.hpp"
+
 #include <queue>
 #include <vector>
 #include <list>
@@ -36,6 +38,7 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <chrono>
 #include <exception>
 #include <condition_variable>
 
@@ -45,8 +48,12 @@ namespace logger
 
     using BufferQ = std::queue<std::array<char, bufferSize>>;
 
+    class IoExecutor;
+
     class LoggingOps
     {
+        friend class IoExecutor;
+
         public:
             /**
              * @brief Overloaded output operator for LoggingOps class
@@ -96,9 +103,9 @@ namespace logger
             /**
              * @brief Get all the exceptions happened during the file ops
              *
-             * @return std::filesystem::path The file path object
+             * @return std::vector<std::exception_ptr> A copy of the exceptions collected so far
              */
-            inline const std::vector<std::exception_ptr>& getAllExceptions() noexcept       { return m_excpPtrVec; }
+            std::vector<std::exception_ptr> getAllExceptions() const;
 
             /**
              * @brief Add a raised exception to the exception vector
@@ -107,30 +114,29 @@ namespace logger
              * @note This function is thread safe. It uses mutex to ensure that
              * only one thread can add an exception at a time.
              */
-            inline void addRaisedException(const std::exception_ptr& excpPtr) noexcept      { m_excpPtrVec.emplace_back(excpPtr); }
+            void addRaisedException(const std::exception_ptr& excpPtr) noexcept;
 
             /**
              * @brief Default constructor for LoggingOps class
-             * Initializes the data records queue, data ready flag,
-             * shutdown and exit flag, and starts the watcher thread
+             * Initializes the data records queue, data ready flag and
+             * shutdown and exit flag. No thread of its own is started, the
+             * data records queue gets drained by the shared I/O executor.
              *
-             * @note The watcher thread will keep watch and pull the data
-             * from the data records queue and write it to the file
-             * whenever it is available.
-             * @note This function is thread safe. It uses mutex and condition variable
-             * to ensure that only one thread can keep watch and pull the data at a time.
+             * @note The executor drains the queue in turns, one batch a turn,
+             * whenever 256 records (see setMaxBatchSize()) are queued or a
+             * flush is asked for.
+             * @see IoExecutor
              */
             LoggingOps();
 
             /**
              * @brief Destructor for LoggingOps class
-             * Stops the watcher thread and clears the data records queue.
+             * Drains the data records queue and retires it from the I/O executor.
              * 
              * @note It also collects and prints any exceptions that occurred
              * during the data operations before the object is destroyed.
              *
-             * @note This function is thread safe. It uses mutex and condition variable
-             * to ensure that only one thread can stop the watcher thread and clear the data records queue at a time.
+             * @see stopWatcher()
              */
             virtual ~LoggingOps();
 
@@ -146,15 +152,205 @@ namespace logger
             /**
              * @brief flush the data records queue.
              * It checks the data records queue and if it is not empty then
-             * notifies the watcher thread to write the data to the file/console
+             * schedules a drain turn to write the data to the file/console
              * immediately.
              */
-            void flush();
+            virtual void flush();
+
+            /**
+             * @brief flush the data records queue and wait for it.
+             * Unlike flush() it blocks until everything queued so far
+             * has been handed over to writeToOutStreamObject and that
+             * batch has been written, or the draining has been stopped.
+             * While an event loop drives the I/O, the calling thread
+             * writes them out itself.
+             */
+            virtual void flushAndWait();
+
+            /**
+             * @brief Make the records written so far durable
+             * Called right after a LOG_ERR, LOG_FATAL or LOG_ASSERT record
+             * has been written, before the logging call returns. Does nothing
+             * by default, sinks which support a durability policy override it.
+             *
+             * @see FileOps::commitCritical()
+             */
+            virtual void commitCritical() {}
+
+            /**
+             * @brief Wait for a LOG_FATAL or LOG_ASSERT record to be written
+             * The process may well be about to go down. Called once the record
+             * got handed over to writeRecord(), with the formatter released,
+             * does nothing for the other log types.
+             *
+             * @param [in] logType The log type of the record
+             */
+            void waitForFatal(const LOG_TYPE logType);
+
+            /**
+             * @brief Set the level threshold of the sink
+             * Records less severe than the threshold are dropped by
+             * writeRecord(). LOG_DEFAULT, the default, lets everything through.
+             *
+             * @param [in] threshold The least severe log type to be written
+             * @see getLogTypeSeverity()
+             */
+            inline void setLevelThreshold(const LOG_TYPE threshold) noexcept    { m_levelThreshold = threshold; }
+
+            /**
+             * @brief Get the level threshold of the sink
+             *
+             * @return LOG_TYPE The least severe log type written
+             */
+            inline LOG_TYPE getLevelThreshold() const noexcept                  { return m_levelThreshold; }
+
+            /**
+             * @brief Set the number of records which makes a batch
+             * A drain turn gets scheduled as soon as that many records are
+             * queued. Effective from the next record, it can change any time.
+             *
+             * @param [in] maxBatchSize The number of records, 0 is taken as 1
+             */
+            inline void setMaxBatchSize(const size_t maxBatchSize) noexcept     { m_maxBatchSize = maxBatchSize ? maxBatchSize : 1; }
+
+            /**
+             * @brief Get the number of records which makes a batch
+             *
+             * @return size_t The number of records (default 256)
+             */
+            inline size_t getMaxBatchSize() const noexcept                      { return m_maxBatchSize; }
+
+            /**
+             * @brief Set the longest a record waits to be written
+             * Taken by the sinks which hand a batch not full yet over on a
+             * timer, e.g. ConsoleOps and BatchSinkOps. Effective from the
+             * next batch, it can change any time.
+             *
+             * @param [in] maxLatency The longest a queued record waits
+             */
+            inline void setMaxLatency(const std::chrono::milliseconds maxLatency) noexcept  { m_maxLatency = maxLatency; }
+
+            /**
+             * @brief Get the longest a record waits to be written
+             *
+             * @return std::chrono::milliseconds The longest a queued record waits
+             */
+            inline std::chrono::milliseconds getMaxLatency() const noexcept     { return m_maxLatency; }
+
+            /**
+             * @brief Set the load shedding of the sink
+             * Under a sustained overload, i.e. a backlog which takes longer than
+             * maxBacklogDelay to drain at the rate the sink writes, the records
+             * get dropped a level at a time: DBG, then INFO, then IMP. WARN
+             * and the more severe ones are never dropped. The levels come
+             * back as the backlog clears. Each change gets a WARN record.
+             *
+             * @param [in] maxBacklogDelay The longest the backlog may take to
+             *             drain, 0 (the default) for no shedding
+             */
+            inline void setLoadShedding(const std::chrono::milliseconds maxBacklogDelay) noexcept   { m_maxBacklogDelay = maxBacklogDelay; }
+
+            /**
+             * @brief Get the longest the backlog may take to drain, before records get shed
+             *
+             * @return std::chrono::milliseconds The delay, 0 for no shedding
+             */
+            inline std::chrono::milliseconds getLoadShedding() const noexcept   { return m_maxBacklogDelay; }
+
+            /**
+             * @brief Get the least severe log type let through under the load
+             *
+             * @return LOG_TYPE LOG_DEFAULT when nothing is shed, otherwise
+             *         LOG_INFO, LOG_IMP or LOG_WARN
+             */
+            inline LOG_TYPE getShedLevel() const noexcept                       { return m_shedLevel; }
+
+            /**
+             * @brief Get the number of records shed so far
+             *
+             * @return uint64_t The records dropped under the load
+             */
+            inline uint64_t getShedCount() const noexcept                       { return m_shedCnt; }
+
+            /**
+             * @brief Set the least severe log type which takes the priority lane
+             * The records at least that severe skip the queue of the others:
+             * a drain turn is scheduled for them right away and writes them
+             * first. Each lane keeps the order the records came in, so the
+             * records of a thread stay in order within a lane. A LOG_FATAL or
+             * LOG_ASSERT record is waited for by waitForFatal().
+             *
+             * @param [in] priorityLevel The log type, LOG_ERR by default,
+             *             LOG_FATAL to have the errors wait in line too
+             */
+            inline void setPriorityLevel(const LOG_TYPE priorityLevel) noexcept { m_priorityLevel = priorityLevel; }
+
+            /**
+             * @brief Get the least severe log type which takes the priority lane
+             *
+             * @return LOG_TYPE The log type (default LOG_ERR)
+             */
+            inline LOG_TYPE getPriorityLevel() const noexcept                   { return m_priorityLevel; }
+
+            /**
+             * @brief Checks if a record of a log type takes the priority lane
+             *
+             * The notices the sink writes of its own, e.g. of the load
+             * shedding, take it whatever their log type.
+             *
+             * @param [in] logType The log type of the record
+             * @return true If it skips the queue, otherwise
+             * @return false
+             * @note Sinks which give the lane a meaning of their own, e.g. ConsoleOps, override it
+             */
+            virtual bool isPriority(const LOG_TYPE logType) const noexcept;
+
+            /**
+             * @brief Checks if a record of a log type is to be written
+             * It has to pass the level threshold and the shed level both.
+             *
+             * @param [in] logType The log type of the record
+             * @return true If it is to be written, otherwise
+             * @return false
+             */
+            inline bool admits(const LOG_TYPE logType) noexcept
+            {
+                if (!isLogTypeAtLeast(logType, m_levelThreshold))
+                    return false;
+                if (isLogTypeAtLeast(logType, m_shedLevel.load(std::memory_order_relaxed)))
+                    return true;
+
+                m_shedCnt.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            /**
+             * @brief write a formatted log record.
+             * Writes the record like write() does, if its log type passes the
+             * level threshold and the shed level of the sink, otherwise drops
+             * it. Its fields, if any, get rendered after the text as " key=value".
+             * The severe ones take the priority lane. It only queues the record,
+             * not to hold up the logging call while it holds the formatter.
+             *
+             * @param [in] record The record, its text and its metadata
+             * @see setLevelThreshold(), setLoadShedding(), setPriorityLevel()
+             */
+            virtual void writeRecord(const LogRecord& record);
+
+            /**
+             * @brief write a formatted log record.
+             * Same as writeRecord(const LogRecord&), the time stamp and the
+             * thread of the record being those of the call.
+             *
+             * @param [in] logType The log type of the record
+             * @param [in] data The formatted record to be written
+             */
+            void writeRecord(const LOG_TYPE logType, const std::string_view data);
 
             /**
              * @brief write the data.
              * Writes the data passed to it. The data is  pushed to the
-             * data records queue and then the watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] data The data to be written to the file
              */
@@ -163,7 +359,7 @@ namespace logger
             /**
              * @brief write the data.
              * Writes the data passed to it. The data is  pushed to the
-             * data records queue and then the watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] dataVec The data in a vector to be written to the file
              */
@@ -172,7 +368,7 @@ namespace logger
             /**
              * @brief write the data.
              * Writes the data passed to it. The data is  pushed to the
-             * data records queue and then the file watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] dataList The data in a list to be written to the file
              */
@@ -181,7 +377,7 @@ namespace logger
             /**
              * @brief write the data.
              * Writes the data passed to it. The data is  pushed to the
-             * data records queue and then the watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] dataVec The data in a vector to be written to the file
              */
@@ -190,7 +386,7 @@ namespace logger
             /**
              * @brief write the data.
              * Writes the data passed to it. The data is  pushed to the
-             * data records queue and then the file watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] dataList The data in a list to be written to the file
              */
@@ -199,7 +395,7 @@ namespace logger
             /**
              * @brief write the data.
              * Writes the binary data passed to it. The data is  pushed to the
-             * data records queue and then the file watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] data The data to be written to. Is of type uint8_t
              */
@@ -208,7 +404,7 @@ namespace logger
             /**
              * @brief write the data.
              * Writes the data passed to it. The data is  pushed to the
-             * data records queue and then the file watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] data The data to be written to the out stream. Is of type uint16_t
              * @note The data is converted to a string of 16 bits and then written to the out stream.
@@ -218,7 +414,7 @@ namespace logger
             /**
              * @brief write the data.
              * Writes the  data passed to it. The data is  pushed to the
-             * data records queue and then the watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] data The data to be written to the outstream. Is of type uint64_t
              * @note The data is converted to a string of 64 bits and then written to.
@@ -228,7 +424,7 @@ namespace logger
             /**
              * @brief write the data.
              * Writes the data passed to it. The data is  pushed to the
-             * data records queue and then the watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] data The data to be written to the outstream. Is of type uint32_t
              * @note The data is converted to a string of 32 bits and then written to.
@@ -237,7 +433,7 @@ namespace logger
             /**
              * @brief write the data.
              * Writes the out stream with the binary data stream passed to it. The data is  pushed to the
-             * data records queue and then the watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] binaryStream The binary data stream (uint8_t) to be written to.
              * @note It internally calls write(const uint8_t data) in a loop
@@ -248,7 +444,7 @@ namespace logger
             /**
              * @brief write the data.
              * Writes the out stream with the binary data stream passed to it. The data is  pushed to the
-             * data records queue and then the watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] binaryStream The binary data stream (uint16_t) to be written to.
              * @note It internally calls write(const uint16_t data) in a loop
@@ -259,7 +455,7 @@ namespace logger
             /**
              * @brief write the data.
              * Writes the out stream with the binary data stream passed to it. The data is  pushed to the
-             * data records queue and then the watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] binaryStream The binary data stream (uint32_t) to be written to.
              * @note It internally calls write(const uint32_t data) in a loop
@@ -270,7 +466,7 @@ namespace logger
             /**
              * @brief write the data.
              * Writes the out stream with the binary data stream passed to it. The data is  pushed to the
-             * data records queue and then the watcher thread will pick it up.
+             * data records queue and then the I/O executor will pick it up.
              *
              * @param [in] binaryStream The binary data stream (uint64_t) to be written to.
              * @note It internally calls write(const uint64_t data) in a loop
@@ -376,16 +572,95 @@ namespace logger
 
         protected:
             /**
-             * @brief Keep watch and pull the data from the data records queue
+             * @brief Write out one batch, a drain turn run by the I/O executor
+             * Pops what the priority lane and the data records queue hold and
+             * hands them over to writeToOutStreamObject, the priority lane
+             * first. The turns of a sink never overlap.
              *
-             * @note This function is thread safe. It uses mutex and condition variable
-             * to ensure that only one thread can keep watch and pull the data at a time.
+             * @return true If there is more due to be written, which then
+             * gets a turn of its own behind the other sinks, otherwise
+             * @return false
+             * @note Sinks with a queue of their own override it along with isQueueEmpty()
+             * @see IoExecutor
+             */
+            virtual bool drainBatch();
+
+            /**
+             * @brief Checks if there is nothing queued to be written
+             * Called with m_DataRecordsMtx held.
              *
-             * @see writeToFile
-             * @see pop
-             * @see push
+             * @return true If there is nothing left to write, otherwise
+             * @return false
              */
-            void keepWatchAndPull();
+            virtual bool isQueueEmpty() const                                 { return m_DataRecords.empty() && m_priorityRecords.empty(); }
+
+            /**
+             * @brief Checks if there is nothing queued in the priority lane
+             * Called with m_DataRecordsMtx held.
+             *
+             * @return true If the priority lane is empty, otherwise
+             * @return false
+             * @note Sinks with a queue of their own override it along with isQueueEmpty()
+             */
+            virtual bool isPriorityQueueEmpty() const                         { return m_priorityRecords.empty(); }
+
+            /**
+             * @brief Wait for the priority lane to be written
+             * Unlike flushAndWait() the records queued in the other lane
+             * are not waited for. Not to be called from a drain turn.
+             */
+            void flushPriorityAndWait();
+
+            /**
+             * @brief Schedule a drain turn with the I/O executor
+             * Called with m_DataRecordsMtx held, does nothing once stopped.
+             */
+            void scheduleDrain();
+
+            /**
+             * @brief Schedule a drain turn with the I/O executor after a delay
+             * Called with m_DataRecordsMtx held, does nothing once stopWatcher()
+             * has been called, the turn may well be due after the sink is gone.
+             *
+             * @param [in] delay How long from now
+             */
+            void scheduleDrainAfter(const std::chrono::steady_clock::duration delay);
+
+            /**
+             * @brief Account for a drain turn in the load shedding
+             * Called at the end of every drain turn, with m_DataRecordsMtx held.
+             * The backlog is weighed against the drain rate, smoothed over the
+             * turns. A few overloaded turns in a row raise the shed level a
+             * step, a few calm ones lower it a step. While records get shed, a
+             * turn is scheduled now and then, so that the levels come back
+             * even if nothing gets logged anymore.
+             *
+             * @param [in] backlog The records the turn wrote
+             * @param [in] elapsed How long the turn took to write them
+             * @return true If the shed level changed, for writeShedRecord(), otherwise
+             * @return false
+             */
+            bool noteDrainTurn(const size_t backlog, const std::chrono::steady_clock::duration elapsed);
+
+            /**
+             * @brief Write the WARN record of a change of the shed level
+             * Called after a drain turn, without m_DataRecordsMtx held. It takes
+             * the priority lane, not to wait behind the backlog being shed.
+             */
+            void writeShedRecord();
+
+            /**
+             * @brief Stop the draining of the data records queue
+             * Has the I/O executor drain whatever is left in the data records
+             * queue and waits for it to finish. Calling it more than
+             * once is harmless.
+             *
+             * @note Derived classes which own resources used by their
+             * writeToOutStreamObject override must call it from their own
+             * destructor, before releasing those resources, as the base
+             * destructor runs only after the derived part is gone.
+             */
+            void stopWatcher();
 
             /**
              * @brief Write to the file
@@ -398,6 +673,20 @@ namespace logger
              */
             virtual void writeToOutStreamObject(BufferQ&& /*dataQueue*/, std::exception_ptr& /*excpPtr*/) {}
 
+            /**
+             * @brief Write the records of the priority lane
+             * Called by drainBatch() before the other records are written.
+             * Hands them over to writeToOutStreamObject(), unless overridden,
+             * e.g. by ConsoleOps to write them to stderr.
+             *
+             * @param [in] dataQueue The records of the priority lane
+             * @param [out] excpPtr The exception pointer to be used for exception handling
+             */
+            virtual void writePriorityToOutStreamObject(BufferQ&& dataQueue, std::exception_ptr& excpPtr)
+            {
+                writeToOutStreamObject(std::move(dataQueue), excpPtr);
+            }
+
             /**
              * @brief Write data to the out stream object
              *
@@ -418,6 +707,8 @@ namespace logger
 
             /**
              * @brief Push the data to the data records queue
+             * Or to the priority lane, if it is the text of a record which
+             * takes it, written by writeRecord() on this thread.
              *
              * @param [in] data The data to be pushed to the data records queue
              * @note This function is thread safe. It uses mutex and condition variable
@@ -426,18 +717,54 @@ namespace logger
             void push(const std::string_view data);
 
             BufferQ m_DataRecords;
+            /// The records which skip the queue of the others, guarded by m_DataRecordsMtx
+            BufferQ m_priorityRecords;
             std::mutex m_DataRecordsMtx;
-            std::condition_variable m_DataRecordsCv;
             std::atomic_bool m_dataReady;
             std::atomic_bool m_shutAndExit;
-            std::thread m_watcher;
+            /// The I/O threads draining the data records queue, shared by all the sinks
+            IoExecutor& m_executor;
+            /// Set (under m_DataRecordsMtx) while a batch is out for writing
+            bool m_writeInFlight;
+            /// Set (under m_DataRecordsMtx) while the records of the priority lane are out for writing
+            bool m_priorityInFlight;
+            /// Set (under m_DataRecordsMtx) once stopWatcher() has drained the queue for good
+            bool m_watcherDone;
+            /// Notified whenever a batch has been written
+            std::condition_variable m_drainedCv;
+            /// The least severe log type writeRecord() lets through
+            std::atomic<LOG_TYPE> m_levelThreshold;
+            /// The least severe log type which takes the priority lane
+            std::atomic<LOG_TYPE> m_priorityLevel;
+            /// The number of queued records which makes a batch
+            std::atomic<size_t> m_maxBatchSize;
+            /// The longest a record waits, for the sinks draining on a timer
+            std::atomic<std::chrono::milliseconds> m_maxLatency;
+            /// The longest the backlog may take to drain before records get shed, 0 for never
+            std::atomic<std::chrono::milliseconds> m_maxBacklogDelay;
+            /// The least severe log type let through under the load
+            std::atomic<LOG_TYPE> m_shedLevel;
+            std::atomic<uint64_t> m_shedCnt;
+            // The load shedding state, touched by the drain turns only, which never overlap
+            size_t m_shedStep;
+            size_t m_overloadedTurns;
+            size_t m_calmTurns;
+            /// Records written per second, smoothed over the turns
+            double m_drainRate;
+            /// How long the last backlog took to drain at m_drainRate
+            std::chrono::milliseconds m_backlogDelay;
+            size_t m_lastBacklog;
+            /// When the turn scheduled to check the load is due
+            std::chrono::steady_clock::time_point m_shedCheckDue;
 
             /**
              * @brief It is a vector of exception pointers
              * which is used to store the exceptions occurred
-             * during the data operations.
+             * during the data operations. Both the drain turns and the
+             * logging threads add to it, through addRaisedException().
              */
             std::vector<std::exception_ptr> m_excpPtrVec;
+            mutable std::mutex m_excpMtx;
 
         private:
             /**
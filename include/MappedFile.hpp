@@ -0,0 +1,169 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Declaration of the MappedFile class, a read only, memory mapped view
+ *        of a log file handing out its lines as std::string_view without copying.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string_view>
+#include <functional>
+#include <filesystem>
+#include <iterator>
+#include <cstddef>
+
+namespace logger
+{
+    class MappedFile
+    {
+        public:
+            /// Default window size of the chunked (streaming) mode
+            static constexpr size_t defaultChunkSize = 64 * 1024 * 1024;
+
+            /**
+             * @brief Forward iterator over the lines of a buffer
+             * Each line is a view into the buffer, without its new line.
+             * A last line without a new line at its end is visited as well.
+             */
+            class LineIterator
+            {
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = std::string_view;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = const std::string_view*;
+                    using reference = const std::string_view&;
+
+                    LineIterator() = default;
+                    /**
+                     * @brief Construct an iterator pointing to the first line of a buffer
+                     *
+                     * @param [in] buffer The buffer to be iterated over
+                     */
+                    explicit LineIterator(const std::string_view buffer);
+
+                    inline reference operator*() const                              { return m_line;                        }
+                    inline pointer operator->() const                               { return &m_line;                       }
+                    LineIterator& operator++();
+                    LineIterator operator++(int);
+                    inline bool operator==(const LineIterator& rhs) const           { return m_line.data() == rhs.m_line.data(); }
+
+                private:
+                    /**
+                     * @brief Point m_line to the first line of m_rest and move m_rest past it
+                     */
+                    void readLine();
+
+                    std::string_view m_rest;
+                    std::string_view m_line;
+            };
+
+            /**
+             * @brief A range of lines, usable in a range based for loop
+             */
+            class LineRange
+            {
+                public:
+                    explicit LineRange(const std::string_view buffer) : m_buffer(buffer) {}
+                    inline LineIterator begin() const                               { return LineIterator(m_buffer);        }
+                    inline LineIterator end() const                                 { return LineIterator();                }
+
+                private:
+                    std::string_view m_buffer;
+            };
+
+            /**
+             * @brief Visit all the lines of a file through a sliding mapped window
+             * Meant for files larger than the memory, as only one window of about
+             * chunkSize bytes is mapped at any point of time. A line running across
+             * two windows is visited whole, the window grows if a single line is
+             * longer than chunkSize.
+             *
+             * @param [in] file The file to be read
+             * @param [in] func Called for every line, the view is valid only during the call.
+             *                  Returning false stops the iteration.
+             * @param [in] chunkSize Size of the mapped window (rounded up to the page size)
+             * @return size_t Number of lines visited
+             *
+             * @note Throws std::runtime_error if the file can not be opened or mapped
+             */
+            static size_t forEachLine(const std::filesystem::path& file,
+                                      const std::function<bool(std::string_view)>& func,
+                                      const size_t chunkSize = defaultChunkSize);
+
+            /**
+             * @brief Construct a new MappedFile object
+             * Maps the whole file read only. An empty file gives an empty view.
+             *
+             * @param [in] file The file to be mapped
+             * @note Throws std::runtime_error if the file can not be opened or mapped
+             */
+            explicit MappedFile(const std::filesystem::path& file);
+
+            /**
+             * @brief Destroy the MappedFile object, unmapping the file
+             */
+            ~MappedFile();
+
+            /**
+             * @brief Copy is deleted, moving hands the mapping over
+             */
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+            MappedFile(MappedFile&& rhs) noexcept;
+            MappedFile& operator=(MappedFile&& rhs) noexcept;
+
+            /**
+             * @brief Get the whole content of the file
+             *
+             * @return std::string_view View of the mapping, valid as long as the object lives
+             */
+            inline std::string_view view() const                                    { return { m_mapping, m_size };         }
+            /**
+             * @brief Get the size of the mapped file
+             *
+             * @return size_t Number of bytes mapped
+             */
+            inline size_t size() const                                              { return m_size;                        }
+            /**
+             * @brief Get the lines of the file
+             *
+             * @return LineRange The lines, as views valid as long as the object lives
+             */
+            inline LineRange lines() const                                          { return LineRange(view());             }
+
+        private:
+            /**
+             * @brief Unmap the file, if mapped
+             */
+            void unmap() noexcept;
+
+            const char* m_mapping;
+            size_t m_size;
+    };
+};  //logger namespace
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,202 @@
+/**
+ * @file MmapFileOps.hpp
+ * @brief Declaration of the MmapFileOps class, a FileOps backend which writes the
+ *        log into fixed size, preallocated and memory mapped file segments.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MMAP_FILE_OPS_HPP
+#define MMAP_FILE_OPS_HPP
+
+#include "FileOps.hpp"
+
+namespace logger
+{
+    /**
+     * @brief Durability policy of a memory mapped segment
+     *
+     * Decides what is done with the dirty pages of the mapping
+     * once a batch of data records has been copied into it.
+     */
+    enum class MmapSyncPolicy
+    {
+        NONE,   ///< Leave it to the kernel to write the pages back
+        ASYNC,  ///< msync(MS_ASYNC) the range written by each batch
+        SYNC,   ///< msync(MS_SYNC) the range written by each batch, i.e. wait for it
+        RANGE   ///< sync_file_range() to start the write back of each batch (Linux only, ASYNC elsewhere)
+    };
+
+    class MmapFileOps : public FileOps
+    {
+        public:
+            /**
+             * @brief Construct a new MmapFileOps object
+             * This is a deleted constructor to prevent creating
+             * an object without specifying the segment size.
+             */
+            MmapFileOps() = delete;
+            /**
+             * @brief Construct a new MmapFileOps object
+             *
+             * @param [in] segmentSize Size of each segment, which is also the max file size
+             * @param [in] fileName Name of the file (default blank)
+             * @param [in] filePath Path where file would be placed eventually (default current path)
+             * @param [in] fileExtension Extension of the file like .txt or .log etc. (default .txt)
+             * @param [in] syncPolicy What to do with the dirty pages after each batch (default NONE)
+             *
+             * @note The segment size should be greater than the max line length
+             * allowed, which is 4096 bytes or 4KB, defined as bufferSize.
+             * @note The segment is created, preallocated and mapped lazily on the first write.
+             */
+            MmapFileOps(const std::uintmax_t segmentSize,
+                        const std::string_view fileName = "",
+                        const std::string_view filePath = "",
+                        const std::string_view fileExtension = "",
+                        const MmapSyncPolicy syncPolicy = MmapSyncPolicy::NONE);
+
+            /**
+             * @brief Destroy the MmapFileOps object
+             * Drains the data records queue into the segment and then
+             * closes it, truncating the file to its real length.
+             */
+            ~MmapFileOps();
+
+            /**
+             * @brief Copy and move constructors and assignment operators are deleted
+             */
+            MmapFileOps(const MmapFileOps&) = delete;
+            MmapFileOps& operator=(const MmapFileOps&) = delete;
+            MmapFileOps(MmapFileOps&&) = delete;
+            MmapFileOps& operator=(MmapFileOps&&) = delete;
+
+            /**
+             * @brief Set the durability policy of the segment
+             *
+             * @param [in] syncPolicy The new policy, effective from the next batch
+             * @return MmapFileOps& Refrence to the current object
+             * @note DurabilityPolicy::PER_BATCH (setDurabilityPolicy()) has each batch
+             * msync'ed with MS_SYNC, whatever this policy is
+             */
+            inline MmapFileOps& setSyncPolicy(const MmapSyncPolicy syncPolicy)  { m_syncPolicy = syncPolicy; return *this;  }
+            /**
+             * @brief Get the durability policy of the segment
+             *
+             * @return MmapSyncPolicy The current policy
+             */
+            inline MmapSyncPolicy getSyncPolicy() const                         { return m_syncPolicy;                      }
+            /**
+             * @brief Get the number of bytes written into the current segment so far
+             *
+             * @return std::uintmax_t The real length of the current segment
+             */
+            inline std::uintmax_t getWrittenSize() const                        { return m_writeOffset;                     }
+            /**
+             * @brief Get the number of segments rolled over so far by this object
+             *
+             * @return size_t The number of full segments renamed away
+             */
+            inline size_t getRolledSegmentCount() const                         { return m_rolledSegments;                  }
+            /**
+             * @brief Get the Class Id for the object
+             *
+             * @return std::string The class id of the object
+             * @see LoggingOps::getClassId()
+             */
+            inline const std::string getClassId() const override                { return "MmapFileOps";                     }
+
+            /**
+             * @brief Close the current segment
+             * Waits for everything queued so far to be written, syncs the segment
+             * as per the policy, unmaps it and truncates the file to its real length.
+             * The next batch opens the segment again and carries on from where it
+             * was left.
+             *
+             * @note As the active segment is preallocated, it carries a zero filled
+             * tail while it is open. Close it before reading it back through the
+             * FileOps read functions.
+             */
+            void closeSegment();
+
+        protected:
+            /**
+             * @brief Write data to the segment
+             * Only queues the data. Unlike FileOps there is no per write size
+             * check, as the writer rolls the segment over when it is full.
+             *
+             * @param [in] data The data to be written to the segment
+             */
+            void writeDataTo(const std::string_view data) override;
+
+            /**
+             * @brief Copy a batch of data records into the mapped segment
+             *
+             * @param [in] dataQueue The data queue to be written to the segment
+             * @param [out] excpPtr The exception pointer to be used for exception handling
+             */
+            void writeToOutStreamObject(BufferQ&& dataQueue, std::exception_ptr& excpPtr) override;
+
+        private:
+            /**
+             * @brief Open, preallocate and map the segment file
+             * If the file already holds some data then writing carries on after
+             * its last non zero byte, which also recovers a segment left
+             * preallocated by a process which died before closing it.
+             * Throws std::runtime_error on any failure.
+             */
+            void openSegment();
+
+            /**
+             * @brief Sync, unmap and truncate the segment to its real length
+             * @note The caller must hold m_segmentMtx
+             */
+            void unmapSegment();
+
+            /**
+             * @brief Close the full segment, rename it away and open a fresh one
+             * @note The caller must hold m_segmentMtx
+             */
+            void rollOverSegment();
+
+            /**
+             * @brief Apply the sync policy to a range of the mapping
+             *
+             * @param [in] start Offset of the first byte of the range
+             * @param [in] end Offset one past the last byte of the range
+             * @param [in] wait Whether to wait for the write back irrespective of the policy
+             * @throws std::runtime_error If the msync of a DurabilityPolicy::PER_BATCH
+             *         group commit fails
+             */
+            void syncRange(const std::uintmax_t start, const std::uintmax_t end, const bool wait);
+
+            int m_fd;
+            char* m_mapping;
+            std::uintmax_t m_mappedSize;
+            std::atomic<std::uintmax_t> m_writeOffset;
+            std::atomic<size_t> m_rolledSegments;
+            std::atomic<MmapSyncPolicy> m_syncPolicy;
+            std::mutex m_segmentMtx;
+    };
+};  //logger namespace
+
+#endif // MMAP_FILE_OPS_HPP
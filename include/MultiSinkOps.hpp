@@ -0,0 +1,147 @@
+/**
+ * @file MultiSinkOps.hpp
+ * @brief Declaration of the MultiSinkOps class, which fans a record formatted
+ *        once out to several sinks, each with its own queue and level threshold.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MULTI_SINK_OPS_HPP
+#define MULTI_SINK_OPS_HPP
+
+#include "LoggingOps.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <shared_mutex>
+
+namespace logger
+{
+    class MultiSinkOps : public LoggingOps
+    {
+        public:
+            /**
+             * @brief Default constructor for MultiSinkOps class
+             * Starts with no sinks. It has no queue of its own to drain, as the
+             * records go to the queues of the sinks, each drained by its own.
+             */
+            MultiSinkOps();
+
+            /**
+             * @brief Destructor for MultiSinkOps class
+             * Destroys the sinks, each of them writing out what it has queued.
+             */
+            virtual ~MultiSinkOps();
+
+            /**
+             * @brief Deleted copy constructor and move constructor
+             * to prevent copying and moving of MultiSinkOps objects
+             */
+            MultiSinkOps(const MultiSinkOps& rhs) = delete;
+            MultiSinkOps(MultiSinkOps&& rhs) = delete;
+            MultiSinkOps& operator=(const MultiSinkOps& rhs) = delete;
+            MultiSinkOps& operator=(MultiSinkOps&& rhs) = delete;
+
+            /**
+             * @brief Add a sink to fan the records out to
+             *
+             * @param [in] sink The sink, owned by this object from now on
+             * @param [in] threshold The least severe log type the sink gets,
+             *             LOG_DEFAULT for all of them
+             * @return LoggingOps& The sink added
+             * @throws std::invalid_argument If the sink is null or this object itself
+             */
+            LoggingOps& addSink(std::unique_ptr<LoggingOps> sink, const LOG_TYPE threshold = LOG_TYPE::LOG_DEFAULT);
+
+            /**
+             * @brief Get the number of sinks
+             *
+             * @return size_t The number of sinks added so far
+             */
+            size_t getSinkCount() const;
+
+            /**
+             * @brief Get a sink
+             *
+             * @param [in] idx The index of the sink, in the order they were added
+             * @return LoggingOps& The sink
+             * @throws std::out_of_range If there is no such sink
+             */
+            LoggingOps& getSink(const size_t idx) const;
+
+            using LoggingOps::writeRecord;
+
+            /**
+             * @brief write a formatted log record.
+             * Hands the record over to every sink whose level threshold it
+             * passes, after checking it against the threshold of this object.
+             *
+             * @param [in] record The record, its text and its metadata
+             */
+            void writeRecord(const LogRecord& record) override;
+
+            /**
+             * @brief Flush the queues of all the sinks
+             * @see LoggingOps::flush()
+             */
+            void flush() override;
+
+            /**
+             * @brief Flush the queues of all the sinks and wait for them
+             * @see LoggingOps::flushAndWait()
+             */
+            void flushAndWait() override;
+
+            /**
+             * @brief Make the records written so far durable, on every sink
+             * @see LoggingOps::commitCritical()
+             */
+            void commitCritical() override;
+
+            /**
+             * @brief Get the Class Id for the object
+             *
+             * @return std::string The class id of the object
+             * @see LoggingOps::getClassId()
+             */
+            inline const std::string getClassId() const override { return "MultiSinkOps"; }
+
+        protected:
+            /**
+             * @brief Write data to every sink
+             * Data written without a log type, e.g. with operator<<,
+             * is not filtered and goes to all the sinks.
+             *
+             * @param [in] data The data to be written
+             */
+            void writeDataTo(const std::string_view data) override;
+
+        private:
+            /// Guards the sinks, shared by the writers and exclusive for addSink()
+            mutable std::shared_mutex m_sinksMtx;
+            std::vector<std::unique_ptr<LoggingOps>> m_sinks;
+    };
+};  // logger namespace
+
+#endif  // MULTI_SINK_OPS_HPP
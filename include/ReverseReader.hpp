@@ -0,0 +1,133 @@
+/**
+ * @file ReverseReader.hpp
+ * @brief Declaration of the ReverseReader class, which reads a log file
+ *        backwards from its end, for its last lines or records.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef REVERSE_READER_HPP
+#define REVERSE_READER_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace logger
+{
+    class ReverseReader
+    {
+        public:
+            static constexpr size_t defaultBlockSize = 64 * 1024;
+
+            /**
+             * @brief Construct a new ReverseReader object
+             * The file is read up to its size at the time of construction.
+             *
+             * @param [in] file The file to be read
+             * @param [in] blockSize Bytes read at a time, going backwards
+             * @throw std::runtime_error If the file can't be opened
+             */
+            explicit ReverseReader(const std::filesystem::path& file, const size_t blockSize = defaultBlockSize);
+            ~ReverseReader();
+
+            ReverseReader(ReverseReader&& rhs) noexcept;
+            ReverseReader& operator=(ReverseReader&& rhs) noexcept;
+            ReverseReader(const ReverseReader&) = delete;
+            ReverseReader& operator=(const ReverseReader&) = delete;
+
+            /**
+             * @brief Read the line before the ones read so far
+             * The first call gives the last line of the file. A new line
+             * ending the file does not start another (empty) line.
+             *
+             * @param [out] line The line, without its new line
+             * @return true If there was a line, otherwise
+             * @return false If the beginning of the file has been reached
+             * @throw std::runtime_error If the file can't be read
+             */
+            bool prevLine(std::string& line);
+
+            /**
+             * @brief Read the last lines of the file
+             *
+             * @param [in] lineCnt Number of lines wanted
+             * @return std::vector<std::string> Up to lineCnt lines, in file order
+             */
+            std::vector<std::string> lastLines(const size_t lineCnt);
+
+            /**
+             * @brief Read the last records of a log file
+             * A record is a line with a log prefix (see LogLine) along with the
+             * lines following it without one, i.e. a message with new lines in it.
+             *
+             * @param [in] recordCnt Number of records wanted
+             * @return std::vector<std::string> Up to recordCnt records, in file
+             *         order, the lines of a record joined by new lines
+             */
+            std::vector<std::string> lastRecords(const size_t recordCnt);
+
+            /**
+             * @brief Read the records of a log file from a time stamp on
+             * The log being written in time order, the read stops at the
+             * first record older than the time stamp.
+             *
+             * @param [in] timestamp Oldest time stamp wanted, as the Logger formats
+             *                       it, e.g. "20250825_155051"; a shorter one such
+             *                       as "20250825_15" compares by its prefix
+             * @return std::vector<std::string> The records, in file order
+             */
+            std::vector<std::string> recordsSince(const std::string_view timestamp);
+
+            inline std::uintmax_t getFileSize() const noexcept              { return m_fileSize;    }
+            inline std::uintmax_t getBytesRead() const noexcept             { return m_bytesRead;   }
+
+        private:
+            /**
+             * @brief Read the records backwards until enough are read or the predicate says stop
+             *
+             * @param [in] maxRecords Number of records wanted at most
+             * @param [in] keepGoing Given the number of records collected and the
+             *                       parsed head line of the next one (nullptr for
+             *                       lines without a prefix at the beginning of the
+             *                       file), says if that record is wanted
+             */
+            template <typename Predicate>
+            std::vector<std::string> collectRecords(const size_t maxRecords, Predicate keepGoing);
+
+            void close() noexcept;
+
+            int m_fd;
+            size_t m_blockSize;
+            std::uintmax_t m_fileSize;
+            std::uintmax_t m_lineEnd;       // End (exclusive) of the next line to be read
+            std::uintmax_t m_blockStart;    // File offset of m_block
+            std::vector<char> m_block;      // The block last read
+            std::uintmax_t m_bytesRead;
+            bool m_done;
+    };
+};  //logger namespace
+
+#endif // REVERSE_READER_HPP
@@ -69,6 +69,11 @@ def main():
     log_file_path = os.getenv('LOG_FILE_PATH', '')
     log_file_name = os.getenv('LOG_FILE_NAME', '')
     log_file_extn = os.getenv('LOG_FILE_EXTN', '')
+    file_log_level = os.getenv('FILE_LOG_LEVEL', '').upper()
+    file_log_format = os.getenv('FILE_LOG_FORMAT', '').lower()
+    console_logging = os.getenv('CONSOLE_LOGGING', '').lower()
+    console_log_level = os.getenv('CONSOLE_LOG_LEVEL', '').upper()
+    console_stderr = os.getenv('CONSOLE_STDERR', '').lower()
 
     lines = [MIT_LICENSE, "\n#ifndef ENV_VARS_HPP\n", "#define ENV_VARS_HPP\n\n"]
 
@@ -94,6 +99,23 @@ def main():
             ext = '.' + ext
         lines.append(f'#define LOG_FILE_EXTN {quote_string(ext)}\n')
 
+    if file_log_level:
+        lines.append(f'#define FILE_LOG_LEVEL {quote_string(file_log_level)}\n')
+
+    if file_log_format == 'binary':
+        lines.append("#define FILE_LOG_FORMAT_BINARY 1\n")
+    elif file_log_format == 'json':
+        lines.append("#define FILE_LOG_FORMAT_JSON 1\n")
+
+    if console_logging == 'yes':
+        lines.append("#define CONSOLE_LOGGING 1\n")
+
+    if console_log_level:
+        lines.append(f'#define CONSOLE_LOG_LEVEL {quote_string(console_log_level)}\n')
+
+    if console_stderr == 'yes':
+        lines.append("#define CONSOLE_STDERR 1\n")
+
     lines.append("\n#endif // ENV_VARS_HPP\n")
 
     # Create include directory if it doesn't exist
@@ -0,0 +1,255 @@
+/*
+ * BatchSinkOps.cpp
+ *
+ * Implementation of the BatchSinkOps class. The records are queued with their
+ * strings copied into one arena per batch, and handed over to the LogSink as a
+ * contiguous span of LogRecord views into that arena, by the I/O executor.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "BatchSinkOps.hpp"
+
+#include <stdexcept>
+
+using namespace logger;
+
+BatchSinkOps::BatchSinkOps(std::unique_ptr<LogSink> sink,
+                           const size_t maxBatchSize,
+                           const std::chrono::milliseconds maxLatency)
+    : LoggingOps()
+    , m_sink(std::move(sink))
+    , m_pending()
+    , m_priorityPending()
+    , m_inFlight()
+    , m_records()
+    , m_fields()
+    , m_sinkFlushRequested(false)
+    , m_drainTimerDue(std::chrono::steady_clock::time_point::max())
+    , m_batchCnt(0)
+{
+    if (!m_sink)
+        throw std::invalid_argument("SINK_ERROR : A null sink can't be plugged in");
+
+    setMaxBatchSize(maxBatchSize);
+    setMaxLatency(maxLatency);
+}
+
+BatchSinkOps::~BatchSinkOps()
+{
+    // The drain turns make use of the members of this class
+    stopWatcher();
+    // Once more after the last batch
+    try
+    {
+        m_sink->flush();
+    }
+    catch(...)
+    {
+        addRaisedException(std::current_exception());
+    }
+}
+
+void BatchSinkOps::writeRecord(const LogRecord& record)
+{
+    if (record.text.empty() || !admits(record.logType))
+        return;
+
+    queueRecord(record, isPriority(record.logType));
+}
+
+void BatchSinkOps::writeDataTo(const std::string_view data)
+{
+    if (data.empty())
+        return;
+
+    LogRecord record;
+    record.timestamp = std::chrono::system_clock::now();
+    record.threadId = std::this_thread::get_id();
+    record.text = data;
+    queueRecord(record, false);
+}
+
+void BatchSinkOps::queueRecord(const LogRecord& record, const bool priority)
+{
+    std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+    auto& batch = priority ? m_priorityPending : m_pending;
+    auto& arena = batch.arena;
+    auto& entry = batch.entries.emplace_back();
+    entry.meta.logType = record.logType;
+    entry.meta.timestamp = record.timestamp;
+    entry.meta.threadId = record.threadId;
+    entry.meta.lineNo = record.lineNo;
+    entry.meta.prefixSize = record.prefixSize;
+    entry.meta.msgOffset = record.msgOffset;
+    entry.fileNameOff = arena.size();
+    arena.append(record.fileName);
+    entry.funcNameOff = arena.size();
+    arena.append(record.funcName);
+    entry.markerOff = arena.size();
+    arena.append(record.marker);
+    entry.textOff = arena.size();
+    arena.append(record.text);
+    entry.endOff = arena.size();
+    entry.fieldsOff = batch.fields.size();
+    for (const auto& field : record.fields)
+    {
+        auto& fieldEntry = batch.fields.emplace_back();
+        fieldEntry.meta.value = field.value;
+        fieldEntry.keyOff = arena.size();
+        arena.append(field.key);
+        fieldEntry.valueOff = arena.size();
+        if (auto strValue = std::get_if<std::string_view>(&field.value))
+        {
+            arena.append(*strValue);
+            fieldEntry.meta.value = std::string_view();
+        }
+        fieldEntry.endOff = arena.size();
+    }
+
+    if (priority)
+    {
+        // It does not wait for a batch to fill up
+        scheduleDrain();
+    }
+    else if (m_pending.entries.size() >= getMaxBatchSize() && !m_dataReady)
+    {
+        m_dataReady = true;
+        scheduleDrain();
+    }
+    else if (m_drainTimerDue == std::chrono::steady_clock::time_point::max())
+    {
+        // A batch not full yet goes as well once it has waited long enough,
+        // a single timer at a time, not one for each batch
+        m_drainTimerDue = std::chrono::steady_clock::now() + getMaxLatency();
+        scheduleDrainAfter(getMaxLatency());
+    }
+}
+
+void BatchSinkOps::commitCritical()
+{
+    {
+        std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+        m_sinkFlushRequested = true;
+    }
+    flushAndWait();
+}
+
+bool BatchSinkOps::isQueueEmpty() const
+{
+    return m_pending.entries.empty() && m_priorityPending.entries.empty() && !m_sinkFlushRequested;
+}
+
+bool BatchSinkOps::isPriorityQueueEmpty() const
+{
+    return m_priorityPending.entries.empty();
+}
+
+bool BatchSinkOps::drainBatch()
+{
+    bool flushSink = false;
+    {
+        std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+        flushSink = m_sinkFlushRequested;
+        // The timer is up, the records queued from now on need one of their own
+        if (std::chrono::steady_clock::now() >= m_drainTimerDue)
+            m_drainTimerDue = std::chrono::steady_clock::time_point::max();
+        std::swap(m_priorityPending, m_inFlight);
+        m_priorityInFlight = !m_inFlight.entries.empty();
+        m_writeInFlight = m_priorityInFlight || !m_pending.entries.empty() || flushSink;
+        m_dataReady = false;
+    }
+    auto backlog = m_inFlight.entries.size();
+    auto turnStart = std::chrono::steady_clock::now();
+    if (!m_inFlight.entries.empty())
+    {
+        consumeBatch(m_inFlight, false);
+        m_inFlight.clear();
+    }
+    {
+        // Whoever waits for the priority lane does not wait for the rest
+        std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+        m_priorityInFlight = false;
+        m_drainedCv.notify_all();
+        std::swap(m_pending, m_inFlight);
+        m_writeInFlight = m_writeInFlight || !m_inFlight.entries.empty();
+    }
+    backlog += m_inFlight.entries.size();
+    consumeBatch(m_inFlight, flushSink);
+    m_inFlight.clear();
+
+    bool more = false;
+    bool shedChanged = false;
+    {
+        std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+        m_writeInFlight = false;
+        if (flushSink)
+            m_sinkFlushRequested = false;
+        m_drainedCv.notify_all();
+        shedChanged = noteDrainTurn(backlog, std::chrono::steady_clock::now() - turnStart);
+        more = !isPriorityQueueEmpty() || (!isQueueEmpty() && (m_dataReady || m_shutAndExit));
+    }
+    if (shedChanged)
+        writeShedRecord();
+    return more;
+}
+
+void BatchSinkOps::consumeBatch(const Batch& batch, const bool flushSink)
+{
+    try
+    {
+        if (!batch.entries.empty())
+        {
+            std::string_view arena(batch.arena);
+            m_fields.clear();
+            m_fields.reserve(batch.fields.size());
+            for (const auto& fieldEntry : batch.fields)
+            {
+                auto& field = m_fields.emplace_back(fieldEntry.meta);
+                field.key = arena.substr(fieldEntry.keyOff, fieldEntry.valueOff - fieldEntry.keyOff);
+                if (std::holds_alternative<std::string_view>(field.value))
+                    field.value = arena.substr(fieldEntry.valueOff, fieldEntry.endOff - fieldEntry.valueOff);
+            }
+            m_records.clear();
+            m_records.reserve(batch.entries.size());
+            for (size_t idx = 0; idx < batch.entries.size(); ++idx)
+            {
+                const auto& entry = batch.entries[idx];
+                auto& record = m_records.emplace_back(entry.meta);
+                record.fileName = arena.substr(entry.fileNameOff, entry.funcNameOff - entry.fileNameOff);
+                record.funcName = arena.substr(entry.funcNameOff, entry.markerOff - entry.funcNameOff);
+                record.marker = arena.substr(entry.markerOff, entry.textOff - entry.markerOff);
+                record.text = arena.substr(entry.textOff, entry.endOff - entry.textOff);
+                auto fieldsEnd = (idx + 1 < batch.entries.size()) ? batch.entries[idx + 1].fieldsOff : m_fields.size();
+                record.fields = std::span<const LogField>(m_fields).subspan(entry.fieldsOff, fieldsEnd - entry.fieldsOff);
+            }
+            m_sink->consume(std::span<const LogRecord>(m_records));
+            ++m_batchCnt;
+        }
+        if (flushSink)
+            m_sink->flush();
+    }
+    catch(...)
+    {
+        addRaisedException(std::current_exception());
+    }
+}
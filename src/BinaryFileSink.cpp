@@ -0,0 +1,283 @@
+/*
+ * BinaryFileSink.cpp
+ *
+ * Implementation of the BinaryFileSink class. A batch is encoded into one
+ * buffer, reused from batch to batch, and appended to the file with a single
+ * write(2). The strings of a call site go to the file only the first time
+ * it shows up in a session, the records refer to it by a varint id.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "BinaryFileSink.hpp"
+#include "BinaryLogFormat.hpp"
+#include "FileOps.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace logger;
+
+namespace
+{
+    constexpr int64_t unknownUtcOffset = INT64_MIN;
+
+    /**
+     * @brief Get the offset of the local time from UTC at a point in time
+     */
+    int64_t getUtcOffset(const std::chrono::system_clock::time_point& timePoint)
+    {
+        auto timeT = std::chrono::system_clock::to_time_t(timePoint);
+        std::tm localTm = {};
+        ::localtime_r(&timeT, &localTm);
+        return localTm.tm_gmtoff;
+    }
+
+    int64_t toMicroseconds(const std::chrono::system_clock::time_point& timePoint)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(timePoint.time_since_epoch()).count();
+    }
+};
+
+BinaryFileSink::BinaryFileSink(const std::filesystem::path& file, const std::string_view timeFormat)
+    : m_file(file)
+    , m_timeFormat(timeFormat)
+    , m_fd(-1)
+    , m_buffer()
+    , m_callSites()
+    , m_callSiteKey()
+    , m_threads()
+    , m_keys()
+    , m_keyScratch()
+    , m_keyIds()
+    , m_lastTimestamp(0)
+    , m_utcOffset(unknownUtcOffset)
+    , m_bytesWritten(0)
+{
+    m_fd = ::open(m_file.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (m_fd < 0)
+        throw std::runtime_error("BINARY_LOG_ERROR : File " + m_file.string() + " can't be opened: " + std::strerror(errno));
+
+    // Appending to a former session is fine, to a text log it is not
+    std::array<char, BinaryLogFormat::magic.size()> fileMagic = {};
+    auto readCnt = ::pread(m_fd, fileMagic.data(), fileMagic.size(), 0);
+    if (readCnt > 0 && (static_cast<size_t>(readCnt) != fileMagic.size() || fileMagic != BinaryLogFormat::magic))
+    {
+        ::close(m_fd);
+        throw std::runtime_error("BINARY_LOG_ERROR : File " + m_file.string() + " is not a binary log");
+    }
+
+    if (readCnt == 0)
+        m_buffer.append(BinaryLogFormat::magic.data(), BinaryLogFormat::magic.size());
+    startSession();
+    try
+    {
+        writeBuffer();
+    }
+    catch(...)
+    {
+        ::close(m_fd);
+        throw;
+    }
+}
+
+BinaryFileSink::~BinaryFileSink()
+{
+    ::close(m_fd);
+}
+
+void BinaryFileSink::consume(std::span<const LogRecord> records)
+{
+    if (records.empty())
+        return;
+
+    // A batch spans a few milliseconds, the offset gets checked once per batch
+    auto utcOffset = getUtcOffset(records.front().timestamp);
+    if (utcOffset != m_utcOffset)
+    {
+        m_buffer.push_back(static_cast<char>(BinaryLogFormat::Tag::UTC_OFFSET));
+        BinaryLogFormat::putSignedVarint(m_buffer, utcOffset);
+        m_utcOffset = utcOffset;
+    }
+
+    for (const auto& record : records)
+        encodeRecord(record);
+
+    writeBuffer();
+}
+
+void BinaryFileSink::flush()
+{
+    if (::fdatasync(m_fd) != 0)
+        throw std::runtime_error("BINARY_LOG_ERROR : File " + m_file.string() + " can't be synced: " + std::strerror(errno));
+}
+
+void BinaryFileSink::encodeRecord(const LogRecord& record)
+{
+    // Only a record rendered by the Logger can have its prefix rendered again
+    auto hasCallSite = record.hasCallSite();
+    uint64_t callSiteId = 0;
+    if (hasCallSite)
+        callSiteId = getCallSiteId(record, record.text.substr(record.prefixSize, record.msgOffset - record.prefixSize));
+    auto threadId = getThreadId(record.threadId);
+    if (!record.fields.empty())
+        encodeFields(record.fields);
+
+    auto timestamp = toMicroseconds(record.timestamp);
+    auto timeDelta = timestamp - m_lastTimestamp;
+    m_lastTimestamp = timestamp;
+
+    if (hasCallSite)
+    {
+        m_buffer.push_back(static_cast<char>(BinaryLogFormat::Tag::RECORD));
+        BinaryLogFormat::putSignedVarint(m_buffer, timeDelta);
+        BinaryLogFormat::putVarint(m_buffer, callSiteId);
+        m_buffer.push_back(static_cast<char>(record.logType));
+        BinaryLogFormat::putVarint(m_buffer, threadId);
+        BinaryLogFormat::putString(m_buffer, record.text.substr(record.msgOffset));
+    }
+    else
+    {
+        m_buffer.push_back(static_cast<char>(BinaryLogFormat::Tag::TEXT));
+        BinaryLogFormat::putSignedVarint(m_buffer, timeDelta);
+        m_buffer.push_back(static_cast<char>(record.logType));
+        BinaryLogFormat::putVarint(m_buffer, threadId);
+        BinaryLogFormat::putString(m_buffer, record.text);
+    }
+}
+
+uint64_t BinaryFileSink::getCallSiteId(const LogRecord& record, const std::string_view context)
+{
+    m_callSiteKey.clear();
+    BinaryLogFormat::putVarint(m_callSiteKey, record.lineNo);
+    BinaryLogFormat::putString(m_callSiteKey, record.getBaseFileName());
+    BinaryLogFormat::putString(m_callSiteKey, record.funcName);
+    BinaryLogFormat::putString(m_callSiteKey, record.marker);
+    BinaryLogFormat::putString(m_callSiteKey, context);
+    auto itr = m_callSites.find(m_callSiteKey);
+    if (itr != m_callSites.end())
+        return itr->second;
+
+    // The key happens to be the frame's payload, after the id
+    auto callSiteId = static_cast<uint64_t>(m_callSites.size());
+    m_callSites.emplace(m_callSiteKey, callSiteId);
+    m_buffer.push_back(static_cast<char>(BinaryLogFormat::Tag::CALL_SITE));
+    BinaryLogFormat::putVarint(m_buffer, callSiteId);
+    m_buffer.append(m_callSiteKey);
+    return callSiteId;
+}
+
+uint64_t BinaryFileSink::getThreadId(const std::thread::id& threadId)
+{
+    auto itr = m_threads.find(threadId);
+    if (itr != m_threads.end())
+        return itr->second;
+
+    auto id = static_cast<uint64_t>(m_threads.size());
+    m_threads.emplace(threadId, id);
+    m_buffer.push_back(static_cast<char>(BinaryLogFormat::Tag::THREAD));
+    BinaryLogFormat::putVarint(m_buffer, id);
+    BinaryLogFormat::putString(m_buffer, LogRecord::getThreadIdText(threadId));
+    return id;
+}
+
+uint64_t BinaryFileSink::getKeyId(const std::string_view key)
+{
+    m_keyScratch.assign(key);
+    auto itr = m_keys.find(m_keyScratch);
+    if (itr != m_keys.end())
+        return itr->second;
+
+    auto id = static_cast<uint64_t>(m_keys.size());
+    m_keys.emplace(m_keyScratch, id);
+    m_buffer.push_back(static_cast<char>(BinaryLogFormat::Tag::KEY));
+    BinaryLogFormat::putVarint(m_buffer, id);
+    BinaryLogFormat::putString(m_buffer, key);
+    return id;
+}
+
+void BinaryFileSink::encodeFields(const std::span<const LogField> fields)
+{
+    // The key dictionary frames have to come first
+    m_keyIds.clear();
+    for (const auto& field : fields)
+        m_keyIds.push_back(getKeyId(field.key));
+
+    m_buffer.push_back(static_cast<char>(BinaryLogFormat::Tag::FIELDS));
+    BinaryLogFormat::putVarint(m_buffer, fields.size());
+    for (size_t idx = 0; idx < fields.size(); ++idx)
+    {
+        const auto& field = fields[idx];
+        BinaryLogFormat::putVarint(m_buffer, m_keyIds[idx]);
+        m_buffer.push_back(static_cast<char>(field.getType()));
+        switch (field.getType())
+        {
+            case LogField::Type::BOOL:
+                m_buffer.push_back(std::get<bool>(field.value) ? 1 : 0);
+                break;
+            case LogField::Type::INT:
+                BinaryLogFormat::putSignedVarint(m_buffer, std::get<int64_t>(field.value));
+                break;
+            case LogField::Type::UINT:
+                BinaryLogFormat::putVarint(m_buffer, std::get<uint64_t>(field.value));
+                break;
+            case LogField::Type::DOUBLE:
+                BinaryLogFormat::putDouble(m_buffer, std::get<double>(field.value));
+                break;
+            case LogField::Type::STRING:
+                BinaryLogFormat::putString(m_buffer, std::get<std::string_view>(field.value));
+                break;
+        }
+    }
+}
+
+void BinaryFileSink::startSession()
+{
+    m_callSites.clear();
+    m_threads.clear();
+    m_keys.clear();
+    m_lastTimestamp = 0;
+    m_utcOffset = unknownUtcOffset;
+    m_buffer.push_back(static_cast<char>(BinaryLogFormat::Tag::SESSION));
+    BinaryLogFormat::putString(m_buffer, m_timeFormat);
+}
+
+void BinaryFileSink::writeBuffer()
+{
+    auto written = FileOps::writeAll(m_fd, m_buffer);
+    m_bytesWritten += written;
+    if (written < m_buffer.size())
+    {
+        auto errNo = errno;
+        // The dictionary frames of this batch may not have made it,
+        // the next batch starts over with a session of its own
+        m_buffer.clear();
+        startSession();
+        throw std::runtime_error("BINARY_LOG_ERROR : File " + m_file.string() + " can't be written: " + std::strerror(errNo));
+    }
+    m_buffer.clear();
+}
@@ -0,0 +1,392 @@
+/*
+ * BinaryLogDecoder.cpp
+ *
+ * Implementation of the BinaryLogDecoder class. The dictionaries of a session
+ * are kept as views into the mapped file, and each record is rendered in the
+ * layout of Logger::constructLogMsgPrefix() followed by its context and message.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "BinaryLogDecoder.hpp"
+#include "BinaryLogFormat.hpp"
+#include "MappedFile.hpp"
+#include "Logger.hpp"
+
+#include <array>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief A call site, as in the dictionary
+     */
+    struct CallSite
+    {
+        uint64_t lineNo;
+        std::string_view fileName;
+        std::string_view funcName;
+        std::string_view marker;
+        std::string_view context;
+    };
+
+    /**
+     * @brief Decodes the frames of a binary log and renders its records
+     */
+    class FrameDecoder
+    {
+        public:
+            explicit FrameDecoder(const std::function<bool(std::string_view)>& func)
+                : m_func(func)
+                , m_utcOffset(0)
+                , m_lastTimestamp(0)
+                , m_renderedSecond(-1)
+                , m_lineCnt(0)
+            {}
+
+            size_t decode(std::string_view data)
+            {
+                if (data.size() < BinaryLogFormat::magic.size() ||
+                    std::memcmp(data.data(), BinaryLogFormat::magic.data(), BinaryLogFormat::magic.size()) != 0)
+                    throw std::runtime_error("DECODING_ERROR : Not a binary log");
+
+                data.remove_prefix(BinaryLogFormat::magic.size());
+                while (!data.empty())
+                {
+                    auto tag = static_cast<BinaryLogFormat::Tag>(data.front());
+                    data.remove_prefix(1);
+                    auto keepGoing = true;
+                    if (!decodeFrame(tag, data, keepGoing))
+                        break;  // Cut short, nothing more to come
+                    if (!keepGoing)
+                        break;
+                }
+                return m_lineCnt;
+            }
+
+        private:
+            /**
+             * @brief Decode the frame of a tag, false if it is cut short
+             */
+            bool decodeFrame(const BinaryLogFormat::Tag tag, std::string_view& data, bool& keepGoing)
+            {
+                switch (tag)
+                {
+                    case BinaryLogFormat::Tag::SESSION:
+                    {
+                        std::string_view timeFormat;
+                        if (!BinaryLogFormat::getString(data, timeFormat))
+                            return false;
+
+                        m_timeFormat = timeFormat;
+                        m_callSites.clear();
+                        m_threads.clear();
+                        m_keys.clear();
+                        m_fields.clear();
+                        m_utcOffset = 0;
+                        m_lastTimestamp = 0;
+                        m_renderedSecond = -1;
+                        return true;
+                    }
+                    case BinaryLogFormat::Tag::UTC_OFFSET:
+                        m_renderedSecond = -1;
+                        return BinaryLogFormat::getSignedVarint(data, m_utcOffset);
+                    case BinaryLogFormat::Tag::CALL_SITE:
+                    {
+                        uint64_t id = 0;
+                        CallSite callSite = {};
+                        if (!BinaryLogFormat::getVarint(data, id) ||
+                            !BinaryLogFormat::getVarint(data, callSite.lineNo) ||
+                            !BinaryLogFormat::getString(data, callSite.fileName) ||
+                            !BinaryLogFormat::getString(data, callSite.funcName) ||
+                            !BinaryLogFormat::getString(data, callSite.marker) ||
+                            !BinaryLogFormat::getString(data, callSite.context))
+                            return false;
+
+                        if (id != m_callSites.size())
+                            throw std::runtime_error("DECODING_ERROR : Call site " + std::to_string(id) + " out of order");
+                        m_callSites.push_back(callSite);
+                        return true;
+                    }
+                    case BinaryLogFormat::Tag::THREAD:
+                    {
+                        uint64_t id = 0;
+                        std::string_view threadId;
+                        if (!BinaryLogFormat::getVarint(data, id) || !BinaryLogFormat::getString(data, threadId))
+                            return false;
+
+                        if (id != m_threads.size())
+                            throw std::runtime_error("DECODING_ERROR : Thread " + std::to_string(id) + " out of order");
+                        m_threads.push_back(threadId);
+                        return true;
+                    }
+                    case BinaryLogFormat::Tag::RECORD:
+                    {
+                        int64_t timeDelta = 0;
+                        uint64_t callSiteId = 0;
+                        uint64_t threadId = 0;
+                        std::string_view message;
+                        if (!BinaryLogFormat::getSignedVarint(data, timeDelta) ||
+                            !BinaryLogFormat::getVarint(data, callSiteId) ||
+                            data.empty())
+                            return false;
+
+                        auto logType = static_cast<LOG_TYPE>(static_cast<uint8_t>(data.front()));
+                        data.remove_prefix(1);
+                        if (!BinaryLogFormat::getVarint(data, threadId) || !BinaryLogFormat::getString(data, message))
+                            return false;
+
+                        if (callSiteId >= m_callSites.size())
+                            throw std::runtime_error("DECODING_ERROR : Unknown call site " + std::to_string(callSiteId));
+                        m_lastTimestamp += timeDelta;
+                        renderRecord(m_callSites[callSiteId], logType, getThread(threadId), message);
+                        LogField::appendText(m_line, m_fields);
+                        m_fields.clear();
+                        keepGoing = visit(m_line);
+                        return true;
+                    }
+                    case BinaryLogFormat::Tag::TEXT:
+                    {
+                        int64_t timeDelta = 0;
+                        uint64_t threadId = 0;
+                        std::string_view text;
+                        if (!BinaryLogFormat::getSignedVarint(data, timeDelta) || data.size() < 1)
+                            return false;
+
+                        data.remove_prefix(1);  // The log type, the text has it already if any
+                        if (!BinaryLogFormat::getVarint(data, threadId) || !BinaryLogFormat::getString(data, text))
+                            return false;
+
+                        getThread(threadId);
+                        m_lastTimestamp += timeDelta;
+                        if (!m_fields.empty())
+                        {
+                            m_line.assign(text);
+                            LogField::appendText(m_line, m_fields);
+                            m_fields.clear();
+                            text = m_line;
+                        }
+                        keepGoing = visit(text);
+                        return true;
+                    }
+                    case BinaryLogFormat::Tag::KEY:
+                    {
+                        uint64_t id = 0;
+                        std::string_view key;
+                        if (!BinaryLogFormat::getVarint(data, id) || !BinaryLogFormat::getString(data, key))
+                            return false;
+
+                        if (id != m_keys.size())
+                            throw std::runtime_error("DECODING_ERROR : Key " + std::to_string(id) + " out of order");
+                        m_keys.push_back(key);
+                        return true;
+                    }
+                    case BinaryLogFormat::Tag::FIELDS:
+                        return decodeFields(data);
+                }
+                throw std::runtime_error("DECODING_ERROR : Unknown frame tag " + std::to_string(static_cast<int>(tag)));
+            }
+
+            /**
+             * @brief Decode the fields of the record to come, false if it is cut short
+             */
+            bool decodeFields(std::string_view& data)
+            {
+                uint64_t count = 0;
+                if (!BinaryLogFormat::getVarint(data, count))
+                    return false;
+
+                m_fields.clear();
+                for (uint64_t idx = 0; idx < count; ++idx)
+                {
+                    uint64_t keyId = 0;
+                    if (!BinaryLogFormat::getVarint(data, keyId) || data.empty())
+                        return false;
+
+                    if (keyId >= m_keys.size())
+                        throw std::runtime_error("DECODING_ERROR : Unknown key " + std::to_string(keyId));
+                    auto& field = m_fields.emplace_back();
+                    field.key = m_keys[keyId];
+                    auto type = static_cast<LogField::Type>(data.front());
+                    data.remove_prefix(1);
+                    switch (type)
+                    {
+                        case LogField::Type::BOOL:
+                        {
+                            if (data.empty())
+                                return false;
+                            field.value = (data.front() != 0);
+                            data.remove_prefix(1);
+                            break;
+                        }
+                        case LogField::Type::INT:
+                        {
+                            int64_t value = 0;
+                            if (!BinaryLogFormat::getSignedVarint(data, value))
+                                return false;
+                            field.value = value;
+                            break;
+                        }
+                        case LogField::Type::UINT:
+                        {
+                            uint64_t value = 0;
+                            if (!BinaryLogFormat::getVarint(data, value))
+                                return false;
+                            field.value = value;
+                            break;
+                        }
+                        case LogField::Type::DOUBLE:
+                        {
+                            double value = 0;
+                            if (!BinaryLogFormat::getDouble(data, value))
+                                return false;
+                            field.value = value;
+                            break;
+                        }
+                        case LogField::Type::STRING:
+                        {
+                            std::string_view value;
+                            if (!BinaryLogFormat::getString(data, value))
+                                return false;
+                            field.value = value;
+                            break;
+                        }
+                        default:
+                            throw std::runtime_error("DECODING_ERROR : Unknown field type " + std::to_string(static_cast<int>(type)));
+                    }
+                }
+                return true;
+            }
+
+            std::string_view getThread(const uint64_t id) const
+            {
+                if (id >= m_threads.size())
+                    throw std::runtime_error("DECODING_ERROR : Unknown thread " + std::to_string(id));
+                return m_threads[id];
+            }
+
+            bool visit(const std::string_view line)
+            {
+                ++m_lineCnt;
+                return m_func(line);
+            }
+
+            /**
+             * @brief Append a field padded with spaces up to a width, as std::setw does
+             */
+            static void appendPadded(std::string& line, const std::string_view field, const size_t width, const bool leftAligned)
+            {
+                auto padding = (field.size() < width) ? width - field.size() : 0;
+                if (!leftAligned)
+                    line.append(padding, ' ');
+                line.append(field);
+                if (leftAligned)
+                    line.append(padding, ' ');
+            }
+
+            /**
+             * @brief Render the time stamp of the current record, once per second
+             */
+            const std::string& getTimeStr()
+            {
+                // Floor division, for the time stamps before the epoch
+                auto second = m_lastTimestamp / 1000000 - (m_lastTimestamp % 1000000 < 0 ? 1 : 0);
+                if (second != m_renderedSecond)
+                {
+                    auto timeT = static_cast<std::time_t>(second + m_utcOffset);
+                    std::tm localTm = {};
+                    ::gmtime_r(&timeT, &localTm);
+                    std::array<char, 80> buffer = {};
+                    std::strftime(buffer.data(), buffer.size(), m_timeFormat.c_str(), &localTm);
+                    m_timeStr = buffer.data();
+                    m_renderedSecond = second;
+                }
+                return m_timeStr;
+            }
+
+            /**
+             * @brief Render a record the way Logger::constructLogMsgPrefix() and vlog() do
+             */
+            void renderRecord(const CallSite& callSite, const LOG_TYPE logType,
+                              const std::string_view threadId, const std::string_view message)
+            {
+                m_line.clear();
+                m_line.append(FIELD_SEPARATOR).append(getTimeStr());
+                m_line.append(FIELD_SEPARATOR).append(ONE_SPACE);
+                appendPadded(m_line, threadId, 10, false);
+                m_line.append(FIELD_SEPARATOR).append(ONE_SPACE);
+                appendPadded(m_line, callSite.fileName, 20, true);
+                m_line.append(FIELD_SEPARATOR).append(ONE_SPACE);
+                appendPadded(m_line, std::to_string(callSite.lineNo), 4, false);
+                m_line.append(FIELD_SEPARATOR);
+                auto logTypeStr = Logger::covertLogTypeEnumToString(logType);
+                m_line.append(logTypeStr).append(callSite.marker);
+                static const auto maxLogTypeSize = Logger::covertLogTypeEnumToString(LOG_TYPE::LOG_ASSERT).size();
+                for (auto size = logTypeStr.size() + callSite.marker.size(); size < maxLogTypeSize + 1; ++size)
+                    m_line.append(ONE_SPACE);
+                m_line.append(ONE_SPACE);
+                m_line.append(callSite.context).append(message);
+            }
+
+            const std::function<bool(std::string_view)>& m_func;
+            std::string m_timeFormat;
+            std::vector<CallSite> m_callSites;
+            std::vector<std::string_view> m_threads;
+            std::vector<std::string_view> m_keys;
+            /// The fields of the record to come
+            std::vector<LogField> m_fields;
+            int64_t m_utcOffset;
+            int64_t m_lastTimestamp;
+            int64_t m_renderedSecond;
+            std::string m_timeStr;
+            std::string m_line;
+            size_t m_lineCnt;
+    };
+};
+
+/*static*/ bool BinaryLogDecoder::isBinaryLog(const std::filesystem::path& file)
+{
+    std::ifstream ifile(file, std::ios::binary);
+    std::array<char, BinaryLogFormat::magic.size()> fileMagic = {};
+    return ifile.read(fileMagic.data(), fileMagic.size()) && fileMagic == BinaryLogFormat::magic;
+}
+
+/*static*/ size_t BinaryLogDecoder::forEachLine(const std::filesystem::path& file,
+                                                const std::function<bool(std::string_view)>& func)
+{
+    MappedFile mappedFile(file);
+    return forEachLineInBuffer(mappedFile.view(), func);
+}
+
+/*static*/ size_t BinaryLogDecoder::forEachLineInBuffer(std::string_view data,
+                                                        const std::function<bool(std::string_view)>& func)
+{
+    FrameDecoder decoder(func);
+    return decoder.decode(data);
+}
@@ -108,7 +108,13 @@ std::string Clock::getGmtTimeStr(const std::string_view format) const
 
 std::string Clock::getLocalTimeStr(const std::string_view format) const
 {
-    auto nowTimeT = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    return getLocalTimeStr(std::chrono::system_clock::now(), format);
+}
+
+std::string Clock::getLocalTimeStr(const std::chrono::system_clock::time_point& timePoint,
+                                   const std::string_view format) const
+{
+    auto nowTimeT = std::chrono::system_clock::to_time_t(timePoint);
     auto localTimeT = std::localtime(&nowTimeT);
     std::array<char, 80> buffer;
     std::strftime(buffer.data(), sizeof(buffer), 
@@ -0,0 +1,254 @@
+/*
+ * CoalescingOps.cpp
+ *
+ * Implementation of the CoalescingOps class. The records are told apart by a
+ * hash rolled over their call site and rendered message, never by comparing
+ * the strings, so that a storm of repeats costs a hash and a counter each.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "CoalescingOps.hpp"
+
+#include <string>
+#include <variant>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace logger;
+
+namespace
+{
+    constexpr uint64_t fnvOffsetBasis = 14695981039346656037ULL;
+    constexpr uint64_t fnvPrime = 1099511628211ULL;
+
+    /**
+     * @brief Roll a FNV-1a hash over some bytes
+     */
+    inline uint64_t hashBytes(uint64_t hash, const void* data, const size_t len) noexcept
+    {
+        auto bytes = static_cast<const unsigned char*>(data);
+        for (size_t idx = 0; idx < len; ++idx)
+        {
+            hash ^= bytes[idx];
+            hash *= fnvPrime;
+        }
+        return hash;
+    }
+
+    inline uint64_t hashString(const uint64_t hash, const std::string_view str) noexcept
+    {
+        // The size along, so that "ab" + "c" and "a" + "bc" differ
+        auto size = str.size();
+        return hashBytes(hashBytes(hash, &size, sizeof(size)), str.data(), str.size());
+    }
+};
+
+CoalescingOps::CoalescingOps(std::unique_ptr<LoggingOps> sink, const std::chrono::milliseconds window)
+    : LoggingOps()
+    , m_pSink(std::move(sink))
+    , m_window(window)
+    , m_collapsedCnt(0)
+    , m_runMtx()
+    , m_lastHash(0)
+    , m_runStart()
+    , m_repeatCnt(0)
+    , m_repeatDue(std::chrono::steady_clock::time_point::max())
+    , m_repeatLogType(LOG_TYPE::LOG_DEFAULT)
+    , m_repeatTimestamp()
+    , m_repeatThreadId()
+    , m_repeatLineNo(0)
+    , m_repeatPrefixSize(0)
+{
+    if (!m_pSink)
+        throw std::invalid_argument("SINK_ERROR : A null sink can't be wrapped");
+}
+
+CoalescingOps::~CoalescingOps()
+{
+    // The drain turns make use of the members of this class
+    stopWatcher();
+    {
+        std::scoped_lock<std::mutex> runLock(m_runMtx);
+        writeRepeatRecord();
+    }
+    m_pSink.reset();
+}
+
+/*static*/ uint64_t CoalescingOps::hashRecord(const LogRecord& record) noexcept
+{
+    auto hash = hashString(fnvOffsetBasis, record.fileName);
+    hash = hashBytes(hash, &record.lineNo, sizeof(record.lineNo));
+    hash = hashBytes(hash, &record.logType, sizeof(record.logType));
+    // Past the time stamp and the thread id, the class, the function and the message
+    hash = hashString(hash, record.text.substr(std::min(record.prefixSize, record.text.size())));
+    for (const auto& field : record.fields)
+    {
+        hash = hashString(hash, field.key);
+        auto type = field.getType();
+        hash = hashBytes(hash, &type, sizeof(type));
+        std::visit([&hash](const auto& value)
+        {
+            if constexpr (std::is_same_v<std::decay_t<decltype(value)>, std::string_view>)
+                hash = hashString(hash, value);
+            else
+                hash = hashBytes(hash, &value, sizeof(value));
+        }, field.value);
+    }
+    return hash;
+}
+
+void CoalescingOps::writeRecord(const LogRecord& record)
+{
+    if (record.text.empty() || !isLogTypeAtLeast(record.logType, getLevelThreshold()))
+        return;
+
+    auto window = m_window.load();
+    // The critical ones are never collapsed, each of them is to reach the
+    // sink, and be waited for, before a crash can take the count along
+    auto collapsible = (window.count() > 0) && !isCriticalLogType(record.logType);
+    // Hashed by the caller, only the hash of the run is kept
+    auto hash = collapsible ? hashRecord(record) : 0;
+    auto now = std::chrono::steady_clock::now();
+
+    std::scoped_lock<std::mutex> runLock(m_runMtx);
+    if (collapsible && hash == m_lastHash && now - m_runStart <= window)
+    {
+        if (m_repeatCnt++ == 0)
+        {
+            // The call site is the one of the run, copied once
+            m_repeatLogType = record.logType;
+            m_repeatFileName = record.fileName;
+            m_repeatFuncName = record.funcName;
+            m_repeatLineNo = record.lineNo;
+            m_repeatMarker = record.marker;
+            // The run may well be over with no record coming to tell, a timer does
+            armRepeatTurn(now);
+        }
+        // The repeat record carries the time stamp and the thread of the last repeat
+        m_repeatTimestamp = record.timestamp;
+        m_repeatThreadId = record.threadId;
+        auto msgOffset = std::min(record.msgOffset, record.text.size());
+        m_repeatPrefix.assign(record.text.data(), msgOffset);
+        m_repeatPrefixSize = std::min(record.prefixSize, msgOffset);
+        ++m_collapsedCnt;
+        return;
+    }
+
+    writeRepeatRecord();
+    m_lastHash = hash;
+    m_runStart = now;
+    m_pSink->writeRecord(record);
+}
+
+void CoalescingOps::writeDataTo(const std::string_view data)
+{
+    if (data.empty())
+        return;
+
+    std::scoped_lock<std::mutex> runLock(m_runMtx);
+    writeRepeatRecord();
+    m_lastHash = 0;
+    m_pSink->write(data);
+}
+
+void CoalescingOps::armRepeatTurn(const std::chrono::steady_clock::time_point now)
+{
+    if (m_repeatDue != std::chrono::steady_clock::time_point::max())
+        return;
+
+    m_repeatDue = m_runStart + m_window.load();
+    std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+    scheduleDrainAfter(m_repeatDue - now);
+}
+
+bool CoalescingOps::drainBatch()
+{
+    bool shutAndExit = false;
+    {
+        std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+        shutAndExit = m_shutAndExit;
+        m_dataReady = false;
+    }
+
+    std::scoped_lock<std::mutex> runLock(m_runMtx);
+    auto now = std::chrono::steady_clock::now();
+    if (now >= m_repeatDue)
+        m_repeatDue = std::chrono::steady_clock::time_point::max();     // It has fired
+    if (m_repeatCnt > 0)
+    {
+        if (shutAndExit || now >= m_runStart + m_window.load())
+            writeRepeatRecord();
+        else
+            armRepeatTurn(now);
+    }
+    return false;
+}
+
+void CoalescingOps::writeRepeatRecord()
+{
+    if (m_repeatCnt == 0)
+        return;
+
+    auto msgOffset = m_repeatPrefix.size();
+    m_repeatPrefix += "last message repeated ";
+    m_repeatPrefix += std::to_string(m_repeatCnt);
+    m_repeatPrefix += " times";
+    LogRecord record;
+    record.logType = m_repeatLogType;
+    record.timestamp = m_repeatTimestamp;
+    record.threadId = m_repeatThreadId;
+    record.fileName = m_repeatFileName;
+    record.funcName = m_repeatFuncName;
+    record.lineNo = m_repeatLineNo;
+    record.marker = m_repeatMarker;
+    record.text = m_repeatPrefix;
+    record.prefixSize = m_repeatPrefixSize;
+    record.msgOffset = msgOffset;
+    m_repeatCnt = 0;
+    m_pSink->writeRecord(record);
+}
+
+void CoalescingOps::flush()
+{
+    {
+        std::scoped_lock<std::mutex> runLock(m_runMtx);
+        writeRepeatRecord();
+    }
+    m_pSink->flush();
+}
+
+void CoalescingOps::flushAndWait()
+{
+    {
+        std::scoped_lock<std::mutex> runLock(m_runMtx);
+        writeRepeatRecord();
+    }
+    m_pSink->flushAndWait();
+}
+
+void CoalescingOps::commitCritical()
+{
+    // The records are with the sink already, the repeat count pending not
+    m_pSink->commitCritical();
+}
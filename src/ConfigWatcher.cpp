@@ -0,0 +1,188 @@
+/*
+ * ConfigWatcher.cpp
+ *
+ * Implementation of the ConfigWatcher class. The directory of the config file
+ * is watched by a DirWatch, which also catches the editors that write a new
+ * file and rename it over the old one; without inotify, and as a safety net,
+ * the file is looked at every poll period. The SIGHUP handler only writes to
+ * the wakeup pipe, the reload itself is done by the watcher thread.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "ConfigWatcher.hpp"
+#include "LoggerRegistry.hpp"
+#include "Logger.hpp"
+
+#include <cerrno>
+#include <csignal>
+
+#include <unistd.h>
+
+using namespace logger;
+
+namespace
+{
+    /// The write end of the wakeup pipe of the watcher handling SIGHUP, -1 if none
+    std::atomic<int> sighupPipeFd{-1};
+    struct sigaction prevSighupAction = {};
+
+    extern "C" void onSighup(int)
+    {
+        auto savedErrno = errno;
+        auto fd = sighupPipeFd.load();
+        if (fd >= 0)
+        {
+            char wakeup = 'H';
+            [[maybe_unused]] auto retVal = ::write(fd, &wakeup, sizeof(wakeup));
+        }
+        errno = savedErrno;
+    }
+};
+
+ConfigWatcher::ConfigWatcher(LoggingOps& ops,
+                             const std::filesystem::path& configFile,
+                             const bool watchFile,
+                             const bool onSighup,
+                             LoggerRegistry* registry,
+                             const std::chrono::milliseconds pollPeriod)
+    : m_ops(ops)
+    , m_configFile(configFile)
+    , m_watchFile(watchFile)
+    , m_onSighup(onSighup)
+    , m_registry(registry)
+    , m_pollPeriod(pollPeriod)
+    , m_lastWriteTime()
+    , m_lastSize(0)
+    , m_dirWatch()
+    , m_reloadCnt(0)
+    , m_running(false)
+{
+}
+
+ConfigWatcher::~ConfigWatcher()
+{
+    stop();
+}
+
+bool ConfigWatcher::start()
+{
+    if (m_running)
+        return false;
+
+    if (m_watchFile)
+        isModified();   // Where it is at now, changes are looked for from here on
+    if (!(m_watchFile ? m_dirWatch.open(m_configFile, DirWatchEvents::WRITTEN) : m_dirWatch.open()))
+        return false;
+
+    if (m_onSighup)
+    {
+        auto noFd = -1;
+        if (!sighupPipeFd.compare_exchange_strong(noFd, m_dirWatch.getWakeupFd()))
+        {
+            m_dirWatch.close();
+            return false;   // Another one handles it
+        }
+
+        struct sigaction action = {};
+        action.sa_handler = onSighup;
+        ::sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        ::sigaction(SIGHUP, &action, &prevSighupAction);
+    }
+
+    m_running = true;
+    m_watchThread = std::thread(&ConfigWatcher::watch, this);
+    return true;
+}
+
+void ConfigWatcher::stop()
+{
+    if (!m_running)
+        return;
+
+    if (m_onSighup)
+    {
+        ::sigaction(SIGHUP, &prevSighupAction, nullptr);
+        sighupPipeFd = -1;
+    }
+
+    m_running = false;
+    m_dirWatch.wakeup();
+    if (m_watchThread.joinable())
+        m_watchThread.join();
+    m_dirWatch.close();
+}
+
+void ConfigWatcher::reload()
+{
+    auto config = LoggerConfig::load(m_configFile);
+    Logger::applySettings(m_ops, config);
+    (m_registry ? *m_registry : LoggerRegistry::getShared()).applyLevels(config.loggerLevels);
+    ++m_reloadCnt;
+}
+
+void ConfigWatcher::watch()
+{
+    while (m_running)
+    {
+        if (!waitForChange() || !m_running)
+            continue;
+
+        try
+        {
+            reload();
+        }
+        catch(...)
+        {
+            // Left with the former settings, till the next change
+        }
+    }
+}
+
+bool ConfigWatcher::waitForChange()
+{
+    auto result = m_dirWatch.wait(m_watchFile ? m_pollPeriod : std::chrono::milliseconds(-1));
+    if (result.timedOut)
+        return m_watchFile && isModified();  // The safety net
+
+    auto reloadDue = (result.wakeups.find('H') != std::string::npos) || result.fileChanged;
+    if (result.fileChanged)
+        isModified();   // Keep the safety net from reloading it once more
+    return reloadDue;
+}
+
+bool ConfigWatcher::isModified()
+{
+    std::error_code ec;
+    auto writeTime = std::filesystem::last_write_time(m_configFile, ec);
+    if (ec)
+        return false;   // Not there, e.g. in the middle of being replaced
+    auto size = std::filesystem::file_size(m_configFile, ec);
+    if (ec)
+        return false;
+
+    auto modified = (writeTime != m_lastWriteTime) || (size != m_lastSize);
+    m_lastWriteTime = writeTime;
+    m_lastSize = size;
+    return modified;
+}
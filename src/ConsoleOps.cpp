@@ -25,95 +25,168 @@
  *
  * Purpose:
  *   This file implements the ConsoleOps class, which provides logging operations
- *   for writing log data to the console (stdout). It manages a background thread
- *   to process queued log messages and supports both normal and testing modes.
+ *   for writing log data to the console. The queued records are written a batch
+ *   at a time, assembled in one buffer and handed to a single write(2) on stdout,
+ *   while the critical ones take the priority lane, or a lane of their own
+ *   to stderr.
+ *   It supports both normal and testing modes.
  */
 
 #include "ConsoleOps.hpp"
+#include "FileOps.hpp"
 
-#include <iostream>
-#include <functional>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+
+#include <unistd.h>
 
 using namespace logger;
 
-ConsoleOps::ConsoleOps()
+namespace
+{
+    /// The console whose writeRecord() writes a record bound for stderr on this thread,
+    /// for its writeDataTo() to tell. Another sink written to meanwhile decides on its own
+    thread_local const ConsoleOps* stderrOps = nullptr;
+
+    /**
+     * @brief Marks the record a console writes on this thread as bound for stderr, for a scope
+     */
+    class StderrScope
+    {
+        public:
+            StderrScope(const ConsoleOps& ops, const bool toStderr) noexcept
+                : m_prevOps(stderrOps)
+            {
+                stderrOps = toStderr ? &ops : nullptr;
+            }
+            ~StderrScope()                                          { stderrOps = m_prevOps;        }
+            StderrScope(const StderrScope&) = delete;
+            StderrScope& operator=(const StderrScope&) = delete;
+
+        private:
+            const ConsoleOps* m_prevOps;
+    };
+};
+
+ConsoleOps::ConsoleOps(const bool criticalToStderr, const std::chrono::milliseconds maxLatency)
     : LoggingOps()
     , m_testing(false)
     , m_testStringStream()
-    , m_isOpsRunning(false)
+    , m_testErrStringStream()
+    , m_criticalToStderr(criticalToStderr)
+    , m_drainTimerArmed(false)
 {
-    //Spawn a thread to keep watch and pull the data from the data records queue
-    //and write it to the file whenever it is available
-    std::function<void()> watcherThread = [this]() { keepWatchAndPull(); };
-    m_watcher = std::thread(std::move(watcherThread));
+    setMaxLatency(maxLatency);
 }
 
 ConsoleOps::~ConsoleOps()
 {
+    // The writer makes use of the members of this class
+    stopWatcher();
+}
+
+bool ConsoleOps::isPriority(const LOG_TYPE logType) const noexcept
+{
+    return isCriticalLogType(logType) || LoggingOps::isPriority(logType);
+}
+
+void ConsoleOps::writeRecord(const LogRecord& record)
+{
+    // By the log type, the priority lane holds more than the critical records
+    StderrScope stderrScope(*this, m_criticalToStderr && isCriticalLogType(record.logType));
+    LoggingOps::writeRecord(record);
 }
 
 void ConsoleOps::writeDataTo(const std::string_view data)
 {
-    if (!data.empty())
+    if (data.empty())
+        return;
+
+    if (stderrOps == this)
     {
-        push(data);
-        flush(); //Flush it immediately as the data might be critical error or warning
+        std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+        m_stderrRecords.append(data);
+        m_stderrRecords.push_back('\n');
+        // Like the priority lane, it does not wait for a batch to fill up
+        scheduleDrain();
+        return;
+    }
+
+    push(data);
+    // A batch which does not fill up on its own goes out after getMaxLatency() at the latest
+    std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+    if (!m_drainTimerArmed && !m_DataRecords.empty())
+    {
+        m_drainTimerArmed = true;
+        scheduleDrainAfter(getMaxLatency());
     }
 }
 
+/*virtual*/ bool ConsoleOps::drainBatch()
+{
+    {
+        // The records queued from now on need a timer of their own
+        std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+        m_drainTimerArmed = false;
+        m_stderrBatch.clear();
+        m_stderrBatch.swap(m_stderrRecords);
+        m_priorityInFlight = !m_stderrBatch.empty();
+        m_writeInFlight = m_priorityInFlight;
+    }
+    if (!m_stderrBatch.empty())
+    {
+        try
+        {
+            std::scoped_lock<std::mutex> consoleLock(m_consoleMtx);
+            writeToConsole(m_stderrBatch, true);
+        }
+        catch(...)
+        {
+            addRaisedException(std::current_exception());
+        }
+
+        // Whoever waits for the critical records does not wait for the rest
+        std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+        m_priorityInFlight = false;
+        m_drainedCv.notify_all();
+    }
+    return LoggingOps::drainBatch();
+}
+
+bool ConsoleOps::isQueueEmpty() const
+{
+    return m_stderrRecords.empty() && LoggingOps::isQueueEmpty();
+}
+
+bool ConsoleOps::isPriorityQueueEmpty() const
+{
+    return m_stderrRecords.empty() && LoggingOps::isPriorityQueueEmpty();
+}
+
 void ConsoleOps::writeToOutStreamObject(BufferQ&& dataQueue, std::exception_ptr& excpPtr)
+{
+    writeBatch(std::move(dataQueue), excpPtr, false);
+}
+
+void ConsoleOps::writeBatch(BufferQ&& dataQueue, std::exception_ptr& excpPtr, const bool toStderr)
 {
     if (dataQueue.empty())
         return;
 
     try
     {
-        std::string errMsg;
-        std::unique_lock<std::mutex> consoleLock(m_mtx);
-        m_cv.wait(consoleLock, [this]{ return !m_isOpsRunning; });
-        m_isOpsRunning = true;
-
-        std::ostream& outStream = std::cout;
-        if (outStream.good())
+        std::scoped_lock<std::mutex> consoleLock(m_consoleMtx);
+        m_batchBuffer.clear();
+        while (!dataQueue.empty())
         {
-            while (!dataQueue.empty())
-            {
-                auto data = dataQueue.front();
-                dataQueue.pop();
-                if (m_testing && m_testStringStream.good()) // If testing mode is ON, write to the test string stream
-                {
-                    m_testStringStream << data.data() << std::endl;
-                    if (!m_testStringStream.good()) // If writing to the test string stream fails, set the error message
-                    {
-                        std::ostringstream osstr;
-                        osstr << "WRITING_ERROR : [";
-                        osstr << std::this_thread::get_id();
-                        osstr << "]: to test stringstream for data" << "[" << data.data() << "]";
-                        if (osstr.good())
-                            errMsg = osstr.str();
-                    }
-                }
-                else
-                {
-                    outStream << data.data() << std::endl;
-                    outStream.flush();
-                }
-            }
+            const auto& data = dataQueue.front();
+            auto dataEnd = std::find(data.begin(), data.end(), '\0');
+            m_batchBuffer.append(data.begin(), dataEnd);
+            m_batchBuffer.push_back('\n');
+            dataQueue.pop();
         }
-        else
-        {
-            std::ostringstream osstr;
-            osstr << "WRITING_ERROR : [";
-            osstr << std::this_thread::get_id();
-            osstr << "]: to console for data";
-            errMsg = osstr.str();
-        }
-        m_isOpsRunning = false;
-        consoleLock.unlock();
-        m_cv.notify_all();
-
-        if (!errMsg.empty())
-            throw std::runtime_error(errMsg);
+        writeToConsole(m_batchBuffer, toStderr);
     }
     catch(...)
     {
@@ -121,3 +194,17 @@ void ConsoleOps::writeToOutStreamObject(BufferQ&& dataQueue, std::exception_ptr&
     }
 }
 
+void ConsoleOps::writeToConsole(const std::string_view buffer, const bool toStderr)
+{
+    if (m_testing) // If testing mode is ON, write to the test string streams
+    {
+        auto& testStream = toStderr ? m_testErrStringStream : m_testStringStream;
+        testStream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!testStream.good())
+            throw std::runtime_error("WRITING_ERROR : to test stringstream for " + std::to_string(buffer.size()) + " bytes");
+        return;
+    }
+
+    if (FileOps::writeAll(toStderr ? STDERR_FILENO : STDOUT_FILENO, buffer) < buffer.size())
+        throw std::runtime_error(std::string("WRITING_ERROR : to ") + (toStderr ? "stderr" : "stdout") + ": " + std::strerror(errno));
+}
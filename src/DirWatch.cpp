@@ -0,0 +1,147 @@
+/*
+ * DirWatch.cpp
+ *
+ * Implementation of the DirWatch class. On Linux the directory of the file is
+ * watched with inotify, the events of the file being picked out of those of
+ * the directory. A self pipe wakes the waiting thread up, e.g. to stop it.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "DirWatch.hpp"
+
+#include <array>
+
+#include <poll.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+using namespace logger;
+
+DirWatch::DirWatch()
+    : m_fileName()
+    , m_notifyFd(-1)
+    , m_wakeupPipe{ -1, -1 }
+{
+}
+
+DirWatch::~DirWatch()
+{
+    close();
+}
+
+bool DirWatch::open(const std::filesystem::path& file, const DirWatchEvents events)
+{
+    if (!open())
+        return false;
+
+    m_fileName = file.filename().string();
+#ifdef __linux__
+    m_notifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_notifyFd >= 0)
+    {
+        auto dirPath = file.parent_path();
+        if (dirPath.empty())
+            dirPath = ".";
+        // Once written out or renamed over it, not on its creation, which would
+        // have an empty or half written file read, unless any change counts
+        auto mask = (events == DirWatchEvents::WRITTEN)
+                  ? static_cast<uint32_t>(IN_CLOSE_WRITE | IN_MOVED_TO)
+                  : static_cast<uint32_t>(IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE);
+        if (::inotify_add_watch(m_notifyFd, dirPath.c_str(), mask) < 0)
+        {
+            // Polling alone does the job, only slower
+            ::close(m_notifyFd);
+            m_notifyFd = -1;
+        }
+    }
+#else
+    (void)events;
+#endif
+    return true;
+}
+
+bool DirWatch::open()
+{
+    close();
+    return ::pipe(m_wakeupPipe) == 0;
+}
+
+void DirWatch::close() noexcept
+{
+    for (auto& fd : { &m_wakeupPipe[0], &m_wakeupPipe[1], &m_notifyFd })
+    {
+        if (*fd >= 0)
+            ::close(*fd);
+        *fd = -1;
+    }
+    m_fileName.clear();
+}
+
+void DirWatch::wakeup(const char wakeup) noexcept
+{
+    [[maybe_unused]] auto retVal = ::write(m_wakeupPipe[1], &wakeup, sizeof(wakeup));
+}
+
+DirWatchResult DirWatch::wait(const std::chrono::milliseconds timeout)
+{
+    DirWatchResult result;
+    std::array<pollfd, 2> pollFds = {{ { m_wakeupPipe[0], POLLIN, 0 }, { m_notifyFd, POLLIN, 0 } }};
+    auto fdCnt = isWatching() ? 2 : 1;
+    auto timeoutMs = (timeout.count() < 0) ? -1 : static_cast<int>(timeout.count());
+    if (::poll(pollFds.data(), static_cast<nfds_t>(fdCnt), timeoutMs) <= 0)
+    {
+        result.timedOut = true;
+        return result;
+    }
+
+    if (pollFds[0].revents & POLLIN)
+    {
+        std::array<char, 64> wakeups;
+        auto readCnt = ::read(m_wakeupPipe[0], wakeups.data(), wakeups.size());
+        if (readCnt > 0)
+            result.wakeups.assign(wakeups.data(), static_cast<size_t>(readCnt));
+    }
+
+#ifdef __linux__
+    if (fdCnt == 2 && (pollFds[1].revents & POLLIN))
+    {
+        // Only the events of the file count, the directory may well be a busy one
+        alignas(inotify_event) std::array<char, 4096> events;
+        ssize_t readCnt = 0;
+        while ((readCnt = ::read(m_notifyFd, events.data(), events.size())) > 0)
+        {
+            for (ssize_t offset = 0; offset < readCnt; )
+            {
+                auto event = reinterpret_cast<const inotify_event*>(events.data() + offset);
+                if (event->len > 0 && m_fileName == event->name)
+                    result.fileChanged = true;
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+        }
+    }
+#endif
+    return result;
+}
@@ -31,6 +31,12 @@
 #include <tuple>
 #include <memory>
 #include <functional>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 using namespace logger;
 
@@ -38,6 +44,100 @@ using namespace logger;
 static constexpr std::string_view nullString = "";
 static constexpr std::string_view DEFAULT_FILE_EXTN = ".txt";
 
+namespace
+{
+    /**
+     * @brief Marks a file operation in progress, for a scope
+     * Whatever way the scope is left, the flag gets cleared and the
+     * ones waiting for it get notified, the lock released before.
+     */
+    class FileOpsRunningScope
+    {
+        public:
+            FileOpsRunningScope(std::unique_lock<std::mutex>& lock,
+                                std::atomic_bool& isRunning,
+                                std::condition_variable& cv) noexcept
+                : m_lock(lock)
+                , m_isRunning(isRunning)
+                , m_cv(cv)
+            {
+                m_isRunning = true;
+            }
+
+            ~FileOpsRunningScope()
+            {
+                m_isRunning = false;
+                if (m_lock.owns_lock())
+                    m_lock.unlock();
+                m_cv.notify_all();
+            }
+
+            FileOpsRunningScope(const FileOpsRunningScope&) = delete;
+            FileOpsRunningScope& operator=(const FileOpsRunningScope&) = delete;
+
+        private:
+            std::unique_lock<std::mutex>& m_lock;
+            std::atomic_bool& m_isRunning;
+            std::condition_variable& m_cv;
+    };
+
+    /**
+     * @brief The log file opened by a drain turn to append its batch to
+     * Created if missing, closed when the scope is left.
+     */
+    class AppendFd
+    {
+        public:
+            explicit AppendFd(const std::filesystem::path& file)
+                : m_fd(-1)
+            {
+                open(file);
+            }
+
+            ~AppendFd()
+            {
+                if (m_fd >= 0)
+                    ::close(m_fd);
+            }
+
+            AppendFd(const AppendFd&) = delete;
+            AppendFd& operator=(const AppendFd&) = delete;
+
+            /**
+             * @brief Close the file and open another one, e.g. the new one after a rotation
+             */
+            void open(const std::filesystem::path& file)
+            {
+                if (m_fd >= 0)
+                    ::close(m_fd);
+                m_fd = ::open(file.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+                if (m_fd < 0)
+                {
+                    std::ostringstream osstr;
+                    osstr << "WRITING_ERROR : [";
+                    osstr << std::this_thread::get_id();
+                    osstr << "]: File [" << file.string();
+                    osstr << "] can not be opened to write log data: " << std::strerror(errno) << "\n";
+                    throw std::runtime_error(osstr.str());
+                }
+            }
+
+            inline int get() const noexcept                                 { return m_fd;  }
+
+            /**
+             * @brief Get the size of the file, 0 if it can't be had
+             */
+            std::uintmax_t getSize() const noexcept
+            {
+                struct stat fileStat = {};
+                return (::fstat(m_fd, &fileStat) == 0) ? static_cast<std::uintmax_t>(fileStat.st_size) : 0;
+            }
+
+        private:
+            int m_fd;
+    };
+};
+
 /*static*/ bool FileOps::isFileEmpty(const std::filesystem::path& file) noexcept
 {
     if (fileExists(file))
@@ -114,17 +214,24 @@ static constexpr std::string_view DEFAULT_FILE_EXTN = ".txt";
                 throw std::runtime_error("Out of bound: Start pos is greater than end pos");
         }
 
-        std::ifstream ifile(file.getFilePathObj(), std::ios::binary);
-        if (!ifile)
+        int fd = ::open(file.getFilePathObj().c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
             throw std::runtime_error("File " + file.getFilePathObj().string() + " can't be opened for reading");
 
-        auto bytesToRead = end - start;
-        outBuff.clear();
-        outBuff.resize(bytesToRead);
-        ifile.seekg(start, std::ios::beg);
-        ifile.read(outBuff.data(), bytesToRead);
+        auto bytesToRead = static_cast<size_t>(end - start);
+        size_t readCnt = 0;
+        try
+        {
+            readCnt = readFileByteRange(fd, static_cast<std::uintmax_t>(start), static_cast<std::uintmax_t>(end), outBuff);
+        }
+        catch(...)
+        {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
 
-        if (!ifile)
+        if (readCnt != bytesToRead)
             throw std::runtime_error("File " + file.getFilePathObj().string() + " can't be read even after opening");
 
         return true;
@@ -137,6 +244,51 @@ static constexpr std::string_view DEFAULT_FILE_EXTN = ".txt";
     return false;
 }
 
+/*static*/ size_t FileOps::readFileByteRange(const int fd,
+                                             const std::uintmax_t start,
+                                             const std::uintmax_t end,
+                                             std::vector<char>& outBuff)
+{
+    if (start > end)
+        throw std::runtime_error("Out of bound: Start pos is greater than end pos");
+
+    outBuff.resize(static_cast<size_t>(end - start));
+    size_t readCnt = 0;
+    while (readCnt < outBuff.size())
+    {
+        auto retVal = ::pread(fd, outBuff.data() + readCnt, outBuff.size() - readCnt, static_cast<off_t>(start + readCnt));
+        if (retVal < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error(std::string("File can't be read: ") + std::strerror(errno));
+        }
+        if (retVal == 0)
+            break;  // The file ends before the range does
+
+        readCnt += static_cast<size_t>(retVal);
+    }
+    outBuff.resize(readCnt);
+    return readCnt;
+}
+
+/*static*/ size_t FileOps::writeAll(const int fd, const std::string_view data) noexcept
+{
+    size_t written = 0;
+    while (written < data.size())
+    {
+        auto retVal = ::write(fd, data.data() + written, data.size() - written);
+        if (retVal < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        written += static_cast<size_t>(retVal);
+    }
+    return written;
+}
+
 /*static*/bool FileOps::readFileLineRange(FileOps& file,
                                         const size_t startLineNo,
                                         const size_t endLineNo,
@@ -150,14 +302,29 @@ static constexpr std::string_view DEFAULT_FILE_EXTN = ".txt";
         if (startLineNo > endLineNo)
             throw std::runtime_error("Out of bound: Start pos is greater than end pos");
 
-        std::ifstream ifile(file.getFilePathObj(), std::ios::binary);
-        if (!ifile)
-            throw std::runtime_error("File " + file.getFilePathObj().string() + " can't be opened for reading");
+        // Neither a clear nor a rotation may truncate the file while it
+        // is mapped, a page gone from under the mapping raises a SIGBUS
+        std::unique_lock<std::mutex> fileLock(file.m_FileOpsMutex);
+        file.m_FileOpsCv.wait(fileLock, [&file]{ return !file.m_isFileOpsRunning; });
+        FileOpsRunningScope runningScope(fileLock, file.m_isFileOpsRunning, file.m_FileOpsCv);
+
+        MappedFile mappedFile(file.m_FilePathObj);
+        auto content = mappedFile.view();
 
         outBuf.clear();
-        std::string readLine;
         size_t readLineCnt = 0;
-        while (std::getline(ifile, readLine))
+        {
+            // Jump close to the start line rather than reading all the lines before it
+            std::scoped_lock<std::mutex> indexLock(file.m_lineIndexMtx);
+            if (file.m_lineIndex)
+            {
+                file.m_lineIndex->refresh();
+                auto [offset, lineNo] = file.m_lineIndex->seekLine(startLineNo);
+                content.remove_prefix(std::min<std::uintmax_t>(offset, content.size()));
+                readLineCnt = lineNo - 1;
+            }
+        }
+        for (auto readLine : MappedFile::LineRange(content))
         {
             ++readLineCnt;
             if (readLineCnt >= startLineNo)
@@ -165,12 +332,9 @@ static constexpr std::string_view DEFAULT_FILE_EXTN = ".txt";
                 if (readLineCnt <= endLineNo)
                     outBuf.emplace_back(readLine);
             }
-            readLine.clear();
-            if (readLineCnt > endLineNo)
+            if (readLineCnt >= endLineNo)
                 break;
         }
-        if (!ifile)
-            throw std::runtime_error("File " + file.getFilePathObj().string() + " can't be read even after opening");
 
         return true;
     }
@@ -273,18 +437,213 @@ FileOps::FileOps(const std::uintmax_t maxFileSize,
     , m_FileContent(DataQ())
     , m_MaxFileSize(maxFileSize)
     , m_isFileOpsRunning(false)
+    , m_fileCreated(false)
+    , m_durabilityPolicy(DurabilityPolicy::NO_SYNC)
+    , m_syncPeriod(1000)
+    , m_unsyncedData(false)
+    , m_criticalTicket(0)
+    , m_syncedTicket(0)
+    , m_turnTicket(0)
+    , m_turnSyncDue(false)
+    , m_nextSyncDue()
 {
     auto fileDetails = std::make_tuple(m_FileName, m_FilePath, m_FileExtension);
     // Initialize the file path object
     populateFilePathObj(fileDetails);
-    //Spawn a thread to keep watch and pull the data from the data records queue
-    //and write it to the file whenever it is available
-    std::function<void()> watcherThread = [this]() { keepWatchAndPull(); };
-    m_watcher = std::thread(std::move(watcherThread));
 }
 
 FileOps::~FileOps()
 {
+    // The writer makes use of the members of this class
+    stopWatcher();
+    // Whatever was still queued must reach the disk as well
+    if (m_durabilityPolicy != DurabilityPolicy::NO_SYNC && m_unsyncedData)
+    {
+        try
+        {
+            syncFile();
+        }
+        catch(...)
+        {
+            addRaisedException(std::current_exception());
+        }
+    }
+}
+
+FileOps& FileOps::setDurabilityPolicy(const DurabilityPolicy policy, const std::chrono::milliseconds syncPeriod)
+{
+    m_durabilityPolicy = policy;
+    if (policy == DurabilityPolicy::PERIODIC)
+    {
+        std::chrono::milliseconds period;
+        {
+            std::scoped_lock<std::mutex> syncLock(m_syncMtx);
+            m_syncPeriod = period = (syncPeriod.count() > 0) ? syncPeriod : std::chrono::milliseconds(1);
+            m_nextSyncDue = std::chrono::steady_clock::now() + period;
+        }
+        // A timer left from an earlier period finds it not due, and is not armed again
+        scheduleDrainAfter(period);
+    }
+    return *this;
+}
+
+SyncStats FileOps::getSyncStats()
+{
+    std::scoped_lock<std::mutex> syncLock(m_syncMtx);
+    return m_syncStats;
+}
+
+FileOps& FileOps::enableLineIndex(const size_t stride)
+{
+    std::scoped_lock<std::mutex> indexLock(m_lineIndexMtx);
+    if (!m_lineIndex || m_lineIndex->getStride() != stride)
+        m_lineIndex = std::make_unique<LineIndex>(m_FilePathObj, stride);
+
+    return *this;
+}
+
+FileOps& FileOps::disableLineIndex()
+{
+    std::scoped_lock<std::mutex> indexLock(m_lineIndexMtx);
+    m_lineIndex.reset();
+    return *this;
+}
+
+bool FileOps::isLineIndexEnabled()
+{
+    std::scoped_lock<std::mutex> indexLock(m_lineIndexMtx);
+    return m_lineIndex != nullptr;
+}
+
+bool FileOps::sync()
+{
+    try
+    {
+        flushAndWait();
+        syncFile();
+        return true;
+    }
+    catch(...)
+    {
+        addRaisedException(std::current_exception());
+    }
+    return false;
+}
+
+void FileOps::commitCritical()
+{
+    if (m_durabilityPolicy != DurabilityPolicy::ON_CRITICAL)
+        return;
+
+    // Taken once the record got queued, the first drain turn popping the
+    // records after it syncs the file it writes them to
+    auto ticket = ++m_criticalTicket;
+    flushAndWait();
+    if (m_syncedTicket >= ticket)
+        return;
+
+    // Queued too late for the turn that wrote it. The record is still in
+    // the file at the path, as a rotation syncs the file before renaming it
+    try
+    {
+        syncFile();
+        raiseSyncedTicket(ticket);
+    }
+    catch(...)
+    {
+        addRaisedException(std::current_exception());
+    }
+}
+
+void FileOps::raiseSyncedTicket(const uint64_t ticket)
+{
+    auto synced = m_syncedTicket.load();
+    while (synced < ticket && !m_syncedTicket.compare_exchange_weak(synced, ticket));
+}
+
+bool FileOps::syncFd(const int fd)
+{
+    auto start = std::chrono::steady_clock::now();
+#if defined(__APPLE__)
+    auto success = (::fsync(fd) == 0);  // No fdatasync on macOS
+#else
+    auto success = (::fdatasync(fd) == 0);
+#endif
+    noteSync(success, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+    return success;
+}
+
+void FileOps::noteSync(const bool success, const std::chrono::nanoseconds latency)
+{
+    std::scoped_lock<std::mutex> syncLock(m_syncMtx);
+    if (success)
+    {
+        ++m_syncStats.syncCount;
+        m_syncStats.totalLatency += latency;
+        m_syncStats.lastLatency = latency;
+        m_syncStats.maxLatency = std::max(m_syncStats.maxLatency, latency);
+    }
+    else
+    {
+        ++m_syncStats.failedCount;
+    }
+}
+
+void FileOps::syncFile()
+{
+    if (!fileExists())
+        return;
+
+    // Clear it upfront, so that a batch written while syncing is not forgotten
+    m_unsyncedData = false;
+    int fd = ::open(m_FilePathObj.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (fd < 0)
+        throw std::runtime_error("SYNC_ERROR : File " + m_FilePathObj.string() + " can't be opened: " + std::strerror(errno));
+
+    auto success = syncFd(fd);
+    auto errNo = errno;
+    ::close(fd);
+    if (!success)
+        throw std::runtime_error("SYNC_ERROR : File " + m_FilePathObj.string() + " can't be synced: " + std::strerror(errNo));
+}
+
+bool FileOps::drainBatch()
+{
+    // Read before the records get popped, the record of every ticket up to
+    // it is written by this turn at the latest. Every batch of the turn gets
+    // synced then, a critical record may be in either lane.
+    m_turnTicket = m_criticalTicket;
+    m_turnSyncDue = (m_durabilityPolicy == DurabilityPolicy::ON_CRITICAL && m_turnTicket > m_syncedTicket);
+    auto more = LoggingOps::drainBatch();
+    if (m_durabilityPolicy == DurabilityPolicy::PERIODIC)
+        syncIfDue();
+    return more;
+}
+
+void FileOps::syncIfDue()
+{
+    std::chrono::milliseconds period;
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::scoped_lock<std::mutex> syncLock(m_syncMtx);
+        if (now < m_nextSyncDue)
+            return;
+        period = m_syncPeriod;
+        m_nextSyncDue = now + period;
+    }
+
+    if (m_unsyncedData)
+    {
+        try
+        {
+            syncFile();
+        }
+        catch(...)
+        {
+            addRaisedException(std::current_exception());
+        }
+    }
+    scheduleDrainAfter(period);
 }
 
 FileOps& FileOps::setFileName(const std::string_view fileName)
@@ -319,7 +678,7 @@ std::uintmax_t FileOps::getFileSize()
     std::uintmax_t fileSize = 0;
     if (fileExists())
     {
-        flush();
+        flushAndWait();
         std::scoped_lock<std::mutex> fileLock(m_FileOpsMutex);
         m_isFileOpsRunning = true;
         std::error_code ec;
@@ -365,6 +724,12 @@ bool FileOps::deleteFile()
         m_FileOpsCv.wait(fileLock, [this] { return !m_isFileOpsRunning; });
         m_isFileOpsRunning = true;
         retVal = std::filesystem::remove(m_FilePathObj);
+        m_fileCreated = false;
+        {
+            std::scoped_lock<std::mutex> indexLock(m_lineIndexMtx);
+            if (m_lineIndex)
+                m_lineIndex->reset();
+        }
         m_isFileOpsRunning = false;
         fileLock.unlock();
         m_FileOpsCv.notify_one();
@@ -402,7 +767,7 @@ void FileOps::readFile()
 
     // Check if there is any data in the data records queue
     // and wait for it to be processed before reading the file
-    flush();
+    flushAndWait();
 
     DataQ().swap(m_FileContent); // Clear the file content queue
 
@@ -412,17 +777,13 @@ void FileOps::readFile()
 
     if (std::filesystem::exists(m_FilePathObj))
     {
-        std::ifstream file(m_FilePathObj, std::ios::binary);
-        if (file.is_open())
+        try
         {
-            std::string line;
-            while (std::getline(file, line))
-            {
+            MappedFile file(m_FilePathObj);
+            for (auto line : file.lines())
                 m_FileContent.emplace(line);
-                line.clear();
-            }
         }
-        else
+        catch(...)
         {
             m_isFileOpsRunning = false;
             fileLock.unlock();
@@ -435,6 +796,33 @@ void FileOps::readFile()
     m_FileOpsCv.notify_all();
 }
 
+MappedFile FileOps::mapFile()
+{
+    if (m_FilePathObj.empty())
+        throw std::runtime_error("File path is empty");
+
+    flushAndWait();
+    return MappedFile(m_FilePathObj);
+}
+
+size_t FileOps::forEachLine(const std::function<bool(std::string_view)>& func, const size_t chunkSize)
+{
+    if (m_FilePathObj.empty())
+        throw std::runtime_error("File path is empty");
+
+    flushAndWait();
+    return MappedFile::forEachLine(m_FilePathObj, func, chunkSize);
+}
+
+ReverseReader FileOps::reverseReader(const size_t blockSize)
+{
+    if (m_FilePathObj.empty())
+        throw std::runtime_error("File path is empty");
+
+    flushAndWait();
+    return ReverseReader(m_FilePathObj, blockSize);
+}
+
 bool FileOps::clearFile()
 {
     auto retVal = false;
@@ -450,6 +838,9 @@ bool FileOps::clearFile()
             file.close();
             retVal = true;
         }
+        std::scoped_lock<std::mutex> indexLock(m_lineIndexMtx);
+        if (m_lineIndex)
+            m_lineIndex->reset();
     }
     m_isFileOpsRunning = false;
     fileLock.unlock();
@@ -459,123 +850,168 @@ bool FileOps::clearFile()
 
 void FileOps::writeDataTo(const std::string_view data)
 {
-    try
+    if (data.empty())
+        return;
+
+    // Created right away the first time, to be found by the caller. Then on
+    // the drain turns keep track of its size, and rotate it once it reaches
+    // the max file size, no need to look at it for every record.
+    if (!m_fileCreated.exchange(true) && !fileExists() && !createFile())
     {
-        if (data.empty())
-            return;
+        m_fileCreated = false;
+        addRaisedException(std::make_exception_ptr(std::runtime_error("File neither exists nor can be created")));
+        return;
+    }
+    push(data);
+}
 
-        if (!fileExists())
-        {
-            if (createFile())
-                push(data);
-            else
-                throw std::runtime_error("File neither exists nor can be created");
-        }
-        else
+void FileOps::writeToOutStreamObject(BufferQ&& dataQueue, std::exception_ptr& excpPtr)
+{
+    if (dataQueue.empty())
+        return;
+
+    try
+    {
+        // Gather the records for the file, so that they go out with a
+        // single write instead of a stream flush per line
+        std::string batch;
+        batch.reserve(dataQueue.size() * 128);
+        std::uintmax_t sizeBeforeWrite = 0;
         {
-            /**
-             * First check if the current log file
-             * size and the data size to be written
-             * exceeds the max file size limit set
-             * by the user. If so then rename the
-             * existing file with the current time
-             * stamp and create a new blank file
-             * for further logging/writting. Throw
-             * exception for any runtime error case.
-             */
-            flush(); //Flush the data whatever in the queue waiting to be written
-            // Now get the file size
-            auto currFileSize = getFileSize();
-            if ((currFileSize + data.size()) >= m_MaxFileSize)
+            std::unique_lock<std::mutex> fileLock(m_FileOpsMutex);
+            m_FileOpsCv.wait(fileLock, [this]{ return !m_isFileOpsRunning; });
+            FileOpsRunningScope runningScope(fileLock, m_isFileOpsRunning, m_FileOpsCv);
+
+            AppendFd file(m_FilePathObj);
+            sizeBeforeWrite = file.getSize();
+            while (!dataQueue.empty())
             {
-                Clock clock;
-                auto currentTimeStr = clock.getLocalTimeStr("%d%m%Y_%H%M%S");
-                auto currentFileName = getFileName();
-                auto currentFileExtension = getFileExtension();
-                auto newFileName = currentFileName.substr(0, currentFileName.find(currentFileExtension))
-                                     + "_" + currentTimeStr + currentFileExtension;
-                if (renameFile(newFileName))
+                const auto& data = dataQueue.front();
+                auto dataLen = ::strnlen(data.data(), data.size());
+                // The file size is the one before the batch plus what it gathered so far,
+                // no need to ask the file system again for every record
+                auto fileSize = sizeBeforeWrite + batch.size();
+                if (fileSize > 0 && (fileSize + dataLen) >= m_MaxFileSize)
                 {
-                    setFileName(currentFileName);
-                    createFile();
-                }
-                else
-                {
-                    throw std::runtime_error("File limit exceeds but can not be renamed");
+                    writeBatch(file.get(), batch);
+                    updateLineIndex(batch, sizeBeforeWrite);
+                    rotateFile(file.get());
+                    file.open(m_FilePathObj);
+                    batch.clear();
+                    sizeBeforeWrite = 0;
                 }
+                batch.append(data.data(), dataLen);
+                batch.push_back('\n');
+                dataQueue.pop();
             }
-            push(data);
+            writeBatch(file.get(), batch);
         }
+        // Not to hold up the other file operations, a failure of it leaves the log file alone
+        updateLineIndex(batch, sizeBeforeWrite);
     }
     catch(...)
     {
-        m_excpPtrVec.emplace_back(std::current_exception());
+        excpPtr = std::current_exception();
     }
 }
 
-void FileOps::writeToOutStreamObject(BufferQ&& dataQueue, std::exception_ptr& excpPtr)
+void FileOps::writeBatch(const int fd, const std::string_view batch)
 {
-    if (dataQueue.empty())
+    if (writeAll(fd, batch) < batch.size())
+        throw std::runtime_error(std::string("WRITING_ERROR : File [") + m_FilePathObj.string() + "] write failed: " + std::strerror(errno));
+
+    // Group commit, one sync for the whole batch, or for the one with a critical record
+    if (m_durabilityPolicy == DurabilityPolicy::PER_BATCH || m_turnSyncDue)
+    {
+        m_unsyncedData = false;
+        if (!syncFd(fd))
+            throw std::runtime_error(std::string("SYNC_ERROR : File [") + m_FilePathObj.string() + "] can't be synced: " + std::strerror(errno));
+        if (m_turnSyncDue)
+            raiseSyncedTicket(m_turnTicket);
+    }
+    else
+    {
+        m_unsyncedData = true;
+    }
+}
+
+void FileOps::rotateFile(const int fd)
+{
+    // Once renamed, a sync by its path would reach the new file instead
+    if (m_durabilityPolicy != DurabilityPolicy::NO_SYNC && m_unsyncedData.exchange(false))
+    {
+        if (!syncFd(fd))
+            addRaisedException(std::make_exception_ptr(std::runtime_error(
+                std::string("SYNC_ERROR : File [") + m_FilePathObj.string() + "] can't be synced: " + std::strerror(errno))));
+    }
+
+    auto newFileName = getRotatedFileName();
+    std::error_code ec;
+    std::filesystem::rename(m_FilePathObj, m_FilePathObj.parent_path() / newFileName, ec);
+    if (ec)
+        throw std::runtime_error("File limit exceeds but can not be renamed: " + ec.message());
+
+    // The index goes along with the file it belongs to
+    std::scoped_lock<std::mutex> indexLock(m_lineIndexMtx);
+    if (m_lineIndex)
+    {
+        std::filesystem::rename(LineIndex::getIndexFilePath(m_FilePathObj),
+                                LineIndex::getIndexFilePath(m_FilePathObj.parent_path() / newFileName), ec);
+        m_lineIndex = std::make_unique<LineIndex>(m_FilePathObj, m_lineIndex->getStride());
+    }
+}
+
+void FileOps::updateLineIndex(const std::string_view batch, const std::uintmax_t sizeBeforeWrite) noexcept
+{
+    std::scoped_lock<std::mutex> indexLock(m_lineIndexMtx);
+    if (!m_lineIndex)
         return;
 
     try
     {
-        std::string errMsg;
-        std::unique_lock<std::mutex> fileLock(m_FileOpsMutex);
-        m_FileOpsCv.wait(fileLock, [this]{ return !m_isFileOpsRunning; });
-        m_isFileOpsRunning = true;
-
-        std::ofstream file(m_FilePathObj, std::ios::out | std::ios::app | std::ios::binary);
-        std::array<char, bufferSize> data;
-        if (file.is_open())
-        {
-            while (!dataQueue.empty())
-            {
-                data.fill('\0');
-                data = dataQueue.front();
-                dataQueue.pop();
-                file << data.data() << std::endl;
-                file.flush();
-            }
-            file.close();
-        }
+        // Catch up first with whatever the index has missed
+        // (e.g. it was just enabled for a file with some data)
+        if (m_lineIndex->getIndexedSize() != sizeBeforeWrite)
+            m_lineIndex->refresh();
         else
-        {
-            std::ostringstream osstr;
-            osstr << "WRITING_ERROR : [";
-            osstr << std::this_thread::get_id();
-            osstr << "]: File [" << m_FilePathObj.string();
-            osstr << "] can not be opened to write log data: " << data.data() << "\n";
-            errMsg = osstr.str();
-        }
-        m_isFileOpsRunning = false;
-        fileLock.unlock();
-        m_FileOpsCv.notify_all();
-
-        if (!errMsg.empty())
-            throw std::runtime_error(errMsg);
+            m_lineIndex->append(batch.data(), batch.size());
+        m_lineIndex->persist();
     }
     catch(...)
     {
-        excpPtr = std::current_exception();
+        // It can't be trusted any longer, the reads go without it from now on
+        addRaisedException(std::current_exception());
+        m_lineIndex.reset();
     }
 }
 
+std::string FileOps::getRotatedFileName() const
+{
+    Clock clock;
+    auto currentTimeStr = clock.getLocalTimeStr("%d%m%Y_%H%M%S");
+    auto baseName = m_FileName.substr(0, m_FileName.find(m_FileExtension)) + "_" + currentTimeStr;
+    auto newFileName = baseName + m_FileExtension;
+    // More than one rotation within the same second must not
+    // overwrite the file rotated a moment ago
+    size_t suffix = 0;
+    while (fileExists(m_FilePathObj.parent_path() / newFileName))
+        newFileName = baseName + "_" + std::to_string(++suffix) + m_FileExtension;
+
+    return newFileName;
+}
+
 bool FileOps::isEmpty()
 {
-    flush();
+    flushAndWait();
     std::unique_lock<std::mutex> fileLock(m_FileOpsMutex);
     m_FileOpsCv.wait(fileLock, [this]{ return !m_isFileOpsRunning; });
-    m_isFileOpsRunning = true;
+    FileOpsRunningScope runningScope(fileLock, m_isFileOpsRunning, m_FileOpsCv);
     std::ifstream file(m_FilePathObj.string(), std::ios::ate | std::ios::binary);
     if (!file)
         return false;
 
     auto retVal = file.tellg();
     file.close();
-    m_isFileOpsRunning = false;
-    fileLock.unlock();
-    m_FileOpsCv.notify_one();
     return retVal == 0;
 }
 
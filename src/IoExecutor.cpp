@@ -0,0 +1,712 @@
+/*
+ * IoExecutor.cpp
+ *
+ * Implementation of the IoExecutor class. The sinks waiting for a drain turn
+ * are served first come first served, one batch a turn, so that a sink with a
+ * lot to write can't hold the others up for longer than a batch. An idle
+ * thread either parks, or polls the size of the ready queue and the first
+ * timer due, the sinks notifying nobody while a thread polls.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "IoExecutor.hpp"
+#include "LoggingOps.hpp"
+#include "LoggerConfig.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+using namespace logger;
+
+namespace
+{
+    /// Set while the thread runs a drain turn
+    thread_local bool inDrainTurn = false;
+
+    /**
+     * @brief Marks the thread as running a drain turn, for a scope
+     */
+    class DrainTurnScope
+    {
+        public:
+            DrainTurnScope() noexcept : m_wasInDrainTurn(inDrainTurn)   { inDrainTurn = true;               }
+            ~DrainTurnScope()                                           { inDrainTurn = m_wasInDrainTurn;   }
+            DrainTurnScope(const DrainTurnScope&) = delete;
+            DrainTurnScope& operator=(const DrainTurnScope&) = delete;
+
+        private:
+            bool m_wasInDrainTurn;
+    };
+
+    /**
+     * @brief Ease off the core for a moment while polling
+     */
+    inline void cpuRelax() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+#if defined(__linux__)
+    std::string getSchedPolicyName(const SchedPolicy policy)
+    {
+        switch (policy)
+        {
+            case SchedPolicy::OTHER:
+                return "SCHED_OTHER";
+            case SchedPolicy::BATCH:
+                return "SCHED_BATCH";
+            case SchedPolicy::IDLE:
+                return "SCHED_IDLE";
+            case SchedPolicy::FIFO:
+                return "SCHED_FIFO";
+            case SchedPolicy::RR:
+                return "SCHED_RR";
+        }
+        return "";
+    }
+
+    int getNativeSchedPolicy(const SchedPolicy policy)
+    {
+        switch (policy)
+        {
+            case SchedPolicy::OTHER:
+                return SCHED_OTHER;
+            case SchedPolicy::BATCH:
+                return SCHED_BATCH;
+            case SchedPolicy::IDLE:
+                return SCHED_IDLE;
+            case SchedPolicy::FIFO:
+                return SCHED_FIFO;
+            case SchedPolicy::RR:
+                return SCHED_RR;
+        }
+        return SCHED_OTHER;
+    }
+#endif  // __linux__
+
+    /**
+     * @brief Check the options before any thread gets them, as far as it can be told without trying
+     *
+     * @param [in] options The options to be applied
+     * @throws std::runtime_error If they are out of range, or not supported here
+     */
+    void validateThreadOptions(const IoThreadOptions& options)
+    {
+#if defined(__linux__)
+        for (auto cpu : options.cpus)
+        {
+            if (cpu < 0 || cpu >= CPU_SETSIZE)
+                throw std::runtime_error("EXECUTOR_ERROR : CPU " + std::to_string(cpu) + " is out of range");
+        }
+        if (options.schedPolicy && (*options.schedPolicy == SchedPolicy::FIFO || *options.schedPolicy == SchedPolicy::RR))
+        {
+            auto nativePolicy = getNativeSchedPolicy(*options.schedPolicy);
+            if (options.schedPriority < ::sched_get_priority_min(nativePolicy) || options.schedPriority > ::sched_get_priority_max(nativePolicy))
+                throw std::runtime_error("EXECUTOR_ERROR : Priority " + std::to_string(options.schedPriority) + " is out of range for " +
+                                         getSchedPolicyName(*options.schedPolicy));
+        }
+        if (options.niceLevel && (*options.niceLevel < -20 || *options.niceLevel > 19))
+            throw std::runtime_error("EXECUTOR_ERROR : Nice level " + std::to_string(*options.niceLevel) + " is out of range");
+#else
+        if (!options.cpus.empty() || options.schedPolicy || options.niceLevel)
+            throw std::runtime_error("EXECUTOR_ERROR : The I/O threads can be pinned and scheduled on Linux only");
+#endif
+    }
+
+#if defined(__linux__)
+    /**
+     * @brief What applyThreadOptions() changes of a thread, for it to be put back
+     */
+    struct ThreadState
+    {
+        cpu_set_t cpuSet;
+        int policy;
+        sched_param param;
+        std::optional<int> niceLevel;
+    };
+
+    ThreadState getThreadState(std::thread& thread, const pid_t threadId)
+    {
+        ThreadState state = {};
+        auto errNo = ::pthread_getaffinity_np(thread.native_handle(), sizeof(state.cpuSet), &state.cpuSet);
+        if (errNo == 0)
+            errNo = ::pthread_getschedparam(thread.native_handle(), &state.policy, &state.param);
+        if (errNo != 0)
+            throw std::runtime_error(std::string("EXECUTOR_ERROR : I/O thread settings can't be read: ") + std::strerror(errNo));
+
+        // -1 is a nice level as well
+        errno = 0;
+        auto niceLevel = ::getpriority(PRIO_PROCESS, static_cast<id_t>(threadId));
+        if (errno == 0)
+            state.niceLevel = niceLevel;
+        return state;
+    }
+
+    void setThreadState(std::thread& thread, const pid_t threadId, const ThreadState& state) noexcept
+    {
+        // As much as can be put back, it is what the thread had already
+        ::pthread_setaffinity_np(thread.native_handle(), sizeof(state.cpuSet), &state.cpuSet);
+        ::pthread_setschedparam(thread.native_handle(), state.policy, &state.param);
+        if (state.niceLevel)
+            ::setpriority(PRIO_PROCESS, static_cast<id_t>(threadId), *state.niceLevel);
+    }
+
+    /**
+     * @brief Pin and schedule one I/O thread
+     *
+     * @param [in] thread The thread
+     * @param [in] threadId Its kernel id
+     * @param [in] idx Its index, for the core it gets
+     * @param [in] options The options to be applied, validated already
+     */
+    void applyThreadOptions(std::thread& thread, const pid_t threadId, const size_t idx, const IoThreadOptions& options)
+    {
+        if (!options.cpus.empty())
+        {
+            auto cpu = options.cpus[idx % options.cpus.size()];
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(cpu, &cpuSet);
+            auto errNo = ::pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet);
+            if (errNo != 0)
+                throw std::runtime_error("EXECUTOR_ERROR : I/O thread can't be pinned to CPU " + std::to_string(cpu) + ": " + std::strerror(errNo));
+        }
+        if (options.schedPolicy)
+        {
+            auto realTime = (*options.schedPolicy == SchedPolicy::FIFO || *options.schedPolicy == SchedPolicy::RR);
+            sched_param param = {};
+            param.sched_priority = realTime ? options.schedPriority : 0;
+            auto errNo = ::pthread_setschedparam(thread.native_handle(), getNativeSchedPolicy(*options.schedPolicy), &param);
+            if (errNo != 0)
+                throw std::runtime_error("EXECUTOR_ERROR : I/O thread can't be scheduled with " + getSchedPolicyName(*options.schedPolicy) +
+                                         " priority " + std::to_string(param.sched_priority) + ": " + std::strerror(errNo));
+        }
+        // The nice level is per thread on Linux, set through its kernel id
+        if (options.niceLevel && ::setpriority(PRIO_PROCESS, static_cast<id_t>(threadId), *options.niceLevel) != 0)
+            throw std::runtime_error("EXECUTOR_ERROR : I/O thread can't be given the nice level " + std::to_string(*options.niceLevel) + ": " + std::strerror(errno));
+    }
+#endif  // __linux__
+
+    /**
+     * @brief Pin and schedule the I/O threads, all of them or none
+     * Should a thread fail to take the options, those which got them
+     * already, and the one which failed, are put back as they were.
+     *
+     * @param [in] workers The threads
+     * @param [in] threadIds Their kernel ids
+     * @param [in] options The options to be applied
+     * @throws std::runtime_error If the options can't be applied
+     */
+    void applyThreadOptions(std::vector<std::thread>& workers, const std::vector<pid_t>& threadIds, const IoThreadOptions& options)
+    {
+        validateThreadOptions(options);
+#if defined(__linux__)
+        if (options.cpus.empty() && !options.schedPolicy && !options.niceLevel)
+            return;
+
+        std::vector<ThreadState> states;
+        states.reserve(workers.size());
+        for (size_t idx = 0; idx < workers.size(); ++idx)
+            states.push_back(getThreadState(workers[idx], threadIds[idx]));
+
+        size_t idx = 0;
+        try
+        {
+            for (; idx < workers.size(); ++idx)
+                applyThreadOptions(workers[idx], threadIds[idx], idx, options);
+        }
+        catch(...)
+        {
+            for (size_t changed = 0; changed <= idx && changed < workers.size(); ++changed)
+                setThreadState(workers[changed], threadIds[changed], states[changed]);
+            throw;
+        }
+#else
+        (void)workers;
+        (void)threadIds;
+#endif
+    }
+};
+
+/*static*/ bool IoExecutor::isInDrainTurn() noexcept
+{
+    return inDrainTurn;
+}
+
+/*static*/ IoExecutor& IoExecutor::getShared()
+{
+    // Never destroyed, the sinks may well be destroyed after it otherwise
+    static IoExecutor* sharedExecutor = new IoExecutor(LoggerConfig::load().ioThreadCnt);
+    return *sharedExecutor;
+}
+
+IoExecutor::IoExecutor(const size_t threadCnt)
+    : m_ready()
+    , m_timers()
+    , m_states()
+    , m_stop(false)
+    , m_readyCnt(0)
+    , m_nextTimerDue(std::chrono::steady_clock::time_point::max())
+    , m_pollingCnt(0)
+    , m_waitStrategy(WaitStrategy::BLOCK)
+    , m_spinTime(IoThreadOptions().spinTime)
+    , m_options()
+    , m_threadCnt(std::max<size_t>(threadCnt, 1))
+    , m_externalDrive(false)
+    , m_eventFd(-1)
+{
+    startThreads(m_threadCnt);
+}
+
+IoExecutor::~IoExecutor()
+{
+    {
+        std::scoped_lock<std::mutex> lock(m_mtx);
+        m_stop = true;
+    }
+    m_readyCv.notify_all();
+    for (auto& worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+#if defined(__linux__)
+    if (m_eventFd >= 0)
+        ::close(m_eventFd);
+#endif
+}
+
+void IoExecutor::startThreads(const size_t threadCnt)
+{
+    {
+        std::scoped_lock<std::mutex> lock(m_mtx);
+        m_threadIds.assign(threadCnt, 0);
+    }
+    m_workers.reserve(threadCnt);
+    for (size_t idx = 0; idx < threadCnt; ++idx)
+        m_workers.emplace_back([this, idx]() { run(idx); });
+
+    // The threads can't be scheduled before their kernel ids are known
+    std::unique_lock<std::mutex> lock(m_mtx);
+    m_idleCv.wait(lock, [this]()
+    {
+        return std::none_of(m_threadIds.begin(), m_threadIds.end(), [](const pid_t threadId) { return threadId == 0; });
+    });
+}
+
+int IoExecutor::startExternalDrive()
+{
+    // It joins the I/O threads, the calling one would be among them
+    if (isInDrainTurn())
+        throw std::runtime_error("EXECUTOR_ERROR : The drain turns can't be handed to an event loop from a drain turn");
+
+    std::scoped_lock<std::mutex> optionsLock(m_optionsMtx);
+    if (m_externalDrive)
+        return m_eventFd;
+
+#if defined(__linux__)
+    m_eventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_eventFd < 0)
+        throw std::runtime_error(std::string("EXECUTOR_ERROR : No eventfd for the event loop: ") + std::strerror(errno));
+#else
+    throw std::runtime_error("EXECUTOR_ERROR : The drain turns can be driven by an event loop on Linux only");
+#endif
+
+    {
+        std::scoped_lock<std::mutex> lock(m_mtx);
+        m_externalDrive = true;
+    }
+    // The threads finish the turns they run, and leave the rest to the event loop
+    m_readyCv.notify_all();
+    for (auto& worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    m_workers.clear();
+
+    std::scoped_lock<std::mutex> lock(m_mtx);
+    m_threadIds.clear();
+    if (!m_ready.empty() || !m_timers.empty())
+        signalEventFd();
+    return m_eventFd;
+}
+
+void IoExecutor::stopExternalDrive()
+{
+    if (isInDrainTurn())
+        throw std::runtime_error("EXECUTOR_ERROR : The drain turns can't be handed back to the I/O threads from a drain turn");
+
+    std::scoped_lock<std::mutex> optionsLock(m_optionsMtx);
+    if (!m_externalDrive)
+        return;
+
+    {
+        std::scoped_lock<std::mutex> lock(m_mtx);
+        m_externalDrive = false;
+#if defined(__linux__)
+        ::close(m_eventFd);
+#endif
+        m_eventFd = -1;
+    }
+    // They take over whatever is ready or due, the sinks have no idea of the switch
+    startThreads(m_threadCnt);
+    try
+    {
+        applyThreadOptions(m_workers, m_threadIds, m_options);
+    }
+    catch(...)
+    {
+        // The threads run as they got started, the options have to tell so
+        IoThreadOptions options;
+        options.waitStrategy = m_options.waitStrategy;
+        options.spinTime = m_options.spinTime;
+        m_options = options;
+        throw;
+    }
+}
+
+void IoExecutor::setThreadOptions(const IoThreadOptions& options)
+{
+    std::scoped_lock<std::mutex> optionsLock(m_optionsMtx);
+    applyThreadOptions(m_workers, m_threadIds, options);
+
+    m_options = options;
+    m_spinTime = options.spinTime;
+    {
+        // Under m_mtx, so that a thread about to park can't miss it
+        std::scoped_lock<std::mutex> lock(m_mtx);
+        m_waitStrategy = options.waitStrategy;
+    }
+    // The parked threads start polling, if they are to
+    m_readyCv.notify_all();
+}
+
+IoThreadOptions IoExecutor::getThreadOptions() const
+{
+    std::scoped_lock<std::mutex> optionsLock(m_optionsMtx);
+    return m_options;
+}
+
+void IoExecutor::schedule(LoggingOps& ops)
+{
+    std::scoped_lock<std::mutex> lock(m_mtx);
+    scheduleLocked(ops);
+}
+
+void IoExecutor::scheduleAfter(LoggingOps& ops, const std::chrono::steady_clock::duration delay)
+{
+    std::scoped_lock<std::mutex> lock(m_mtx);
+    auto due = std::chrono::steady_clock::now() + delay;
+    auto wakeUp = m_timers.empty() || due < m_timers.begin()->first;
+    m_timers.emplace(due, &ops);
+    updateNextTimerDue();
+    if (wakeUp && m_externalDrive)
+        signalEventFd();    // For the event loop to take the new timeout
+    else if (wakeUp && m_pollingCnt == 0)
+        m_readyCv.notify_one();
+}
+
+void IoExecutor::retire(LoggingOps& ops)
+{
+    auto dropTimers = [this, &ops]()
+    {
+        std::erase_if(m_timers, [&ops](const auto& timer) { return timer.second == &ops; });
+        updateNextTimerDue();
+    };
+
+    std::unique_lock<std::mutex> lock(m_mtx);
+    dropTimers();
+    // No thread to wait for, the event loop may be the one retiring it
+    while (m_externalDrive)
+    {
+        lock.unlock();
+        drainSink(ops);
+        lock.lock();
+        if (m_states.find(&ops) == m_states.end())
+        {
+            dropTimers();
+            return;
+        }
+    }
+    scheduleLocked(ops);
+    m_idleCv.wait(lock, [this, &ops]() { return m_states.find(&ops) == m_states.end(); });
+    // The last turns may have armed one again, e.g. a periodic sync
+    dropTimers();
+}
+
+void IoExecutor::scheduleLocked(LoggingOps& ops)
+{
+    auto& state = m_states[&ops];
+    if (state.running)
+    {
+        state.again = true;
+        return;
+    }
+    if (state.queued)
+        return;
+
+    state.queued = true;
+    m_ready.push_back(&ops);
+    m_readyCnt.store(m_ready.size(), std::memory_order_release);
+    if (m_externalDrive)
+    {
+        // Readable till the next drain(), once is enough
+        if (m_ready.size() == 1)
+            signalEventFd();
+    }
+    // A polling thread sees it on its own, no need for a futex wake up
+    else if (m_pollingCnt == 0)
+        m_readyCv.notify_one();
+}
+
+void IoExecutor::updateNextTimerDue() noexcept
+{
+    m_nextTimerDue.store(m_timers.empty() ? std::chrono::steady_clock::time_point::max() : m_timers.begin()->first,
+                         std::memory_order_release);
+}
+
+bool IoExecutor::keepPolling(const std::chrono::steady_clock::time_point idleSince,
+                             const std::chrono::steady_clock::time_point now) const noexcept
+{
+    switch (m_waitStrategy.load(std::memory_order_relaxed))
+    {
+        case WaitStrategy::BUSY_POLL:
+            return true;
+        case WaitStrategy::SPIN_THEN_PARK:
+            return now - idleSince < m_spinTime.load(std::memory_order_relaxed);
+        case WaitStrategy::BLOCK:
+            break;
+    }
+    return false;
+}
+
+void IoExecutor::poll(const std::chrono::steady_clock::time_point idleSince) const noexcept
+{
+    // Stopping or handing the turns over to an event loop ends it as well
+    while (m_readyCnt.load(std::memory_order_acquire) == 0 &&
+           !m_stop.load(std::memory_order_relaxed) &&
+           !m_externalDrive.load(std::memory_order_relaxed))
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= m_nextTimerDue.load(std::memory_order_acquire) || !keepPolling(idleSince, now))
+            return;
+
+        cpuRelax();
+    }
+}
+
+size_t IoExecutor::drain(const size_t budget)
+{
+    std::unique_lock<std::mutex> lock(m_mtx);
+#if defined(__linux__)
+    if (m_eventFd >= 0)
+    {
+        std::uint64_t eventCnt = 0;
+        [[maybe_unused]] auto readCnt = ::read(m_eventFd, &eventCnt, sizeof(eventCnt));
+    }
+#endif
+
+    size_t turnCnt = 0;
+    scheduleDueTimers(std::chrono::steady_clock::now());
+    while (turnCnt < budget && !m_ready.empty())
+    {
+        runTurn(lock);
+        ++turnCnt;
+    }
+    // Over budget, the loop comes back for the rest
+    if (!m_ready.empty())
+        signalEventFd();
+    return turnCnt;
+}
+
+int IoExecutor::getDrainTimeout() const noexcept
+{
+    if (m_readyCnt.load(std::memory_order_acquire) > 0)
+        return 0;
+
+    auto nextTimerDue = m_nextTimerDue.load(std::memory_order_acquire);
+    if (nextTimerDue == std::chrono::steady_clock::time_point::max())
+        return -1;
+
+    auto now = std::chrono::steady_clock::now();
+    if (nextTimerDue <= now)
+        return 0;
+    // Rounded up, not to wake up just before it is due
+    auto timeout = std::chrono::ceil<std::chrono::milliseconds>(nextTimerDue - now).count();
+    return static_cast<int>(std::min<int64_t>(timeout, std::numeric_limits<int>::max()));
+}
+
+void IoExecutor::drainSink(LoggingOps& ops)
+{
+    std::unique_lock<std::mutex> lock(m_mtx);
+    // Its turns never overlap, one may well run in the event loop meanwhile
+    m_idleCv.wait(lock, [this, &ops]()
+    {
+        auto stateItr = m_states.find(&ops);
+        return stateItr == m_states.end() || !stateItr->second.running;
+    });
+    auto& state = m_states[&ops];
+    if (state.queued)
+    {
+        m_ready.erase(std::find(m_ready.begin(), m_ready.end(), &ops));
+        m_readyCnt.store(m_ready.size(), std::memory_order_release);
+    }
+    state.queued = false;
+    state.running = true;
+    state.again = false;
+    lock.unlock();
+
+    {
+        DrainTurnScope drainTurnScope;
+        while (ops.drainBatch())
+            ;
+    }
+
+    lock.lock();
+    auto& doneState = m_states[&ops];
+    doneState.running = false;
+    // Whatever got scheduled meanwhile gets a turn of its own
+    if (doneState.again)
+        scheduleLocked(ops);
+    else
+        m_states.erase(&ops);
+    m_idleCv.notify_all();
+}
+
+void IoExecutor::scheduleDueTimers(const std::chrono::steady_clock::time_point now)
+{
+    while (!m_timers.empty() && m_timers.begin()->first <= now)
+    {
+        scheduleLocked(*m_timers.begin()->second);
+        m_timers.erase(m_timers.begin());
+        updateNextTimerDue();
+    }
+}
+
+void IoExecutor::runTurn(std::unique_lock<std::mutex>& lock)
+{
+    auto ops = m_ready.front();
+    m_ready.pop_front();
+    m_readyCnt.store(m_ready.size(), std::memory_order_release);
+    auto& state = m_states[ops];
+    state.queued = false;
+    state.running = true;
+    state.again = false;
+    lock.unlock();
+
+    bool more = false;
+    {
+        DrainTurnScope drainTurnScope;
+        more = ops->drainBatch();
+    }
+
+    lock.lock();
+    auto& doneState = m_states[ops];    // The map may have been rehashed meanwhile
+    doneState.running = false;
+    // What is left gets a turn of its own, behind the other sinks
+    if (more || doneState.again)
+        scheduleLocked(*ops);
+    else
+        m_states.erase(ops);
+    m_idleCv.notify_all();
+}
+
+void IoExecutor::signalEventFd() const noexcept
+{
+#if defined(__linux__)
+    if (m_eventFd >= 0)
+    {
+        std::uint64_t eventCnt = 1;
+        [[maybe_unused]] auto writeCnt = ::write(m_eventFd, &eventCnt, sizeof(eventCnt));
+    }
+#endif
+}
+
+void IoExecutor::run(const size_t idx)
+{
+    std::unique_lock<std::mutex> lock(m_mtx);
+#if defined(__linux__)
+    m_threadIds[idx] = static_cast<pid_t>(::syscall(SYS_gettid));
+#else
+    m_threadIds[idx] = static_cast<pid_t>(idx + 1);
+#endif
+    m_idleCv.notify_all();
+
+    auto idleSince = std::chrono::steady_clock::now();
+    while (!m_externalDrive)
+    {
+        auto now = std::chrono::steady_clock::now();
+        scheduleDueTimers(now);
+
+        if (m_ready.empty())
+        {
+            if (m_stop)
+                break;
+
+            if (keepPolling(idleSince, now))
+            {
+                ++m_pollingCnt;
+                lock.unlock();
+                poll(idleSince);
+                lock.lock();
+                --m_pollingCnt;
+                continue;
+            }
+
+            if (m_timers.empty())
+                m_readyCv.wait(lock);
+            else
+            {
+                // A copy, retire() may well drop the timer while waiting
+                const auto nextDue = m_timers.begin()->first;
+                m_readyCv.wait_until(lock, nextDue);
+            }
+            // Woken up for a turn most likely, polling again after it
+            idleSince = std::chrono::steady_clock::now();
+            continue;
+        }
+
+        runTurn(lock);
+        idleSince = std::chrono::steady_clock::now();
+    }
+}
@@ -0,0 +1,174 @@
+/*
+ * JsonEscaper.cpp
+ *
+ * Implementation of the JsonEscaper class. A character has to be escaped if it
+ * is a quote, a backslash or below 0x20, the latter being checked with an
+ * unsigned max against 0x1F since the vector compares are signed. The AVX2
+ * kernel is compiled with a function level target attribute, as in LineScanner.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "JsonEscaper.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define JSON_ESCAPER_X86
+#include <immintrin.h>
+#endif
+
+using namespace logger;
+
+namespace
+{
+    using FindFunc = const char* (*)(const char*, const char*);
+
+    inline bool isSpecial(const char chr) noexcept
+    {
+        return static_cast<unsigned char>(chr) < 0x20 || chr == '"' || chr == '\\';
+    }
+
+    const char* findScalar(const char* begin, const char* end)
+    {
+        for (; begin < end; ++begin)
+        {
+            if (isSpecial(*begin))
+                return begin;
+        }
+        return end;
+    }
+
+#ifdef JSON_ESCAPER_X86
+    const char* findSse2(const char* begin, const char* end)
+    {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i ctrlMax = _mm_set1_epi8(0x1F);
+        for (; end - begin >= 16; begin += 16)
+        {
+            auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            auto special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                        _mm_cmpeq_epi8(_mm_max_epu8(chunk, ctrlMax), ctrlMax));
+            auto mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+            if (mask)
+                return begin + __builtin_ctz(mask);
+        }
+        return findScalar(begin, end);
+    }
+
+    __attribute__((target("avx2")))
+    const char* findAvx2(const char* begin, const char* end)
+    {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i ctrlMax = _mm256_set1_epi8(0x1F);
+        for (; end - begin >= 32; begin += 32)
+        {
+            auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+            auto special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+                                           _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, ctrlMax), ctrlMax));
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(special));
+            if (mask)
+                return begin + __builtin_ctz(mask);
+        }
+        return findSse2(begin, end);
+    }
+#endif  // JSON_ESCAPER_X86
+
+    FindFunc getFindFunc(const LineScanner::Isa isa)
+    {
+#ifdef JSON_ESCAPER_X86
+        switch (isa)
+        {
+            case LineScanner::Isa::AVX2:
+                return findAvx2;
+            case LineScanner::Isa::SSE2:
+                return findSse2;
+            case LineScanner::Isa::SCALAR:
+                break;
+        }
+#else
+        (void)isa;
+#endif
+        return findScalar;
+    }
+
+    /**
+     * @brief The kernel of the best instruction set, detected once
+     */
+    FindFunc getBestFindFunc()
+    {
+        static const FindFunc findFunc = getFindFunc(LineScanner::getIsa());
+        return findFunc;
+    }
+
+    void appendEscaped(std::string& out, const char chr)
+    {
+        static constexpr char hexDigits[] = "0123456789abcdef";
+        switch (chr)
+        {
+            case '"':   out.append("\\\"");  return;
+            case '\\':  out.append("\\\\"); return;
+            case '\b':  out.append("\\b");   return;
+            case '\f':  out.append("\\f");   return;
+            case '\n':  out.append("\\n");   return;
+            case '\r':  out.append("\\r");   return;
+            case '\t':  out.append("\\t");   return;
+            default:
+                break;
+        }
+        auto code = static_cast<unsigned char>(chr);
+        const char unicodeEscape[] = { '\\', 'u', '0', '0', hexDigits[code >> 4], hexDigits[code & 0x0F] };
+        out.append(unicodeEscape, sizeof(unicodeEscape));
+    }
+
+    void escapeWith(std::string& out, const std::string_view in, const FindFunc findFunc)
+    {
+        const char* begin = in.data();
+        const char* end = begin + in.size();
+        out.reserve(out.size() + in.size());
+        while (begin < end)
+        {
+            auto special = findFunc(begin, end);
+            out.append(begin, special);
+            if (special == end)
+                break;
+
+            appendEscaped(out, *special);
+            begin = special + 1;
+        }
+    }
+};
+
+/*static*/ void JsonEscaper::escape(std::string& out, const std::string_view in)
+{
+    escapeWith(out, in, getBestFindFunc());
+}
+
+/*static*/ void JsonEscaper::escape(std::string& out, const std::string_view in, const LineScanner::Isa isa)
+{
+    escapeWith(out, in, getFindFunc(LineScanner::isSupported(isa) ? isa : LineScanner::getIsa()));
+}
+
+/*static*/ const char* JsonEscaper::findSpecial(const char* begin, const char* end, const LineScanner::Isa isa) noexcept
+{
+    return getFindFunc(LineScanner::isSupported(isa) ? isa : LineScanner::getIsa())(begin, end);
+}
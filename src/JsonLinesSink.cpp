@@ -0,0 +1,256 @@
+/*
+ * JsonLinesSink.cpp
+ *
+ * Implementation of the JsonLinesSink class. The records are rendered into one
+ * buffer per batch, reused from batch to batch, and appended to the file with a
+ * single write(2). The strings are escaped with the JsonEscaper.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "JsonLinesSink.hpp"
+#include "JsonEscaper.hpp"
+#include "Logger.hpp"
+#include "FileOps.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief Fold a hash into another one
+     */
+    inline size_t combineHash(const size_t hash, const size_t other) noexcept
+    {
+        return hash ^ (other + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+    }
+
+    /**
+     * @brief Get the name of a log type, as in the text logs
+     */
+    std::string_view getLevelName(const LOG_TYPE logType)
+    {
+        static const auto levelNames = []()
+        {
+            std::array<std::string, 256> names;
+            for (auto type : { LOG_TYPE::LOG_ERR, LOG_TYPE::LOG_INFO, LOG_TYPE::LOG_DBG, LOG_TYPE::LOG_FATAL,
+                               LOG_TYPE::LOG_WARN, LOG_TYPE::LOG_IMP, LOG_TYPE::LOG_ASSERT, LOG_TYPE::LOG_DEFAULT })
+                names[static_cast<uint8_t>(type)] = Logger::covertLogTypeEnumToString(type);
+            return names;
+        }();
+        return levelNames[static_cast<uint8_t>(logType)];
+    }
+
+    /**
+     * @brief Append a number with std::to_chars
+     */
+    template<typename T>
+    void appendNumber(std::string& out, const T value)
+    {
+        std::array<char, 32> buffer;
+        auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        out.append(buffer.data(), result.ptr);
+    }
+
+    /**
+     * @brief Append the fields of a record as the members of a "fields" object
+     */
+    void appendFields(std::string& out, const std::span<const LogField> fields)
+    {
+        out.append(",\"fields\":{");
+        for (const auto& field : fields)
+        {
+            if (&field != &fields.front())
+                out.push_back(',');
+            out.push_back('"');
+            JsonEscaper::escape(out, field.key);
+            out.append("\":");
+            switch (field.getType())
+            {
+                case LogField::Type::BOOL:
+                    out.append(std::get<bool>(field.value) ? "true" : "false");
+                    break;
+                case LogField::Type::INT:
+                    appendNumber(out, std::get<int64_t>(field.value));
+                    break;
+                case LogField::Type::UINT:
+                    appendNumber(out, std::get<uint64_t>(field.value));
+                    break;
+                case LogField::Type::DOUBLE:
+                {
+                    // JSON has no NaN nor infinity
+                    auto value = std::get<double>(field.value);
+                    if (std::isfinite(value))
+                        appendNumber(out, value);
+                    else
+                        out.append("null");
+                    break;
+                }
+                case LogField::Type::STRING:
+                    out.push_back('"');
+                    JsonEscaper::escape(out, std::get<std::string_view>(field.value));
+                    out.push_back('"');
+                    break;
+            }
+        }
+        out.push_back('}');
+    }
+};
+
+JsonLinesSink::JsonLinesSink(const std::filesystem::path& file)
+    : m_file(file)
+    , m_fd(-1)
+    , m_buffer()
+    , m_callSites()
+    , m_threads()
+    , m_renderedSecond(-1)
+    , m_secondStr()
+{
+    m_fd = ::open(m_file.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (m_fd < 0)
+        throw std::runtime_error("JSON_LOG_ERROR : File " + m_file.string() + " can't be opened: " + std::strerror(errno));
+}
+
+JsonLinesSink::~JsonLinesSink()
+{
+    ::close(m_fd);
+}
+
+void JsonLinesSink::consume(std::span<const LogRecord> records)
+{
+    m_buffer.clear();
+    for (const auto& record : records)
+        render(record, m_buffer);
+
+    if (FileOps::writeAll(m_fd, m_buffer) < m_buffer.size())
+        throw std::runtime_error("JSON_LOG_ERROR : File " + m_file.string() + " can't be written: " + std::strerror(errno));
+}
+
+void JsonLinesSink::flush()
+{
+    if (::fdatasync(m_fd) != 0)
+        throw std::runtime_error("JSON_LOG_ERROR : File " + m_file.string() + " can't be synced: " + std::strerror(errno));
+}
+
+void JsonLinesSink::render(const LogRecord& record, std::string& out)
+{
+    out.append("{\"timestamp\":\"");
+    appendTimestamp(record.timestamp, out);
+    out.append("\",\"level\":\"").append(getLevelName(record.logType));
+    out.append("\",\"tid\":\"").append(getThreadField(record.threadId)).append("\"");
+
+    // Only a record rendered by the Logger has a call site and a message of its own
+    auto hasCallSite = record.hasCallSite();
+    out.append(hasCallSite ? getCallSiteFields(record) : std::string());
+    out.append(",\"message\":\"");
+    if (hasCallSite)
+    {
+        // Past the "[Class : function] " part, the assertion details if any are part of the message
+        auto context = record.text.substr(record.prefixSize, record.msgOffset - record.prefixSize);
+        auto contextEnd = context.find(RIGHT_SQUARE_BRACE);
+        if (contextEnd != std::string_view::npos)
+            context.remove_prefix(std::min(context.size(), contextEnd + RIGHT_SQUARE_BRACE.size() + ONE_SPACE.size()));
+        JsonEscaper::escape(out, context);
+        JsonEscaper::escape(out, record.text.substr(record.msgOffset));
+    }
+    else
+    {
+        JsonEscaper::escape(out, record.text);
+    }
+    out.push_back('"');
+    if (!record.fields.empty())
+        appendFields(out, record.fields);
+    out.append("}\n");
+}
+
+const std::string& JsonLinesSink::getCallSiteFields(const LogRecord& record)
+{
+    // Not keyed by the address of the file name, the views point into the copy of the
+    // batch rather than at the literals of the call site. Hashed instead, nothing gets
+    // allocated for a call site seen already.
+    auto key = combineHash(std::hash<std::string_view>()(record.fileName), std::hash<std::string_view>()(record.funcName));
+    auto& callSite = m_callSites[combineHash(key, record.lineNo)];
+    if (!callSite.fields.empty() && callSite.lineNo == record.lineNo &&
+        callSite.fileName == record.fileName && callSite.funcName == record.funcName)
+        return callSite.fields;
+
+    std::string className;
+    std::string funcName;
+    Logger::extractClassAndFuncName(record.funcName, className, funcName);
+
+    std::string fields = ",\"file\":\"";
+    JsonEscaper::escape(fields, record.getBaseFileName());
+    fields.append("\",\"line\":").append(std::to_string(record.lineNo));
+    fields.append(",\"class\":\"");
+    JsonEscaper::escape(fields, className);
+    fields.append("\",\"function\":\"");
+    JsonEscaper::escape(fields, funcName);
+    fields.append("\"");
+    // A collision, if any, takes the place over
+    callSite.fileName = record.fileName;
+    callSite.funcName = record.funcName;
+    callSite.lineNo = record.lineNo;
+    callSite.fields = std::move(fields);
+    return callSite.fields;
+}
+
+const std::string& JsonLinesSink::getThreadField(const std::thread::id& threadId)
+{
+    auto itr = m_threads.find(threadId);
+    if (itr != m_threads.end())
+        return itr->second;
+
+    std::string field;
+    JsonEscaper::escape(field, LogRecord::getThreadIdText(threadId));
+    return m_threads.emplace(threadId, std::move(field)).first->second;
+}
+
+void JsonLinesSink::appendTimestamp(const std::chrono::system_clock::time_point& timestamp, std::string& out)
+{
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(timestamp.time_since_epoch()).count();
+    auto second = micros / 1000000 - (micros % 1000000 < 0 ? 1 : 0);
+    if (second != m_renderedSecond)
+    {
+        auto timeT = static_cast<std::time_t>(second);
+        std::tm utcTm = {};
+        ::gmtime_r(&timeT, &utcTm);
+        std::array<char, 32> buffer = {};
+        std::strftime(buffer.data(), buffer.size(), "%Y-%m-%dT%H:%M:%S", &utcTm);
+        m_secondStr = buffer.data();
+        m_renderedSecond = second;
+    }
+    auto fraction = std::to_string(micros - second * 1000000);
+    out.append(m_secondStr).append(".");
+    out.append(6 - fraction.size(), '0').append(fraction).append("Z");
+}
@@ -0,0 +1,242 @@
+/*
+ * LineIndex.cpp
+ *
+ * Implementation of the LineIndex class, which keeps a sparse line number
+ * to byte offset index of a log file in a sidecar file.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LineIndex.hpp"
+#include "LineScanner.hpp"
+
+#include <array>
+#include <cstring>
+#include <cerrno>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace logger;
+
+namespace
+{
+    constexpr std::array<char, 8> indexMagic = { 'L', 'O', 'G', 'I', 'D', 'X', '0', '1' };
+    constexpr size_t headerSize = indexMagic.size() + 3 * sizeof(std::uint64_t);
+    constexpr size_t scanChunkSize = 64 * 1024;
+
+    /**
+     * @brief Write the whole buffer at an offset, retrying on short writes
+     */
+    bool writeAllAt(const int fd, const char* data, size_t len, off_t offset)
+    {
+        while (len > 0)
+        {
+            auto retVal = ::pwrite(fd, data, len, offset);
+            if (retVal < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            data += retVal;
+            len -= static_cast<size_t>(retVal);
+            offset += retVal;
+        }
+        return true;
+    }
+};
+
+/*static*/ std::filesystem::path LineIndex::getIndexFilePath(const std::filesystem::path& file)
+{
+    auto indexFile = file;
+    indexFile += ".idx";
+    return indexFile;
+}
+
+LineIndex::LineIndex(const std::filesystem::path& file, const size_t stride)
+    : m_file(file)
+    , m_indexFile(getIndexFilePath(file))
+    , m_stride(stride ? stride : 1)
+    , m_lineCount(0)
+    , m_indexedSize(0)
+    , m_offsets(1, 0)
+    , m_persistedCnt(0)
+{
+}
+
+void LineIndex::refresh()
+{
+    std::error_code ec;
+    auto fileSize = std::filesystem::file_size(m_file, ec);
+    if (ec)
+        fileSize = 0;
+
+    // Nothing indexed in this process yet, see if a former one left an index behind
+    if (m_indexedSize == 0 && m_persistedCnt == 0)
+        load();
+
+    // The file got truncated, cleared or replaced since it was indexed
+    if (m_indexedSize > fileSize)
+    {
+        m_lineCount = 0;
+        m_indexedSize = 0;
+        m_offsets.assign(1, 0);
+        m_persistedCnt = 0;
+    }
+
+    if (m_indexedSize < fileSize)
+        scanFile();
+
+    persist();
+}
+
+void LineIndex::append(const char* data, const size_t len)
+{
+    const char* begin = data;
+    const char* end = data + len;
+    while (begin < end)
+    {
+        auto newLine = LineScanner::findNewLine(begin, end);
+        if (newLine == end)
+            break;
+
+        ++m_lineCount;
+        if (m_lineCount % m_stride == 0)
+            m_offsets.push_back(m_indexedSize + (newLine - data) + 1);
+        begin = newLine + 1;
+    }
+    m_indexedSize += len;
+}
+
+void LineIndex::persist()
+{
+    // A fresh index is written as a whole, otherwise only the
+    // new entries get appended and the header gets updated
+    auto fresh = (m_persistedCnt == 0) || !std::filesystem::exists(m_indexFile);
+    int fd = ::open(m_indexFile.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (fresh ? O_TRUNC : 0), 0644);
+    if (fd < 0)
+        throw std::runtime_error("INDEX_ERROR : Index file " + m_indexFile.string() + " can't be opened: " + std::strerror(errno));
+
+    if (fresh)
+        m_persistedCnt = 0;
+
+    std::array<char, headerSize> header;
+    std::array<std::uint64_t, 3> fields = { m_stride, m_lineCount, m_indexedSize };
+    std::memcpy(header.data(), indexMagic.data(), indexMagic.size());
+    std::memcpy(header.data() + indexMagic.size(), fields.data(), sizeof(fields));
+
+    auto newEntries = m_offsets.size() - m_persistedCnt;
+    std::vector<std::uint64_t> entries(m_offsets.begin() + m_persistedCnt, m_offsets.end());
+    auto success = writeAllAt(fd,
+                              reinterpret_cast<const char*>(entries.data()),
+                              newEntries * sizeof(std::uint64_t),
+                              static_cast<off_t>(headerSize + m_persistedCnt * sizeof(std::uint64_t)));
+    // The header goes last, so that it never counts entries which are not there
+    success = success && writeAllAt(fd, header.data(), header.size(), 0);
+    auto errNo = errno;
+    ::close(fd);
+    if (!success)
+        throw std::runtime_error("INDEX_ERROR : Index file " + m_indexFile.string() + " can't be written: " + std::strerror(errNo));
+
+    m_persistedCnt = m_offsets.size();
+}
+
+void LineIndex::reset()
+{
+    m_lineCount = 0;
+    m_indexedSize = 0;
+    m_offsets.assign(1, 0);
+    m_persistedCnt = 0;
+    std::error_code ec;
+    std::filesystem::remove(m_indexFile, ec);
+}
+
+std::pair<std::uintmax_t, size_t> LineIndex::seekLine(const size_t lineNo) const
+{
+    size_t entry = (lineNo > 0) ? (lineNo - 1) / m_stride : 0;
+    if (entry >= m_offsets.size())
+        entry = m_offsets.size() - 1;
+
+    return { m_offsets[entry], entry * m_stride + 1 };
+}
+
+bool LineIndex::load()
+{
+    std::ifstream indexFile(m_indexFile, std::ios::binary);
+    if (!indexFile)
+        return false;
+
+    std::array<char, headerSize> header;
+    if (!indexFile.read(header.data(), header.size()) ||
+        std::memcmp(header.data(), indexMagic.data(), indexMagic.size()) != 0)
+        return false;
+
+    std::array<std::uint64_t, 3> fields;
+    std::memcpy(fields.data(), header.data() + indexMagic.size(), sizeof(fields));
+    if (fields[0] != m_stride)
+        return false;   // Built with another stride, rebuild it
+
+    auto entryCnt = static_cast<size_t>(fields[1] / m_stride) + 1;
+    std::vector<std::uint64_t> entries(entryCnt);
+    if (!indexFile.read(reinterpret_cast<char*>(entries.data()), entryCnt * sizeof(std::uint64_t)))
+        return false;
+
+    // The line recorded last must still start right after a new line,
+    // or else the file got replaced by another one meanwhile
+    if (entries.back() > 0)
+    {
+        std::ifstream file(m_file, std::ios::binary);
+        char prevChar = '\0';
+        if (!file.seekg(static_cast<std::streamoff>(entries.back() - 1)) || !file.get(prevChar) || prevChar != '\n')
+            return false;
+    }
+
+    m_lineCount = static_cast<size_t>(fields[1]);
+    m_indexedSize = fields[2];
+    m_offsets.assign(entries.begin(), entries.end());
+    m_persistedCnt = m_offsets.size();
+    return true;
+}
+
+void LineIndex::scanFile()
+{
+    std::ifstream file(m_file, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("INDEX_ERROR : File " + m_file.string() + " can't be opened for indexing");
+
+    file.seekg(static_cast<std::streamoff>(m_indexedSize));
+    std::vector<char> chunk(scanChunkSize);
+    while (file)
+    {
+        file.read(chunk.data(), chunk.size());
+        auto readCnt = static_cast<size_t>(file.gcount());
+        if (readCnt == 0)
+            break;
+
+        append(chunk.data(), readCnt);
+    }
+    if (file.bad())
+        throw std::runtime_error("INDEX_ERROR : File " + m_file.string() + " can't be read for indexing");
+}
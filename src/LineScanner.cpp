@@ -0,0 +1,233 @@
+/*
+ * LineScanner.cpp
+ *
+ * Implementation of the LineScanner class. The AVX2 kernels are compiled with
+ * a function level target attribute, so that the library itself needs no
+ * -mavx2 and still runs on CPUs without it, the choice being made at runtime.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LineScanner.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LINE_SCANNER_X86
+#include <immintrin.h>
+#endif
+
+using namespace logger;
+
+namespace
+{
+    using FindFunc = const char* (*)(const char*, const char*);
+    using CountFunc = size_t (*)(const char*, const char*);
+
+    /**
+     * @brief The kernels of one instruction set
+     */
+    struct Kernels
+    {
+        FindFunc find;
+        CountFunc count;
+    };
+
+    const char* findScalar(const char* begin, const char* end)
+    {
+        auto found = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+        return found ? found : end;
+    }
+
+    size_t countScalar(const char* begin, const char* end)
+    {
+        size_t count = 0;
+        for (; begin < end; ++begin)
+            count += (*begin == '\n');
+        return count;
+    }
+
+#ifdef LINE_SCANNER_X86
+    const char* findSse2(const char* begin, const char* end)
+    {
+        const __m128i newLine = _mm_set1_epi8('\n');
+        for (; end - begin >= 16; begin += 16)
+        {
+            auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newLine)));
+            if (mask)
+                return begin + __builtin_ctz(mask);
+        }
+        return findScalar(begin, end);
+    }
+
+    size_t countSse2(const char* begin, const char* end)
+    {
+        const __m128i newLine = _mm_set1_epi8('\n');
+        size_t count = 0;
+        for (; end - begin >= 16; begin += 16)
+        {
+            auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            count += __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newLine))));
+        }
+        return count + countScalar(begin, end);
+    }
+
+    __attribute__((target("avx2")))
+    const char* findAvx2(const char* begin, const char* end)
+    {
+        const __m256i newLine = _mm256_set1_epi8('\n');
+        for (; end - begin >= 32; begin += 32)
+        {
+            auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newLine)));
+            if (mask)
+                return begin + __builtin_ctz(mask);
+        }
+        return findSse2(begin, end);
+    }
+
+    __attribute__((target("avx2")))
+    size_t countAvx2(const char* begin, const char* end)
+    {
+        const __m256i newLine = _mm256_set1_epi8('\n');
+        size_t count = 0;
+        // Four vectors a round, to keep more loads in flight
+        for (; end - begin >= 128; begin += 128)
+        {
+            auto mask0 = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin)), newLine)));
+            auto mask1 = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + 32)), newLine)));
+            auto mask2 = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + 64)), newLine)));
+            auto mask3 = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + 96)), newLine)));
+            count += __builtin_popcount(mask0) + __builtin_popcount(mask1)
+                   + __builtin_popcount(mask2) + __builtin_popcount(mask3);
+        }
+        for (; end - begin >= 32; begin += 32)
+        {
+            auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+            count += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newLine))));
+        }
+        return count + countSse2(begin, end);
+    }
+#endif  // LINE_SCANNER_X86
+
+    const Kernels& getKernels(const LineScanner::Isa isa)
+    {
+        static const Kernels scalarKernels = { findScalar, countScalar };
+#ifdef LINE_SCANNER_X86
+        static const Kernels sse2Kernels = { findSse2, countSse2 };
+        static const Kernels avx2Kernels = { findAvx2, countAvx2 };
+        switch (isa)
+        {
+            case LineScanner::Isa::AVX2:
+                return avx2Kernels;
+            case LineScanner::Isa::SSE2:
+                return sse2Kernels;
+            case LineScanner::Isa::SCALAR:
+                break;
+        }
+#else
+        (void)isa;
+#endif
+        return scalarKernels;
+    }
+
+    /**
+     * @brief The kernels of the best instruction set, detected once
+     */
+    const Kernels& getBestKernels()
+    {
+        static const Kernels& kernels = getKernels(LineScanner::getIsa());
+        return kernels;
+    }
+};
+
+/*static*/ bool LineScanner::isSupported(const Isa isa) noexcept
+{
+    switch (isa)
+    {
+        case Isa::SCALAR:
+            return true;
+#ifdef LINE_SCANNER_X86
+        case Isa::SSE2:
+            return __builtin_cpu_supports("sse2");
+        case Isa::AVX2:
+            return __builtin_cpu_supports("avx2");
+#else
+        case Isa::SSE2:
+        case Isa::AVX2:
+            return false;
+#endif
+    }
+    return false;
+}
+
+/*static*/ LineScanner::Isa LineScanner::getIsa() noexcept
+{
+    static const Isa isa = []()
+    {
+        if (isSupported(Isa::AVX2))
+            return Isa::AVX2;
+        if (isSupported(Isa::SSE2))
+            return Isa::SSE2;
+        return Isa::SCALAR;
+    }();
+    return isa;
+}
+
+/*static*/ std::string LineScanner::getIsaName(const Isa isa)
+{
+    switch (isa)
+    {
+        case Isa::SCALAR:
+            return "SCALAR";
+        case Isa::SSE2:
+            return "SSE2";
+        case Isa::AVX2:
+            return "AVX2";
+    }
+    return "";
+}
+
+/*static*/ const char* LineScanner::findNewLine(const char* begin, const char* end) noexcept
+{
+    return getBestKernels().find(begin, end);
+}
+
+/*static*/ size_t LineScanner::countNewLines(const char* begin, const char* end) noexcept
+{
+    return getBestKernels().count(begin, end);
+}
+
+/*static*/ size_t LineScanner::countNewLines(const char* begin, const char* end, const Isa isa) noexcept
+{
+    return getKernels(isSupported(isa) ? isa : getIsa()).count(begin, end);
+}
+
+/*static*/ const char* LineScanner::findNewLine(const char* begin, const char* end, const Isa isa) noexcept
+{
+    return getKernels(isSupported(isa) ? isa : getIsa()).find(begin, end);
+}
@@ -0,0 +1,124 @@
+/*
+ * LogField.cpp
+ *
+ * Implementation of the LogField struct, the text rendering of the fields.
+ * The numbers are rendered with std::to_chars, without any locale.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LogField.hpp"
+
+#include <array>
+#include <charconv>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief Append a number with std::to_chars
+     */
+    template<typename T>
+    void appendNumber(std::string& out, const T value)
+    {
+        std::array<char, 32> buffer;
+        auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        out.append(buffer.data(), result.ptr);
+    }
+
+    bool needsQuotes(const std::string_view value) noexcept
+    {
+        if (value.empty())
+            return true;
+
+        for (auto chr : value)
+        {
+            if (chr == ' ' || chr == '=' || chr == '"' || static_cast<unsigned char>(chr) < 0x20)
+                return true;
+        }
+        return false;
+    }
+
+    void appendString(std::string& out, const std::string_view value)
+    {
+        if (!needsQuotes(value))
+        {
+            out.append(value);
+            return;
+        }
+
+        out.push_back('"');
+        for (auto chr : value)
+        {
+            switch (chr)
+            {
+                case '"':
+                    out.append("\\\"");
+                    break;
+                case '\\':
+                    out.append("\\\\");
+                    break;
+                case '\n':
+                    out.append("\\n");
+                    break;
+                case '\r':
+                    out.append("\\r");
+                    break;
+                case '\t':
+                    out.append("\\t");
+                    break;
+                default:
+                    out.push_back(chr);
+            }
+        }
+        out.push_back('"');
+    }
+};
+
+/*static*/ void LogField::appendText(std::string& out, const std::span<const LogField> fields)
+{
+    for (const auto& field : fields)
+    {
+        out.push_back(' ');
+        out.append(field.key);
+        out.push_back('=');
+        switch (field.getType())
+        {
+            case Type::BOOL:
+                out.append(std::get<bool>(field.value) ? "true" : "false");
+                break;
+            case Type::INT:
+                appendNumber(out, std::get<int64_t>(field.value));
+                break;
+            case Type::UINT:
+                appendNumber(out, std::get<uint64_t>(field.value));
+                break;
+            case Type::DOUBLE:
+                appendNumber(out, std::get<double>(field.value));
+                break;
+            case Type::STRING:
+                appendString(out, std::get<std::string_view>(field.value));
+                break;
+        }
+    }
+}
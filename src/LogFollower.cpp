@@ -0,0 +1,407 @@
+/*
+ * LogFollower.cpp
+ *
+ * Implementation of the LogFollower class. The directory of the log is
+ * watched by a DirWatch, so that writes, renames and creations wake the
+ * follower thread up; without inotify, and as a safety net, the file is
+ * looked at every poll period.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LogFollower.hpp"
+#include "LogSearch.hpp"
+#include "FileOps.hpp"
+#include "LineScanner.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using namespace logger;
+
+namespace
+{
+    constexpr size_t readChunkSize = 64 * 1024;
+};
+
+LogFollower::LogFollower(const std::filesystem::path& file,
+                         LineCallback callback,
+                         const Checkpoint& checkpoint,
+                         const std::chrono::milliseconds pollPeriod)
+    : m_filePath(file)
+    , m_callback(std::move(callback))
+    , m_pollPeriod(pollPeriod)
+    , m_fd(-1)
+    , m_inode(0)
+    , m_readOffset(0)
+    , m_checkpoint(checkpoint)
+    , m_dirWatch()
+    , m_running(false)
+{
+}
+
+LogFollower::LogFollower(FileOps& fileOps,
+                         LineCallback callback,
+                         const Checkpoint& checkpoint,
+                         const std::chrono::milliseconds pollPeriod)
+    : LogFollower(fileOps.getFilePathObj(), std::move(callback), checkpoint, pollPeriod)
+{
+}
+
+LogFollower::~LogFollower()
+{
+    stop();
+}
+
+bool LogFollower::start()
+{
+    if (m_running)
+        return false;
+
+    // Any change of the directory, the creation of the new file after a
+    // rotation as well as the writes into the current one
+    if (!m_dirWatch.open(m_filePath, DirWatchEvents::ANY))
+        return false;
+
+    m_running = true;
+    m_followThread = std::thread(&LogFollower::follow, this);
+    return true;
+}
+
+void LogFollower::stop()
+{
+    if (!m_running)
+        return;
+
+    m_running = false;
+    m_dirWatch.wakeup();
+    if (m_followThread.joinable())
+        m_followThread.join();
+    m_dirWatch.close();
+}
+
+LogFollower::Checkpoint LogFollower::getCheckpoint() const
+{
+    std::scoped_lock<std::mutex> lock(m_checkpointMtx);
+    return m_checkpoint;
+}
+
+std::vector<std::exception_ptr> LogFollower::getAllExceptions() const
+{
+    std::scoped_lock<std::mutex> lock(m_excpMtx);
+    return m_excpPtrVec;
+}
+
+/*static*/ bool LogFollower::saveCheckpoint(const std::filesystem::path& checkpointFile, const Checkpoint& checkpoint) noexcept
+{
+    try
+    {
+        // Written aside and renamed, so that a crash never leaves half a checkpoint
+        auto tmpFile = checkpointFile;
+        tmpFile += ".tmp";
+        {
+            std::ofstream ofile(tmpFile, std::ios::trunc);
+            ofile << checkpoint.inode << ' ' << checkpoint.offset << '\n';
+            if (!ofile.flush())
+                return false;
+        }
+        std::filesystem::rename(tmpFile, checkpointFile);
+        return true;
+    }
+    catch(...)
+    {
+        return false;
+    }
+}
+
+/*static*/ LogFollower::Checkpoint LogFollower::loadCheckpoint(const std::filesystem::path& checkpointFile) noexcept
+{
+    Checkpoint checkpoint;
+    std::ifstream ifile(checkpointFile);
+    if (!(ifile >> checkpoint.inode >> checkpoint.offset))
+        return Checkpoint();
+
+    return checkpoint;
+}
+
+void LogFollower::follow()
+{
+    try
+    {
+        openAtCheckpoint();
+    }
+    catch(...)
+    {
+        std::scoped_lock<std::mutex> lock(m_excpMtx);
+        m_excpPtrVec.emplace_back(std::current_exception());
+    }
+
+    while (m_running)
+    {
+        try
+        {
+            if (m_fd < 0)
+                reopenFile();
+
+            if (m_fd >= 0)
+            {
+                readToEnd(false);
+                if (isRotated())
+                {
+                    // The rest of the rotated file, even what the writer may still
+                    // put into it, is read from its archive by reopenFile()
+                    closeFile();
+                    if (reopenFile())
+                        continue;
+                }
+            }
+        }
+        catch(...)
+        {
+            std::scoped_lock<std::mutex> lock(m_excpMtx);
+            m_excpPtrVec.emplace_back(std::current_exception());
+        }
+        waitForChange();
+    }
+    closeFile();
+}
+
+void LogFollower::openAtCheckpoint()
+{
+    auto checkpoint = getCheckpoint();
+    struct stat fileStat = {};
+    auto exists = (::stat(m_filePath.c_str(), &fileStat) == 0);
+    if (checkpoint.inode == 0 || (exists && fileStat.st_ino == checkpoint.inode))
+    {
+        if (openFile())
+        {
+            // A file shorter than the checkpoint got truncated meanwhile, start over
+            if (checkpoint.offset <= static_cast<std::uint64_t>(fileStat.st_size))
+                m_readOffset = checkpoint.offset;
+            std::scoped_lock<std::mutex> lock(m_checkpointMtx);
+            m_checkpoint = { m_inode, m_readOffset };
+        }
+        return;
+    }
+
+    // The file got rotated since the checkpoint was taken, finish the
+    // archive it is in and every archive rotated after it first
+    m_inode = checkpoint.inode;
+    m_readOffset = checkpoint.offset;
+    reopenFile();
+}
+
+bool LogFollower::reopenFile()
+{
+    // Opened before the archives are looked for, a file rotated in between
+    // is then among them rather than skipped
+    auto fd = ::open(m_filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    struct stat fileStat = {};
+    if (::fstat(fd, &fileStat) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // The same file, taken up where it was left
+    if (m_inode == fileStat.st_ino)
+    {
+        m_fd = fd;
+        return true;
+    }
+
+    // More than one rotation may have happened since the last file was read
+    if (m_inode != 0)
+        readArchives(fileStat.st_ino);
+
+    m_fd = fd;
+    m_inode = fileStat.st_ino;
+    m_readOffset = 0;
+    m_partialLine.clear();
+    std::scoped_lock<std::mutex> lock(m_checkpointMtx);
+    m_checkpoint = { m_inode, 0 };
+    return true;
+}
+
+bool LogFollower::readArchives(const std::uint64_t currentInode)
+{
+    auto inode = m_inode;
+    auto files = LogSearch::discoverFiles(m_filePath);
+    if (!files.empty() && files.back() == m_filePath)
+        files.pop_back();   // The current file is not an archive
+
+    auto archive = std::find_if(files.begin(), files.end(), [inode](const std::filesystem::path& file)
+    {
+        struct stat archiveStat = {};
+        return ::stat(file.c_str(), &archiveStat) == 0 && archiveStat.st_ino == inode;
+    });
+    if (archive == files.end())
+        return false;
+
+    // The first one is taken up where it was left, the others from their beginning
+    for (auto first = archive; archive != files.end(); ++archive)
+    {
+        m_fd = ::open(archive->c_str(), O_RDONLY | O_CLOEXEC);
+        if (m_fd < 0)
+            continue;
+
+        if (archive != first)
+        {
+            struct stat archiveStat = {};
+            ::fstat(m_fd, &archiveStat);
+            // Rotated since it got opened, it is read as the current file
+            if (archiveStat.st_ino == currentInode)
+            {
+                closeFile();
+                break;
+            }
+            m_inode = archiveStat.st_ino;
+            m_readOffset = 0;
+            m_partialLine.clear();
+        }
+        readToEnd(true);
+        closeFile();
+    }
+    return true;
+}
+
+bool LogFollower::openFile()
+{
+    m_fd = ::open(m_filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0)
+        return false;
+
+    struct stat fileStat = {};
+    if (::fstat(m_fd, &fileStat) != 0)
+    {
+        closeFile();
+        return false;
+    }
+    m_inode = fileStat.st_ino;
+    m_readOffset = 0;
+    m_partialLine.clear();
+    std::scoped_lock<std::mutex> lock(m_checkpointMtx);
+    m_checkpoint = { m_inode, 0 };
+    return true;
+}
+
+void LogFollower::closeFile() noexcept
+{
+    if (m_fd >= 0)
+        ::close(m_fd);
+    m_fd = -1;
+}
+
+void LogFollower::readToEnd(const bool finalRead)
+{
+    struct stat fileStat = {};
+    if (::fstat(m_fd, &fileStat) == 0 && static_cast<std::uint64_t>(fileStat.st_size) < m_readOffset)
+    {
+        // Truncated (e.g. FileOps::clearFile()), read it again from its beginning
+        m_readOffset = 0;
+        m_partialLine.clear();
+    }
+
+    Checkpoint checkpoint = { m_inode, m_readOffset - m_partialLine.size() };
+    auto deliver = [this, &checkpoint](std::string_view line, const std::uint64_t lineEnd)
+    {
+        checkpoint.offset = lineEnd;
+        try
+        {
+            m_callback(line, checkpoint);
+        }
+        catch(...)
+        {
+            std::scoped_lock<std::mutex> lock(m_excpMtx);
+            m_excpPtrVec.emplace_back(std::current_exception());
+        }
+    };
+
+    while (m_running || finalRead)
+    {
+        auto readCnt = FileOps::readFileByteRange(m_fd, m_readOffset, m_readOffset + readChunkSize, m_readBuff);
+        if (readCnt == 0)
+            break;
+
+        const char* begin = m_readBuff.data();
+        const char* end = begin + readCnt;
+        while (begin < end)
+        {
+            auto newLine = LineScanner::findNewLine(begin, end);
+            if (newLine == end)
+            {
+                m_partialLine.append(begin, end);
+                break;
+            }
+
+            auto lineEnd = m_readOffset + static_cast<std::uint64_t>(newLine - m_readBuff.data()) + 1;
+            if (m_partialLine.empty())
+            {
+                deliver(std::string_view(begin, static_cast<size_t>(newLine - begin)), lineEnd);
+            }
+            else
+            {
+                m_partialLine.append(begin, newLine);
+                deliver(m_partialLine, lineEnd);
+                m_partialLine.clear();
+            }
+            begin = newLine + 1;
+        }
+        m_readOffset += readCnt;
+        if (readCnt < readChunkSize)
+            break;
+    }
+
+    if (finalRead && !m_partialLine.empty())
+    {
+        deliver(m_partialLine, m_readOffset);
+        m_partialLine.clear();
+    }
+
+    std::scoped_lock<std::mutex> lock(m_checkpointMtx);
+    m_checkpoint = checkpoint;
+}
+
+bool LogFollower::isRotated() const
+{
+    struct stat fileStat = {};
+    if (::stat(m_filePath.c_str(), &fileStat) != 0)
+        return true;    // Renamed and not created again yet, or removed
+
+    return fileStat.st_ino != m_inode;
+}
+
+void LogFollower::waitForChange()
+{
+    // Which file changed does not matter, reading the followed one again is
+    // cheap enough
+    m_dirWatch.wait(m_pollPeriod);
+}
@@ -0,0 +1,175 @@
+/*
+ * LogHandle.cpp
+ *
+ * Implementation of the LogHandle class. Each handle formats with a Logger
+ * of its own and writes to sinks of its own, each with its own queue, so
+ * that the handles scale independently of each other.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LogHandle.hpp"
+#include "ConsoleOps.hpp"
+#include "ConfigWatcher.hpp"
+#include "IoExecutor.hpp"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief Start reloading the config file on a change or a SIGHUP, if asked for
+     * A failure, e.g. no thread to spare, gets reported along with the write
+     * errors of the sink, the settings loaded at startup staying as they are.
+     */
+    std::unique_ptr<ConfigWatcher> startConfigWatcher(LoggingOps& ops, const LoggerConfig& config) noexcept
+    {
+        auto configFile = std::getenv(LoggerConfig::CONFIG_FILE_ENV.data());
+        if (!configFile || !*configFile || !(config.watchConfig || config.reloadOnSighup))
+            return nullptr;
+
+        try
+        {
+            auto pConfigWatcher = std::make_unique<ConfigWatcher>(ops, configFile, config.watchConfig, config.reloadOnSighup);
+            if (!pConfigWatcher->start())
+                throw std::runtime_error(std::string("CONFIG_ERROR : Config file ") + configFile + " can't be watched");
+            return pConfigWatcher;
+        }
+        catch(...)
+        {
+            ops.addRaisedException(std::current_exception());
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Pin and schedule the I/O threads as configured
+     * A failure, e.g. a real time policy without the privilege to, gets
+     * reported along with the write errors of the sink.
+     *
+     * @return true If the options got applied, otherwise
+     * @return false
+     */
+    bool setIoThreadOptions(LoggingOps& ops, const LoggerConfig& config) noexcept
+    {
+        try
+        {
+            IoExecutor::getShared().setThreadOptions(config.ioThreads);
+            return true;
+        }
+        catch(...)
+        {
+            ops.addRaisedException(std::current_exception());
+        }
+        return false;
+    }
+};
+
+/*static*/ LogHandle& LogHandle::getDefault() noexcept
+{
+    // Read once, the compiled in settings being the defaults
+    static const auto config = LoggerConfig::load();
+    static LogHandle defaultHandle(config, true);
+    [[maybe_unused]] static const auto ioThreadsSet = setIoThreadOptions(defaultHandle.getOps(), config);
+    // Stopped before the handle it applies the reloads to gets destroyed
+    static auto pConfigWatcher = startConfigWatcher(defaultHandle.getOps(), config);
+    return defaultHandle;
+}
+
+LogHandle::LogHandle(std::unique_ptr<LoggingOps> ops)
+    : m_pOps(std::move(ops))
+    , m_formatMtx()
+    , m_formatter(LOG_TIME_FORMAT)
+{
+    if (!m_pOps)
+        throw std::invalid_argument("SINK_ERROR : A log handle can't be made without a sink");
+}
+
+LogHandle::LogHandle(const LoggerConfig& config)
+    : LogHandle(Logger::makeLoggingOps(config))
+{
+}
+
+LogHandle::LogHandle(const LoggerConfig& config, const bool fallback)
+    : m_pOps()
+    , m_formatMtx()
+    , m_formatter(LOG_TIME_FORMAT)
+{
+    try
+    {
+        m_pOps = Logger::makeLoggingOps(config);
+    }
+    catch(...)
+    {
+        if (!fallback)
+            throw;
+        // The log file can't be had, the console it is then
+        m_pOps = std::make_unique<ConsoleOps>(config.consoleStderr);
+    }
+}
+
+void LogHandle::flushAndWait()
+{
+    m_pOps->flushAndWait();
+}
+
+void LogHandle::prepare(const std::string_view fileName,
+                        const std::string_view funcName,
+                        const std::string_view marker,
+                        const size_t lineNo,
+                        const std::thread::id& tid,
+                        const LOG_TYPE logType)
+{
+    m_formatter.setFileName(std::string(fileName))
+               .setFunctionName(std::string(funcName))
+               .setLineNo(lineNo)
+               .setThreadId(tid)
+               .setMarker(std::string(marker))
+               .setLogType(logType);
+}
+
+void LogHandle::submit(LoggingOps& ops,
+                       const std::string_view fileName,
+                       const std::string_view funcName,
+                       const std::string_view marker,
+                       const size_t lineNo,
+                       const std::thread::id& tid,
+                       const LOG_TYPE logType,
+                       const std::span<const LogField> fields)
+{
+    // Formatted once, each sink then decides by its level threshold
+    auto text = m_formatter.getLogStream().str();
+    ops.writeRecord(LogRecord::fromLogger(m_formatter, text, fileName, funcName, marker, lineNo, tid, logType, fields));
+}
+
+/*static*/ void LogHandle::commitIfCritical(LoggingOps& ops, const LOG_TYPE logType)
+{
+    if (!isCriticalLogType(logType))
+        return;
+
+    ops.waitForFatal(logType);
+    ops.commitCritical();
+}
@@ -0,0 +1,105 @@
+/*
+ * LogLine.cpp
+ *
+ * Implementation of the LogLine prefix parser.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LogLine.hpp"
+
+#include <charconv>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief Strip the padding spaces around a field
+     */
+    std::string_view trim(std::string_view field)
+    {
+        while (!field.empty() && field.front() == ' ')
+            field.remove_prefix(1);
+        while (!field.empty() && field.back() == ' ')
+            field.remove_suffix(1);
+        return field;
+    }
+
+    /**
+     * @brief Take the next field, up to the next field separator, off the rest of the line
+     */
+    bool nextField(std::string_view& rest, std::string_view& field)
+    {
+        auto sepPos = rest.find(FIELD_SEPARATOR);
+        if (sepPos == std::string_view::npos)
+            return false;
+
+        field = rest.substr(0, sepPos);
+        rest.remove_prefix(sepPos + FIELD_SEPARATOR.size());
+        return true;
+    }
+};
+
+/*static*/ bool LogLine::parse(const std::string_view line, LogLine& out) noexcept
+{
+    if (!line.starts_with(FIELD_SEPARATOR))
+        return false;
+
+    auto rest = line.substr(FIELD_SEPARATOR.size());
+    std::string_view lineNoField;
+    if (!nextField(rest, out.timestamp) ||
+        !nextField(rest, out.threadId) ||
+        !nextField(rest, out.fileName) ||
+        !nextField(rest, lineNoField))
+        return false;
+
+    out.threadId = trim(out.threadId);
+    out.fileName = trim(out.fileName);
+    lineNoField = trim(lineNoField);
+    auto [ptr, ec] = std::from_chars(lineNoField.data(), lineNoField.data() + lineNoField.size(), out.lineNo);
+    if (ec != std::errc() || ptr != lineNoField.data() + lineNoField.size() || out.timestamp.empty())
+        return false;
+
+    // The log type is in capitals, immediately followed by the marker
+    size_t typeLen = 0;
+    while (typeLen < rest.size() && rest[typeLen] >= 'A' && rest[typeLen] <= 'Z')
+        ++typeLen;
+
+    auto typeStr = rest.substr(0, typeLen);
+    out.logType = Logger::convertStringToLogTypeEnum(typeStr);
+    if (out.logType == LOG_TYPE::LOG_DEFAULT && typeStr != "DEFAULT")
+        return false;
+
+    rest.remove_prefix(typeLen);
+    auto markerLen = rest.find(ONE_SPACE);
+    if (markerLen == std::string_view::npos)
+        markerLen = rest.size();
+
+    out.marker = rest.substr(0, markerLen);
+    rest.remove_prefix(markerLen);
+    // Skip the spaces the Logger aligns the messages with
+    while (rest.starts_with(ONE_SPACE))
+        rest.remove_prefix(ONE_SPACE.size());
+    out.message = rest;
+    return true;
+}
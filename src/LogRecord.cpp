@@ -0,0 +1,75 @@
+/*
+ * LogRecord.cpp
+ *
+ * Implementation of the LogRecord struct, a record built out of the Logger
+ * which rendered its message.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LogRecord.hpp"
+#include "Logger.hpp"
+
+#include <sstream>
+
+using namespace logger;
+
+/*static*/ LogRecord LogRecord::fromLogger(const Logger& logger,
+                                          const std::string_view text,
+                                          const std::string_view fileName,
+                                          const std::string_view funcName,
+                                          const std::string_view marker,
+                                          const size_t lineNo,
+                                          const std::thread::id threadId,
+                                          const LOG_TYPE logType,
+                                          const std::span<const LogField> fields) noexcept
+{
+    LogRecord record;
+    record.logType = logType;
+    record.timestamp = logger.getTimestamp();
+    record.threadId = threadId;
+    record.fileName = fileName;
+    record.funcName = funcName;
+    record.lineNo = lineNo;
+    record.marker = marker;
+    record.text = text;
+    record.prefixSize = logger.getLogMsgPrefixSize();
+    record.msgOffset = logger.getLogMsgOffset();
+    record.fields = fields;
+    return record;
+}
+
+std::string_view LogRecord::getBaseFileName() const noexcept
+{
+    auto baseName = fileName;
+    auto dirPos = baseName.rfind(FORWARD_SLASH);
+    if (dirPos != std::string_view::npos)
+        baseName.remove_prefix(dirPos + 1);
+    return baseName;
+}
+
+/*static*/ std::string LogRecord::getThreadIdText(const std::thread::id threadId)
+{
+    std::ostringstream osstr;
+    osstr << threadId;
+    return osstr.str();
+}
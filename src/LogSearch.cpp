@@ -0,0 +1,264 @@
+/*
+ * LogSearch.cpp
+ *
+ * Implementation of the LogSearch class. Every file is memory mapped and
+ * scanned by one thread of a small pool; the per file results are merged
+ * by time stamp at the end.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LogSearch.hpp"
+#include "LogLine.hpp"
+#include "MappedFile.hpp"
+
+#include <regex>
+#include <tuple>
+#include <atomic>
+#include <thread>
+#include <optional>
+#include <algorithm>
+#include <exception>
+#include <functional>
+
+using namespace logger;
+
+/**
+ * @brief Matches the pattern of a query against a line
+ * A literal pattern goes through a Boyer-Moore-Horspool searcher, a regex or
+ * a case insensitive literal through std::regex. Both are safe to be used
+ * from several threads at once.
+ */
+struct LogSearch::Matcher
+{
+    explicit Matcher(const SearchQuery& query)
+        : pattern(query.pattern)
+    {
+        if (pattern.empty())
+            return;
+
+        if (query.regex || query.ignoreCase)
+        {
+            auto regexStr = query.regex ? pattern : escape(pattern);
+            auto flags = std::regex::ECMAScript | std::regex::optimize;
+            if (query.ignoreCase)
+                flags |= std::regex::icase;
+            regex.emplace(regexStr, flags);
+        }
+        else
+        {
+            searcher.emplace(pattern.begin(), pattern.end());
+        }
+    }
+
+    bool operator()(const std::string_view line) const
+    {
+        if (regex)
+            return std::regex_search(line.begin(), line.end(), *regex);
+        if (searcher)
+            return std::search(line.begin(), line.end(), *searcher) != line.end();
+        return true;    // No pattern, everything matches
+    }
+
+    static std::string escape(const std::string_view literal)
+    {
+        static constexpr std::string_view specialChars = R"(\^$.|?*+()[]{})";
+        std::string escaped;
+        escaped.reserve(literal.size() * 2);
+        for (auto ch : literal)
+        {
+            if (specialChars.find(ch) != std::string_view::npos)
+                escaped += '\\';
+            escaped += ch;
+        }
+        return escaped;
+    }
+
+    // The searcher refers to the pattern, hence the pattern is declared first
+    const std::string pattern;
+    std::optional<std::regex> regex;
+    std::optional<std::boyer_moore_horspool_searcher<std::string::const_iterator>> searcher;
+};
+
+/*static*/ std::vector<std::filesystem::path> LogSearch::discoverFiles(const std::filesystem::path& baseFile)
+{
+    auto dirPath = baseFile.parent_path();
+    if (dirPath.empty())
+        dirPath = ".";
+
+    // <stem>_<ddmmyyyy>_<hhmmss>[_<n>]<extn>, as named by FileOps::getRotatedFileName()
+    const std::regex rotatedName(Matcher::escape(baseFile.stem().string())
+                                 + R"(_(\d{2})(\d{2})(\d{4})_(\d{6})(?:_(\d+))?)"
+                                 + Matcher::escape(baseFile.extension().string()));
+
+    std::vector<std::tuple<std::filesystem::file_time_type, std::string, uint64_t, std::filesystem::path>> archives;
+    std::error_code ec;
+    std::smatch match;
+    for (const auto& entry : std::filesystem::directory_iterator(dirPath, ec))
+    {
+        auto fileName = entry.path().filename().string();
+        if (!entry.is_regular_file(ec) || !std::regex_match(fileName, match, rotatedName))
+            continue;
+
+        // The time stamp of the name year first, the files rotated within
+        // the same second being numbered from 1 on
+        auto timeStamp = match[3].str() + match[2].str() + match[1].str() + match[4].str();
+        auto seqNo = match[5].matched ? std::stoull(match[5].str()) : 0;
+        archives.emplace_back(entry.last_write_time(ec), std::move(timeStamp), seqNo, entry.path());
+    }
+
+    // The modification time gives the order, the time stamp and the number
+    // in the name breaking the ties, as the time stamps of the file system
+    // may well be coarser than the rotations
+    std::sort(archives.begin(), archives.end());
+    std::vector<std::filesystem::path> files;
+    files.reserve(archives.size() + 1);
+    for (auto& archive : archives)
+        files.push_back(std::move(std::get<3>(archive)));
+
+    if (std::filesystem::exists(baseFile, ec))
+        files.push_back(baseFile);
+
+    return files;
+}
+
+LogSearch::LogSearch(const SearchQuery& query, const size_t threadCnt)
+    : m_query(query)
+    , m_threadCnt(threadCnt ? threadCnt : std::max(1u, std::thread::hardware_concurrency()))
+    , m_matcher(std::make_unique<Matcher>(query))
+{
+}
+
+LogSearch::~LogSearch() = default;
+
+std::vector<SearchMatch> LogSearch::search(const std::filesystem::path& baseFile)
+{
+    return searchFiles(discoverFiles(baseFile));
+}
+
+std::vector<SearchMatch> LogSearch::searchFiles(const std::vector<std::filesystem::path>& files)
+{
+    std::vector<std::vector<SearchMatch>> fileMatches(files.size());
+    std::vector<std::exception_ptr> excpPtrVec(files.size());
+    std::atomic<size_t> nextFile = 0;
+    auto worker = [&]()
+    {
+        for (auto idx = nextFile++; idx < files.size(); idx = nextFile++)
+        {
+            try
+            {
+                fileMatches[idx] = searchFile(files[idx]);
+            }
+            catch(...)
+            {
+                excpPtrVec[idx] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    auto workerCnt = std::min(m_threadCnt, files.size());
+    for (size_t cnt = 1; cnt < workerCnt; ++cnt)
+        workers.emplace_back(worker);
+    worker();   // This thread takes its share too
+    for (auto& thread : workers)
+        thread.join();
+
+    for (const auto& excpPtr : excpPtrVec)
+    {
+        if (excpPtr)
+            std::rethrow_exception(excpPtr);
+    }
+
+    size_t totalCnt = 0;
+    for (const auto& matches : fileMatches)
+        totalCnt += matches.size();
+
+    std::vector<SearchMatch> results;
+    results.reserve(totalCnt);
+    for (auto& matches : fileMatches)
+        std::move(matches.begin(), matches.end(), std::back_inserter(results));
+
+    std::stable_sort(results.begin(), results.end(), [](const SearchMatch& lhs, const SearchMatch& rhs)
+    {
+        return lhs.timestamp < rhs.timestamp;
+    });
+
+    if (m_query.maxResults && results.size() > m_query.maxResults)
+        results.resize(m_query.maxResults);
+
+    return results;
+}
+
+std::vector<SearchMatch> LogSearch::searchFile(const std::filesystem::path& file) const
+{
+    const auto filterOnPrefix = !m_query.levels.empty() || !m_query.since.empty() ||
+                                !m_query.until.empty() || !m_query.threadId.empty();
+    auto keepRecord = [this](const LogLine& logLine)
+    {
+        if (!m_query.levels.empty() &&
+            std::find(m_query.levels.begin(), m_query.levels.end(), logLine.logType) == m_query.levels.end())
+            return false;
+        if (!m_query.since.empty() && logLine.timestamp < m_query.since)
+            return false;
+        // A shorter until, e.g. "20250825", takes in the whole day
+        if (!m_query.until.empty() && logLine.timestamp.substr(0, m_query.until.size()) > m_query.until)
+            return false;
+        if (!m_query.threadId.empty() && logLine.threadId != m_query.threadId)
+            return false;
+        return true;
+    };
+
+    std::vector<SearchMatch> matches;
+    MappedFile mappedFile(file);
+    LogLine logLine;
+    auto inRecord = false;      // A record has been seen, continuation lines belong to it
+    auto keepCurrent = !filterOnPrefix;
+    size_t lineNo = 0;
+    for (auto line : mappedFile.lines())
+    {
+        ++lineNo;
+        // Lines without a prefix continue the record above them
+        // (a message with new lines in it) and are filtered along with it
+        LogLine parsed;
+        if (LogLine::parse(line, parsed))
+        {
+            logLine = parsed;
+            inRecord = true;
+            keepCurrent = keepRecord(logLine);
+        }
+        else if (!inRecord)
+        {
+            keepCurrent = !filterOnPrefix;
+        }
+
+        if (!keepCurrent || !(*m_matcher)(line))
+            continue;
+
+        matches.push_back({ file, lineNo, std::string(inRecord ? logLine.timestamp : std::string_view()), std::string(line) });
+        // Within a file the lines are in time order, those
+        // after the first maxResults would be dropped anyway
+        if (m_query.maxResults && matches.size() >= m_query.maxResults)
+            break;
+    }
+    return matches;
+}
@@ -1,8 +1,12 @@
 #include "Logger.hpp"
 #include "FileOps.hpp"
 #include "ConsoleOps.hpp"
-
-#include "ENV_VARS.hpp"
+#include "MultiSinkOps.hpp"
+#include "CoalescingOps.hpp"
+#include "BatchSinkOps.hpp"
+#include "BinaryFileSink.hpp"
+#include "JsonLinesSink.hpp"
+#include "LogHandle.hpp"
 
 #include <iomanip>
 #include <regex>
@@ -36,13 +40,13 @@ using namespace logger;
 /*static*/LOG_TYPE Logger::convertStringToLogTypeEnum(const std::string_view type) noexcept
 {
     if (type.empty())
-        return m_stringToEnumMap.cend()->second;
+        return LOG_TYPE::LOG_DEFAULT;
 
-    auto itr = m_stringToEnumMap.find(type.data());
+    auto itr = m_stringToEnumMap.find(std::string(type));
     if (itr != m_stringToEnumMap.end())
         return itr->second;
     else
-        return m_stringToEnumMap.cend()->second;
+        return LOG_TYPE::LOG_DEFAULT;
 }
 
 /*static*/std::string Logger::covertLogTypeEnumToString(const LOG_TYPE& type) noexcept
@@ -52,53 +56,109 @@ using namespace logger;
     if (itr != m_EnumToStringMap.end())
         return itr->second;
     else
-        return m_EnumToStringMap.cend()->second;
+        return m_EnumToStringMap.at(LOG_TYPE::LOG_DEFAULT);
 }
 
-/*static*/ LoggingOps& Logger::buildLoggingOpsObject() noexcept
+/*static*/ std::unique_ptr<LoggingOps> Logger::makeLoggingOps(const LoggerConfig& config)
+{
+    if (config.coalesceWindow.count() > 0)  // The repeats collapsed before they get to the sinks
+    {
+        auto sinkConfig = config;
+        sinkConfig.coalesceWindow = std::chrono::milliseconds(0);
+        return std::make_unique<CoalescingOps>(makeLoggingOps(sinkConfig), config.coalesceWindow);
+    }
+
+    if (!config.fileLogging)    // Plain console logging it is
+    {
+        auto pConsoleOps = std::make_unique<ConsoleOps>(config.consoleStderr);
+        applySettings(*pConsoleOps, config);
+        return pConsoleOps;
+    }
+
+    auto makeFileOps = [&config]() -> std::unique_ptr<LoggingOps>
+    {
+        std::exception_ptr excpPtr = nullptr;
+        if (config.fileFormat != LoggerConfig::FileFormat::TEXT)
+        {
+            auto binary = (config.fileFormat == LoggerConfig::FileFormat::BINARY);
+            try
+            {
+                std::filesystem::path file = config.filePath.empty() ? std::filesystem::current_path()
+                                                                     : std::filesystem::path(config.filePath);
+                file /= config.fileName.empty() ? (binary ? "Logger.bin" : "Logger.jsonl") : config.fileName;
+                if (!config.fileExtn.empty())
+                    file.replace_extension(config.fileExtn);
+                // Compact binary records, rendered as text by tools/LogDecode, or JSON Lines for log indexers
+                if (binary)
+                    return std::make_unique<BatchSinkOps>(std::make_unique<BinaryFileSink>(file));
+                return std::make_unique<BatchSinkOps>(std::make_unique<JsonLinesSink>(file));
+            }
+            catch(const std::runtime_error&)
+            {
+                // Not a binary log already, or not writable, a text log it is then,
+                // the reason kept along with the exceptions of the text log
+                excpPtr = std::current_exception();
+            }
+        }
+        auto pFileOps = std::make_unique<FileOps>(config.fileSize, config.fileName, config.filePath, config.fileExtn);
+        if (excpPtr)
+            pFileOps->addRaisedException(excpPtr);
+        return pFileOps;
+    };
+
+    if (config.consoleLogging)  // To the console as well, fan the records out to both
+    {
+        auto pMultiSinkOps = std::make_unique<MultiSinkOps>();
+        pMultiSinkOps->addSink(makeFileOps());
+        pMultiSinkOps->addSink(std::make_unique<ConsoleOps>(config.consoleStderr));
+        applySettings(*pMultiSinkOps, config);
+        return pMultiSinkOps;
+    }
+
+    auto pFileOps = makeFileOps();
+    applySettings(*pFileOps, config);
+    return pFileOps;
+}
+
+/*static*/ void Logger::applySettings(LoggingOps& ops, const LoggerConfig& config) noexcept
 {
-    static std::unique_ptr<LoggingOps> pLoggingOps;
-    static auto initialize = true;  // First time TRUE and then always FALSE
-    while (initialize)
+    auto applyTo = [&config](LoggingOps& sink, const LOG_TYPE threshold)
+    {
+        // Atomics all of them, the logging calls and the drain turns go on meanwhile
+        sink.setLevelThreshold(threshold);
+        sink.setMaxBatchSize(config.maxBatchSize);
+        sink.setMaxLatency(config.maxLatency);
+        sink.setLoadShedding(config.maxBacklogDelay);
+        sink.setPriorityLevel(config.priorityLevel);
+        if (auto pFileOps = dynamic_cast<FileOps*>(&sink))
+            pFileOps->setMaxFileSize(config.fileSize);
+    };
+
+    if (auto pCoalescingOps = dynamic_cast<CoalescingOps*>(&ops))
+    {
+        // Turning it on takes a restart, as it wraps the sinks, off is a window of 0
+        pCoalescingOps->setWindow(config.coalesceWindow);
+        applySettings(pCoalescingOps->getSink(), config);
+    }
+    else if (auto pMultiSinkOps = dynamic_cast<MultiSinkOps*>(&ops))
     {
-#if defined(FILE_LOGGING) // Is it going to be a file logging ops?
-        std::ostringstream parser;
-        uintmax_t fileSize = 1024 * 1000;   // Default max log file size is 1 MB
-        std::string fileName;
-        std::string fileExtn;
-        std::string filePath;
-#ifdef LOG_FILE_NAME
-        parser << LOG_FILE_NAME;
-        fileName = parser.str();
-        // Break out then and there if file logging is requested
-        // but none provided. We are not assuming
-        // any log file name on our own in any case
-        if (fileName.empty())
-            break;
-#endif  // LOG_FILE_NAME
-#ifdef FILE_SIZE    // Is the max log file size provided?
-        fileSize = FILE_SIZE;
-#endif // FILE_SIZE
-#ifdef LOG_FILE_EXTN    // IS there a separate file extn also available from user?
-        std::ostringstream().swap(parser);
-        parser << LOG_FILE_EXTN;
-        fileExtn = parser.str();
-#endif  // LOG_FILE_EXTN
-#ifdef LOG_FILE_PATH
-        std::ostringstream().swap(parser);
-        parser << LOG_FILE_PATH;
-        filePath = parser.str();
-        std::filesystem::path path(filePath);
-        if (!std::filesystem::exists(path) && std::filesystem::is_directory(path))
-            break;  // Invalid file path not allowed
-#endif // LOG_FILE_PATH
-        pLoggingOps.reset(new FileOps(fileSize, fileName, filePath, fileExtn));
-#else   // Plain console logging it is
-        pLoggingOps.reset(new ConsoleOps());
-#endif  // FILE_LOGGING
-        initialize = false; // By this time initialization is completed
+        for (size_t idx = 0; idx < pMultiSinkOps->getSinkCount(); ++idx)
+        {
+            auto& sink = pMultiSinkOps->getSink(idx);
+            // Only the warnings and worse to the console by default, along with a file
+            applyTo(sink, dynamic_cast<ConsoleOps*>(&sink) ? config.consoleLevel.value_or(LOG_TYPE::LOG_WARN)
+                                                           : config.fileLevel);
+        }
     }
-    return *pLoggingOps;
+    else if (dynamic_cast<ConsoleOps*>(&ops))
+        applyTo(ops, config.consoleLevel.value_or(LOG_TYPE::LOG_DEFAULT));
+    else
+        applyTo(ops, config.fileLevel);
+}
+
+/*static*/ LoggingOps& Logger::buildLoggingOpsObject() noexcept
+{
+    return LogHandle::getDefault().getOps();
 }
 
 Logger::Logger(const std::string_view timeFormat)
@@ -165,9 +225,11 @@ void Logger::populatePrerequisitFileds()
     // Clear the log stream before populating it with new log message
     std::lock_guard<std::mutex> dataStreamLock(m_logStrmMtx);
     std::stringstream().swap(m_logStream);
+    m_timestamp = std::chrono::system_clock::now();
     constructLogMsgPrefix();
+    m_prefixSize = static_cast<size_t>(m_logStream.tellp());
 
-    extractClassAndFuncName(m_extractedClassName, m_extractedFuncName);
+    extractClassAndFuncName(m_prettyFuncName, m_extractedClassName, m_extractedFuncName);
 
     m_logStream << LEFT_SQUARE_BRACE
                 << m_extractedClassName
@@ -202,7 +264,7 @@ void Logger::constructLogMsgPrefix()
 
 void Logger::constructLogMsgPrefixFirstPart()
 {
-    m_logStream << FIELD_SEPARATOR << m_clock.getLocalTimeStr();
+    m_logStream << FIELD_SEPARATOR << m_clock.getLocalTimeStr(m_timestamp);
     m_logStream << FIELD_SEPARATOR << ONE_SPACE;
 }
 
@@ -263,14 +325,17 @@ void Logger::vlog(const std::string_view formatStr, std::format_args args)
                     logMsg.find_last_of(DOUBLE_QUOTES) - 1);
     }
     std::lock_guard<std::mutex> dataStreamLock(m_logStrmMtx);
+    m_msgOffset = static_cast<size_t>(m_logStream.tellp());
     m_logStream << logMsg;
 }
 
-void Logger::extractClassAndFuncName(std::string& className, std::string& funcName) noexcept
+/*static*/ void Logger::extractClassAndFuncName(const std::string_view prettyFuncName,
+                                               std::string& className,
+                                               std::string& funcName) noexcept
 {
     className.clear();
     funcName.clear();
-    if (m_prettyFuncName.empty())
+    if (prettyFuncName.empty())
         return;
 
     /**
@@ -293,7 +358,7 @@ void Logger::extractClassAndFuncName(std::string& className, std::string& funcNa
      * "auto LoggerTest_testDiffFuncSignatures_Test::TestBody()::(anonymous class)::operator()"
      * In this case the targeted aim is class : operator()
      */
-    funcName = m_prettyFuncName.substr(0, m_prettyFuncName.find(LEFT_OPENING_BRACE));
+    funcName = prettyFuncName.substr(0, prettyFuncName.find(LEFT_OPENING_BRACE));
     auto scopeOptrPos = funcName.find_last_of(COLONE_SEP);
     if (std::string::npos != scopeOptrPos)
     {
@@ -0,0 +1,433 @@
+/*
+ * LoggerConfig.cpp
+ *
+ * Implementation of the LoggerConfig struct. The settings are a handful of
+ * getenv() calls and a config file of a few lines, read once at startup.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LoggerConfig.hpp"
+#include "Logger.hpp"
+
+#include "ENV_VARS.hpp"
+
+#include <array>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief The names of the settings, as the build options go
+     */
+    constexpr std::array<std::string_view, 22> settingNames =
+    {
+        "FILE_LOGGING", "FILE_SIZE", "LOG_FILE_PATH", "LOG_FILE_NAME", "LOG_FILE_EXTN",
+        "FILE_LOG_LEVEL", "FILE_LOG_FORMAT", "CONSOLE_LOGGING", "CONSOLE_LOG_LEVEL", "CONSOLE_STDERR",
+        "BATCH_SIZE", "BATCH_LATENCY_MS", "WATCH_CONFIG", "RELOAD_ON_SIGHUP", "COALESCE_WINDOW_MS",
+        "SHED_BACKLOG_MS", "PRIORITY_LEVEL", "IO_THREAD_CPUS", "IO_THREAD_SCHED", "IO_THREAD_NICE",
+        "IO_WAIT", "IO_THREADS"
+    };
+
+    std::string toUpper(const std::string_view value)
+    {
+        std::string upper(value);
+        for (auto& ch : upper)
+            ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+        return upper;
+    }
+
+    std::string_view trim(std::string_view value)
+    {
+        while (!value.empty() && std::isspace(static_cast<unsigned char>(value.front())))
+            value.remove_prefix(1);
+        while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back())))
+            value.remove_suffix(1);
+        return value;
+    }
+
+    std::optional<bool> parseBool(const std::string_view value)
+    {
+        auto upper = toUpper(value);
+        if (upper == "YES" || upper == "TRUE" || upper == "ON" || upper == "1")
+            return true;
+        if (upper == "NO" || upper == "FALSE" || upper == "OFF" || upper == "0")
+            return false;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Parse a whole value as a number
+     */
+    template <typename T>
+    std::optional<T> parseNumber(const std::string_view value)
+    {
+        T num = 0;
+        auto [numEnd, errCode] = std::from_chars(value.data(), value.data() + value.size(), num);
+        if (errCode != std::errc() || numEnd != value.data() + value.size())
+            return std::nullopt;
+        return num;
+    }
+
+    /**
+     * @brief Parse a comma separated list of cores, e.g. 2,3
+     */
+    std::optional<std::vector<int>> parseCpus(const std::string_view value)
+    {
+        std::vector<int> cpus;
+        if (trim(value).empty())
+            return cpus;
+
+        size_t start = 0;
+        while (start <= value.size())
+        {
+            auto end = std::min(value.find(',', start), value.size());
+            auto cpu = parseNumber<int>(trim(value.substr(start, end - start)));
+            if (!cpu || *cpu < 0)
+                return std::nullopt;
+            cpus.push_back(*cpu);
+            start = end + 1;
+        }
+        return cpus;
+    }
+
+    /**
+     * @brief Split a NAME[:number] value, e.g. FIFO:50
+     */
+    std::pair<std::string, std::optional<std::string_view>> splitArgument(const std::string_view value)
+    {
+        auto colonPos = value.find(':');
+        if (colonPos == std::string_view::npos)
+            return { toUpper(trim(value)), std::nullopt };
+        return { toUpper(trim(value.substr(0, colonPos))), trim(value.substr(colonPos + 1)) };
+    }
+
+    std::optional<LOG_TYPE> parseLevel(const std::string_view value)
+    {
+        auto upper = toUpper(value);
+        auto logType = Logger::convertStringToLogTypeEnum(upper);
+        // Anything unknown comes back as the default one
+        if (logType == LOG_TYPE::LOG_DEFAULT && upper != Logger::covertLogTypeEnumToString(LOG_TYPE::LOG_DEFAULT))
+            return std::nullopt;
+        return logType;
+    }
+};
+
+/*static*/ LoggerConfig LoggerConfig::getCompiledDefaults() noexcept
+{
+    LoggerConfig config;
+#ifdef FILE_LOGGING
+    config.fileLogging = true;
+#endif  // FILE_LOGGING
+#ifdef FILE_SIZE
+    config.fileSize = FILE_SIZE;
+#endif  // FILE_SIZE
+#ifdef LOG_FILE_PATH
+    config.filePath = LOG_FILE_PATH;
+#endif  // LOG_FILE_PATH
+#ifdef LOG_FILE_NAME
+    config.fileName = LOG_FILE_NAME;
+#endif  // LOG_FILE_NAME
+#ifdef LOG_FILE_EXTN
+    config.fileExtn = LOG_FILE_EXTN;
+#endif  // LOG_FILE_EXTN
+#ifdef FILE_LOG_LEVEL
+    config.fileLevel = Logger::convertStringToLogTypeEnum(FILE_LOG_LEVEL);
+#endif  // FILE_LOG_LEVEL
+#if defined(FILE_LOG_FORMAT_BINARY)
+    config.fileFormat = FileFormat::BINARY;
+#elif defined(FILE_LOG_FORMAT_JSON)
+    config.fileFormat = FileFormat::JSON;
+#endif  // FILE_LOG_FORMAT_BINARY, FILE_LOG_FORMAT_JSON
+#ifdef CONSOLE_LOGGING
+    config.consoleLogging = true;
+#endif  // CONSOLE_LOGGING
+#ifdef CONSOLE_LOG_LEVEL
+    config.consoleLevel = Logger::convertStringToLogTypeEnum(CONSOLE_LOG_LEVEL);
+#endif  // CONSOLE_LOG_LEVEL
+#ifdef CONSOLE_STDERR
+    config.consoleStderr = true;
+#endif  // CONSOLE_STDERR
+    return config;
+}
+
+/*static*/ LoggerConfig LoggerConfig::load() noexcept
+{
+    auto configFile = std::getenv(CONFIG_FILE_ENV.data());
+    return load((configFile && *configFile) ? configFile : "");
+}
+
+/*static*/ LoggerConfig LoggerConfig::load(const std::filesystem::path& configFile) noexcept
+{
+    auto config = getCompiledDefaults();
+    if (!configFile.empty())
+        config.applyFile(configFile);
+
+    config.applyEnvironment();
+    return config;
+}
+
+/*static*/ std::optional<std::uintmax_t> LoggerConfig::parseFileSize(const std::string_view value) noexcept
+{
+    auto size = trim(value);
+    std::uintmax_t num = 0;
+    auto [unitStart, errCode] = std::from_chars(size.data(), size.data() + size.size(), num);
+    if (errCode != std::errc() || unitStart == size.data())
+        return std::nullopt;
+
+    auto unit = toUpper(std::string_view(unitStart, static_cast<size_t>(size.data() + size.size() - unitStart)));
+    std::uintmax_t multiplier = 1;
+    if (unit == "K" || unit == "KB")
+        multiplier = 1024;
+    else if (unit == "M" || unit == "MB")
+        multiplier = 1024 * 1024;
+    else if (unit == "G" || unit == "GB")
+        multiplier = 1024 * 1024 * 1024;
+    else if (!unit.empty() && unit != "B")
+        return std::nullopt;
+
+    if (num > UINTMAX_MAX / multiplier)
+        return std::nullopt;
+    return num * multiplier;
+}
+
+bool LoggerConfig::set(const std::string_view key, const std::string_view value) noexcept
+{
+    try
+    {
+        auto name = toUpper(trim(key));
+        auto val = trim(value);
+        if (name.starts_with(LEVEL_PREFIX))
+        {
+            // The logger name keeps its case
+            auto loggerName = trim(key).substr(LEVEL_PREFIX.size());
+            std::optional<LOG_TYPE> level;
+            if (toUpper(val) != "OFF")
+            {
+                level = parseLevel(val);
+                if (!level)
+                    return false;
+            }
+            for (auto& [levelName, loggerLevel] : loggerLevels)
+            {
+                if (levelName == loggerName)
+                {
+                    loggerLevel = level;
+                    return true;
+                }
+            }
+            loggerLevels.emplace_back(std::string(loggerName), level);
+        }
+        else if (name == "FILE_LOGGING" || name == "CONSOLE_LOGGING" || name == "CONSOLE_STDERR" ||
+                 name == "WATCH_CONFIG" || name == "RELOAD_ON_SIGHUP")
+        {
+            auto flag = parseBool(val);
+            if (!flag)
+                return false;
+            if (name == "FILE_LOGGING")
+                fileLogging = *flag;
+            else if (name == "CONSOLE_LOGGING")
+                consoleLogging = *flag;
+            else if (name == "CONSOLE_STDERR")
+                consoleStderr = *flag;
+            else if (name == "WATCH_CONFIG")
+                watchConfig = *flag;
+            else
+                reloadOnSighup = *flag;
+        }
+        else if (name == "BATCH_SIZE" || name == "BATCH_LATENCY_MS" || name == "COALESCE_WINDOW_MS" || name == "SHED_BACKLOG_MS")
+        {
+            size_t num = 0;
+            auto [numEnd, errCode] = std::from_chars(val.data(), val.data() + val.size(), num);
+            if (errCode != std::errc() || numEnd != val.data() + val.size())
+                return false;
+            if (name == "BATCH_SIZE")
+            {
+                if (num == 0)
+                    return false;
+                maxBatchSize = num;
+            }
+            else if (name == "BATCH_LATENCY_MS")
+                maxLatency = std::chrono::milliseconds(num);
+            else if (name == "COALESCE_WINDOW_MS")
+                coalesceWindow = std::chrono::milliseconds(num);
+            else
+                maxBacklogDelay = std::chrono::milliseconds(num);
+        }
+        else if (name == "IO_THREADS")
+        {
+            auto threadCnt = parseNumber<size_t>(val);
+            if (!threadCnt || *threadCnt == 0)
+                return false;
+            ioThreadCnt = *threadCnt;
+        }
+        else if (name == "IO_THREAD_CPUS")
+        {
+            auto cpus = parseCpus(val);
+            if (!cpus)
+                return false;
+            ioThreads.cpus = *cpus;
+        }
+        else if (name == "IO_THREAD_SCHED")
+        {
+            auto [policyName, priorityArg] = splitArgument(val);
+            constexpr std::array<std::pair<std::string_view, SchedPolicy>, 5> policies =
+            {{
+                { "OTHER", SchedPolicy::OTHER }, { "BATCH", SchedPolicy::BATCH }, { "IDLE", SchedPolicy::IDLE },
+                { "FIFO", SchedPolicy::FIFO }, { "RR", SchedPolicy::RR }
+            }};
+            auto policy = std::find_if(policies.begin(), policies.end(), [&policyName](const auto& entry) { return entry.first == policyName; });
+            if (policy == policies.end())
+                return false;
+
+            // The real time ones take a priority, the others none
+            auto realTime = (policy->second == SchedPolicy::FIFO || policy->second == SchedPolicy::RR);
+            std::optional<int> priority = 0;
+            if (realTime)
+                priority = priorityArg ? parseNumber<int>(*priorityArg) : std::nullopt;
+            if (!priority || (realTime ? (*priority < 1 || *priority > 99) : priorityArg.has_value()))
+                return false;
+            ioThreads.schedPolicy = policy->second;
+            ioThreads.schedPriority = *priority;
+        }
+        else if (name == "IO_THREAD_NICE")
+        {
+            auto niceLevel = parseNumber<int>(val);
+            if (!niceLevel || *niceLevel < -20 || *niceLevel > 19)
+                return false;
+            ioThreads.niceLevel = *niceLevel;
+        }
+        else if (name == "IO_WAIT")
+        {
+            auto [strategyName, spinArg] = splitArgument(val);
+            if (strategyName == "BLOCK" && !spinArg)
+                ioThreads.waitStrategy = WaitStrategy::BLOCK;
+            else if (strategyName == "BUSY_POLL" && !spinArg)
+                ioThreads.waitStrategy = WaitStrategy::BUSY_POLL;
+            else if (strategyName == "SPIN")
+            {
+                auto spinTime = spinArg ? parseNumber<size_t>(*spinArg) : std::optional<size_t>(IoThreadOptions().spinTime.count());
+                if (!spinTime)
+                    return false;
+                ioThreads.waitStrategy = WaitStrategy::SPIN_THEN_PARK;
+                ioThreads.spinTime = std::chrono::microseconds(*spinTime);
+            }
+            else
+                return false;
+        }
+        else if (name == "FILE_SIZE")
+        {
+            auto size = parseFileSize(val);
+            if (!size || *size == 0)
+                return false;
+            fileSize = *size;
+        }
+        else if (name == "LOG_FILE_PATH")
+            filePath = val;
+        else if (name == "LOG_FILE_NAME")
+            fileName = val;
+        else if (name == "LOG_FILE_EXTN")
+            fileExtn = (val.empty() || val.front() == '.') ? std::string(val) : "." + std::string(val);
+        else if (name == "FILE_LOG_LEVEL" || name == "CONSOLE_LOG_LEVEL" || name == "PRIORITY_LEVEL")
+        {
+            auto level = parseLevel(val);
+            if (!level)
+                return false;
+            if (name == "FILE_LOG_LEVEL")
+                fileLevel = *level;
+            else if (name == "CONSOLE_LOG_LEVEL")
+                consoleLevel = *level;
+            else
+                priorityLevel = *level;
+        }
+        else if (name == "FILE_LOG_FORMAT")
+        {
+            auto format = toUpper(val);
+            if (format == "TEXT")
+                fileFormat = FileFormat::TEXT;
+            else if (format == "BINARY")
+                fileFormat = FileFormat::BINARY;
+            else if (format == "JSON")
+                fileFormat = FileFormat::JSON;
+            else
+                return false;
+        }
+        else
+            return false;   // Not a known setting
+
+        return true;
+    }
+    catch(...)
+    {
+        return false;   // Out of memory, left as is
+    }
+}
+
+size_t LoggerConfig::applyFile(const std::filesystem::path& file) noexcept
+{
+    size_t applied = 0;
+    try
+    {
+        std::ifstream configFile(file);
+        std::string line;
+        while (std::getline(configFile, line))
+        {
+            auto entry = trim(line);
+            if (entry.empty() || entry.front() == '#')
+                continue;
+
+            auto equalPos = entry.find('=');
+            if (equalPos == std::string_view::npos)
+                continue;
+
+            auto value = trim(entry.substr(equalPos + 1));
+            if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+                value = value.substr(1, value.size() - 2);
+            applied += set(entry.substr(0, equalPos), value);
+        }
+    }
+    catch(...)
+    {
+        // Whatever got applied till here stays
+    }
+    return applied;
+}
+
+size_t LoggerConfig::applyEnvironment() noexcept
+{
+    size_t applied = 0;
+    std::string envName(ENV_PREFIX);
+    for (auto name : settingNames)
+    {
+        envName.resize(ENV_PREFIX.size());
+        envName += name;
+        if (auto value = std::getenv(envName.c_str()))
+            applied += set(name, value);
+    }
+    return applied;
+}
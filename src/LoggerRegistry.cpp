@@ -0,0 +1,225 @@
+/*
+ * LoggerRegistry.cpp
+ *
+ * Implementation of the LoggerRegistry class. The settings of the loggers are
+ * resolved along the hierarchy whenever they change, under the mutex of the
+ * registry, and published to the atomics the logging calls read.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LoggerRegistry.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+using namespace logger;
+
+namespace
+{
+    /// Above every log type, nothing gets through
+    constexpr uint8_t silencedSeverity = UINT8_MAX;
+
+    void validateName(const std::string_view name)
+    {
+        if (name.empty())
+            return; // The root
+
+        if (name.front() == '.' || name.back() == '.' || name.find("..") != std::string_view::npos)
+            throw std::invalid_argument("REGISTRY_ERROR : Invalid logger name \"" + std::string(name) + "\"");
+    }
+};
+
+void OpsEpochs::waitForReaders()
+{
+    std::scoped_lock<std::mutex> epochLock(m_epochMtx);
+    auto prevEpoch = m_epoch.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (size_t shard = 0; shard < shardCnt; ++shard)
+    {
+        auto& counter = m_readers[(prevEpoch & 1) * shardCnt + shard].cnt;
+        // A logging call is short, bar a LOG_FATAL waiting for its sink
+        while (counter.load(std::memory_order_acquire) != 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+
+NamedLogger::NamedLogger(const std::string_view name, NamedLogger* parent, OpsEpochs& epochs)
+    : m_name(name)
+    , m_parent(parent)
+    , m_epochs(epochs)
+    , m_children()
+    , m_ownMinSeverity()
+    , m_ownOps()
+    , m_minSeverity(parent ? parent->m_minSeverity.load() : getLogTypeSeverity(LOG_TYPE::LOG_DEFAULT))
+    , m_ops(parent ? parent->m_ops.load() : nullptr)
+{
+}
+
+/*static*/ LoggerRegistry& LoggerRegistry::getShared()
+{
+    // Never destroyed, the loggers may well be used by statics at exit
+    static LoggerRegistry* sharedRegistry = []()
+    {
+        auto registry = new LoggerRegistry(Logger::buildLoggingOpsObject());
+        registry->applyLevels(LoggerConfig::load().loggerLevels);
+        return registry;
+    }();
+    return *sharedRegistry;
+}
+
+LoggerRegistry::LoggerRegistry(LoggingOps& rootOps)
+    : m_mtx()
+    , m_rootOps(rootOps)
+    , m_loggers()
+    , m_epochs()
+    , m_configuredNames()
+{
+    auto root = std::unique_ptr<NamedLogger>(new NamedLogger("", nullptr, m_epochs));
+    root->m_ops = &m_rootOps;
+    m_loggers.emplace("", std::move(root));
+}
+
+LoggerRegistry::~LoggerRegistry() = default;
+
+NamedLogger& LoggerRegistry::get(const std::string_view name)
+{
+    validateName(name);
+    std::scoped_lock<std::mutex> registryLock(m_mtx);
+    return getLocked(name);
+}
+
+NamedLogger& LoggerRegistry::getLocked(const std::string_view name)
+{
+    auto itr = m_loggers.find(std::string(name));
+    if (itr != m_loggers.end())
+        return *itr->second;
+
+    // The parent first, it is where the new one inherits from
+    auto dotPos = name.rfind('.');
+    auto& parent = getLocked((dotPos == std::string_view::npos) ? std::string_view() : name.substr(0, dotPos));
+    auto namedLogger = std::unique_ptr<NamedLogger>(new NamedLogger(name, &parent, m_epochs));
+    parent.m_children.push_back(namedLogger.get());
+    return *m_loggers.emplace(std::string(name), std::move(namedLogger)).first->second;
+}
+
+void LoggerRegistry::setLevel(const std::string_view name, const LOG_TYPE threshold)
+{
+    validateName(name);
+    std::scoped_lock<std::mutex> registryLock(m_mtx);
+    auto& namedLogger = getLocked(name);
+    namedLogger.m_ownMinSeverity = getLogTypeSeverity(threshold);
+    resolve(namedLogger);
+}
+
+void LoggerRegistry::silence(const std::string_view name)
+{
+    validateName(name);
+    std::scoped_lock<std::mutex> registryLock(m_mtx);
+    auto& namedLogger = getLocked(name);
+    namedLogger.m_ownMinSeverity = silencedSeverity;
+    resolve(namedLogger);
+}
+
+void LoggerRegistry::resetLevel(const std::string_view name)
+{
+    validateName(name);
+    std::scoped_lock<std::mutex> registryLock(m_mtx);
+    auto& namedLogger = getLocked(name);
+    namedLogger.m_ownMinSeverity.reset();
+    resolve(namedLogger);
+}
+
+void LoggerRegistry::applyLevels(const LoggerConfig::LoggerLevels& levels)
+{
+    std::scoped_lock<std::mutex> registryLock(m_mtx);
+    std::vector<std::string> configuredNames;
+    for (const auto& [name, level] : levels)
+    {
+        try
+        {
+            validateName(name);
+        }
+        catch(const std::invalid_argument&)
+        {
+            continue;
+        }
+        auto& namedLogger = getLocked(name);
+        namedLogger.m_ownMinSeverity = level ? getLogTypeSeverity(*level) : silencedSeverity;
+        resolve(namedLogger);
+        configuredNames.push_back(name);
+    }
+
+    // Left out this time, back to inheriting
+    for (const auto& name : m_configuredNames)
+    {
+        if (std::find(configuredNames.begin(), configuredNames.end(), name) != configuredNames.end())
+            continue;
+
+        auto& namedLogger = getLocked(name);
+        namedLogger.m_ownMinSeverity.reset();
+        resolve(namedLogger);
+    }
+    m_configuredNames = std::move(configuredNames);
+}
+
+void LoggerRegistry::setOps(const std::string_view name, std::shared_ptr<LoggingOps> ops)
+{
+    validateName(name);
+    std::shared_ptr<LoggingOps> replacedOps;
+    {
+        std::scoped_lock<std::mutex> registryLock(m_mtx);
+        auto& namedLogger = getLocked(name);
+        replacedOps = std::move(namedLogger.m_ownOps);
+        namedLogger.m_ownOps = std::move(ops);
+        resolve(namedLogger);
+    }
+    if (replacedOps)
+    {
+        // Not before the logging calls which may have got it are over,
+        // the last owner drains it and has the executor forget it
+        m_epochs.waitForReaders();
+        replacedOps.reset();
+    }
+}
+
+size_t LoggerRegistry::getLoggerCount() const
+{
+    std::scoped_lock<std::mutex> registryLock(m_mtx);
+    return m_loggers.size();
+}
+
+void LoggerRegistry::resolve(NamedLogger& namedLogger)
+{
+    const auto* parent = namedLogger.m_parent;
+    auto minSeverity = namedLogger.m_ownMinSeverity.value_or(
+                            parent ? parent->m_minSeverity.load() : getLogTypeSeverity(LOG_TYPE::LOG_DEFAULT));
+    auto* ops = namedLogger.m_ownOps ? namedLogger.m_ownOps.get()
+                                     : (parent ? parent->m_ops.load() : &m_rootOps);
+    namedLogger.m_minSeverity.store(minSeverity, std::memory_order_relaxed);
+    namedLogger.m_ops.store(ops, std::memory_order_release);
+
+    for (auto* child : namedLogger.m_children)
+        resolve(*child);
+}
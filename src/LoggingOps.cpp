@@ -27,7 +27,9 @@
  */
 
 #include "LoggingOps.hpp"
+#include "IoExecutor.hpp"
 #include "Clock.hpp"
+#include "Logger.hpp"
 
 #include <sstream>
 #include <bitset>
@@ -38,6 +40,63 @@ using namespace logger;
 
 static std::mutex m_excpFileMtx;
 
+namespace
+{
+    /// The least severe log type let through at each step of the load shedding
+    constexpr std::array<LOG_TYPE, 4> shedSteps = { LOG_TYPE::LOG_DEFAULT, LOG_TYPE::LOG_INFO, LOG_TYPE::LOG_IMP, LOG_TYPE::LOG_WARN };
+    /// The turns in a row it takes to raise or to lower the shed level a step
+    constexpr size_t shedTurns = 3;
+    /// The weight of the last turn in the smoothed drain rate
+    constexpr double drainRateWeight = 0.25;
+
+    /// The sink whose writeRecord() writes a record which takes the priority
+    /// lane, for its push() to tell, the derived writeDataTo() being in between.
+    /// Another sink written to meanwhile, e.g. a child of a MultiSinkOps, decides on its own
+    thread_local const LoggingOps* priorityOps = nullptr;
+
+    /**
+     * @brief Marks the record a sink writes on this thread as a priority one, for a scope
+     * The one marked before, by a sink writing to this one, is marked again once it is over.
+     */
+    class PriorityScope
+    {
+        public:
+            PriorityScope(const LoggingOps& ops, const bool priority) noexcept
+                : m_prevOps(priorityOps)
+            {
+                priorityOps = priority ? &ops : nullptr;
+            }
+            ~PriorityScope()                                        { priorityOps = m_prevOps;      }
+            PriorityScope(const PriorityScope&) = delete;
+            PriorityScope& operator=(const PriorityScope&) = delete;
+
+        private:
+            const LoggingOps* m_prevOps;
+    };
+
+    /// The sink writing a notice of its own on this thread, which takes the priority lane
+    thread_local const LoggingOps* noticeOps = nullptr;
+
+    /**
+     * @brief Marks the record a sink writes on this thread as a notice of its own, for a scope
+     */
+    class NoticeScope
+    {
+        public:
+            explicit NoticeScope(const LoggingOps& ops) noexcept
+                : m_prevOps(noticeOps)
+            {
+                noticeOps = &ops;
+            }
+            ~NoticeScope()                                          { noticeOps = m_prevOps;        }
+            NoticeScope(const NoticeScope&) = delete;
+            NoticeScope& operator=(const NoticeScope&) = delete;
+
+        private:
+            const LoggingOps* m_prevOps;
+    };
+};
+
 /*friend*/ void logger::operator<<(LoggingOps& obj, const std::ostringstream& oss)
 {
     if (oss.good())
@@ -70,27 +129,53 @@ static std::mutex m_excpFileMtx;
 
 LoggingOps::LoggingOps()
     : m_DataRecords()
+    , m_priorityRecords()
     , m_dataReady(false)
     , m_shutAndExit(false)
+    , m_executor(IoExecutor::getShared())
+    , m_writeInFlight(false)
+    , m_priorityInFlight(false)
+    , m_watcherDone(false)
+    , m_levelThreshold(LOG_TYPE::LOG_DEFAULT)
+    , m_priorityLevel(LOG_TYPE::LOG_ERR)
+    , m_maxBatchSize(256)
+    , m_maxLatency(std::chrono::milliseconds(100))
+    , m_maxBacklogDelay(std::chrono::milliseconds(0))
+    , m_shedLevel(LOG_TYPE::LOG_DEFAULT)
+    , m_shedCnt(0)
+    , m_shedStep(0)
+    , m_overloadedTurns(0)
+    , m_calmTurns(0)
+    , m_drainRate(0)
+    , m_backlogDelay(0)
+    , m_lastBacklog(0)
+    , m_shedCheckDue()
     , m_excpPtrVec(0)
 {
 }
 
 /*virtual*/LoggingOps::~LoggingOps()
 {
-    // Wait for any ongoing data operations to finish
-    std::unique_lock<std::mutex> dataLock(m_DataRecordsMtx);
-    // Set the flag to true to indicate that we are shutting down
-    m_shutAndExit = true;
-    // Notify the watcher thread to wake up and complete
-    // any pending operations before exiting
-    dataLock.unlock();
-    m_DataRecordsCv.notify_one();
+    stopWatcher();
+    collectAndPrintExceptions();
+}
 
-    if (m_watcher.joinable())
-        m_watcher.join();
+void LoggingOps::stopWatcher()
+{
+    {
+        std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+        if (m_watcherDone)
+            return;
+        // Set the flag to true to indicate that we are shutting down
+        m_shutAndExit = true;
+    }
+    // Have whatever is pending written, and the executor
+    // done with this object, before it goes away
+    m_executor.retire(*this);
 
-    collectAndPrintExceptions();
+    std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+    m_watcherDone = true;
+    m_drainedCv.notify_all();
 }
 
 void LoggingOps::push(const std::string_view data)
@@ -98,7 +183,9 @@ void LoggingOps::push(const std::string_view data)
     if (data.empty())
         return;
 
-    auto push = [this](std::array<char, bufferSize>& dataRecord, const std::string_view data)
+    auto priority = (priorityOps == this);
+    auto& lane = priority ? m_priorityRecords : m_DataRecords;
+    auto push = [&lane](std::array<char, bufferSize>& dataRecord, const std::string_view data)
     {
         std::copy(data.begin(), data.end(), dataRecord.begin());
         if (data.size() < dataRecord.size())
@@ -106,7 +193,7 @@ void LoggingOps::push(const std::string_view data)
             auto dataSize = data.size();
             std::fill(dataRecord.begin() + dataSize, dataRecord.end(), '\0');
         }
-        m_DataRecords.push(dataRecord);
+        lane.push(dataRecord);
     };
     
     {
@@ -130,14 +217,17 @@ void LoggingOps::push(const std::string_view data)
         {
             push(dataRecord, data);
         }
-    }
-    // If the data queue contains at least 256 elements
-    // then notify the watcher thread that data is available
-    // and it can start writing to the outstream object
-    if (m_DataRecords.size() == 256)
-    {
-        m_dataReady = true;
-        m_DataRecordsCv.notify_one();
+        // A priority record does not wait for a batch to fill up
+        if (priority)
+            scheduleDrain();
+        // If the data queue contains at least a batch of
+        // elements then schedule a drain turn to start
+        // writing to the outstream object
+        else if (m_DataRecords.size() >= m_maxBatchSize && !m_dataReady)
+        {
+            m_dataReady = true;
+            scheduleDrain();
+        }
     }
 }
 
@@ -154,52 +244,211 @@ bool LoggingOps::pop(BufferQ& data)
     return true;
 }
 
-void LoggingOps::keepWatchAndPull()
+/*virtual*/ bool LoggingOps::drainBatch()
 {
+    BufferQ priorityq;
     BufferQ dataq;
-    // It is an infinite loop, but it will break out of the loop
-    // when the m_shutAndExit flag is set to true
-    do
-    {
-        std::unique_lock<std::mutex> dataLock(m_DataRecordsMtx);
-        m_DataRecordsCv.wait(dataLock, [this]{ return m_dataReady || m_shutAndExit.load(); });
-
-        auto success = pop(dataq);
-        dataLock.unlock();
-        m_DataRecordsCv.notify_one();
-        // Spawn a thread to write to the file
-        // and pass the data queue to it so that
-        // the data records queue can be free for
-        // other threads to push data to it
-        // and the file can be written to in parallel
-        // The thread will be joined after the file is written
-        std::thread writerThread;
+    {
+        std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+        priorityq.swap(m_priorityRecords);
+        m_priorityInFlight = !priorityq.empty();
+        m_writeInFlight = pop(dataq) || m_priorityInFlight;
+    }
+    auto backlog = priorityq.size() + dataq.size();
+    auto turnStart = std::chrono::steady_clock::now();
+    if (!priorityq.empty())
+    {
         std::exception_ptr excpPtr = nullptr;
-        if (success)
+        writePriorityToOutStreamObject(std::move(priorityq), excpPtr);
+        if (excpPtr)
+            addRaisedException(excpPtr);
+
+        // Whoever waits for the priority lane does not wait for the rest
+        std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+        m_priorityInFlight = false;
+        m_drainedCv.notify_all();
+    }
+    if (!dataq.empty())
+    {
+        std::exception_ptr excpPtr = nullptr;
+        writeToOutStreamObject(std::move(dataq), excpPtr);
+        if (excpPtr)
+            addRaisedException(excpPtr);
+    }
+
+    bool more = false;
+    bool shedChanged = false;
+    {
+        std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+        m_writeInFlight = false;
+        m_drainedCv.notify_all();
+        shedChanged = noteDrainTurn(backlog, std::chrono::steady_clock::now() - turnStart);
+        // Don't leave behind what got queued while the last batch was being written
+        more = !isPriorityQueueEmpty() || (!isQueueEmpty() && (m_dataReady || m_shutAndExit));
+    }
+    if (shedChanged)
+        writeShedRecord();
+    return more;
+}
+
+void LoggingOps::flushPriorityAndWait()
+{
+    if (m_executor.isExternallyDriven())
+    {
+        m_executor.drainSink(*this);
+        return;
+    }
+
+    std::unique_lock<std::mutex> dataLock(m_DataRecordsMtx);
+    m_drainedCv.wait(dataLock, [this]
+    {
+        return m_watcherDone || (isPriorityQueueEmpty() && !m_priorityInFlight);
+    });
+}
+
+bool LoggingOps::noteDrainTurn(const size_t backlog, const std::chrono::steady_clock::duration elapsed)
+{
+    auto maxBacklogDelay = m_maxBacklogDelay.load();
+    if (maxBacklogDelay.count() <= 0 || m_shutAndExit)
+    {
+        // Turned off while shedding, everything goes through again
+        auto wasShedding = (m_shedStep != 0);
+        m_shedStep = m_overloadedTurns = m_calmTurns = 0;
+        m_shedLevel = shedSteps[0];
+        return wasShedding && !m_shutAndExit;
+    }
+
+    auto elapsedSec = std::chrono::duration<double>(elapsed).count();
+    if (backlog > 0 && elapsedSec > 0)
+    {
+        auto rate = static_cast<double>(backlog) / elapsedSec;
+        m_drainRate = (m_drainRate > 0) ? (1 - drainRateWeight) * m_drainRate + drainRateWeight * rate : rate;
+    }
+    m_lastBacklog = backlog;
+    m_backlogDelay = (backlog > 0 && m_drainRate > 0)
+                   ? std::chrono::milliseconds(static_cast<int64_t>(1000 * static_cast<double>(backlog) / m_drainRate))
+                   : std::chrono::milliseconds(0);
+
+    // Calm well below the limit only, so that it doesn't flap around it
+    if (m_backlogDelay > maxBacklogDelay)
+    {
+        ++m_overloadedTurns;
+        m_calmTurns = 0;
+    }
+    else if (m_backlogDelay < maxBacklogDelay / 4)
+    {
+        ++m_calmTurns;
+        m_overloadedTurns = 0;
+    }
+    else
+        m_overloadedTurns = m_calmTurns = 0;
+
+    auto prevStep = m_shedStep;
+    if (m_overloadedTurns >= shedTurns && m_shedStep + 1 < shedSteps.size())
+        ++m_shedStep;
+    else if (m_calmTurns >= shedTurns && m_shedStep > 0)
+        --m_shedStep;
+    if (m_shedStep != prevStep)
+    {
+        m_overloadedTurns = m_calmTurns = 0;
+        m_shedLevel = shedSteps[m_shedStep];
+    }
+
+    // No records might come to drive the turns, check on the load now and then
+    auto now = std::chrono::steady_clock::now();
+    if (m_shedStep != 0 && now >= m_shedCheckDue)
+    {
+        m_shedCheckDue = now + maxBacklogDelay;
+        scheduleDrainAfter(maxBacklogDelay);
+    }
+    return m_shedStep != prevStep;
+}
+
+bool LoggingOps::isPriority(const LOG_TYPE logType) const noexcept
+{
+    return noticeOps == this || isLogTypeAtLeast(logType, m_priorityLevel);
+}
+
+void LoggingOps::writeShedRecord()
+{
+    auto shedLevel = m_shedLevel.load();
+    const size_t lineNo = __LINE__;
+    Logger logger(LOG_TIME_FORMAT);
+    logger.setFileName(__FILE__)
+          .setFunctionName(__PRETTY_FUNCTION__)
+          .setLineNo(lineNo)
+          .setThreadId(std::this_thread::get_id())
+          .setMarker(FORWARD_ANGLE.data())
+          .setLogType(LOG_TYPE::LOG_WARN);
+    if (shedLevel == LOG_TYPE::LOG_DEFAULT)
+        logger.log("Load shedding over, every level let through again, {} records shed", m_shedCnt.load());
+    else
+        logger.log("Load shedding, {} records took {} ms to drain, only {} and more severe let through",
+                   m_lastBacklog, m_backlogDelay.count(), Logger::covertLogTypeEnumToString(shedLevel));
+
+    auto text = logger.getLogStream().str();
+    // The backlog it tells of is still queued, it must not wait behind it
+    NoticeScope noticeScope(*this);
+    writeRecord(LogRecord::fromLogger(logger, text, __FILE__, __PRETTY_FUNCTION__, FORWARD_ANGLE,
+                                      lineNo, std::this_thread::get_id(), LOG_TYPE::LOG_WARN));
+}
+
+void LoggingOps::scheduleDrain()
+{
+    if (!m_watcherDone)
+        m_executor.schedule(*this);
+}
+
+void LoggingOps::scheduleDrainAfter(const std::chrono::steady_clock::duration delay)
+{
+    // A timer armed by the last turns would outlive the sink
+    if (!m_watcherDone && !m_shutAndExit)
+        m_executor.scheduleAfter(*this, delay);
+}
+
+void LoggingOps::flushAndWait()
+{
+    // No thread to wait for, the caller writes them out
+    if (m_executor.isExternallyDriven())
+    {
         {
-            writerThread = std::thread([this, &dataq, &excpPtr](){ writeToOutStreamObject(std::move(dataq), excpPtr); });
+            std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+            if (m_watcherDone || isQueueEmpty())
+                return;
+            m_dataReady = true;
         }
-        if (writerThread.joinable())
+        m_executor.drainSink(*this);
+        return;
+    }
+
+    std::unique_lock<std::mutex> dataLock(m_DataRecordsMtx);
+    if (m_watcherDone || (isQueueEmpty() && !m_writeInFlight))
+        return;
+
+    m_dataReady = true;
+    scheduleDrain();
+    m_drainedCv.wait(dataLock, [this]
+    {
+        if (m_watcherDone || (isQueueEmpty() && !m_writeInFlight))
+            return true;
+        // Whatever got queued meanwhile must not be left waiting for a full batch
+        if (!isQueueEmpty() && !m_writeInFlight)
         {
-            if (excpPtr)
-                m_excpPtrVec.emplace_back(excpPtr);
-            writerThread.join();
+            m_dataReady = true;
+            scheduleDrain();
         }
-
-        if (m_shutAndExit)
-            break;
-    } while (true);
+        return false;
+    });
 }
 
 void LoggingOps::flush()
 {
-    if (!m_DataRecords.empty())
-    {
-        m_dataReady = true;
-        m_DataRecordsCv.notify_one();
-        // Give it sometime to get flashed
-        std::this_thread::sleep_for(std::chrono::microseconds(200));
-    }
+    std::scoped_lock<std::mutex> dataLock(m_DataRecordsMtx);
+    if (isQueueEmpty())
+        return;
+
+    m_dataReady = true;
+    scheduleDrain();
 }
 
 void LoggingOps::write(const std::string_view data)
@@ -210,6 +459,42 @@ void LoggingOps::write(const std::string_view data)
     writeDataTo(data);
 }
 
+void LoggingOps::writeRecord(const LogRecord& record)
+{
+    if (!admits(record.logType))
+        return;
+
+    PriorityScope priorityScope(*this, isPriority(record.logType));
+    if (record.fields.empty())
+        write(record.text);
+    else
+    {
+        // A text log gets the fields as " key=value" after the message
+        std::string text;
+        text.reserve(record.text.size() + 16 * record.fields.size());
+        text.append(record.text);
+        LogField::appendText(text, record.fields);
+        write(text);
+    }
+}
+
+void LoggingOps::waitForFatal(const LOG_TYPE logType)
+{
+    // The process may well be about to go down
+    if (logType == LOG_TYPE::LOG_FATAL || logType == LOG_TYPE::LOG_ASSERT)
+        flushAndWait();
+}
+
+void LoggingOps::writeRecord(const LOG_TYPE logType, const std::string_view data)
+{
+    LogRecord record;
+    record.logType = logType;
+    record.timestamp = std::chrono::system_clock::now();
+    record.threadId = std::this_thread::get_id();
+    record.text = data;
+    writeRecord(record);
+}
+
 void LoggingOps::write(const std::vector<std::string_view>& dataVec) noexcept
 {
     if (!dataVec.empty())
@@ -363,11 +648,24 @@ void LoggingOps::write(const std::vector<uint64_t>& binaryStream)
     }
 }
 
+std::vector<std::exception_ptr> LoggingOps::getAllExceptions() const
+{
+    std::scoped_lock<std::mutex> excpLock(m_excpMtx);
+    return m_excpPtrVec;
+}
+
+void LoggingOps::addRaisedException(const std::exception_ptr& excpPtr) noexcept
+{
+    std::scoped_lock<std::mutex> excpLock(m_excpMtx);
+    m_excpPtrVec.emplace_back(excpPtr);
+}
+
 void LoggingOps::collectAndPrintExceptions()
 {
     // Check for if there is any data write exceptions
     // before quitting. If so, log them in a common file
-    if (!m_excpPtrVec.empty())
+    auto excpPtrVec = getAllExceptions();
+    if (!excpPtrVec.empty())
     {
         auto constructMsg = [](const std::exception& excp)
         {
@@ -388,7 +686,7 @@ void LoggingOps::collectAndPrintExceptions()
         std::ofstream excpFile(filePathObj, std::ios::app | std::ios::binary);
         if (excpFile.is_open())
         {
-            for (const auto& excp : m_excpPtrVec)
+            for (const auto& excp : excpPtrVec)
             {
                 try
                 {
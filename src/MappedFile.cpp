@@ -0,0 +1,230 @@
+/*
+ * MappedFile.cpp
+ *
+ * Implementation of the MappedFile class, a read only and memory mapped
+ * view of a log file with zero copy line iteration.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "MappedFile.hpp"
+#include "LineScanner.hpp"
+
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief Owns a file descriptor opened for reading
+     */
+    class ReadOnlyFd
+    {
+        public:
+            explicit ReadOnlyFd(const std::filesystem::path& file)
+                : m_fd(::open(file.c_str(), O_RDONLY | O_CLOEXEC))
+            {
+                if (m_fd < 0)
+                    throw std::runtime_error("MMAP_ERROR : File " + file.string() + " can't be opened: " + std::strerror(errno));
+            }
+            ~ReadOnlyFd()                                       { ::close(m_fd);    }
+            ReadOnlyFd(const ReadOnlyFd&) = delete;
+            ReadOnlyFd& operator=(const ReadOnlyFd&) = delete;
+
+            inline int get() const                              { return m_fd;      }
+
+            size_t size(const std::filesystem::path& file) const
+            {
+                struct stat fileStat = {};
+                if (::fstat(m_fd, &fileStat) != 0)
+                    throw std::runtime_error("MMAP_ERROR : File " + file.string() + " can't be stat'ed: " + std::strerror(errno));
+                return static_cast<size_t>(fileStat.st_size);
+            }
+
+        private:
+            int m_fd;
+    };
+
+    /**
+     * @brief Map a range of a file read only, for a sequential read
+     */
+    const char* mapRange(const int fd, const size_t offset, const size_t len, const std::filesystem::path& file)
+    {
+        void* mapping = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(offset));
+        if (mapping == MAP_FAILED)
+            throw std::runtime_error("MMAP_ERROR : File " + file.string() + " can't be mapped: " + std::strerror(errno));
+
+        ::madvise(mapping, len, MADV_SEQUENTIAL);
+        return static_cast<const char*>(mapping);
+    }
+};
+
+MappedFile::LineIterator::LineIterator(const std::string_view buffer)
+    : m_rest(buffer)
+{
+    readLine();
+}
+
+MappedFile::LineIterator& MappedFile::LineIterator::operator++()
+{
+    readLine();
+    return *this;
+}
+
+MappedFile::LineIterator MappedFile::LineIterator::operator++(int)
+{
+    auto prev = *this;
+    readLine();
+    return prev;
+}
+
+void MappedFile::LineIterator::readLine()
+{
+    if (m_rest.empty())
+    {
+        m_line = std::string_view();    // The end
+        return;
+    }
+
+    auto restEnd = m_rest.data() + m_rest.size();
+    auto newLine = LineScanner::findNewLine(m_rest.data(), restEnd);
+    if (newLine != restEnd)
+    {
+        auto lineLen = static_cast<size_t>(newLine - m_rest.data());
+        m_line = m_rest.substr(0, lineLen);
+        m_rest.remove_prefix(lineLen + 1);
+    }
+    else
+    {
+        m_line = m_rest;
+        m_rest = std::string_view();
+    }
+}
+
+/*static*/ size_t MappedFile::forEachLine(const std::filesystem::path& file,
+                                          const std::function<bool(std::string_view)>& func,
+                                          const size_t chunkSize)
+{
+    ReadOnlyFd fd(file);
+    auto fileSize = fd.size(file);
+    static const auto pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    auto windowSize = std::max(pageSize, ((chunkSize + pageSize - 1) / pageSize) * pageSize);
+
+    size_t lineCnt = 0;
+    size_t lineStart = 0;   // Offset of the first line not visited yet
+    while (lineStart < fileSize)
+    {
+        // mmap wants a page aligned offset
+        auto windowStart = lineStart - (lineStart % pageSize);
+        auto windowLen = std::min(windowSize, fileSize - windowStart);
+        const char* mapping = mapRange(fd.get(), windowStart, windowLen, file);
+        auto lastWindow = (windowStart + windowLen == fileSize);
+        std::string_view buffer(mapping + (lineStart - windowStart), windowLen - (lineStart - windowStart));
+        if (!lastWindow)
+        {
+            // Leave the incomplete line at the end to the next window
+            auto lastNewLine = buffer.rfind('\n');
+            if (lastNewLine == std::string_view::npos)
+            {
+                // A single line longer than the window, map a bigger one
+                ::munmap(const_cast<char*>(mapping), windowLen);
+                windowSize *= 2;
+                continue;
+            }
+            buffer = buffer.substr(0, lastNewLine + 1);
+        }
+
+        auto keepGoing = true;
+        for (auto itr = LineIterator(buffer); itr != LineIterator(); ++itr)
+        {
+            ++lineCnt;
+            if (!func(*itr))
+            {
+                keepGoing = false;
+                break;
+            }
+        }
+        ::munmap(const_cast<char*>(mapping), windowLen);
+        if (!keepGoing)
+            break;
+
+        lineStart += buffer.size();
+    }
+    return lineCnt;
+}
+
+MappedFile::MappedFile(const std::filesystem::path& file)
+    : m_mapping(nullptr)
+    , m_size(0)
+{
+    ReadOnlyFd fd(file);
+    auto fileSize = fd.size(file);
+    if (fileSize == 0)
+        return; // Nothing to map, mmap does not take a zero length
+
+    m_mapping = mapRange(fd.get(), 0, fileSize, file);
+    m_size = fileSize;
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+    : m_mapping(rhs.m_mapping)
+    , m_size(rhs.m_size)
+{
+    rhs.m_mapping = nullptr;
+    rhs.m_size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        unmap();
+        m_mapping = rhs.m_mapping;
+        m_size = rhs.m_size;
+        rhs.m_mapping = nullptr;
+        rhs.m_size = 0;
+    }
+    return *this;
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (m_mapping)
+        ::munmap(const_cast<char*>(m_mapping), m_size);
+
+    m_mapping = nullptr;
+    m_size = 0;
+}
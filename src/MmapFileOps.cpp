@@ -0,0 +1,262 @@
+/*
+ * MmapFileOps.cpp
+ *
+ * Implementation of the MmapFileOps class, which writes the log into
+ * preallocated and memory mapped file segments.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "MmapFileOps.hpp"
+
+#include <cstring>
+#include <cerrno>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace logger;
+
+namespace
+{
+    std::string errorMessage(const std::string_view what, const std::filesystem::path& file)
+    {
+        std::ostringstream os;
+        os << "MMAP_ERROR : [" << std::this_thread::get_id() << "]: ";
+        os << what << " for file [" << file.string() << "]: " << std::strerror(errno);
+        return os.str();
+    }
+};
+
+MmapFileOps::MmapFileOps(const std::uintmax_t segmentSize,
+                         const std::string_view fileName,
+                         const std::string_view filePath,
+                         const std::string_view fileExtension,
+                         const MmapSyncPolicy syncPolicy)
+    : FileOps(segmentSize, fileName, filePath, fileExtension)
+    , m_fd(-1)
+    , m_mapping(nullptr)
+    , m_mappedSize(0)
+    , m_writeOffset(0)
+    , m_rolledSegments(0)
+    , m_syncPolicy(syncPolicy)
+{
+}
+
+MmapFileOps::~MmapFileOps()
+{
+    // The writer must be done with the mapping before it goes away
+    stopWatcher();
+    std::scoped_lock<std::mutex> segmentLock(m_segmentMtx);
+    try
+    {
+        unmapSegment();
+    }
+    catch(...)
+    {
+        addRaisedException(std::current_exception());
+    }
+}
+
+void MmapFileOps::closeSegment()
+{
+    // Nothing queued so far may land in the next mapping
+    flushAndWait();
+    std::scoped_lock<std::mutex> segmentLock(m_segmentMtx);
+    try
+    {
+        unmapSegment();
+    }
+    catch(...)
+    {
+        addRaisedException(std::current_exception());
+    }
+}
+
+void MmapFileOps::writeDataTo(const std::string_view data)
+{
+    if (data.empty())
+        return;
+
+    push(data);
+}
+
+void MmapFileOps::openSegment()
+{
+    const auto& filePathObj = getFilePathObj();
+    if (filePathObj.empty())
+        throw std::runtime_error("File path is empty");
+
+    m_fd = ::open(filePathObj.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_fd < 0)
+        throw std::runtime_error(errorMessage("open failed", filePathObj));
+
+    auto closeAndThrow = [this, &filePathObj](const std::string_view what)
+    {
+        auto errMsg = errorMessage(what, filePathObj);
+        ::close(m_fd);
+        m_fd = -1;
+        throw std::runtime_error(errMsg);
+    };
+
+    struct stat fileStat = {};
+    if (::fstat(m_fd, &fileStat) != 0)
+        closeAndThrow("fstat failed");
+
+    std::uintmax_t currFileSize = static_cast<std::uintmax_t>(fileStat.st_size);
+    m_mappedSize = std::max(getMaxFileSize(), currFileSize);
+    // Reserve the blocks upfront so that the steady state writes
+    // never have to allocate any, and never fail with SIGBUS
+#if defined(__linux__)
+    errno = ::posix_fallocate(m_fd, 0, static_cast<off_t>(m_mappedSize));
+    if (errno != 0)
+        closeAndThrow("posix_fallocate failed");
+#else
+    if (::ftruncate(m_fd, static_cast<off_t>(m_mappedSize)) != 0)
+        closeAndThrow("ftruncate failed");
+#endif
+
+    void* mapping = ::mmap(nullptr, m_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (mapping == MAP_FAILED)
+        closeAndThrow("mmap failed");
+
+    m_mapping = static_cast<char*>(mapping);
+    // Carry on after the last byte written, skipping the zero filled tail
+    // of a segment which was never closed properly
+    auto writeOffset = currFileSize;
+    while (writeOffset > 0 && m_mapping[writeOffset - 1] == '\0')
+        --writeOffset;
+
+    m_writeOffset = writeOffset;
+}
+
+void MmapFileOps::unmapSegment()
+{
+    if (!m_mapping)
+        return;
+
+    auto writeOffset = m_writeOffset.load();
+    if (m_syncPolicy != MmapSyncPolicy::NONE)
+        syncRange(0, writeOffset, true);
+
+    ::munmap(m_mapping, m_mappedSize);
+    m_mapping = nullptr;
+    m_mappedSize = 0;
+
+    // Give back the unused, preallocated part of the segment
+    auto truncated = (::ftruncate(m_fd, static_cast<off_t>(writeOffset)) == 0);
+    ::close(m_fd);
+    m_fd = -1;
+    if (!truncated)
+        throw std::runtime_error(errorMessage("ftruncate failed", getFilePathObj()));
+}
+
+void MmapFileOps::rollOverSegment()
+{
+    unmapSegment();
+    auto newFileName = getRotatedFileName();
+    std::filesystem::rename(getFilePathObj(), getFilePathObj().parent_path() / newFileName);
+    ++m_rolledSegments;
+    openSegment();
+}
+
+void MmapFileOps::syncRange(const std::uintmax_t start, const std::uintmax_t end, const bool wait)
+{
+    if (!m_mapping || end <= start)
+        return;
+
+    // msync wants a page aligned address
+    static const auto pageSize = static_cast<std::uintmax_t>(::sysconf(_SC_PAGESIZE));
+    auto alignedStart = start - (start % pageSize);
+    auto length = end - alignedStart;
+
+    // A group commit is an msync of the batch, the mapping being what gets written
+    auto perBatch = (getDurabilityPolicy() == DurabilityPolicy::PER_BATCH);
+    if (!wait && !perBatch)
+        markUnsynced();     // For the periodic sync
+    auto policy = (wait || perBatch) ? MmapSyncPolicy::SYNC : m_syncPolicy.load();
+    switch (policy)
+    {
+        case MmapSyncPolicy::NONE:
+            break;
+        case MmapSyncPolicy::SYNC:
+        {
+            auto syncStart = std::chrono::steady_clock::now();
+            auto success = (::msync(m_mapping + alignedStart, length, MS_SYNC) == 0);
+            noteSync(success, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - syncStart));
+            if (!success && perBatch)
+                throw std::runtime_error(errorMessage("msync failed", getFilePathObj()));
+            break;
+        }
+        case MmapSyncPolicy::RANGE:
+#if defined(__linux__)
+            ::sync_file_range(m_fd, static_cast<off_t>(start), static_cast<off_t>(end - start), SYNC_FILE_RANGE_WRITE);
+            break;
+#else
+            [[fallthrough]];
+#endif
+        case MmapSyncPolicy::ASYNC:
+            ::msync(m_mapping + alignedStart, length, MS_ASYNC);
+            break;
+    }
+}
+
+void MmapFileOps::writeToOutStreamObject(BufferQ&& dataQueue, std::exception_ptr& excpPtr)
+{
+    if (dataQueue.empty())
+        return;
+
+    std::scoped_lock<std::mutex> segmentLock(m_segmentMtx);
+    try
+    {
+        if (!m_mapping)
+            openSegment();
+
+        auto batchStart = m_writeOffset.load();
+        while (!dataQueue.empty())
+        {
+            const auto& data = dataQueue.front();
+            auto dataLen = ::strnlen(data.data(), data.size());
+            auto writeOffset = m_writeOffset.load();
+            if (writeOffset + dataLen + 1 > m_mappedSize)
+            {
+                syncRange(batchStart, writeOffset, false);
+                rollOverSegment();
+                writeOffset = batchStart = m_writeOffset.load();
+                if (writeOffset + dataLen + 1 > m_mappedSize)
+                    throw std::runtime_error("Segment size is too small to hold a single data record");
+            }
+            std::memcpy(m_mapping + writeOffset, data.data(), dataLen);
+            m_mapping[writeOffset + dataLen] = '\n';
+            m_writeOffset = writeOffset + dataLen + 1;
+            dataQueue.pop();
+        }
+        syncRange(batchStart, m_writeOffset, false);
+    }
+    catch(...)
+    {
+        excpPtr = std::current_exception();
+    }
+}
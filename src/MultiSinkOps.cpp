@@ -0,0 +1,111 @@
+/*
+ * MultiSinkOps.cpp
+ *
+ * Implementation of the MultiSinkOps class. A record is formatted once by the
+ * caller and only its bytes are copied into the queue of every sink, so that
+ * a slow sink holds up its own writer thread and not the others.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "MultiSinkOps.hpp"
+
+#include <stdexcept>
+
+using namespace logger;
+
+MultiSinkOps::MultiSinkOps()
+    : LoggingOps()
+    , m_sinksMtx()
+    , m_sinks()
+{
+}
+
+MultiSinkOps::~MultiSinkOps()
+{
+    std::unique_lock<std::shared_mutex> sinksLock(m_sinksMtx);
+    m_sinks.clear();
+}
+
+LoggingOps& MultiSinkOps::addSink(std::unique_ptr<LoggingOps> sink, const LOG_TYPE threshold)
+{
+    if (!sink || sink.get() == this)
+        throw std::invalid_argument("SINK_ERROR : A null sink or the MultiSinkOps itself can't be added");
+
+    sink->setLevelThreshold(threshold);
+    std::unique_lock<std::shared_mutex> sinksLock(m_sinksMtx);
+    m_sinks.emplace_back(std::move(sink));
+    return *m_sinks.back();
+}
+
+size_t MultiSinkOps::getSinkCount() const
+{
+    std::shared_lock<std::shared_mutex> sinksLock(m_sinksMtx);
+    return m_sinks.size();
+}
+
+LoggingOps& MultiSinkOps::getSink(const size_t idx) const
+{
+    std::shared_lock<std::shared_mutex> sinksLock(m_sinksMtx);
+    if (idx >= m_sinks.size())
+        throw std::out_of_range("SINK_ERROR : No sink at index " + std::to_string(idx));
+
+    return *m_sinks[idx];
+}
+
+void MultiSinkOps::writeRecord(const LogRecord& record)
+{
+    if (record.text.empty() || !isLogTypeAtLeast(record.logType, getLevelThreshold()))
+        return;
+
+    std::shared_lock<std::shared_mutex> sinksLock(m_sinksMtx);
+    for (auto& sink : m_sinks)
+        sink->writeRecord(record);
+}
+
+void MultiSinkOps::writeDataTo(const std::string_view data)
+{
+    std::shared_lock<std::shared_mutex> sinksLock(m_sinksMtx);
+    for (auto& sink : m_sinks)
+        sink->write(data);
+}
+
+void MultiSinkOps::flush()
+{
+    std::shared_lock<std::shared_mutex> sinksLock(m_sinksMtx);
+    for (auto& sink : m_sinks)
+        sink->flush();
+}
+
+void MultiSinkOps::flushAndWait()
+{
+    std::shared_lock<std::shared_mutex> sinksLock(m_sinksMtx);
+    for (auto& sink : m_sinks)
+        sink->flushAndWait();
+}
+
+void MultiSinkOps::commitCritical()
+{
+    std::shared_lock<std::shared_mutex> sinksLock(m_sinksMtx);
+    for (auto& sink : m_sinks)
+        sink->commitCritical();
+}
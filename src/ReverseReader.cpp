@@ -0,0 +1,252 @@
+/*
+ * ReverseReader.cpp
+ *
+ * Implementation of the ReverseReader class. The file is read backwards in
+ * blocks, so the cost of a read is about the bytes returned whatever the
+ * size of the file.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "ReverseReader.hpp"
+#include "FileOps.hpp"
+#include "LogLine.hpp"
+
+#include <limits>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using namespace logger;
+
+ReverseReader::ReverseReader(const std::filesystem::path& file, const size_t blockSize)
+    : m_fd(::open(file.c_str(), O_RDONLY | O_CLOEXEC))
+    , m_blockSize(blockSize ? blockSize : defaultBlockSize)
+    , m_fileSize(0)
+    , m_lineEnd(0)
+    , m_blockStart(0)
+    , m_bytesRead(0)
+    , m_done(false)
+{
+    if (m_fd < 0)
+        throw std::runtime_error("File " + file.string() + " can't be opened for reading: " + std::strerror(errno));
+
+    struct stat fileStat = {};
+    if (::fstat(m_fd, &fileStat) != 0)
+    {
+        auto errNo = errno;
+        close();
+        throw std::runtime_error("File " + file.string() + " can't be stat'ed: " + std::strerror(errNo));
+    }
+    m_fileSize = static_cast<std::uintmax_t>(fileStat.st_size);
+    m_lineEnd = m_fileSize;
+    m_blockStart = m_fileSize;
+    m_done = (m_fileSize == 0);
+}
+
+ReverseReader::~ReverseReader()
+{
+    close();
+}
+
+ReverseReader::ReverseReader(ReverseReader&& rhs) noexcept
+    : m_fd(rhs.m_fd)
+    , m_blockSize(rhs.m_blockSize)
+    , m_fileSize(rhs.m_fileSize)
+    , m_lineEnd(rhs.m_lineEnd)
+    , m_blockStart(rhs.m_blockStart)
+    , m_block(std::move(rhs.m_block))
+    , m_bytesRead(rhs.m_bytesRead)
+    , m_done(rhs.m_done)
+{
+    rhs.m_fd = -1;
+    rhs.m_done = true;
+}
+
+ReverseReader& ReverseReader::operator=(ReverseReader&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        close();
+        m_fd = rhs.m_fd;
+        m_blockSize = rhs.m_blockSize;
+        m_fileSize = rhs.m_fileSize;
+        m_lineEnd = rhs.m_lineEnd;
+        m_blockStart = rhs.m_blockStart;
+        m_block = std::move(rhs.m_block);
+        m_bytesRead = rhs.m_bytesRead;
+        m_done = rhs.m_done;
+        rhs.m_fd = -1;
+        rhs.m_done = true;
+    }
+    return *this;
+}
+
+void ReverseReader::close() noexcept
+{
+    if (m_fd >= 0)
+        ::close(m_fd);
+    m_fd = -1;
+}
+
+bool ReverseReader::prevLine(std::string& line)
+{
+    line.clear();
+    if (m_done)
+        return false;
+
+    // Pieces of a line longer than what is left of the block, the last one first
+    std::vector<std::string> pieces;
+    while (true)
+    {
+        if (m_lineEnd == 0)
+        {
+            m_done = true;  // An empty first line
+            break;
+        }
+
+        if (m_lineEnd <= m_blockStart)
+        {
+            auto start = (m_lineEnd > m_blockSize) ? m_lineEnd - m_blockSize : 0;
+            auto readCnt = FileOps::readFileByteRange(m_fd, start, m_lineEnd, m_block);
+            if (readCnt != m_lineEnd - start)
+                throw std::runtime_error("File got truncated while being read backwards");
+
+            m_bytesRead += readCnt;
+            // The new line ending the file does not start another line
+            if (m_lineEnd == m_fileSize && m_block.back() == '\n')
+            {
+                --m_lineEnd;
+                m_block.pop_back();
+                if (m_lineEnd == 0)
+                {
+                    m_done = true;
+                    break;
+                }
+            }
+            m_blockStart = start;
+        }
+
+        std::string_view rest(m_block.data(), static_cast<size_t>(m_lineEnd - m_blockStart));
+        auto newLinePos = rest.rfind('\n');
+        if (newLinePos != std::string_view::npos)
+        {
+            pieces.emplace_back(rest.substr(newLinePos + 1));
+            m_lineEnd = m_blockStart + newLinePos;
+            break;
+        }
+
+        pieces.emplace_back(rest);
+        m_lineEnd = m_blockStart;
+        if (m_blockStart == 0)
+        {
+            m_done = true;
+            break;
+        }
+    }
+
+    if (pieces.size() == 1)
+    {
+        line = std::move(pieces.front());
+    }
+    else
+    {
+        for (auto itr = pieces.rbegin(); itr != pieces.rend(); ++itr)
+            line += *itr;
+    }
+    return true;
+}
+
+std::vector<std::string> ReverseReader::lastLines(const size_t lineCnt)
+{
+    std::vector<std::string> lines;
+    std::string line;
+    while (lines.size() < lineCnt && prevLine(line))
+        lines.push_back(std::move(line));
+
+    std::reverse(lines.begin(), lines.end());
+    return lines;
+}
+
+template <typename Predicate>
+std::vector<std::string> ReverseReader::collectRecords(const size_t maxRecords, Predicate keepGoing)
+{
+    std::vector<std::string> records;
+    std::vector<std::string> pending;   // Lines without a prefix, the last one first
+    auto joinRecord = [&pending](std::string record)
+    {
+        for (auto itr = pending.rbegin(); itr != pending.rend(); ++itr)
+        {
+            record += '\n';
+            record += *itr;
+        }
+        pending.clear();
+        return record;
+    };
+
+    std::string line;
+    auto stopped = false;
+    while (records.size() < maxRecords && prevLine(line))
+    {
+        LogLine head;
+        if (!LogLine::parse(line, head))
+        {
+            pending.push_back(std::move(line));
+            continue;
+        }
+        if (!keepGoing(records.size(), &head))
+        {
+            stopped = true;
+            break;
+        }
+        records.push_back(joinRecord(std::move(line)));
+    }
+
+    // Lines without a prefix at the very beginning of the file
+    if (!stopped && !pending.empty() && records.size() < maxRecords && keepGoing(records.size(), nullptr))
+    {
+        auto first = std::move(pending.back());
+        pending.pop_back();
+        records.push_back(joinRecord(std::move(first)));
+    }
+
+    std::reverse(records.begin(), records.end());
+    return records;
+}
+
+std::vector<std::string> ReverseReader::lastRecords(const size_t recordCnt)
+{
+    return collectRecords(recordCnt, [](size_t, const LogLine*) { return true; });
+}
+
+std::vector<std::string> ReverseReader::recordsSince(const std::string_view timestamp)
+{
+    return collectRecords(std::numeric_limits<size_t>::max(), [timestamp](size_t, const LogLine* head)
+    {
+        return head && head->timestamp >= timestamp;
+    });
+}
@@ -0,0 +1,484 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="BatchSinkOpsTests.*"
+
+/*
+ * BatchSinkOpsTest.cpp
+ * Unit tests for BatchSinkOps functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the BatchSinkOps class: the records and
+ * their metadata as a LogSink gets them, the batching, the sink flushes,
+ * the exceptions raised by a sink, the load shedding and the priority lane.
+ */
+
+#include "BatchSinkOps.hpp"
+#include "MultiSinkOps.hpp"
+#include "CommonFunc.hpp"
+
+#include <numeric>
+#include <algorithm>
+#include <filesystem>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief A record copied out of a batch
+     */
+    struct CollectedRecord
+    {
+        LOG_TYPE logType;
+        std::chrono::system_clock::time_point timestamp;
+        std::thread::id threadId;
+        std::string fileName;
+        std::string funcName;
+        size_t lineNo;
+        std::string text;
+        std::string fields;     ///< As rendered in the text logs
+        std::vector<LogField::Type> fieldTypes;
+    };
+
+    /**
+     * @brief A sink keeping a copy of everything it gets
+     */
+    class CollectingSink : public LogSink
+    {
+        public:
+            void consume(std::span<const LogRecord> records) override
+            {
+                // A slow device, whatever the size of the batch
+                std::this_thread::sleep_for(m_consumeDelay.load());
+                std::scoped_lock<std::mutex> lock(m_mtx);
+                m_batchSizes.push_back(records.size());
+                for (const auto& record : records)
+                {
+                    std::string fields;
+                    LogField::appendText(fields, record.fields);
+                    std::vector<LogField::Type> fieldTypes;
+                    for (const auto& field : record.fields)
+                        fieldTypes.push_back(field.getType());
+                    m_records.push_back({ record.logType, record.timestamp, record.threadId,
+                                          std::string(record.fileName), std::string(record.funcName),
+                                          record.lineNo, std::string(record.text), fields, fieldTypes });
+                }
+            }
+
+            void flush() override                                   { ++m_flushCnt; }
+            std::string getName() const override                    { return "CollectingSink"; }
+
+            std::vector<CollectedRecord> getRecords()
+            {
+                std::scoped_lock<std::mutex> lock(m_mtx);
+                return m_records;
+            }
+
+            std::vector<size_t> getBatchSizes()
+            {
+                std::scoped_lock<std::mutex> lock(m_mtx);
+                return m_batchSizes;
+            }
+
+            size_t getFlushCount() const                            { return m_flushCnt; }
+            void setConsumeDelay(const std::chrono::milliseconds delay)   { m_consumeDelay = delay; }
+
+        private:
+            std::mutex m_mtx;
+            std::vector<CollectedRecord> m_records;
+            std::vector<size_t> m_batchSizes;
+            std::atomic<size_t> m_flushCnt = 0;
+            std::atomic<std::chrono::milliseconds> m_consumeDelay = std::chrono::milliseconds(0);
+    };
+
+    /**
+     * @brief A sink failing on every batch
+     */
+    class FailingSink : public LogSink
+    {
+        public:
+            void consume(std::span<const LogRecord>) override
+            {
+                throw std::runtime_error("SINK_ERROR : Failing on purpose");
+            }
+    };
+};
+
+class BatchSinkOpsTests : public CommonTestDataGenerator
+{
+    public:
+        /**
+         * @brief Make a BatchSinkOps with a CollectingSink
+         */
+        static std::unique_ptr<BatchSinkOps> makeOps(const size_t maxBatchSize = BatchSinkOps::defaultMaxBatchSize,
+                                                     const std::chrono::milliseconds maxLatency = std::chrono::seconds(10))
+        {
+            return std::make_unique<BatchSinkOps>(std::make_unique<CollectingSink>(), maxBatchSize, maxLatency);
+        }
+
+        static CollectingSink& getSink(BatchSinkOps& ops)
+        {
+            return dynamic_cast<CollectingSink&>(ops.getSink());
+        }
+};
+
+TEST_F(BatchSinkOpsTests, testRecordMetadata)
+{
+    auto ops = makeOps();
+    auto& sink = getSink(*ops);
+    EXPECT_EQ("CollectingSink", ops->getClassId());
+
+    auto timestamp = std::chrono::system_clock::now();
+    std::vector<std::string> texts;
+    for (size_t cnt = 0; cnt < 100; ++cnt)
+    {
+        // Build them in a temporary, the sink must get copies
+        auto text = generateRandomText(1 + cnt * 3);
+        auto fileName = "File" + std::to_string(cnt) + ".cpp";
+        auto funcName = "func" + std::to_string(cnt);
+        LogRecord record;
+        record.logType = (cnt % 2) ? LOG_TYPE::LOG_WARN : LOG_TYPE::LOG_DBG;
+        record.timestamp = timestamp + std::chrono::milliseconds(cnt);
+        record.threadId = std::this_thread::get_id();
+        record.fileName = fileName;
+        record.funcName = funcName;
+        record.lineNo = cnt;
+        record.text = text;
+        ops->writeRecord(record);
+        texts.push_back(text);
+    }
+    ops->flushAndWait();
+
+    auto records = sink.getRecords();
+    ASSERT_EQ(texts.size(), records.size());
+    for (size_t cnt = 0; cnt < records.size(); ++cnt)
+    {
+        EXPECT_EQ((cnt % 2) ? LOG_TYPE::LOG_WARN : LOG_TYPE::LOG_DBG, records[cnt].logType);
+        EXPECT_EQ(timestamp + std::chrono::milliseconds(cnt), records[cnt].timestamp);
+        EXPECT_EQ(std::this_thread::get_id(), records[cnt].threadId);
+        EXPECT_EQ("File" + std::to_string(cnt) + ".cpp", records[cnt].fileName);
+        EXPECT_EQ("func" + std::to_string(cnt), records[cnt].funcName);
+        EXPECT_EQ(cnt, records[cnt].lineNo);
+        EXPECT_EQ(texts[cnt], records[cnt].text);
+    }
+}
+
+TEST_F(BatchSinkOpsTests, testRecordFields)
+{
+    auto ops = makeOps(16);
+    auto& sink = getSink(*ops);
+    std::vector<std::string> expected;
+    for (size_t cnt = 0; cnt < 100; ++cnt)
+    {
+        // Keys and string values in temporaries, the sink must get copies
+        auto key = "key" + std::to_string(cnt);
+        auto value = generateRandomText(cnt % 7);
+        std::vector<LogField> fields;
+        for (size_t idx = 0; idx < cnt % 4; ++idx)
+            fields.push_back((idx % 2) ? kv(key, value) : kv(key, -static_cast<int64_t>(cnt)));
+        auto text = "Record " + std::to_string(cnt);
+        LogRecord record;
+        record.logType = LOG_TYPE::LOG_INFO;
+        record.text = text;
+        record.fields = fields;
+        ops->writeRecord(record);
+
+        std::string rendered;
+        LogField::appendText(rendered, fields);
+        expected.push_back(rendered);
+        key.assign(key.size(), '?');
+        value.assign(value.size(), '?');
+    }
+    ops->flushAndWait();
+
+    auto records = sink.getRecords();
+    ASSERT_EQ(expected.size(), records.size());
+    for (size_t cnt = 0; cnt < records.size(); ++cnt)
+    {
+        EXPECT_EQ(expected[cnt], records[cnt].fields) << cnt;
+        ASSERT_EQ(cnt % 4, records[cnt].fieldTypes.size());
+        for (size_t idx = 0; idx < records[cnt].fieldTypes.size(); ++idx)
+            EXPECT_EQ((idx % 2) ? LogField::Type::STRING : LogField::Type::INT, records[cnt].fieldTypes[idx]);
+    }
+}
+
+TEST_F(BatchSinkOpsTests, testBatchSize)
+{
+    auto ops = makeOps(64);
+    auto& sink = getSink(*ops);
+    for (auto cnt = 0; cnt < 64 * 5; ++cnt)
+        ops->writeRecord(LOG_TYPE::LOG_INFO, generateRandomText(50));
+    ops->flushAndWait();
+
+    auto batchSizes = sink.getBatchSizes();
+    EXPECT_EQ(batchSizes.size(), ops->getBatchCount());
+    EXPECT_EQ(64 * 5, std::accumulate(batchSizes.begin(), batchSizes.end(), size_t(0)));
+    // A batch gets handed over once full, but more may be queued meanwhile
+    EXPECT_GE(batchSizes.front(), 64);
+}
+
+TEST_F(BatchSinkOpsTests, testMaxLatency)
+{
+    auto ops = makeOps(BatchSinkOps::defaultMaxBatchSize, std::chrono::milliseconds(20));
+    auto& sink = getSink(*ops);
+    ops->writeRecord(LOG_TYPE::LOG_INFO, "Not a full batch");
+    // Neither flushed nor a full batch, it goes after the max latency anyway
+    for (auto cnt = 0; cnt < 100 && sink.getRecords().empty(); ++cnt)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(1, sink.getRecords().size());
+    EXPECT_EQ("Not a full batch", sink.getRecords().front().text);
+}
+
+TEST_F(BatchSinkOpsTests, testCommitCriticalFlushesSink)
+{
+    auto ops = makeOps();
+    auto& sink = getSink(*ops);
+    ops->writeRecord(LOG_TYPE::LOG_INFO, "Before the error");
+    ops->writeRecord(LOG_TYPE::LOG_ERR, "The error");
+    EXPECT_EQ(0, sink.getFlushCount());
+    ops->commitCritical();
+    EXPECT_EQ(1, sink.getFlushCount());
+    EXPECT_EQ(2, sink.getRecords().size());
+
+    // Even with nothing queued the sink gets flushed
+    ops->commitCritical();
+    EXPECT_EQ(2, sink.getFlushCount());
+}
+
+TEST_F(BatchSinkOpsTests, testThresholdAndUntypedWrites)
+{
+    auto ops = makeOps();
+    auto& sink = getSink(*ops);
+    ops->setLevelThreshold(LOG_TYPE::LOG_ERR);
+    ops->writeRecord(LOG_TYPE::LOG_WARN, "Dropped");
+    ops->writeRecord(LOG_TYPE::LOG_FATAL, "Kept");
+    *ops << std::string_view("Untyped");
+    ops->flushAndWait();
+
+    auto records = sink.getRecords();
+    ASSERT_EQ(2, records.size());
+    EXPECT_EQ("Kept", records[0].text);
+    EXPECT_EQ(LOG_TYPE::LOG_DEFAULT, records[1].logType);
+    EXPECT_EQ("Untyped", records[1].text);
+}
+
+TEST_F(BatchSinkOpsTests, testLoadShedding)
+{
+    auto ops = makeOps(16, std::chrono::milliseconds(5));
+    auto& sink = getSink(*ops);
+    ops->setLoadShedding(std::chrono::milliseconds(10));
+    // Every batch takes longer to drain than the load shedding allows
+    sink.setConsumeDelay(std::chrono::milliseconds(30));
+
+    const std::array<LOG_TYPE, 5> logTypes = { LOG_TYPE::LOG_DBG, LOG_TYPE::LOG_INFO, LOG_TYPE::LOG_IMP,
+                                               LOG_TYPE::LOG_WARN, LOG_TYPE::LOG_ERR };
+    size_t severeCnt = 0;
+    auto writeRound = [&]()
+    {
+        for (auto logType : logTypes)
+            ops->writeRecord(logType, "Storm");
+        severeCnt += 2;
+    };
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    std::vector<LOG_TYPE> shedLevels;
+    while (ops->getShedLevel() != LOG_TYPE::LOG_WARN && std::chrono::steady_clock::now() < deadline)
+    {
+        writeRound();
+        if (shedLevels.empty() || shedLevels.back() != ops->getShedLevel())
+            shedLevels.push_back(ops->getShedLevel());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(LOG_TYPE::LOG_WARN, ops->getShedLevel());
+    // A level at a time
+    std::vector<LOG_TYPE> expected = { LOG_TYPE::LOG_DEFAULT, LOG_TYPE::LOG_INFO, LOG_TYPE::LOG_IMP };
+    EXPECT_EQ(expected, shedLevels);
+
+    auto shedCnt = ops->getShedCount();
+    writeRound();
+    EXPECT_EQ(shedCnt + 3, ops->getShedCount());
+
+    // The storm is over, the levels come back with nothing more logged
+    sink.setConsumeDelay(std::chrono::milliseconds(0));
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    while (ops->getShedLevel() != LOG_TYPE::LOG_DEFAULT && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(LOG_TYPE::LOG_DEFAULT, ops->getShedLevel());
+    ops->writeRecord(LOG_TYPE::LOG_DBG, "Calm");
+    ops->flushAndWait();
+
+    size_t severeWritten = 0;
+    size_t raisedCnt = 0;
+    size_t overCnt = 0;
+    for (const auto& record : sink.getRecords())
+    {
+        if (record.text == "Storm" && isLogTypeAtLeast(record.logType, LOG_TYPE::LOG_WARN))
+            ++severeWritten;
+        else if (record.text.find("Load shedding, ") != std::string::npos)
+            ++raisedCnt;
+        else if (record.text.find("Load shedding over") != std::string::npos)
+            ++overCnt;
+    }
+    // Nothing but the WARN and the ERR records shed, never those
+    EXPECT_EQ(severeCnt, severeWritten);
+    EXPECT_EQ(5u, raisedCnt);   // Up to WARN and down to INFO
+    EXPECT_EQ(1u, overCnt);
+    EXPECT_EQ("Calm", sink.getRecords().back().text);
+}
+
+TEST_F(BatchSinkOpsTests, testShedNoticeWhileShedding)
+{
+    auto ops = makeOps(16, std::chrono::milliseconds(5));
+    auto& sink = getSink(*ops);
+    ops->setLoadShedding(std::chrono::milliseconds(10));
+    sink.setConsumeDelay(std::chrono::milliseconds(30));
+
+    // A storm of records never shed, which keeps the backlog up
+    auto isNotice = [](const CollectedRecord& record) { return record.text.find("Load shedding, ") != std::string::npos; };
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    std::vector<CollectedRecord> records;
+    while (std::none_of(records.begin(), records.end(), isNotice) && std::chrono::steady_clock::now() < deadline)
+    {
+        for (auto cnt = 0; cnt < 4; ++cnt)
+            ops->writeRecord(LOG_TYPE::LOG_WARN, "Storm");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        records = sink.getRecords();
+    }
+    // Out while the storm is still on, the level still raised
+    auto notice = std::find_if(records.begin(), records.end(), isNotice);
+    ASSERT_NE(records.end(), notice);
+    EXPECT_NE(LOG_TYPE::LOG_DEFAULT, ops->getShedLevel());
+    EXPECT_EQ(LOG_TYPE::LOG_WARN, notice->logType);
+
+    // In a batch of its own, the priority one, ahead of the backlog
+    auto batchSizes = sink.getBatchSizes();
+    auto noticeIdx = static_cast<size_t>(std::distance(records.begin(), notice));
+    size_t batchEnd = 0;
+    auto batchSize = batchSizes.begin();
+    for (; batchSize != batchSizes.end() && batchEnd + *batchSize <= noticeIdx; ++batchSize)
+        batchEnd += *batchSize;
+    ASSERT_NE(batchSizes.end(), batchSize);
+    EXPECT_EQ(1u, *batchSize);
+    sink.setConsumeDelay(std::chrono::milliseconds(0));
+}
+
+TEST_F(BatchSinkOpsTests, testPriorityLane)
+{
+    // Neither a full batch nor the latency would ever have the records drained
+    auto ops = makeOps(1000, std::chrono::hours(1));
+    auto& sink = getSink(*ops);
+    EXPECT_EQ(LOG_TYPE::LOG_ERR, ops->getPriorityLevel());
+    for (auto cnt = 0; cnt < 100; ++cnt)
+        ops->writeRecord(LOG_TYPE::LOG_INFO, "Info " + std::to_string(cnt));
+    ops->writeRecord(LOG_TYPE::LOG_ERR, "Error");
+
+    // The error does not wait for the batch, and goes ahead of it
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (sink.getRecords().size() < 101 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    auto records = sink.getRecords();
+    ASSERT_EQ(101, records.size());
+    EXPECT_EQ("Error", records.front().text);
+    for (size_t idx = 1; idx < records.size(); ++idx)
+        EXPECT_EQ("Info " + std::to_string(idx - 1), records[idx].text);
+    EXPECT_EQ(1u, sink.getBatchSizes().front());
+
+    // A fatal one is handed over before the wait for it returns, however slow the sink
+    sink.setConsumeDelay(std::chrono::milliseconds(20));
+    ops->writeRecord(LOG_TYPE::LOG_INFO, "Before fatal");
+    ops->writeRecord(LOG_TYPE::LOG_FATAL, "Fatal");
+    ops->waitForFatal(LOG_TYPE::LOG_FATAL);
+    records = sink.getRecords();
+    ASSERT_FALSE(records.empty());
+    EXPECT_TRUE(std::any_of(records.begin(), records.end(), [](const auto& record) { return record.text == "Fatal"; }));
+    ops->flushAndWait();
+    EXPECT_EQ("Before fatal", sink.getRecords().back().text);
+
+    // With the errors out of the priority lane, they wait in line
+    sink.setConsumeDelay(std::chrono::milliseconds(0));
+    ops->setPriorityLevel(LOG_TYPE::LOG_FATAL);
+    ops->writeRecord(LOG_TYPE::LOG_INFO, "Info");
+    ops->writeRecord(LOG_TYPE::LOG_ERR, "Error in line");
+    ops->flushAndWait();
+    records = sink.getRecords();
+    ASSERT_GE(records.size(), 2u);
+    EXPECT_EQ("Info", records[records.size() - 2].text);
+    EXPECT_EQ("Error in line", records.back().text);
+}
+
+TEST_F(BatchSinkOpsTests, testDrainedOnDestruction)
+{
+    auto texts = std::make_shared<std::vector<std::string>>();
+    auto flushCnt = std::make_shared<size_t>(0);
+    {
+        /**
+         * @brief A sink outliving neither the ops nor the records it got
+         */
+        class SharedSink : public LogSink
+        {
+            public:
+                SharedSink(std::shared_ptr<std::vector<std::string>> texts, std::shared_ptr<size_t> flushCnt)
+                    : m_texts(std::move(texts)), m_flushCnt(std::move(flushCnt)) {}
+
+                void consume(std::span<const LogRecord> records) override
+                {
+                    for (const auto& record : records)
+                        m_texts->emplace_back(record.text);
+                }
+
+                void flush() override                           { ++*m_flushCnt; }
+
+            private:
+                std::shared_ptr<std::vector<std::string>> m_texts;
+                std::shared_ptr<size_t> m_flushCnt;
+        };
+
+        BatchSinkOps ops(std::make_unique<SharedSink>(texts, flushCnt), 1000, std::chrono::seconds(10));
+        for (auto cnt = 0; cnt < 10; ++cnt)
+            ops.writeRecord(LOG_TYPE::LOG_INFO, std::to_string(cnt));
+        // No flush, the destructor hands the records over
+    }
+    ASSERT_EQ(10, texts->size());
+    EXPECT_EQ("9", texts->back());
+    EXPECT_EQ(1, *flushCnt);
+}
+
+TEST_F(BatchSinkOpsTests, testFanOutAndFailingSink)
+{
+    {
+        MultiSinkOps multiSinkOps;
+        auto& collecting = dynamic_cast<BatchSinkOps&>(multiSinkOps.addSink(makeOps(), LOG_TYPE::LOG_WARN));
+        auto& failing = multiSinkOps.addSink(std::make_unique<BatchSinkOps>(std::make_unique<FailingSink>()));
+        multiSinkOps.writeRecord(LOG_TYPE::LOG_INFO, "Info");
+        multiSinkOps.writeRecord(LOG_TYPE::LOG_WARN, "Warning");
+        multiSinkOps.flushAndWait();
+
+        auto records = getSink(collecting).getRecords();
+        ASSERT_EQ(1, records.size());
+        EXPECT_EQ("Warning", records.front().text);
+        // The failure of one sink stays with it
+        EXPECT_EQ(1, failing.getAllExceptions().size());
+        EXPECT_TRUE(collecting.getAllExceptions().empty());
+        EXPECT_THROW(BatchSinkOps(nullptr), std::invalid_argument);
+    }
+    // Left behind by the failing sink on its destruction
+    std::filesystem::remove("LoggingExceptionsList.txt");
+}
@@ -0,0 +1,296 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="BinaryFileSinkTests.*"
+
+/*
+ * BinaryFileSinkTest.cpp
+ * Unit tests for BinaryFileSink and BinaryLogDecoder functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the binary log format: the records as
+ * the decoder renders them against the text the Logger renders, the call
+ * site dictionary, the sessions of a file written more than once and the
+ * files the decoder has to give up on or stop early in.
+ */
+
+#include "BinaryFileSink.hpp"
+#include "BinaryLogDecoder.hpp"
+#include "BinaryLogFormat.hpp"
+#include "BatchSinkOps.hpp"
+#include "CommonFunc.hpp"
+
+#include <array>
+#include <deque>
+#include <fstream>
+#include <filesystem>
+
+using namespace logger;
+
+class BinaryFileSinkTests : public CommonTestDataGenerator
+{
+    public:
+        void SetUp() override
+        {
+            m_file = generateRandomFileName("tmp_", ".bin");
+        }
+
+        void TearDown() override
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_file, ec);
+        }
+
+        /**
+         * @brief Render a message with a Logger and make the record LogHelper would make of it
+         * The text is kept in m_texts, which the record refers to.
+         */
+        template<typename ...Args>
+        LogRecord makeRecord(const std::string_view funcName,
+                             const std::string_view marker,
+                             const size_t lineNo,
+                             const LOG_TYPE logType,
+                             const std::string_view format,
+                             Args&&... args)
+        {
+            m_logger.setFileName(__FILE__)
+                    .setFunctionName(std::string(funcName))
+                    .setLineNo(lineNo)
+                    .setThreadId(std::this_thread::get_id())
+                    .setMarker(std::string(marker))
+                    .setLogType(logType);
+            m_logger.log(format, args...);
+            const auto& text = m_texts.emplace_back(m_logger.getLogStream().str());
+
+            LogRecord record;
+            record.logType = logType;
+            record.timestamp = m_logger.getTimestamp();
+            record.threadId = std::this_thread::get_id();
+            record.fileName = __FILE__;
+            record.funcName = funcName;
+            record.lineNo = lineNo;
+            record.marker = marker;
+            record.text = text;
+            record.prefixSize = m_logger.getLogMsgPrefixSize();
+            record.msgOffset = m_logger.getLogMsgOffset();
+            return record;
+        }
+
+        /**
+         * @brief Decode m_file into lines
+         */
+        std::vector<std::string> decode() const
+        {
+            std::vector<std::string> lines;
+            BinaryLogDecoder::forEachLine(m_file, [&lines](std::string_view line)
+            {
+                lines.emplace_back(line);
+                return true;
+            });
+            return lines;
+        }
+
+    protected:
+        std::filesystem::path m_file;
+        Logger m_logger{LOG_TIME_FORMAT};
+        std::deque<std::string> m_texts;
+};
+
+TEST_F(BinaryFileSinkTests, testDecodedLinesMatchLoggerText)
+{
+    std::vector<LogRecord> records;
+    records.push_back(makeRecord("void Service::start(int)", FORWARD_ANGLES, 12, LOG_TYPE::LOG_INFO, "Starting {} workers", 8));
+    records.push_back(makeRecord("int main()", FORWARD_ANGLE, 7, LOG_TYPE::LOG_WARN, "Low on {}: {}%", "disk", 3));
+    records.push_back(makeRecord("void Service::stop()", BACKWARD_ANGLES, 40, LOG_TYPE::LOG_DBG, "Stopped"));
+    records.push_back(makeRecord("bool Parser::parse(const std::string&) const", FORWARD_ANGLE, 12345, LOG_TYPE::LOG_ERR, "Bad token at {}", 99));
+    m_logger.setAssertCondition("ptr != nullptr");
+    records.push_back(makeRecord("void Cache::get()", FORWARD_ANGLE, 88, LOG_TYPE::LOG_ASSERT, "Cache miss"));
+    records.push_back(makeRecord("void Service::start(int)", FORWARD_ANGLES, 12, LOG_TYPE::LOG_INFO, "Starting {} workers", 16));
+    {
+        BinaryFileSink sink(m_file);
+        sink.consume(records);
+        EXPECT_EQ(5u, sink.getCallSiteCount());
+    }
+
+    ASSERT_TRUE(BinaryLogDecoder::isBinaryLog(m_file));
+    auto lines = decode();
+    ASSERT_EQ(m_texts.size(), lines.size());
+    for (size_t idx = 0; idx < lines.size(); ++idx)
+        EXPECT_EQ(m_texts[idx], lines[idx]);
+}
+
+TEST_F(BinaryFileSinkTests, testThroughBatchSinkOps)
+{
+    constexpr size_t recordCnt = 1000;
+    size_t textSize = 0;
+    {
+        BatchSinkOps ops(std::make_unique<BinaryFileSink>(m_file), 64);
+        for (size_t cnt = 0; cnt < recordCnt; ++cnt)
+        {
+            auto record = makeRecord("void Worker::run()", FORWARD_ANGLE, 21 + cnt % 2, LOG_TYPE::LOG_INFO, "Processed item {}", cnt);
+            textSize += record.text.size() + 1;
+            ops.writeRecord(record);
+        }
+        ops.write(std::string_view("Written without a call site"));
+        m_texts.emplace_back("Written without a call site");
+        ops.flushAndWait();
+
+        auto& sink = dynamic_cast<BinaryFileSink&>(ops.getSink());
+        EXPECT_EQ(2u, sink.getCallSiteCount());
+        // Only the time stamp delta, the ids and the message are left per record
+        EXPECT_LT(sink.getBytesWritten() * 3, textSize);
+    }
+
+    auto lines = decode();
+    ASSERT_EQ(m_texts.size(), lines.size());
+    for (size_t idx = 0; idx < lines.size(); ++idx)
+        EXPECT_EQ(m_texts[idx], lines[idx]);
+}
+
+TEST_F(BinaryFileSinkTests, testSessionsAppendedToTheSameFile)
+{
+    for (auto session = 0; session < 3; ++session)
+    {
+        BinaryFileSink sink(m_file);
+        std::vector<LogRecord> records;
+        records.push_back(makeRecord("void Session::open()", FORWARD_ANGLES, 5, LOG_TYPE::LOG_IMP, "Session {}", session));
+        records.push_back(makeRecord("void Session::close()", BACKWARD_ANGLES, 9, LOG_TYPE::LOG_FATAL, "Session {} over", session));
+        sink.consume(records);
+        sink.flush();
+        // Every session writes its own dictionary
+        EXPECT_EQ(2u, sink.getCallSiteCount());
+    }
+
+    auto lines = decode();
+    ASSERT_EQ(m_texts.size(), lines.size());
+    for (size_t idx = 0; idx < lines.size(); ++idx)
+        EXPECT_EQ(m_texts[idx], lines[idx]);
+}
+
+TEST_F(BinaryFileSinkTests, testTruncatedAndMalformedFiles)
+{
+    {
+        BinaryFileSink sink(m_file);
+        std::vector<LogRecord> records;
+        for (auto cnt = 0; cnt < 10; ++cnt)
+            records.push_back(makeRecord("void Crash::soon()", FORWARD_ANGLE, 3, LOG_TYPE::LOG_INFO, "Record {}", cnt));
+        sink.consume(records);
+    }
+
+    // Cut in the middle of the last record, as a crash would
+    std::filesystem::resize_file(m_file, std::filesystem::file_size(m_file) - 3);
+    auto lines = decode();
+    ASSERT_EQ(9u, lines.size());
+    EXPECT_EQ(m_texts[8], lines.back());
+
+    // Stopped by the caller
+    auto visitedCnt = BinaryLogDecoder::forEachLine(m_file, [](std::string_view) { return false; });
+    EXPECT_EQ(1u, visitedCnt);
+
+    // An unknown frame tag is not a truncation, nor is a text log a binary one
+    std::string data(BinaryLogFormat::magic.data(), BinaryLogFormat::magic.size());
+    data.push_back(static_cast<char>(0x7F));
+    EXPECT_THROW(BinaryLogDecoder::forEachLineInBuffer(std::string_view(data), [](std::string_view) { return true; }),
+                 std::runtime_error);
+    EXPECT_THROW(BinaryLogDecoder::forEachLineInBuffer(std::string_view("|20250825_155051| text"), [](std::string_view) { return true; }),
+                 std::runtime_error);
+}
+
+TEST_F(BinaryFileSinkTests, testTextLogIsNotAppendedTo)
+{
+    {
+        std::ofstream ofile(m_file);
+        ofile << "|20250825_155051| 140245563983680| FileWriteBench.cpp  |   42|INF>  A text log" << std::endl;
+    }
+    EXPECT_FALSE(BinaryLogDecoder::isBinaryLog(m_file));
+    EXPECT_THROW(BinaryFileSink sink(m_file), std::runtime_error);
+}
+
+TEST_F(BinaryFileSinkTests, testVarints)
+{
+    std::string buffer;
+    const std::vector<uint64_t> values = { 0, 1, 127, 128, 300, 1ULL << 35, UINT64_MAX };
+    const std::vector<int64_t> signedValues = { 0, -1, 1, -64, 64, INT64_MIN, INT64_MAX };
+    for (auto value : values)
+        BinaryLogFormat::putVarint(buffer, value);
+    for (auto value : signedValues)
+        BinaryLogFormat::putSignedVarint(buffer, value);
+    BinaryLogFormat::putString(buffer, "done");
+
+    std::string_view data(buffer);
+    for (auto value : values)
+    {
+        uint64_t decoded = 0;
+        ASSERT_TRUE(BinaryLogFormat::getVarint(data, decoded));
+        EXPECT_EQ(value, decoded);
+    }
+    for (auto value : signedValues)
+    {
+        int64_t decoded = 0;
+        ASSERT_TRUE(BinaryLogFormat::getSignedVarint(data, decoded));
+        EXPECT_EQ(value, decoded);
+    }
+    std::string_view text;
+    ASSERT_TRUE(BinaryLogFormat::getString(data, text));
+    EXPECT_EQ("done", text);
+    EXPECT_TRUE(data.empty());
+
+    // Cut short
+    std::string_view cut(buffer.data(), buffer.size() - 1);
+    uint64_t value = 0;
+    std::string_view rest = cut.substr(cut.size() - 4);
+    EXPECT_FALSE(BinaryLogFormat::getString(rest, text));
+    rest = std::string_view("\x80\x80", 2);
+    EXPECT_FALSE(BinaryLogFormat::getVarint(rest, value));
+}
+
+TEST_F(BinaryFileSinkTests, testRecordFields)
+{
+    const std::array<LogField, 5> fields = { kv("latency_us", -1250),
+                                             kv("bytes", uint64_t(1) << 40),
+                                             kv("ratio", 0.1),
+                                             kv("cached", false),
+                                             kv("path", "/a b") };
+    std::vector<std::string> expected;
+    {
+        BatchSinkOps ops(std::make_unique<BinaryFileSink>(m_file), 8);
+        for (size_t cnt = 0; cnt < 20; ++cnt)
+        {
+            auto record = makeRecord("void Server::handle()", FORWARD_ANGLE, 30, LOG_TYPE::LOG_INFO, "request done");
+            record.fields = std::span<const LogField>(fields).first(cnt % (fields.size() + 1));
+            ops.writeRecord(record);
+            expected.push_back(m_texts.back());
+            LogField::appendText(expected.back(), record.fields);
+        }
+        LogRecord record;
+        record.text = "Without a call site";
+        record.fields = fields;
+        ops.writeRecord(record);
+        expected.push_back(std::string(record.text));
+        LogField::appendText(expected.back(), record.fields);
+    }
+
+    // Rendered as the text logs render them
+    auto lines = decode();
+    EXPECT_EQ(expected, lines);
+    EXPECT_TRUE(lines.front().ends_with("request done"));
+    EXPECT_TRUE(lines.back().ends_with("Without a call site latency_us=-1250 bytes=1099511627776 ratio=0.1 cached=false path=\"/a b\""));
+}
@@ -0,0 +1,277 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="CoalescingOpsTests.*"
+
+/*
+ * CoalescingOpsTest.cpp
+ * Unit tests for CoalescingOps class using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the collapsing of the repeated records:
+ * the runs collapsed and what tells the records apart, the window, the
+ * repeat counts written out on a flush or once the window is over, the
+ * critical records never collapsed, and the threads writing at once.
+ */
+
+#include "CoalescingOps.hpp"
+#include "BatchSinkOps.hpp"
+#include "Logger.hpp"
+#include "CommonFunc.hpp"
+
+#include <thread>
+
+using namespace logger;
+
+class CoalescingOpsTests : public CommonTestDataGenerator
+{
+    public:
+        /**
+         * @brief Make a CoalescingOps in front of a BatchSinkOps with a TextSink
+         */
+        static std::unique_ptr<CoalescingOps> makeOps(const std::chrono::milliseconds window)
+        {
+            return std::make_unique<CoalescingOps>(std::make_unique<BatchSinkOps>(std::make_unique<TextSink>()), window);
+        }
+
+        /**
+         * @brief Get the texts the sink behind a CoalescingOps made by makeOps() got so far
+         */
+        static std::vector<std::string> getTexts(CoalescingOps& ops)
+        {
+            ops.flushAndWait();
+            auto& sinkOps = dynamic_cast<BatchSinkOps&>(ops.getSink());
+            return dynamic_cast<TextSink&>(sinkOps.getSink()).getTexts();
+        }
+
+        /**
+         * @brief Write a record, rendered the way the Logger does
+         *
+         * @param [in] ops The ops to write to
+         * @param [in] msg The message
+         * @param [in] lineNo The line of the call site
+         * @param [in] fields The fields of the record
+         * @param [in] logType The log type of the record
+         */
+        static void writeMsg(LoggingOps& ops,
+                             const std::string_view msg,
+                             const size_t lineNo = 42,
+                             const std::span<const LogField> fields = {},
+                             const LOG_TYPE logType = LOG_TYPE::LOG_WARN)
+        {
+            // A time stamp and a thread of its own for every record
+            static std::atomic<size_t> seqNo(0);
+            auto prefix = "|20250825_1550" + std::to_string(10 + seqNo++ % 90) + "| 1402455| Net.cpp  |   42|" +
+                          Logger::covertLogTypeEnumToString(logType) + ">  ";
+            std::string context = "[Client : connect] ";
+            auto text = prefix + context + std::string(msg);
+            LogRecord record;
+            record.logType = logType;
+            record.timestamp = std::chrono::system_clock::now();
+            record.threadId = std::this_thread::get_id();
+            record.fileName = "Net.cpp";
+            record.funcName = "void Client::connect()";
+            record.lineNo = lineNo;
+            record.marker = ">";
+            record.text = text;
+            record.prefixSize = prefix.size();
+            record.msgOffset = prefix.size() + context.size();
+            record.fields = fields;
+            ops.writeRecord(record);
+        }
+};
+
+TEST_F(CoalescingOpsTests, testRunCollapsed)
+{
+    auto ops = makeOps(std::chrono::milliseconds(60000));
+    for (int cnt = 0; cnt < 5; ++cnt)
+        writeMsg(*ops, "Connection refused");
+    writeMsg(*ops, "Connected");
+    writeMsg(*ops, "Connection refused");
+
+    auto texts = getTexts(*ops);
+    ASSERT_EQ(4u, texts.size());
+    EXPECT_TRUE(texts[0].ends_with("|WARN>  [Client : connect] Connection refused")) << texts[0];
+    EXPECT_TRUE(texts[1].ends_with("|WARN>  [Client : connect] last message repeated 4 times")) << texts[1];
+    EXPECT_TRUE(texts[2].ends_with("Connected")) << texts[2];
+    // Not a repeat of the one right before it
+    EXPECT_TRUE(texts[3].ends_with("Connection refused")) << texts[3];
+    EXPECT_EQ(4u, ops->getCollapsedCount());
+}
+
+TEST_F(CoalescingOpsTests, testRepeatRecordKeepsLastPrefix)
+{
+    auto ops = makeOps(std::chrono::milliseconds(60000));
+    writeMsg(*ops, "Timeout");
+    writeMsg(*ops, "Timeout");
+    writeMsg(*ops, "Timeout");
+    ops->flush();
+
+    auto texts = getTexts(*ops);
+    ASSERT_EQ(2u, texts.size());
+    // The time stamp of the last repeat, not of the first occurrence
+    EXPECT_NE(texts[0].substr(0, 16), texts[1].substr(0, 16));
+    EXPECT_EQ(texts[1].find('|'), 0u);
+    EXPECT_TRUE(texts[1].ends_with("last message repeated 2 times")) << texts[1];
+}
+
+TEST_F(CoalescingOpsTests, testCallSiteAndFieldsTellApart)
+{
+    auto ops = makeOps(std::chrono::milliseconds(60000));
+    const std::array<LogField, 1> port80 = { kv("port", 80) };
+    const std::array<LogField, 1> port443 = { kv("port", 443) };
+    writeMsg(*ops, "Refused", 42, port80);
+    writeMsg(*ops, "Refused", 42, port443);
+    writeMsg(*ops, "Refused", 43, port443);
+    writeMsg(*ops, "Refused", 43, port443);
+
+    auto texts = getTexts(*ops);
+    ASSERT_EQ(4u, texts.size());
+    EXPECT_TRUE(texts[0].ends_with("Refused port=80")) << texts[0];
+    EXPECT_TRUE(texts[1].ends_with("Refused port=443")) << texts[1];
+    EXPECT_TRUE(texts[2].ends_with("Refused port=443")) << texts[2];
+    EXPECT_TRUE(texts[3].ends_with("last message repeated 1 times")) << texts[3];
+}
+
+TEST_F(CoalescingOpsTests, testWindow)
+{
+    auto ops = makeOps(std::chrono::milliseconds(100));
+    writeMsg(*ops, "Disk full");
+    writeMsg(*ops, "Disk full");
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    // Out of the window, the run starts over
+    writeMsg(*ops, "Disk full");
+    writeMsg(*ops, "Disk full");
+    writeMsg(*ops, "Disk full");
+
+    auto texts = getTexts(*ops);
+    ASSERT_EQ(4u, texts.size());
+    EXPECT_TRUE(texts[0].ends_with("Disk full"));
+    EXPECT_TRUE(texts[1].ends_with("last message repeated 1 times")) << texts[1];
+    EXPECT_TRUE(texts[2].ends_with("Disk full"));
+    EXPECT_TRUE(texts[3].ends_with("last message repeated 2 times")) << texts[3];
+
+    // No window, nothing collapsed
+    ops->setWindow(std::chrono::milliseconds(0));
+    writeMsg(*ops, "Disk full");
+    writeMsg(*ops, "Disk full");
+    EXPECT_EQ(6u, getTexts(*ops).size());
+    EXPECT_EQ(3u, ops->getCollapsedCount());
+}
+
+TEST_F(CoalescingOpsTests, testRepeatCountWrittenOnceWindowIsOver)
+{
+    auto ops = makeOps(std::chrono::milliseconds(50));
+    for (int cnt = 0; cnt < 3; ++cnt)
+        writeMsg(*ops, "Broken pipe");
+    // Nothing more comes, nor a flush of the CoalescingOps itself
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    auto& sinkOps = dynamic_cast<BatchSinkOps&>(ops->getSink());
+    sinkOps.flushAndWait();
+
+    auto texts = dynamic_cast<TextSink&>(sinkOps.getSink()).getTexts();
+    ASSERT_EQ(2u, texts.size());
+    EXPECT_TRUE(texts[0].ends_with("Broken pipe")) << texts[0];
+    EXPECT_TRUE(texts[1].ends_with("last message repeated 2 times")) << texts[1];
+}
+
+TEST_F(CoalescingOpsTests, testDifferingRecordsGoStraightToSink)
+{
+    auto ops = makeOps(std::chrono::milliseconds(60000));
+    writeMsg(*ops, "Host unreachable");
+    writeMsg(*ops, "Host unreachable");
+    writeMsg(*ops, "Route added");
+    // No turn of the CoalescingOps itself to wait for
+    auto& sinkOps = dynamic_cast<BatchSinkOps&>(ops->getSink());
+    sinkOps.flushAndWait();
+
+    auto texts = dynamic_cast<TextSink&>(sinkOps.getSink()).getTexts();
+    ASSERT_EQ(3u, texts.size());
+    EXPECT_TRUE(texts[0].ends_with("Host unreachable")) << texts[0];
+    EXPECT_TRUE(texts[1].ends_with("last message repeated 1 times")) << texts[1];
+    EXPECT_TRUE(texts[2].ends_with("Route added")) << texts[2];
+}
+
+TEST_F(CoalescingOpsTests, testCriticalRecordsNotCollapsed)
+{
+    auto ops = makeOps(std::chrono::milliseconds(60000));
+    for (auto logType : { LOG_TYPE::LOG_ERR, LOG_TYPE::LOG_ASSERT })
+    {
+        for (int cnt = 0; cnt < 3; ++cnt)
+            writeMsg(*ops, "Out of memory", 42, {}, logType);
+    }
+    // Each of them reaches the sink, the FATAL one before the wait for it returns
+    writeMsg(*ops, "Out of memory", 42, {}, LOG_TYPE::LOG_FATAL);
+    ops->waitForFatal(LOG_TYPE::LOG_FATAL);
+    auto& sinkOps = dynamic_cast<BatchSinkOps&>(ops->getSink());
+    EXPECT_EQ(7u, dynamic_cast<TextSink&>(sinkOps.getSink()).getTexts().size());
+    writeMsg(*ops, "Out of memory", 42, {}, LOG_TYPE::LOG_FATAL);
+
+    auto texts = getTexts(*ops);
+    ASSERT_EQ(8u, texts.size());
+    for (const auto& text : texts)
+        EXPECT_TRUE(text.ends_with("Out of memory")) << text;
+    EXPECT_EQ(0u, ops->getCollapsedCount());
+}
+
+TEST_F(CoalescingOpsTests, testCommitCriticalLeavesRunPending)
+{
+    auto ops = makeOps(std::chrono::milliseconds(60000));
+    for (int cnt = 0; cnt < 3; ++cnt)
+    {
+        writeMsg(*ops, "Socket error");
+        ops->commitCritical();
+    }
+    auto& sinkOps = dynamic_cast<BatchSinkOps&>(ops->getSink());
+    sinkOps.flushAndWait();
+    EXPECT_EQ(1u, dynamic_cast<TextSink&>(sinkOps.getSink()).getTexts().size());
+
+    auto texts = getTexts(*ops);
+    ASSERT_EQ(2u, texts.size());
+    EXPECT_TRUE(texts[1].ends_with("last message repeated 2 times")) << texts[1];
+}
+
+TEST_F(CoalescingOpsTests, testConcurrentWriters)
+{
+    constexpr size_t threadCnt = 4;
+    constexpr size_t msgCnt = 2000;
+    auto ops = makeOps(std::chrono::milliseconds(60000));
+    std::vector<std::thread> threads;
+    for (size_t thrd = 0; thrd < threadCnt; ++thrd)
+    {
+        threads.emplace_back([&ops]()
+        {
+            for (size_t idx = 0; idx < msgCnt; ++idx)
+                writeMsg(*ops, "Connection reset");
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    auto texts = getTexts(*ops);
+    ASSERT_EQ(2u, texts.size());
+    EXPECT_TRUE(texts[1].ends_with("last message repeated " + std::to_string(threadCnt * msgCnt - 1) + " times")) << texts[1];
+}
+
+TEST_F(CoalescingOpsTests, testNullSinkRefused)
+{
+    EXPECT_THROW(CoalescingOps(nullptr, std::chrono::milliseconds(1)), std::invalid_argument);
+}
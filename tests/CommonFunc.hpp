@@ -30,15 +30,21 @@
  *   such as random strings, binary data of various sizes, and random file names.
  *   It is intended for use in unit tests, especially with Google Test, to facilitate
  *   the creation of diverse and robust test cases. The file also includes a class for
- *   generating random hexadecimal values of different widths.
+ *   generating random hexadecimal values of different widths, and a sink keeping
+ *   the texts of the records it gets.
  */
 
 #ifndef COMMON_FUNC_HPP
 #define COMMON_FUNC_HPP
 
+#include "LogSink.hpp"
+#include "LogField.hpp"
+#include "LineScanner.hpp"
+
 #include <string>
 #include <vector>
 #include <random>
+#include <mutex>
 
 #include <gtest/gtest.h>
 
@@ -195,6 +201,23 @@ class CommonTestDataGenerator : public ::testing::Test
             std::string randomPart = generateRandomText(8);  // 8-char random string
             return prefix + randomPart + extension;
         }
+        /**
+         * @brief Get the instruction sets supported by this CPU
+         * * The scanners and the escapers are checked with each of them.
+         *
+         * @return std::vector<LineScanner::Isa> The supported ones
+         */
+        static std::vector<logger::LineScanner::Isa> getSupportedIsas()
+        {
+            using logger::LineScanner;
+            std::vector<LineScanner::Isa> isas;
+            for (auto isa : { LineScanner::Isa::SCALAR, LineScanner::Isa::SSE2, LineScanner::Isa::AVX2 })
+            {
+                if (LineScanner::isSupported(isa))
+                    isas.push_back(isa);
+            }
+            return isas;
+        }
 };
 
 class RandomHexGenerator
@@ -244,4 +267,33 @@ class RandomHexGenerator
         }
 };
 
-#endif // COMMON_FUNC_HPP
\ No newline at end of file
+/**
+ * @brief A sink keeping the texts it gets, with their fields rendered
+ * To be put behind a BatchSinkOps, to check what got through to a sink.
+ */
+class TextSink : public logger::LogSink
+{
+    public:
+        void consume(std::span<const logger::LogRecord> records) override
+        {
+            std::scoped_lock<std::mutex> lock(m_mtx);
+            for (const auto& record : records)
+            {
+                std::string text(record.text);
+                logger::LogField::appendText(text, record.fields);
+                m_texts.push_back(std::move(text));
+            }
+        }
+
+        std::vector<std::string> getTexts()
+        {
+            std::scoped_lock<std::mutex> lock(m_mtx);
+            return m_texts;
+        }
+
+    private:
+        std::mutex m_mtx;
+        std::vector<std::string> m_texts;
+};
+
+#endif // COMMON_FUNC_HPP
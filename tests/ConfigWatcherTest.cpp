@@ -0,0 +1,237 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="ConfigWatcherTests.*"
+
+/*
+ * ConfigWatcherTest.cpp
+ * Unit tests for ConfigWatcher functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the ConfigWatcher class: the reloads on
+ * a change of the config file and on a SIGHUP, the settings applied to the
+ * sinks and to the named loggers, and the records written meanwhile.
+ */
+
+#include "ConfigWatcher.hpp"
+#include "LoggerRegistry.hpp"
+#include "ConsoleOps.hpp"
+#include "FileOps.hpp"
+#include "MultiSinkOps.hpp"
+#include "BatchSinkOps.hpp"
+#include "CommonFunc.hpp"
+
+#include <csignal>
+#include <fstream>
+#include <filesystem>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief A sink counting the records it gets
+     */
+    class CountingSink : public LogSink
+    {
+        public:
+            void consume(std::span<const LogRecord> records) override   { m_recordCnt += records.size(); }
+
+            size_t getRecordCount() const                               { return m_recordCnt; }
+
+        private:
+            std::atomic<size_t> m_recordCnt{0};
+    };
+};
+
+class ConfigWatcherTests : public CommonTestDataGenerator
+{
+    public:
+        void SetUp() override
+        {
+            m_configFile = std::filesystem::absolute(generateRandomFileName("tmp_", ".conf"));
+        }
+
+        void TearDown() override
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_configFile, ec);
+        }
+
+        /**
+         * @brief Write the config file, as an editor would, to a new file renamed over the old one
+         *
+         * @param [in] content The content of the file
+         */
+        void writeConfigFile(const std::string_view content)
+        {
+            auto tmpFile = m_configFile;
+            tmpFile += ".new";
+            {
+                std::ofstream file(tmpFile, std::ios::trunc);
+                file << content;
+            }
+            std::filesystem::rename(tmpFile, m_configFile);
+        }
+
+        /**
+         * @brief Wait for the watcher to reload, 5 seconds at most
+         *
+         * @param [in] watcher The watcher
+         * @param [in] reloadCnt The number of reloads to wait for
+         * @return true If it reloaded that many times, otherwise
+         * @return false
+         */
+        static bool waitForReloads(const ConfigWatcher& watcher, const size_t reloadCnt)
+        {
+            for (int cnt = 0; cnt < 500 && watcher.getReloadCount() < reloadCnt; ++cnt)
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            return watcher.getReloadCount() >= reloadCnt;
+        }
+
+    protected:
+        std::filesystem::path m_configFile;
+};
+
+TEST_F(ConfigWatcherTests, testReloadOnChange)
+{
+    writeConfigFile("CONSOLE_LOG_LEVEL=INF\n");
+    ConsoleOps consoleOps;
+    LoggerRegistry registry(consoleOps);
+    ConfigWatcher watcher(consoleOps, m_configFile, true, false, &registry);
+    ASSERT_TRUE(watcher.start());
+    EXPECT_FALSE(watcher.start());
+
+    writeConfigFile("CONSOLE_LOG_LEVEL=ERR\n"
+                    "BATCH_SIZE=8\n"
+                    "BATCH_LATENCY_MS=5\n"
+                    "LEVEL.net=OFF\n"
+                    "LEVEL.db=WARN\n");
+    ASSERT_TRUE(waitForReloads(watcher, 1));
+    EXPECT_EQ(consoleOps.getLevelThreshold(), LOG_TYPE::LOG_ERR);
+    EXPECT_EQ(consoleOps.getMaxBatchSize(), 8u);
+    EXPECT_EQ(consoleOps.getMaxLatency(), std::chrono::milliseconds(5));
+    EXPECT_FALSE(registry.get("net.http").isEnabled(LOG_TYPE::LOG_FATAL));
+    EXPECT_FALSE(registry.get("db").isEnabled(LOG_TYPE::LOG_INFO));
+    EXPECT_TRUE(registry.get("db").isEnabled(LOG_TYPE::LOG_WARN));
+
+    // Left out of the config, back to inheriting
+    auto reloadCnt = watcher.getReloadCount();
+    writeConfigFile("LEVEL.db=ERR\n");
+    ASSERT_TRUE(waitForReloads(watcher, reloadCnt + 1));
+    EXPECT_TRUE(registry.get("net.http").isEnabled(LOG_TYPE::LOG_DBG));
+    EXPECT_FALSE(registry.get("db").isEnabled(LOG_TYPE::LOG_WARN));
+    EXPECT_EQ(consoleOps.getLevelThreshold(), LOG_TYPE::LOG_DEFAULT);
+    EXPECT_EQ(consoleOps.getMaxBatchSize(), 256u);
+
+    watcher.stop();
+}
+
+TEST_F(ConfigWatcherTests, testReloadOnSighup)
+{
+    writeConfigFile("CONSOLE_LOG_LEVEL=IMP\n");
+    ConsoleOps consoleOps;
+    LoggerRegistry registry(consoleOps);
+    ConfigWatcher watcher(consoleOps, m_configFile, false, true, &registry);
+    ASSERT_TRUE(watcher.start());
+
+    // A single one handles SIGHUP
+    ConfigWatcher otherWatcher(consoleOps, m_configFile, false, true, &registry);
+    EXPECT_FALSE(otherWatcher.start());
+
+    std::raise(SIGHUP);
+    ASSERT_TRUE(waitForReloads(watcher, 1));
+    EXPECT_EQ(consoleOps.getLevelThreshold(), LOG_TYPE::LOG_IMP);
+
+    writeConfigFile("CONSOLE_LOG_LEVEL=WARN\n");
+    std::raise(SIGHUP);
+    ASSERT_TRUE(waitForReloads(watcher, 2));
+    EXPECT_EQ(consoleOps.getLevelThreshold(), LOG_TYPE::LOG_WARN);
+
+    watcher.stop();
+    EXPECT_TRUE(otherWatcher.start());
+}
+
+TEST_F(ConfigWatcherTests, testReloadAppliesToSinks)
+{
+    auto logFile = generateRandomFileName("tmp_", "");
+    MultiSinkOps multiSinkOps;
+    auto& fileOps = static_cast<FileOps&>(multiSinkOps.addSink(std::make_unique<FileOps>(1024 * 1024, logFile, "", ".log")));
+    auto& consoleOps = multiSinkOps.addSink(std::make_unique<ConsoleOps>());
+    LoggerRegistry registry(multiSinkOps);
+
+    writeConfigFile("FILE_SIZE=64KB\nFILE_LOG_LEVEL=INF\nCONSOLE_LOG_LEVEL=FATAL\n"
+                    "LOG_FILE_NAME=Elsewhere\n");   // Where the records go stays as it is
+    ConfigWatcher watcher(multiSinkOps, m_configFile, false, false, &registry);
+    watcher.reload();
+    EXPECT_EQ(watcher.getReloadCount(), 1u);
+    EXPECT_EQ(fileOps.getMaxFileSize(), 64u * 1024);
+    EXPECT_EQ(fileOps.getLevelThreshold(), LOG_TYPE::LOG_INFO);
+    EXPECT_EQ(fileOps.getFileName(), logFile + ".log");
+    EXPECT_EQ(consoleOps.getLevelThreshold(), LOG_TYPE::LOG_FATAL);
+
+    // Along with a file the console gets the warnings and worse by default
+    writeConfigFile("FILE_SIZE=128KB\n");
+    watcher.reload();
+    EXPECT_EQ(fileOps.getMaxFileSize(), 128u * 1024);
+    EXPECT_EQ(consoleOps.getLevelThreshold(), LOG_TYPE::LOG_WARN);
+
+    std::error_code ec;
+    std::filesystem::remove(logFile + ".log", ec);
+}
+
+TEST_F(ConfigWatcherTests, testNoRecordLostOnReload)
+{
+    auto sink = std::make_unique<CountingSink>();
+    auto& countingSink = *sink;
+    BatchSinkOps batchSinkOps(std::move(sink));
+    LoggerRegistry registry(batchSinkOps);
+    ConfigWatcher watcher(batchSinkOps, m_configFile, false, false, &registry);
+
+    constexpr size_t threadCnt = 4;
+    constexpr size_t recordCnt = 5000;
+    std::atomic_bool producing = true;
+    std::vector<std::thread> producers;
+    for (size_t thr = 0; thr < threadCnt; ++thr)
+    {
+        producers.emplace_back([&batchSinkOps]()
+        {
+            for (size_t cnt = 0; cnt < recordCnt; ++cnt)
+                batchSinkOps.writeRecord(LOG_TYPE::LOG_INFO, "A record written during the reloads");
+        });
+    }
+    std::thread reloader([this, &watcher, &producing]()
+    {
+        for (size_t cnt = 0; producing; ++cnt)
+        {
+            writeConfigFile((cnt % 2) ? "BATCH_SIZE=1\nBATCH_LATENCY_MS=1\n" : "BATCH_SIZE=1000\nBATCH_LATENCY_MS=50\n");
+            watcher.reload();
+        }
+    });
+    for (auto& producer : producers)
+        producer.join();
+    producing = false;
+    reloader.join();
+
+    batchSinkOps.flushAndWait();
+    EXPECT_EQ(countingSink.getRecordCount(), threadCnt * recordCnt);
+    EXPECT_GT(watcher.getReloadCount(), 0u);
+}
@@ -39,6 +39,8 @@
 #include "CommonFunc.hpp"
 
 #include <bitset>
+#include <chrono>
+#include <thread>
 
 using namespace logger;
 
@@ -51,7 +53,9 @@ using namespace logger;
 class ConsoleOpsTestClass : public ConsoleOps
 {
     public:
-        ConsoleOpsTestClass() : ConsoleOps() {}
+        explicit ConsoleOpsTestClass(const bool criticalToStderr = false,
+                                     const std::chrono::milliseconds maxLatency = defaultMaxLatency)
+            : ConsoleOps(criticalToStderr, maxLatency) {}
         ~ConsoleOpsTestClass() = default;
 
         ConsoleOpsTestClass(const ConsoleOpsTestClass& rhs) = delete;
@@ -77,6 +81,15 @@ class ConsoleOpsTestClass : public ConsoleOps
          * * which can be accessed using this function.
          */
         inline const std::ostringstream& getTestStringStreamFromConsole() const { return m_testStringStream; }
+        /**
+         * @brief Get the test string stream standing in for stderr
+         * * When the testing mode is ON, what would have gone to stderr is written to it
+         */
+        inline const std::ostringstream& getTestErrStringStreamFromConsole() const { return m_testErrStringStream; }
+        /**
+         * @brief Get a copy of what got written so far, while a batch may be being written
+         */
+        inline std::string getTestConsoleContents() { std::scoped_lock<std::mutex> lock(m_consoleMtx); return m_testStringStream.str(); }
         /**
          * @brief Get the Class Id for the ConsoleOpsTestClass object
          * * This function is used to get the class id of the ConsoleOpsTestClass object.
@@ -173,6 +186,7 @@ class ConsoleOpsTest : public CommonTestDataGenerator
             ConsoleOpsTestClass testObj;
             testObj.setTestingModeOn();
             testObj.write(hexData);
+            testObj.flushAndWait();
 
             const auto& consoleContents = testObj.getTestStringStreamFromConsole();
             testObj.setTestingModeOff();
@@ -252,6 +266,7 @@ class ConsoleOpsTest : public CommonTestDataGenerator
                 for (const auto& data : bindata)
                     testObj.write(data);
             }
+            testObj.flushAndWait();
 
             const auto& consoleContents = testObj.getTestStringStreamFromConsole();
             testBinaryDataValidity<DataType, DataType>(consoleContents, bindata, bits);
@@ -266,6 +281,7 @@ TEST_F(ConsoleOpsTest, testWriteToConsole)
     ConsoleOpsTestClass testObj;
     testObj.setTestingModeOn();
     testObj.write(text);
+    testObj.flushAndWait();
     auto& result = testObj.getTestStringStreamFromConsole();
     text += "\n";   // A new line character as the outstream object will have one as well
     EXPECT_EQ(text, result.str());
@@ -284,6 +300,7 @@ TEST_F(ConsoleOpsTest, testWriteToConsoleInLoop)
         testObj.write(text);
         textQueue.emplace_back(text);
     }
+    testObj.flushAndWait();
     auto textItr = textQueue.begin();
     auto& consoleTexts = testObj.getTestStringStreamFromConsole();
     std::istringstream iss(consoleTexts.str());
@@ -295,6 +312,7 @@ TEST_F(ConsoleOpsTest, testWriteToConsoleInLoop)
         line.clear();
         ++textItr;
     }
+    EXPECT_EQ(textItr, textQueue.end());
     testObj.setTestingModeOff();
 }
 
@@ -374,3 +392,156 @@ TEST_F(ConsoleOpsTest, testWriteConsoleWith_8_Bytes_Hex_DataStream)
     testHexDataStream<uint64_t>(64);
 }
 
+TEST_F(ConsoleOpsTest, testBatchIsWrittenAfterMaxLatency)
+{
+    ConsoleOpsTestClass testObj(false, std::chrono::milliseconds(20));
+    testObj.setTestingModeOn();
+    std::string expected;
+    for (auto cnt = 0; cnt < 10; ++cnt)
+    {
+        auto text = generateRandomText(64);
+        testObj.write(text);
+        expected += text + "\n";
+    }
+    // Far from a full batch, it still goes out once the latency is up
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (testObj.getTestConsoleContents().size() < expected.size() &&
+           std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(expected, testObj.getTestConsoleContents());
+    testObj.setTestingModeOff();
+}
+
+TEST_F(ConsoleOpsTest, testCriticalRecordIsWrittenRightAway)
+{
+    // A latency long enough for the test to be over before it is up
+    ConsoleOpsTestClass testObj(false, std::chrono::hours(1));
+    testObj.setTestingModeOn();
+    auto info = generateRandomText(64);
+    auto error = generateRandomText(64);
+    testObj.writeRecord(LOG_TYPE::LOG_INFO, info);
+    testObj.writeRecord(LOG_TYPE::LOG_ERR, error);
+    // Not waiting for the batch, it goes out ahead of the record queued before it
+    auto expected = error + "\n" + info + "\n";
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (testObj.getTestConsoleContents().size() < expected.size() &&
+           std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(expected, testObj.getTestConsoleContents());
+    EXPECT_TRUE(testObj.getTestErrStringStreamFromConsole().str().empty());
+
+    // A fatal one is written before the wait for it returns
+    auto fatal = generateRandomText(64);
+    testObj.writeRecord(LOG_TYPE::LOG_FATAL, fatal);
+    testObj.waitForFatal(LOG_TYPE::LOG_FATAL);
+    EXPECT_EQ(expected + fatal + "\n", testObj.getTestConsoleContents());
+    testObj.setTestingModeOff();
+}
+
+TEST_F(ConsoleOpsTest, testPriorityOfNestedWrites)
+{
+    /**
+     * @brief Writes a record of its own to another console, as a sink
+     * wrapping another one would, before queueing the data it got
+     */
+    class ForwardingConsoleOps : public ConsoleOpsTestClass
+    {
+        public:
+            explicit ForwardingConsoleOps(ConsoleOps& other)
+                : ConsoleOpsTestClass(true, std::chrono::hours(1)), m_other(other) {}
+            ~ForwardingConsoleOps() { stopWatcher(); }
+
+        protected:
+            void writeDataTo(const std::string_view data) override
+            {
+                m_other.writeRecord(LOG_TYPE::LOG_INFO, data);
+                ConsoleOpsTestClass::writeDataTo(data);
+            }
+
+        private:
+            ConsoleOps& m_other;
+    };
+
+    ConsoleOpsTestClass other(true, std::chrono::hours(1));
+    other.setTestingModeOn();
+    ForwardingConsoleOps testObj(other);
+    testObj.setTestingModeOn();
+    auto error = generateRandomText(64);
+    testObj.writeRecord(LOG_TYPE::LOG_ERR, error);
+    testObj.flushAndWait();
+    other.flushAndWait();
+    // The inner write neither takes the lane of the outer one nor clears it
+    EXPECT_EQ(error + "\n", testObj.getTestErrStringStreamFromConsole().str());
+    EXPECT_TRUE(testObj.getTestStringStreamFromConsole().str().empty());
+    EXPECT_EQ(error + "\n", other.getTestStringStreamFromConsole().str());
+    EXPECT_TRUE(other.getTestErrStringStreamFromConsole().str().empty());
+    testObj.setTestingModeOff();
+    other.setTestingModeOff();
+}
+
+TEST_F(ConsoleOpsTest, testCriticalRecordsGoToStderr)
+{
+    ConsoleOpsTestClass testObj(true);
+    EXPECT_TRUE(testObj.isCriticalToStderr());
+    testObj.setTestingModeOn();
+    std::string expectedOut;
+    std::string expectedErr;
+    for (auto logType : { LOG_TYPE::LOG_DBG, LOG_TYPE::LOG_INFO, LOG_TYPE::LOG_WARN,
+                          LOG_TYPE::LOG_ERR, LOG_TYPE::LOG_FATAL, LOG_TYPE::LOG_ASSERT })
+    {
+        auto text = generateRandomText(32);
+        testObj.writeRecord(logType, text);
+        auto critical = isLogTypeAtLeast(logType, LOG_TYPE::LOG_ERR);
+        (critical ? expectedErr : expectedOut) += text + "\n";
+    }
+    testObj.flushAndWait();
+    EXPECT_EQ(expectedOut, testObj.getTestStringStreamFromConsole().str());
+    EXPECT_EQ(expectedErr, testObj.getTestErrStringStreamFromConsole().str());
+
+    testObj.setCriticalToStderr(false);
+    EXPECT_FALSE(testObj.isCriticalToStderr());
+    testObj.writeRecord(LOG_TYPE::LOG_ERR, "to stdout");
+    testObj.flushAndWait();
+    EXPECT_EQ(expectedOut + "to stdout\n", testObj.getTestStringStreamFromConsole().str());
+    testObj.setTestingModeOff();
+}
+
+TEST_F(ConsoleOpsTest, testLoweredPriorityLevelKeepsWarnOnStdout)
+{
+    ConsoleOpsTestClass testObj(true, std::chrono::hours(1));
+    testObj.setTestingModeOn();
+    testObj.setPriorityLevel(LOG_TYPE::LOG_WARN);
+    EXPECT_TRUE(testObj.isPriority(LOG_TYPE::LOG_WARN));
+    auto info = generateRandomText(64);
+    auto warn = generateRandomText(64);
+    auto error = generateRandomText(64);
+    testObj.writeRecord(LOG_TYPE::LOG_INFO, info);
+    testObj.writeRecord(LOG_TYPE::LOG_WARN, warn);
+    testObj.writeRecord(LOG_TYPE::LOG_ERR, error);
+    testObj.flushAndWait();
+    // The WARN record takes the priority lane, ahead of the INFO one, yet to stdout,
+    // only the ERR one goes to stderr
+    EXPECT_EQ(warn + "\n" + info + "\n", testObj.getTestStringStreamFromConsole().str());
+    EXPECT_EQ(error + "\n", testObj.getTestErrStringStreamFromConsole().str());
+    testObj.setTestingModeOff();
+}
+
+TEST_F(ConsoleOpsTest, testRecordFieldsAreRenderedAsText)
+{
+    ConsoleOpsTestClass testObj(false, std::chrono::hours(1));
+    testObj.setTestingModeOn();
+    const std::array<LogField, 2> fields = { kv("latency_us", 1250), kv("path", "/a b") };
+    LogRecord record;
+    record.logType = LOG_TYPE::LOG_INFO;
+    record.text = "request done";
+    record.fields = fields;
+    testObj.writeRecord(record);
+    // A critical one goes out ahead of it, its fields along
+    record.logType = LOG_TYPE::LOG_ERR;
+    record.text = "request failed";
+    testObj.writeRecord(record);
+    testObj.flushAndWait();
+    EXPECT_EQ("request failed latency_us=1250 path=\"/a b\"\nrequest done latency_us=1250 path=\"/a b\"\n",
+              testObj.getTestStringStreamFromConsole().str());
+    testObj.setTestingModeOff();
+}
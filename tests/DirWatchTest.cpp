@@ -0,0 +1,142 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="DirWatchTests.*"
+
+/*
+ * DirWatchTest.cpp
+ * Unit tests for DirWatch functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the DirWatch class: the wakeups, the
+ * changes of the file watched picked out of those of its directory, and
+ * the poll period.
+ */
+
+#include "DirWatch.hpp"
+#include "CommonFunc.hpp"
+
+#include <fstream>
+#include <filesystem>
+
+using namespace logger;
+
+class DirWatchTests : public CommonTestDataGenerator
+{
+    public:
+        void SetUp() override
+        {
+            m_file = std::filesystem::absolute(generateRandomFileName("tmp_", ".conf"));
+            m_otherFile = std::filesystem::absolute(generateRandomFileName("tmp_", ".conf"));
+        }
+
+        void TearDown() override
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_file, ec);
+            std::filesystem::remove(m_otherFile, ec);
+        }
+
+        /**
+         * @brief Write a file out and close it
+         */
+        static void writeFile(const std::filesystem::path& file, const std::string& text)
+        {
+            std::ofstream ofile(file, std::ios::trunc);
+            ofile << text << '\n';
+        }
+
+        /**
+         * @brief Wait till the file watched changes, or a few seconds at most
+         */
+        static bool waitForFileChange(DirWatch& dirWatch)
+        {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (std::chrono::steady_clock::now() < deadline)
+            {
+                if (dirWatch.wait(std::chrono::milliseconds(100)).fileChanged)
+                    return true;
+            }
+            return false;
+        }
+
+    protected:
+        std::filesystem::path m_file;
+        std::filesystem::path m_otherFile;
+};
+
+TEST_F(DirWatchTests, testWakeups)
+{
+    DirWatch dirWatch;
+    ASSERT_TRUE(dirWatch.open());
+    EXPECT_FALSE(dirWatch.isWatching());
+    EXPECT_GE(dirWatch.getWakeupFd(), 0);
+
+    // Handed over in order, without a timeout
+    dirWatch.wakeup('H');
+    dirWatch.wakeup();
+    auto result = dirWatch.wait(std::chrono::milliseconds(-1));
+    EXPECT_FALSE(result.timedOut);
+    EXPECT_FALSE(result.fileChanged);
+    EXPECT_EQ(std::string("H\x01"), result.wakeups);
+
+    // Nothing left to read, the poll period elapses
+    result = dirWatch.wait(std::chrono::milliseconds(20));
+    EXPECT_TRUE(result.timedOut);
+    EXPECT_TRUE(result.wakeups.empty());
+
+    dirWatch.close();
+    EXPECT_EQ(-1, dirWatch.getWakeupFd());
+}
+
+#ifdef __linux__
+TEST_F(DirWatchTests, testChangesOfTheFile)
+{
+    DirWatch dirWatch;
+    ASSERT_TRUE(dirWatch.open(m_file, DirWatchEvents::WRITTEN));
+    ASSERT_TRUE(dirWatch.isWatching());
+
+    // The other files of the directory don't count
+    writeFile(m_otherFile, "OTHER=1");
+    auto result = dirWatch.wait(std::chrono::milliseconds(200));
+    EXPECT_FALSE(result.fileChanged);
+
+    writeFile(m_file, "FILE_SIZE=2MB");
+    EXPECT_TRUE(waitForFileChange(dirWatch));
+
+    // Renamed over it, as an editor saves it
+    writeFile(m_otherFile, "FILE_SIZE=4MB");
+    std::filesystem::rename(m_otherFile, m_file);
+    EXPECT_TRUE(waitForFileChange(dirWatch));
+}
+
+TEST_F(DirWatchTests, testAnyChange)
+{
+    writeFile(m_file, "line 1");
+    DirWatch dirWatch;
+    ASSERT_TRUE(dirWatch.open(m_file, DirWatchEvents::ANY));
+    ASSERT_TRUE(dirWatch.isWatching());
+
+    // A removal is a change too, which a write out only does not catch
+    std::filesystem::remove(m_file);
+    EXPECT_TRUE(waitForFileChange(dirWatch));
+}
+#endif
@@ -35,7 +35,10 @@
 #include "FileOps.hpp"
 #include "CommonFunc.hpp"
 
+#include <atomic>
 #include <bitset>
+#include <set>
+#include <thread>
 
 using namespace logger;
 
@@ -763,6 +766,8 @@ TEST_F(FileOpsTests, testFileLimitExceed)
         file.append(text);
         dataQueue.push_back(text);
     }
+    // Rotated by the drain turns, as they write the records out
+    file.flushAndWait();
     size_t cnt = 0;
     for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::current_path()))
     {
@@ -784,3 +789,306 @@ TEST_F(FileOpsTests, testFileLimitExceed)
     }
     EXPECT_EQ(cnt, newCnt);
 }
+
+TEST_F(FileOpsTests, testRotatedByTheDrainTurns)
+{
+    std::uintmax_t maxFileSize = 4096;
+    std::uintmax_t maxTextSize = 100;
+    auto fileName = generateRandomFileName();
+    auto stem = fileName.substr(0, fileName.find(".txt"));
+    std::multiset<std::string> expLines;
+    size_t syncCount = 0;
+    {
+        FileOps file(maxFileSize, fileName);
+        // No critical record, yet each file gets synced before it is renamed
+        file.setDurabilityPolicy(DurabilityPolicy::ON_CRITICAL);
+        for (auto cnt = 0; cnt < 300; ++cnt)
+        {
+            auto text = generateRandomText(maxTextSize);
+            file.write(text);
+            expLines.insert(text);
+        }
+        file.flushAndWait();
+        syncCount = file.getSyncStats().syncCount;
+    }
+
+    std::multiset<std::string> lines;
+    size_t fileCnt = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::current_path()))
+    {
+        if (!entry.path().filename().string().starts_with(stem))
+            continue;
+
+        ++fileCnt;
+        EXPECT_LE(std::filesystem::file_size(entry.path()), maxFileSize) << entry.path();
+        {
+            MappedFile mappedFile(entry.path());
+            for (auto line : mappedFile.lines())
+                lines.emplace(line);
+        }
+        EXPECT_TRUE(FileOps::removeFile(entry.path()));
+    }
+    EXPECT_GT(fileCnt, static_cast<size_t>(1));
+    EXPECT_EQ(fileCnt - 1, syncCount);
+    EXPECT_EQ(expLines, lines);
+}
+
+TEST_F(FileOpsTests, testDurabilityPolicies)
+{
+    std::uintmax_t maxFileSize = 1024 * 1024;
+    std::uintmax_t maxTextSize = 128;
+    auto writeLines = [maxTextSize](FileOps& file, const size_t lineCnt)
+    {
+        for (size_t cnt = 0; cnt < lineCnt; ++cnt)
+            file.write(generateRandomText(maxTextSize));
+    };
+    {
+        FileOps file(maxFileSize, generateRandomFileName());
+        EXPECT_EQ(DurabilityPolicy::NO_SYNC, file.getDurabilityPolicy());
+        writeLines(file, 300);
+        file.flushAndWait();
+        file.commitCritical();
+        EXPECT_EQ(static_cast<size_t>(0), file.getSyncStats().syncCount);
+        EXPECT_EQ(static_cast<std::uintmax_t>(300 * (maxTextSize + 1)), file.getFileSize());
+        ASSERT_TRUE(file.deleteFile());
+    }
+    {
+        // One sync per batch of records written
+        FileOps file(maxFileSize, generateRandomFileName());
+        file.setDurabilityPolicy(DurabilityPolicy::PER_BATCH);
+        writeLines(file, 300);
+        file.flushAndWait();
+        auto stats = file.getSyncStats();
+        EXPECT_GE(stats.syncCount, static_cast<size_t>(1));
+        EXPECT_LE(stats.syncCount, static_cast<size_t>(300));
+        EXPECT_EQ(static_cast<size_t>(0), stats.failedCount);
+        EXPECT_GE(stats.maxLatency, stats.averageLatency());
+        EXPECT_EQ(static_cast<std::uintmax_t>(300 * (maxTextSize + 1)), file.getFileSize());
+        ASSERT_TRUE(file.deleteFile());
+    }
+    {
+        // A timed turn of the shared I/O threads, no thread of its own
+        auto threadCnt = std::distance(std::filesystem::directory_iterator("/proc/self/task"), std::filesystem::directory_iterator());
+        FileOps file(maxFileSize, generateRandomFileName());
+        file.setDurabilityPolicy(DurabilityPolicy::PERIODIC, std::chrono::milliseconds(10));
+        EXPECT_EQ(DurabilityPolicy::PERIODIC, file.getDurabilityPolicy());
+        EXPECT_EQ(threadCnt, std::distance(std::filesystem::directory_iterator("/proc/self/task"), std::filesystem::directory_iterator()));
+        writeLines(file, 10);
+        file.flushAndWait();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        auto syncCnt = file.getSyncStats().syncCount;
+        EXPECT_GE(syncCnt, static_cast<size_t>(1));
+        // Nothing written since, nothing synced
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_EQ(syncCnt, file.getSyncStats().syncCount);
+        // Written again, synced again by the timer armed for the next period
+        writeLines(file, 10);
+        file.flushAndWait();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        EXPECT_GT(file.getSyncStats().syncCount, syncCnt);
+        ASSERT_TRUE(file.deleteFile());
+    }
+    {
+        // Nothing but the critical records are synced, and they are synced right away
+        FileOps file(maxFileSize, generateRandomFileName());
+        file.setDurabilityPolicy(DurabilityPolicy::ON_CRITICAL);
+        writeLines(file, 10);
+        EXPECT_EQ(static_cast<size_t>(0), file.getSyncStats().syncCount);
+        file.commitCritical();
+        auto stats = file.getSyncStats();
+        EXPECT_EQ(static_cast<size_t>(1), stats.syncCount);
+        EXPECT_EQ(stats.lastLatency, stats.totalLatency);
+        file.readFile();
+        EXPECT_EQ(static_cast<size_t>(10), file.getFileContent().size());
+        ASSERT_TRUE(file.deleteFile());
+    }
+}
+
+TEST_F(FileOpsTests, testCloseWhilePeriodicSyncIsDue)
+{
+    std::uintmax_t maxFileSize = 1024 * 1024;
+    std::uintmax_t maxTextSize = 128;
+    std::vector<std::filesystem::path> filePaths;
+    for (auto cnt = 0; cnt < 50; ++cnt)
+    {
+        // Closed while the sync comes due, the last turn must not leave a timer behind
+        FileOps file(maxFileSize, generateRandomFileName());
+        file.setDurabilityPolicy(DurabilityPolicy::PERIODIC, std::chrono::milliseconds(1));
+        for (auto lineCnt = 0; lineCnt < 10; ++lineCnt)
+            file.write(generateRandomText(maxTextSize));
+        std::this_thread::sleep_for(std::chrono::microseconds(500 + 20 * cnt));
+        filePaths.push_back(file.getFilePathObj());
+    }
+    // Any timer left would fire by now, on a sink long gone
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    for (const auto& filePath : filePaths)
+    {
+        EXPECT_EQ(static_cast<std::uintmax_t>(10 * (maxTextSize + 1)), std::filesystem::file_size(filePath));
+        ASSERT_TRUE(FileOps::removeFile(filePath));
+    }
+}
+
+TEST_F(FileOpsTests, testReadFileLineRangeWithIndex)
+{
+    std::uintmax_t maxFileSize = 4096 * 1000;
+    std::uintmax_t maxTextSize = 100;
+    auto fileName = generateRandomFileName();
+    std::vector<std::string> dataQueue;
+    std::filesystem::path filePathObj;
+    {
+        // Some data is there before the index gets enabled
+        FileOps file(maxFileSize, fileName);
+        filePathObj = file.getFilePathObj();
+        for (auto cnt = 0; cnt < 300; ++cnt)
+        {
+            auto text = generateRandomText(maxTextSize);
+            file.write(text);
+            dataQueue.push_back(text);
+        }
+    }
+    FileOps file(maxFileSize, fileName);
+    file.enableLineIndex(16);
+    EXPECT_TRUE(file.isLineIndexEnabled());
+    for (auto cnt = 0; cnt < 300; ++cnt)
+    {
+        auto text = generateRandomText(maxTextSize);
+        file.write(text);
+        dataQueue.push_back(text);
+    }
+    file.flushAndWait();
+    EXPECT_TRUE(FileOps::fileExists(LineIndex::getIndexFilePath(filePathObj)));
+
+    for (auto [startLineNo, endLineNo] : { std::pair<size_t, size_t>(1, 5), {17, 40}, {295, 310}, {590, 600} })
+    {
+        std::vector<std::string> readBuf;
+        ASSERT_TRUE(FileOps::readFileLineRange(file, startLineNo, endLineNo, readBuf));
+        ASSERT_EQ((endLineNo - startLineNo + 1), readBuf.size());
+        for (size_t idx = 0; idx < readBuf.size(); ++idx)
+            EXPECT_EQ(dataQueue[startLineNo - 1 + idx], readBuf[idx]);
+    }
+    EXPECT_TRUE(file.getAllExceptions().empty());
+    ASSERT_TRUE(file.deleteFile());
+    EXPECT_FALSE(FileOps::fileExists(LineIndex::getIndexFilePath(filePathObj)));
+}
+
+TEST_F(FileOpsTests, testLineIndexFailureLeavesTheLogAlone)
+{
+    std::uintmax_t maxFileSize = 4096 * 1000;
+    std::uintmax_t maxTextSize = 100;
+    FileOps file(maxFileSize, generateRandomFileName());
+    // The sidecar can't be written, a directory being in its place
+    auto indexFilePath = LineIndex::getIndexFilePath(file.getFilePathObj());
+    ASSERT_TRUE(std::filesystem::create_directory(indexFilePath));
+    file.enableLineIndex(16);
+    std::vector<std::string> dataQueue;
+    for (auto cnt = 0; cnt < 300; ++cnt)
+    {
+        auto text = generateRandomText(maxTextSize);
+        file.write(text);
+        dataQueue.push_back(text);
+    }
+    file.flushAndWait();
+    EXPECT_FALSE(file.isLineIndexEnabled());
+    EXPECT_FALSE(file.getAllExceptions().empty());
+
+    // Written on and read back without the index, nothing left hanging
+    for (auto cnt = 0; cnt < 10; ++cnt)
+    {
+        auto text = generateRandomText(maxTextSize);
+        file.write(text);
+        dataQueue.push_back(text);
+    }
+    std::vector<std::string> readBuf;
+    ASSERT_TRUE(FileOps::readFileLineRange(file, 295, 310, readBuf));
+    ASSERT_EQ(static_cast<size_t>(16), readBuf.size());
+    for (size_t idx = 0; idx < readBuf.size(); ++idx)
+        EXPECT_EQ(dataQueue[294 + idx], readBuf[idx]);
+    EXPECT_TRUE(file.clearFile());
+    EXPECT_TRUE(file.isEmpty());
+    ASSERT_TRUE(file.deleteFile());
+    std::filesystem::remove(indexFilePath);
+}
+
+TEST_F(FileOpsTests, testReadLineRangeWhileClearing)
+{
+    std::uintmax_t maxFileSize = 4096 * 1000;
+    std::uintmax_t maxTextSize = 1000;
+    FileOps file(maxFileSize, generateRandomFileName());
+    file.enableLineIndex(8);
+    std::atomic_bool done = false;
+    // Cleared and written again and again while being read, a clear must
+    // never truncate the file from under the mapping of a read
+    std::thread clearer([&]()
+    {
+        for (auto round = 0; round < 10; ++round)
+        {
+            file.clearFile();
+            for (auto cnt = 0; cnt < 200; ++cnt)
+                file.write(generateRandomText(maxTextSize));
+            file.flushAndWait();
+        }
+        done = true;
+    });
+    std::vector<std::string> readBuf;
+    while (!done)
+    {
+        if (FileOps::readFileLineRange(file, 1, 200, readBuf))
+        {
+            for (const auto& line : readBuf)
+                EXPECT_EQ(maxTextSize, line.size());
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    clearer.join();
+    ASSERT_TRUE(file.deleteFile());
+    std::filesystem::remove(LineIndex::getIndexFilePath(file.getFilePathObj()));
+}
+
+TEST_F(FileOpsTests, testMapFile)
+{
+    std::uintmax_t maxFileSize = 1024 * 1000;
+    std::uintmax_t maxTextSize = 200;
+    auto fileName = generateRandomFileName();
+    FileOps file(maxFileSize, fileName);
+    std::vector<std::string> dataQueue;
+    for (auto cnt = 0; cnt < 300; ++cnt)
+    {
+        auto text = generateRandomText(maxTextSize);
+        file.write(text);
+        dataQueue.push_back(text);
+    }
+    {
+        auto mappedFile = file.mapFile();
+        size_t idx = 0;
+        for (auto line : mappedFile.lines())
+            EXPECT_EQ(dataQueue[idx++], line);
+        EXPECT_EQ(dataQueue.size(), idx);
+    }
+    size_t idx = 0;
+    auto lineCnt = file.forEachLine([&](std::string_view line)
+    {
+        EXPECT_EQ(dataQueue[idx++], line);
+        return true;
+    }, 4096);
+    EXPECT_EQ(dataQueue.size(), lineCnt);
+    ASSERT_TRUE(file.deleteFile());
+}
+
+TEST_F(FileOpsTests, testReverseReader)
+{
+    std::uintmax_t maxFileSize = 1024 * 1000;
+    std::uintmax_t maxTextSize = 200;
+    auto fileName = generateRandomFileName();
+    FileOps file(maxFileSize, fileName);
+    std::vector<std::string> dataQueue;
+    for (auto cnt = 0; cnt < 300; ++cnt)
+    {
+        auto text = generateRandomText(maxTextSize);
+        file.write(text);
+        dataQueue.push_back(text);
+    }
+    auto lastLines = file.reverseReader(1024).lastLines(20);
+    std::vector<std::string> expLines(dataQueue.end() - 20, dataQueue.end());
+    EXPECT_EQ(expLines, lastLines);
+    ASSERT_TRUE(file.deleteFile());
+}
@@ -0,0 +1,460 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="IoExecutorTests.*"
+
+/*
+ * IoExecutorTest.cpp
+ * Unit tests for IoExecutor functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the IoExecutor class: the number of
+ * threads staying the same whatever the number of sinks, and the order of
+ * the records of each sink while many of them get drained together, the
+ * wait strategies and the pinning and scheduling of the threads.
+ */
+
+#include "IoExecutor.hpp"
+#include "LoggerConfig.hpp"
+#include "FileOps.hpp"
+#include "ConsoleOps.hpp"
+#include "BatchSinkOps.hpp"
+#include "CommonFunc.hpp"
+
+#include <memory>
+#include <functional>
+#include <future>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <poll.h>
+#include <sched.h>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief A LogSink switching the drive of the drain turns while it consumes
+     */
+    class DriveSwitchSink : public LogSink
+    {
+        public:
+            void consume(std::span<const LogRecord> records) override
+            {
+                auto& executor = IoExecutor::getShared();
+                for (auto switchDrive : { std::function<void()>([&executor]() { executor.startExternalDrive(); }),
+                                          std::function<void()>([&executor]() { executor.stopExternalDrive(); }) })
+                {
+                    try
+                    {
+                        switchDrive();
+                    }
+                    catch(const std::runtime_error& excp)
+                    {
+                        m_errors.emplace_back(excp.what());
+                    }
+                }
+                m_consumedCnt += records.size();
+            }
+
+            size_t getConsumedCount() const             { return m_consumedCnt;     }
+            const std::vector<std::string>& getErrors() const
+            {
+                return m_errors;
+            }
+
+        private:
+            size_t m_consumedCnt = 0;
+            std::vector<std::string> m_errors;
+    };
+};
+
+class IoExecutorTests : public CommonTestDataGenerator
+{
+    public:
+        /**
+         * @brief Count the threads of this process
+         *
+         * @return size_t The number of threads, 0 if it can't be told
+         */
+        static size_t getThreadCount()
+        {
+            std::error_code ec;
+            auto taskDir = std::filesystem::directory_iterator("/proc/self/task", ec);
+            if (ec)
+                return 0;
+            return static_cast<size_t>(std::distance(taskDir, std::filesystem::directory_iterator()));
+        }
+
+        /**
+         * @brief Count the threads of this process allowed on a single core
+         *
+         * @param [in] cpu The core
+         * @return size_t The number of threads pinned to it
+         */
+        static size_t getPinnedThreadCount(const int cpu)
+        {
+            std::error_code ec;
+            size_t pinnedCnt = 0;
+            for (const auto& task : std::filesystem::directory_iterator("/proc/self/task", ec))
+            {
+                std::ifstream status(task.path() / "status");
+                std::string line;
+                while (std::getline(status, line))
+                {
+                    if (line == "Cpus_allowed_list:\t" + std::to_string(cpu))
+                        ++pinnedCnt;
+                }
+            }
+            return pinnedCnt;
+        }
+
+        /**
+         * @brief Count the threads of this process at a nice level
+         *
+         * @param [in] niceLevel The nice level
+         * @return size_t The number of threads at it
+         */
+        static size_t getNiceThreadCount(const int niceLevel)
+        {
+            std::error_code ec;
+            size_t niceCnt = 0;
+            for (const auto& task : std::filesystem::directory_iterator("/proc/self/task", ec))
+            {
+                std::ifstream statFile(task.path() / "stat");
+                std::string stat;
+                std::getline(statFile, stat);
+                // The nice level is the 17th field after the command name
+                std::istringstream fields(stat.substr(stat.rfind(')') + 1));
+                std::string field;
+                for (auto cnt = 0; cnt < 17; ++cnt)
+                    fields >> field;
+                if (field == std::to_string(niceLevel))
+                    ++niceCnt;
+            }
+            return niceCnt;
+        }
+};
+
+TEST_F(IoExecutorTests, testThreadCount)
+{
+    // IO_THREADS, defaultThreadCount unless set
+    EXPECT_EQ(LoggerConfig::load().ioThreadCnt, IoExecutor::getShared().getThreadCount());
+    EXPECT_EQ(&IoExecutor::getShared(), &IoExecutor::getShared());
+
+    IoExecutor executor(0);
+    EXPECT_EQ(1, executor.getThreadCount());
+}
+
+TEST_F(IoExecutorTests, testThreadCountFixedForAnyNumberOfSinks)
+{
+    IoExecutor::getShared();
+    auto threadCnt = getThreadCount();
+    if (threadCnt == 0)
+        GTEST_SKIP() << "No /proc/self/task to count the threads";
+
+    std::vector<std::unique_ptr<FileOps>> sinks;
+    for (auto cnt = 0; cnt < 32; ++cnt)
+    {
+        sinks.emplace_back(std::make_unique<FileOps>(1024 * 1000, generateRandomFileName()));
+        for (auto line = 0; line < 300; ++line)
+            sinks.back()->write(generateRandomText(50));
+    }
+    // Each sink used to have a watcher thread and a writer thread on top for a batch
+    EXPECT_EQ(threadCnt, getThreadCount());
+
+    for (auto& sink : sinks)
+    {
+        sink->flushAndWait();
+        auto mappedFile = sink->mapFile();
+        auto lines = mappedFile.lines();
+        EXPECT_EQ(300, std::distance(lines.begin(), lines.end()));
+        EXPECT_TRUE(sink->deleteFile());
+    }
+}
+
+TEST_F(IoExecutorTests, testOrderPerSink)
+{
+    constexpr size_t sinkCnt = 8;
+    constexpr size_t lineCnt = 2000;
+    std::vector<std::unique_ptr<FileOps>> sinks;
+    for (size_t cnt = 0; cnt < sinkCnt; ++cnt)
+        sinks.emplace_back(std::make_unique<FileOps>(1024 * 1000 * 10, generateRandomFileName()));
+
+    // One writer thread per sink, all the sinks being drained at the same time
+    std::vector<std::thread> writers;
+    for (size_t idx = 0; idx < sinkCnt; ++idx)
+    {
+        writers.emplace_back([&sink = *sinks[idx], idx]()
+        {
+            for (size_t line = 0; line < lineCnt; ++line)
+                sink.write(std::to_string(idx) + ":" + std::to_string(line));
+        });
+    }
+    for (auto& writer : writers)
+        writer.join();
+
+    for (size_t idx = 0; idx < sinkCnt; ++idx)
+    {
+        sinks[idx]->flushAndWait();
+        size_t expLine = 0;
+        auto mappedFile = sinks[idx]->mapFile();
+        for (auto line : mappedFile.lines())
+        {
+            ASSERT_EQ(std::to_string(idx) + ":" + std::to_string(expLine), line);
+            ++expLine;
+        }
+        EXPECT_EQ(lineCnt, expLine);
+        EXPECT_TRUE(sinks[idx]->deleteFile());
+    }
+}
+
+TEST_F(IoExecutorTests, testWaitStrategies)
+{
+    auto& executor = IoExecutor::getShared();
+    EXPECT_EQ(WaitStrategy::BLOCK, executor.getWaitStrategy());
+    for (auto waitStrategy : { WaitStrategy::BUSY_POLL, WaitStrategy::SPIN_THEN_PARK, WaitStrategy::BLOCK })
+    {
+        IoThreadOptions options;
+        options.waitStrategy = waitStrategy;
+        options.spinTime = std::chrono::microseconds(200);
+        executor.setThreadOptions(options);
+        EXPECT_EQ(waitStrategy, executor.getWaitStrategy());
+        EXPECT_EQ(std::chrono::microseconds(200), executor.getThreadOptions().spinTime);
+
+        // Drained the same, the batches as well as the timed turns
+        FileOps sink(1024 * 1000, generateRandomFileName());
+        sink.setMaxBatchSize(16);
+        for (auto line = 0; line < 100; ++line)
+            sink.write(std::to_string(line));
+        sink.flushAndWait();
+        auto mappedFile = sink.mapFile();
+        auto lines = mappedFile.lines();
+        EXPECT_EQ(100, std::distance(lines.begin(), lines.end()));
+        EXPECT_TRUE(sink.deleteFile());
+    }
+    EXPECT_EQ(WaitStrategy::BLOCK, executor.getWaitStrategy());
+}
+
+TEST_F(IoExecutorTests, testThreadPinningAndScheduling)
+{
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    ASSERT_EQ(0, ::sched_getaffinity(0, sizeof(cpuSet), &cpuSet));
+    int cpu = 0;
+    while (cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &cpuSet))
+        ++cpu;
+    ASSERT_LT(cpu, CPU_SETSIZE);
+
+    // An executor of its own, not to pin the shared one
+    auto pinnedCnt = getPinnedThreadCount(cpu);
+    IoExecutor executor(2);
+    IoThreadOptions options;
+    options.cpus = { cpu };
+    // Lowering the priority takes no privilege
+    options.schedPolicy = SchedPolicy::BATCH;
+    options.niceLevel = 19;
+    executor.setThreadOptions(options);
+    EXPECT_EQ(pinnedCnt + 2, getPinnedThreadCount(cpu));
+    EXPECT_EQ(std::vector<int>{ cpu }, executor.getThreadOptions().cpus);
+    EXPECT_EQ(19, executor.getThreadOptions().niceLevel);
+
+    // A failure leaves the options as they were
+    options.cpus = { -1 };
+    options.waitStrategy = WaitStrategy::BUSY_POLL;
+    EXPECT_THROW(executor.setThreadOptions(options), std::runtime_error);
+    EXPECT_EQ(std::vector<int>{ cpu }, executor.getThreadOptions().cpus);
+    EXPECT_EQ(WaitStrategy::BLOCK, executor.getWaitStrategy());
+#else
+    GTEST_SKIP() << "The I/O threads are pinned and scheduled on Linux only";
+#endif
+}
+
+TEST_F(IoExecutorTests, testThreadOptionsAllOrNothing)
+{
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    ASSERT_EQ(0, ::sched_getaffinity(0, sizeof(cpuSet), &cpuSet));
+    int cpu = 0;
+    while (cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &cpuSet))
+        ++cpu;
+    int offCpu = CPU_SETSIZE - 1;
+    while (offCpu > cpu && CPU_ISSET(offCpu, &cpuSet))
+        --offCpu;
+    ASSERT_GT(offCpu, cpu);
+
+    // The first thread takes them, the second one can't be pinned
+    auto niceCnt = getNiceThreadCount(19);
+    IoExecutor executor(2);
+    IoThreadOptions options;
+    options.cpus = { cpu, offCpu };
+    options.schedPolicy = SchedPolicy::BATCH;
+    options.niceLevel = 19;
+    options.waitStrategy = WaitStrategy::BUSY_POLL;
+    EXPECT_THROW(executor.setThreadOptions(options), std::runtime_error);
+    EXPECT_EQ(niceCnt, getNiceThreadCount(19));
+    EXPECT_TRUE(executor.getThreadOptions().cpus.empty());
+    EXPECT_FALSE(executor.getThreadOptions().niceLevel);
+    EXPECT_EQ(WaitStrategy::BLOCK, executor.getWaitStrategy());
+
+    // Out of range, nothing gets tried
+    options.cpus = { cpu };
+    options.niceLevel = 20;
+    EXPECT_THROW(executor.setThreadOptions(options), std::runtime_error);
+    EXPECT_EQ(niceCnt, getNiceThreadCount(19));
+#else
+    GTEST_SKIP() << "The I/O threads are pinned and scheduled on Linux only";
+#endif
+}
+
+TEST_F(IoExecutorTests, testExternalDrive)
+{
+#if defined(__linux__)
+    auto& executor = IoExecutor::getShared();
+    auto threadCnt = executor.getThreadCount();
+    auto eventFd = executor.startExternalDrive();
+    // The threads come back whatever happens to the test
+    std::unique_ptr<IoExecutor, void(*)(IoExecutor*)> driveGuard(&executor, [](IoExecutor* pExecutor)
+    {
+        pExecutor->stopExternalDrive();
+    });
+    ASSERT_GE(eventFd, 0);
+    EXPECT_TRUE(executor.isExternallyDriven());
+    EXPECT_EQ(0, executor.getThreadCount());
+    EXPECT_EQ(eventFd, executor.startExternalDrive());
+    auto isReadable = [eventFd]()
+    {
+        pollfd pollFd = { eventFd, POLLIN, 0 };
+        return ::poll(&pollFd, 1, 0) == 1;
+    };
+    executor.drain();
+    EXPECT_FALSE(isReadable());
+
+    {
+        // Full batches wake the event loop up, and wait for it
+        FileOps sink(1024 * 1000, generateRandomFileName());
+        FileOps otherSink(1024 * 1000, generateRandomFileName());
+        for (auto pOps : { &sink, &otherSink })
+        {
+            pOps->setMaxBatchSize(16);
+            for (auto line = 0; line < 64; ++line)
+                pOps->write(std::to_string(line));
+        }
+        EXPECT_TRUE(isReadable());
+        // One turn of one sink, the other one left for the next wake up
+        EXPECT_EQ(1, executor.drain(1));
+        EXPECT_TRUE(isReadable());
+        while (isReadable())
+            executor.drain(1);
+        EXPECT_EQ(0, executor.drain());
+        EXPECT_TRUE(otherSink.deleteFile());
+
+        // A wait for the records writes them on the waiting thread
+        sink.write("64");
+        sink.flushAndWait();
+        auto mappedFile = sink.mapFile();
+        auto lines = mappedFile.lines();
+        EXPECT_EQ(65, std::distance(lines.begin(), lines.end()));
+        EXPECT_TRUE(sink.deleteFile());
+    }
+
+    {
+        // A batch not full yet goes once the loop has waited long enough
+        testing::internal::CaptureStdout();
+        ConsoleOps console(false, std::chrono::milliseconds(5));
+        console.write("external drive");
+        auto timeout = executor.getDrainTimeout();
+        EXPECT_GE(timeout, 0);
+        EXPECT_LE(timeout, 5);
+        pollfd pollFd = { eventFd, POLLIN, 0 };
+        ::poll(&pollFd, 1, timeout);
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+        executor.drain();
+        EXPECT_EQ(-1, executor.getDrainTimeout());
+        EXPECT_NE(std::string::npos, testing::internal::GetCapturedStdout().find("external drive"));
+    }
+
+    driveGuard.reset();
+    EXPECT_FALSE(executor.isExternallyDriven());
+    EXPECT_EQ(threadCnt, executor.getThreadCount());
+    FileOps sink(1024 * 1000, generateRandomFileName());
+    sink.write("threaded again");
+    sink.flushAndWait();
+    auto mappedFile = sink.mapFile();
+    auto lines = mappedFile.lines();
+    EXPECT_EQ(1, std::distance(lines.begin(), lines.end()));
+    EXPECT_TRUE(sink.deleteFile());
+#else
+    GTEST_SKIP() << "The drain turns are driven by an event loop on Linux only";
+#endif
+}
+
+TEST_F(IoExecutorTests, testExternalDriveFromDrainTurn)
+{
+    auto& executor = IoExecutor::getShared();
+    auto threadCnt = executor.getThreadCount();
+    auto pSink = std::make_unique<DriveSwitchSink>();
+    auto& sink = *pSink;
+    {
+        BatchSinkOps ops(std::move(pSink));
+        ops.write("switch");
+        // The I/O thread running the turn would have joined itself
+        auto flushed = std::async(std::launch::async, [&ops]() { ops.flushAndWait(); });
+        ASSERT_EQ(std::future_status::ready, flushed.wait_for(std::chrono::seconds(5)));
+        flushed.get();
+
+        EXPECT_EQ(1, sink.getConsumedCount());
+        ASSERT_EQ(2, sink.getErrors().size());
+        for (const auto& error : sink.getErrors())
+            EXPECT_NE(std::string::npos, error.find("from a drain turn")) << error;
+    }
+    EXPECT_FALSE(executor.isExternallyDriven());
+    EXPECT_EQ(threadCnt, executor.getThreadCount());
+}
+
+TEST_F(IoExecutorTests, testExternalDriveWhilePolling)
+{
+#if defined(__linux__)
+    // An executor of its own, idle, its threads polling rather than parked
+    IoExecutor executor(2);
+    for (auto waitStrategy : { WaitStrategy::BUSY_POLL, WaitStrategy::SPIN_THEN_PARK })
+    {
+        IoThreadOptions options;
+        options.waitStrategy = waitStrategy;
+        options.spinTime = std::chrono::seconds(60);
+        executor.setThreadOptions(options);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        auto started = std::async(std::launch::async, [&executor]() { return executor.startExternalDrive(); });
+        ASSERT_EQ(std::future_status::ready, started.wait_for(std::chrono::seconds(5)));
+        EXPECT_GE(started.get(), 0);
+        EXPECT_EQ(0, executor.getThreadCount());
+        executor.stopExternalDrive();
+        EXPECT_EQ(2, executor.getThreadCount());
+    }
+#else
+    GTEST_SKIP() << "The drain turns are driven by an event loop on Linux only";
+#endif
+}
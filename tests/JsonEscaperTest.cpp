@@ -0,0 +1,142 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="JsonEscaperTests.*"
+
+/*
+ * JsonEscaperTest.cpp
+ * Unit tests for JsonEscaper functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the JsonEscaper class, checking every
+ * supported instruction set against a plain reference escaper, for all
+ * alignments and lengths around the vector widths.
+ */
+
+#include "JsonEscaper.hpp"
+#include "CommonFunc.hpp"
+
+#include <cstdio>
+
+using namespace logger;
+
+class JsonEscaperTests : public CommonTestDataGenerator
+{
+    public:
+        /**
+         * @brief Escape a string a character at a time, as the reference
+         */
+        static std::string escapeReference(const std::string_view in)
+        {
+            std::string out;
+            for (auto chr : in)
+            {
+                switch (chr)
+                {
+                    case '"':  out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\b': out += "\\b";  break;
+                    case '\f': out += "\\f";  break;
+                    case '\n': out += "\\n";  break;
+                    case '\r': out += "\\r";  break;
+                    case '\t': out += "\\t";  break;
+                    default:
+                        if (static_cast<unsigned char>(chr) < 0x20)
+                        {
+                            char buffer[8];
+                            std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(chr));
+                            out += buffer;
+                        }
+                        else
+                        {
+                            out += chr;
+                        }
+                }
+            }
+            return out;
+        }
+};
+
+TEST_F(JsonEscaperTests, testEscapeSequences)
+{
+    std::string out;
+    JsonEscaper::escape(out, "say \"hi\"\\ \b\f\n\r\t\x01\x1f end");
+    EXPECT_EQ("say \\\"hi\\\"\\\\ \\b\\f\\n\\r\\t\\u0001\\u001f end", out);
+
+    // Appended to what is there, UTF-8 and DEL are left as they are
+    JsonEscaper::escape(out.assign("x"), "caf\xc3\xa9 \xe2\x82\xac \x7f");
+    EXPECT_EQ("xcaf\xc3\xa9 \xe2\x82\xac \x7f", out);
+
+    JsonEscaper::escape(out.assign("y"), "");
+    EXPECT_EQ("y", out);
+}
+
+TEST_F(JsonEscaperTests, testAgainstReference)
+{
+    // Random text with specials and bytes past 0x7F sprinkled in
+    auto text = generateRandomText(600);
+    const std::string specials = std::string("\"\\\n\t\x01\x1f\x80\xff", 8) + '\0';
+    for (size_t idx = 0; idx < text.size(); idx += (idx % 11) + 3)
+        text[idx] = specials[idx % specials.size()];
+
+    for (auto isa : getSupportedIsas())
+    {
+        for (size_t start = 0; start < 40; ++start)
+        {
+            for (size_t len = 0; start + len <= text.size(); len += (len < 100) ? 1 : 29)
+            {
+                std::string_view in(text.data() + start, len);
+                std::string out;
+                JsonEscaper::escape(out, in, isa);
+                ASSERT_EQ(escapeReference(in), out)
+                    << LineScanner::getIsaName(isa) << " start " << start << " len " << len;
+            }
+        }
+    }
+}
+
+TEST_F(JsonEscaperTests, testFindSpecial)
+{
+    std::string text(200, 'x');
+    for (auto isa : getSupportedIsas())
+    {
+        // Nothing to escape gives the end
+        EXPECT_EQ(text.data() + text.size(), JsonEscaper::findSpecial(text.data(), text.data() + text.size(), isa));
+        for (size_t pos = 0; pos < 80; ++pos)
+        {
+            for (auto special : { '"', '\\', '\0', '\x1f' })
+            {
+                text[pos] = special;
+                // The bytes right around the specials are not special
+                text[pos + 1] = ' ';
+                text[pos + 2] = '\x7f';
+                for (size_t start = 0; start <= pos; start += 3)
+                {
+                    ASSERT_EQ(text.data() + pos, JsonEscaper::findSpecial(text.data() + start, text.data() + text.size(), isa))
+                        << LineScanner::getIsaName(isa) << " start " << start << " pos " << pos;
+                }
+                // A special just past the end is not found
+                EXPECT_EQ(text.data() + pos, JsonEscaper::findSpecial(text.data(), text.data() + pos, isa));
+            }
+            text[pos] = text[pos + 1] = text[pos + 2] = 'x';
+        }
+    }
+}
@@ -0,0 +1,215 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="JsonLinesSinkTests.*"
+
+/*
+ * JsonLinesSinkTest.cpp
+ * Unit tests for JsonLinesSink functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the JsonLinesSink class: the fields of
+ * the records the Logger renders, the escaping of the messages, the records
+ * written without a call site and the file written through a BatchSinkOps.
+ */
+
+#include "JsonLinesSink.hpp"
+#include "BatchSinkOps.hpp"
+#include "Logger.hpp"
+#include "CommonFunc.hpp"
+
+#include <array>
+#include <deque>
+#include <limits>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+using namespace logger;
+
+class JsonLinesSinkTests : public CommonTestDataGenerator
+{
+    public:
+        void SetUp() override
+        {
+            m_file = generateRandomFileName("tmp_", ".jsonl");
+        }
+
+        void TearDown() override
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_file, ec);
+        }
+
+        /**
+         * @brief Render a message with a Logger and make the record LogHelper would make of it
+         * The text is kept in m_texts, which the record refers to. The time
+         * stamp is set to 2025-08-25T15:50:51.000042Z, for a known rendering.
+         */
+        template<typename ...Args>
+        LogRecord makeRecord(const std::string_view funcName,
+                             const size_t lineNo,
+                             const LOG_TYPE logType,
+                             const std::string_view format,
+                             Args&&... args)
+        {
+            m_logger.setFileName(__FILE__)
+                    .setFunctionName(std::string(funcName))
+                    .setLineNo(lineNo)
+                    .setThreadId(std::this_thread::get_id())
+                    .setMarker(std::string(FORWARD_ANGLE))
+                    .setLogType(logType);
+            m_logger.log(format, args...);
+            const auto& text = m_texts.emplace_back(m_logger.getLogStream().str());
+
+            LogRecord record;
+            record.logType = logType;
+            record.timestamp = std::chrono::system_clock::time_point(std::chrono::microseconds(1756137051000042));
+            record.threadId = std::this_thread::get_id();
+            record.fileName = __FILE__;
+            record.funcName = funcName;
+            record.lineNo = lineNo;
+            record.marker = FORWARD_ANGLE;
+            record.text = text;
+            record.prefixSize = m_logger.getLogMsgPrefixSize();
+            record.msgOffset = m_logger.getLogMsgOffset();
+            return record;
+        }
+
+        /**
+         * @brief Get the id of this thread as the sink renders it
+         */
+        static std::string getThisThreadId()
+        {
+            std::ostringstream osstr;
+            osstr << std::this_thread::get_id();
+            return osstr.str();
+        }
+
+        /**
+         * @brief Read m_file into lines
+         */
+        std::vector<std::string> readLines() const
+        {
+            std::vector<std::string> lines;
+            std::ifstream file(m_file);
+            for (std::string line; std::getline(file, line);)
+                lines.push_back(line);
+            return lines;
+        }
+
+    protected:
+        std::filesystem::path m_file;
+        Logger m_logger{LOG_TIME_FORMAT};
+        std::deque<std::string> m_texts;
+};
+
+TEST_F(JsonLinesSinkTests, testRenderedFields)
+{
+    JsonLinesSink sink(m_file);
+    std::string out;
+    sink.render(makeRecord("void Service::start(int)", 12, LOG_TYPE::LOG_INFO, "Starting {} workers", 8), out);
+    EXPECT_EQ("{\"timestamp\":\"2025-08-25T15:50:51.000042Z\",\"level\":\"INF\",\"tid\":\"" + getThisThreadId() +
+              "\",\"file\":\"JsonLinesSinkTest.cpp\",\"line\":12,\"class\":\"Service\",\"function\":\"start\""
+              ",\"message\":\"Starting 8 workers\"}\n", out);
+
+    // A function without a class, and the call site fields come from the cache the second time
+    out.clear();
+    sink.render(makeRecord("int main()", 7, LOG_TYPE::LOG_WARN, "Low on {}", "disk"), out);
+    sink.render(makeRecord("int main()", 7, LOG_TYPE::LOG_WARN, "Low on {}", "memory"), out);
+    auto fields = "\",\"file\":\"JsonLinesSinkTest.cpp\",\"line\":7,\"class\":\"\",\"function\":\"main\",\"message\":\"";
+    EXPECT_EQ("{\"timestamp\":\"2025-08-25T15:50:51.000042Z\",\"level\":\"WARN\",\"tid\":\"" + getThisThreadId() + fields + "Low on disk\"}\n"
+              "{\"timestamp\":\"2025-08-25T15:50:51.000042Z\",\"level\":\"WARN\",\"tid\":\"" + getThisThreadId() + fields + "Low on memory\"}\n",
+              out);
+    EXPECT_EQ(2u, sink.getCallSiteCount());
+}
+
+TEST_F(JsonLinesSinkTests, testMessagesAreEscaped)
+{
+    JsonLinesSink sink(m_file);
+    std::string out;
+    sink.render(makeRecord("void Parser::parse()", 40, LOG_TYPE::LOG_ERR, "Bad token {} in {}\n\tat col {}\x01", "}", "C:\\tmp", 3), out);
+    EXPECT_NE(std::string::npos, out.find(",\"message\":\"Bad token } in C:\\\\tmp\\n\\tat col 3\\u0001\"}\n"));
+    // One line, whatever the message has in it
+    EXPECT_EQ(out.size() - 1, out.find('\n'));
+
+    // The assertion details are part of the message
+    out.clear();
+    m_logger.setAssertCondition("ptr != nullptr");
+    sink.render(makeRecord("void Cache::get()", 88, LOG_TYPE::LOG_ASSERT, "Cache miss"), out);
+    EXPECT_NE(std::string::npos, out.find("\"level\":\"ASRT\""));
+    EXPECT_NE(std::string::npos, out.find(",\"function\":\"get\",\"message\":\"ASSERTION FAILURE in "));
+    EXPECT_NE(std::string::npos, out.find("[CONDITION: ptr != nullptr] evaluating to FALSE. Cache miss\"}\n"));
+}
+
+TEST_F(JsonLinesSinkTests, testRecordWithoutCallSite)
+{
+    JsonLinesSink sink(m_file);
+    LogRecord record;
+    record.logType = LOG_TYPE::LOG_DEFAULT;
+    record.timestamp = std::chrono::system_clock::time_point(std::chrono::seconds(0));
+    record.threadId = std::this_thread::get_id();
+    record.text = "Raw \"text\"";
+    std::string out;
+    sink.render(record, out);
+    EXPECT_EQ("{\"timestamp\":\"1970-01-01T00:00:00.000000Z\",\"level\":\"" + Logger::covertLogTypeEnumToString(LOG_TYPE::LOG_DEFAULT) +
+              "\",\"tid\":\"" + getThisThreadId() + "\",\"message\":\"Raw \\\"text\\\"\"}\n", out);
+    EXPECT_EQ(0u, sink.getCallSiteCount());
+}
+
+TEST_F(JsonLinesSinkTests, testThroughBatchSinkOps)
+{
+    constexpr size_t recordCnt = 500;
+    {
+        BatchSinkOps ops(std::make_unique<JsonLinesSink>(m_file), 64);
+        for (size_t cnt = 0; cnt < recordCnt; ++cnt)
+            ops.writeRecord(makeRecord("void Worker::run()", 21, LOG_TYPE::LOG_INFO, "Processed item {}", cnt));
+        ops.write(std::string_view("Written without a call site"));
+        ops.flushAndWait();
+        EXPECT_EQ("JsonLinesSink", ops.getSink().getName());
+    }
+
+    auto lines = readLines();
+    ASSERT_EQ(recordCnt + 1, lines.size());
+    for (size_t cnt = 0; cnt < recordCnt; ++cnt)
+    {
+        ASSERT_EQ('{', lines[cnt].front());
+        ASSERT_TRUE(lines[cnt].ends_with(",\"message\":\"Processed item " + std::to_string(cnt) + "\"}")) << lines[cnt];
+    }
+    EXPECT_TRUE(lines.back().ends_with(",\"message\":\"Written without a call site\"}"));
+}
+
+TEST_F(JsonLinesSinkTests, testRecordFields)
+{
+    JsonLinesSink sink(m_file);
+    auto record = makeRecord("void Server::handle()", 30, LOG_TYPE::LOG_INFO, "request done");
+    const std::array<LogField, 6> fields = { kv("latency_us", 1250),
+                                             kv("bytes", uint64_t(18446744073709551615u)),
+                                             kv("ratio", 0.5),
+                                             kv("cached", true),
+                                             kv("path", "/a \"b\""),
+                                             kv("score", std::numeric_limits<double>::quiet_NaN()) };
+    record.fields = fields;
+    std::string out;
+    sink.render(record, out);
+    EXPECT_TRUE(out.ends_with(",\"message\":\"request done\",\"fields\":{\"latency_us\":1250,\"bytes\":18446744073709551615,"
+                              "\"ratio\":0.5,\"cached\":true,\"path\":\"/a \\\"b\\\"\",\"score\":null}}\n")) << out;
+}
@@ -0,0 +1,132 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="LineIndexTests.*"
+
+/*
+ * LineIndexTest.cpp
+ * Unit tests for LineIndex functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the LineIndex class, covering indexing,
+ * seeking, persisting to and loading from the sidecar and the lazy rebuild.
+ */
+
+#include "LineIndex.hpp"
+#include "CommonFunc.hpp"
+
+#include <fstream>
+
+using namespace logger;
+
+class LineIndexTests : public CommonTestDataGenerator
+{
+    public:
+        /**
+         * @brief Write lines of known length into a new file
+         *
+         * @param file The file to be written
+         * @param lineCnt Number of lines
+         * @param lineLen Length of each line (without the new line)
+         */
+        static void writeLines(const std::filesystem::path& file, const size_t lineCnt, const size_t lineLen)
+        {
+            std::ofstream ofile(file, std::ios::binary | std::ios::app);
+            for (size_t cnt = 0; cnt < lineCnt; ++cnt)
+                ofile << generateRandomText(lineLen) << '\n';
+        }
+};
+
+TEST_F(LineIndexTests, testAppendAndSeekLine)
+{
+    LineIndex index(generateRandomFileName(), 4);
+    std::string data;
+    for (auto cnt = 0; cnt < 10; ++cnt)
+        data += generateRandomText(9) + "\n";    // 10 bytes a line
+    index.append(data.data(), data.size());
+
+    EXPECT_EQ(static_cast<size_t>(10), index.getLineCount());
+    EXPECT_EQ(static_cast<std::uintmax_t>(100), index.getIndexedSize());
+    // Lines 1, 5 and 9
+    std::vector<std::uintmax_t> expOffsets = { 0, 40, 80 };
+    EXPECT_EQ(expOffsets, index.getOffsets());
+
+    EXPECT_EQ(std::make_pair(std::uintmax_t(0), size_t(1)), index.seekLine(1));
+    EXPECT_EQ(std::make_pair(std::uintmax_t(0), size_t(1)), index.seekLine(4));
+    EXPECT_EQ(std::make_pair(std::uintmax_t(40), size_t(5)), index.seekLine(5));
+    EXPECT_EQ(std::make_pair(std::uintmax_t(80), size_t(9)), index.seekLine(10));
+    // Beyond the last line it is the last indexed one
+    EXPECT_EQ(std::make_pair(std::uintmax_t(80), size_t(9)), index.seekLine(100));
+}
+
+TEST_F(LineIndexTests, testPersistAndLoad)
+{
+    auto file = std::filesystem::current_path() / generateRandomFileName();
+    writeLines(file, 100, 15);
+    {
+        LineIndex index(file, 8);
+        index.refresh();
+        EXPECT_EQ(static_cast<size_t>(100), index.getLineCount());
+        EXPECT_TRUE(std::filesystem::exists(LineIndex::getIndexFilePath(file)));
+    }
+    writeLines(file, 20, 15);
+    {
+        // Loads what was persisted and indexes only the lines added after it
+        LineIndex index(file, 8);
+        index.refresh();
+        EXPECT_EQ(static_cast<size_t>(120), index.getLineCount());
+        EXPECT_EQ(std::filesystem::file_size(file), index.getIndexedSize());
+        EXPECT_EQ(static_cast<size_t>(120 / 8 + 1), index.getOffsets().size());
+        EXPECT_EQ(std::make_pair(std::uintmax_t(16 * 112), size_t(113)), index.seekLine(120));
+    }
+    {
+        // An index built with another stride is rebuilt
+        LineIndex index(file, 10);
+        index.refresh();
+        EXPECT_EQ(static_cast<size_t>(120), index.getLineCount());
+        EXPECT_EQ(static_cast<size_t>(13), index.getOffsets().size());
+        index.reset();
+        EXPECT_FALSE(std::filesystem::exists(LineIndex::getIndexFilePath(file)));
+    }
+    std::filesystem::remove(file);
+}
+
+TEST_F(LineIndexTests, testRebuildStaleIndex)
+{
+    auto file = std::filesystem::current_path() / generateRandomFileName();
+    writeLines(file, 50, 31);
+    {
+        LineIndex index(file, 4);
+        index.refresh();
+        EXPECT_EQ(static_cast<size_t>(50), index.getLineCount());
+    }
+    // Replace the file by a smaller one with longer lines
+    std::filesystem::remove(file);
+    writeLines(file, 10, 63);
+    {
+        LineIndex index(file, 4);
+        index.refresh();
+        EXPECT_EQ(static_cast<size_t>(10), index.getLineCount());
+        EXPECT_EQ(std::make_pair(std::uintmax_t(8 * 64), size_t(9)), index.seekLine(10));
+        index.reset();
+    }
+    std::filesystem::remove(file);
+}
@@ -0,0 +1,98 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="LineScannerTests.*"
+
+/*
+ * LineScannerTest.cpp
+ * Unit tests for LineScanner functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the LineScanner class, checking every
+ * supported instruction set against the scalar one, for all alignments and
+ * lengths around the vector widths.
+ */
+
+#include "LineScanner.hpp"
+#include "CommonFunc.hpp"
+
+#include <algorithm>
+
+using namespace logger;
+
+class LineScannerTests : public CommonTestDataGenerator
+{
+};
+
+TEST_F(LineScannerTests, testRuntimePick)
+{
+    EXPECT_TRUE(LineScanner::isSupported(LineScanner::Isa::SCALAR));
+    EXPECT_TRUE(LineScanner::isSupported(LineScanner::getIsa()));
+    EXPECT_EQ("AVX2", LineScanner::getIsaName(LineScanner::Isa::AVX2));
+}
+
+TEST_F(LineScannerTests, testCountNewLines)
+{
+    // Random text with some new lines sprinkled in
+    auto text = generateRandomText(1000);
+    for (size_t idx = 0; idx < text.size(); idx += (idx % 7) + 1)
+        text[idx] = '\n';
+
+    for (auto isa : getSupportedIsas())
+    {
+        for (size_t start = 0; start < 40; ++start)
+        {
+            for (size_t len = 0; start + len <= text.size(); len += (len < 140) ? 1 : 37)
+            {
+                auto begin = text.data() + start;
+                auto expCount = static_cast<size_t>(std::count(begin, begin + len, '\n'));
+                ASSERT_EQ(expCount, LineScanner::countNewLines(begin, begin + len, isa))
+                    << LineScanner::getIsaName(isa) << " start " << start << " len " << len;
+            }
+        }
+    }
+    EXPECT_EQ(static_cast<size_t>(std::count(text.begin(), text.end(), '\n')),
+              LineScanner::countNewLines(text.data(), text.data() + text.size()));
+}
+
+TEST_F(LineScannerTests, testFindNewLine)
+{
+    std::string text(300, 'x');
+    for (auto isa : getSupportedIsas())
+    {
+        // No new line at all gives the end
+        EXPECT_EQ(text.data() + text.size(), LineScanner::findNewLine(text.data(), text.data() + text.size(), isa));
+        for (size_t pos = 0; pos < 100; ++pos)
+        {
+            text[pos] = '\n';
+            text[pos + 50] = '\n';
+            for (size_t start = 0; start <= pos; ++start)
+            {
+                ASSERT_EQ(text.data() + pos, LineScanner::findNewLine(text.data() + start, text.data() + text.size(), isa))
+                    << LineScanner::getIsaName(isa) << " start " << start << " pos " << pos;
+            }
+            // A new line just past the end is not found
+            EXPECT_EQ(text.data() + pos, LineScanner::findNewLine(text.data(), text.data() + pos, isa));
+            text[pos] = 'x';
+            text[pos + 50] = 'x';
+        }
+    }
+}
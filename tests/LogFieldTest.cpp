@@ -0,0 +1,102 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="LogFieldTests.*"
+
+/*
+ * LogFieldTest.cpp
+ * Unit tests for LogField and kv() using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the key/value fields of the records:
+ * the types kv() picks for the values and the " key=value" text rendering.
+ */
+
+#include "LogField.hpp"
+#include "CommonFunc.hpp"
+
+#include <array>
+#include <limits>
+
+using namespace logger;
+
+class LogFieldTests : public CommonTestDataGenerator
+{
+    public:
+        enum class Status : uint16_t
+        {
+            OK = 200,
+            NOT_FOUND = 404
+        };
+
+        /**
+         * @brief Render fields as text
+         */
+        static std::string render(const std::span<const LogField> fields)
+        {
+            std::string out;
+            LogField::appendText(out, fields);
+            return out;
+        }
+};
+
+TEST_F(LogFieldTests, testValueTypes)
+{
+    EXPECT_EQ(LogField::Type::BOOL, kv("ok", true).getType());
+    EXPECT_EQ(LogField::Type::INT, kv("delta", -5).getType());
+    EXPECT_EQ(LogField::Type::INT, kv("small", static_cast<int8_t>(-1)).getType());
+    EXPECT_EQ(LogField::Type::UINT, kv("size", size_t(42)).getType());
+    EXPECT_EQ(LogField::Type::UINT, kv("status", Status::NOT_FOUND).getType());
+    EXPECT_EQ(404u, std::get<uint64_t>(kv("status", Status::NOT_FOUND).value));
+    EXPECT_EQ(LogField::Type::DOUBLE, kv("ratio", 0.5f).getType());
+    EXPECT_EQ(LogField::Type::STRING, kv("name", "disk").getType());
+    EXPECT_EQ(LogField::Type::STRING, kv("name", std::string("disk")).getType());
+    EXPECT_EQ(LogField::Type::STRING, kv("name", std::string_view("disk")).getType());
+    EXPECT_EQ("name", kv("name", "disk").key);
+}
+
+TEST_F(LogFieldTests, testTextRendering)
+{
+    const std::array<LogField, 7> fields = { kv("ok", false),
+                                             kv("delta", std::numeric_limits<int64_t>::min()),
+                                             kv("size", std::numeric_limits<uint64_t>::max()),
+                                             kv("ratio", 0.25),
+                                             kv("latency_us", 1250),
+                                             kv("user", "alice"),
+                                             kv("status", Status::OK) };
+    EXPECT_EQ(" ok=false delta=-9223372036854775808 size=18446744073709551615 ratio=0.25 latency_us=1250 user=alice status=200",
+              render(fields));
+    EXPECT_EQ("", render({}));
+}
+
+TEST_F(LogFieldTests, testStringsAreQuotedWhenNeeded)
+{
+    const std::array<LogField, 5> fields = { kv("empty", ""),
+                                             kv("path", "/tmp/a b"),
+                                             kv("expr", "a=b"),
+                                             kv("quote", "say \"hi\" \\o/"),
+                                             kv("lines", "one\ntwo\tthree") };
+    EXPECT_EQ(" empty=\"\" path=\"/tmp/a b\" expr=\"a=b\" quote=\"say \\\"hi\\\" \\\\o/\" lines=\"one\\ntwo\\tthree\"",
+              render(fields));
+    // A backslash alone does not need quotes
+    const std::array<LogField, 1> dir = { kv("dir", "C:\\tmp") };
+    EXPECT_EQ(" dir=C:\\tmp", render(dir));
+}
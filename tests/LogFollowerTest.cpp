@@ -0,0 +1,192 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="LogFollowerTests.*"
+
+/*
+ * LogFollowerTest.cpp
+ * Unit tests for LogFollower functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the LogFollower class: following appends,
+ * partial lines, rotations (by hand and by FileOps) and resuming from a
+ * checkpoint taken before a rotation.
+ */
+
+#include "LogFollower.hpp"
+#include "FileOps.hpp"
+#include "CommonFunc.hpp"
+
+#include <fstream>
+#include <condition_variable>
+
+using namespace logger;
+
+class LogFollowerTests : public CommonTestDataGenerator
+{
+    public:
+        void SetUp() override
+        {
+            m_dirPath = std::filesystem::current_path() / generateRandomFileName("tmp_", "_follow");
+            std::filesystem::create_directories(m_dirPath);
+            m_filePath = m_dirPath / "app.log";
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(m_dirPath);
+        }
+
+        /**
+         * @brief Append text to a file, as is
+         */
+        static void appendText(const std::filesystem::path& file, const std::string& text)
+        {
+            std::ofstream ofile(file, std::ios::binary | std::ios::app);
+            ofile << text;
+        }
+
+        /**
+         * @brief The callback of the follower, collects the lines
+         */
+        LogFollower::LineCallback getCollector()
+        {
+            return [this](std::string_view line, const LogFollower::Checkpoint&)
+            {
+                std::scoped_lock<std::mutex> lock(m_linesMtx);
+                m_lines.emplace_back(line);
+                m_linesCv.notify_all();
+            };
+        }
+
+        /**
+         * @brief Wait until the given number of lines is collected
+         *
+         * @return std::vector<std::string> The lines collected
+         */
+        std::vector<std::string> waitForLines(const size_t lineCnt)
+        {
+            std::unique_lock<std::mutex> lock(m_linesMtx);
+            m_linesCv.wait_for(lock, std::chrono::seconds(10), [this, lineCnt] { return m_lines.size() >= lineCnt; });
+            return m_lines;
+        }
+
+    protected:
+        std::filesystem::path m_dirPath;
+        std::filesystem::path m_filePath;
+        std::vector<std::string> m_lines;
+        std::mutex m_linesMtx;
+        std::condition_variable m_linesCv;
+};
+
+TEST_F(LogFollowerTests, testFollowAppends)
+{
+    appendText(m_filePath, "first\nsecond\n");
+    LogFollower follower(m_filePath, getCollector(), LogFollower::Checkpoint(), std::chrono::milliseconds(50));
+    ASSERT_TRUE(follower.start());
+    EXPECT_FALSE(follower.start());
+    EXPECT_EQ((std::vector<std::string>{ "first", "second" }), waitForLines(2));
+
+    // A line is delivered once it is complete
+    appendText(m_filePath, "thi");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    appendText(m_filePath, "rd\n");
+    EXPECT_EQ((std::vector<std::string>{ "first", "second", "third" }), waitForLines(3));
+
+    follower.stop();
+    EXPECT_FALSE(follower.isRunning());
+    auto checkpoint = follower.getCheckpoint();
+    EXPECT_EQ(std::filesystem::file_size(m_filePath), checkpoint.offset);
+    EXPECT_NE(static_cast<std::uint64_t>(0), checkpoint.inode);
+    EXPECT_TRUE(follower.getAllExceptions().empty());
+}
+
+TEST_F(LogFollowerTests, testFollowAcrossRotation)
+{
+    // Follow a file which does not exist yet
+    LogFollower follower(m_filePath, getCollector(), LogFollower::Checkpoint(), std::chrono::milliseconds(50));
+    ASSERT_TRUE(follower.start());
+    appendText(m_filePath, "one\n");
+    EXPECT_EQ(static_cast<size_t>(1), waitForLines(1).size());
+
+    // Rotated twice before the follower gets to read again
+    std::filesystem::rename(m_filePath, m_dirPath / "app_25082025_100000.log");
+    appendText(m_dirPath / "app_25082025_100000.log", "two\nthree");
+    appendText(m_filePath, "four\n");
+    std::filesystem::rename(m_filePath, m_dirPath / "app_25082025_100000_1.log");
+    appendText(m_filePath, "five\nsix\n");
+
+    std::vector<std::string> expLines = { "one", "two", "three", "four", "five", "six" };
+    EXPECT_EQ(expLines, waitForLines(expLines.size()));
+
+    // Truncated, read again from the beginning
+    FileOps::clearFile(m_filePath);
+    appendText(m_filePath, "seven\n");
+    expLines.push_back("seven");
+    EXPECT_EQ(expLines, waitForLines(expLines.size()));
+}
+
+TEST_F(LogFollowerTests, testResumeFromCheckpoint)
+{
+    auto checkpointFile = m_dirPath / "follower.ckpt";
+    appendText(m_filePath, "one\ntwo\n");
+    {
+        LogFollower follower(m_filePath, getCollector());
+        ASSERT_TRUE(follower.start());
+        EXPECT_EQ(static_cast<size_t>(2), waitForLines(2).size());
+        follower.stop();
+        ASSERT_TRUE(LogFollower::saveCheckpoint(checkpointFile, follower.getCheckpoint()));
+    }
+
+    // Meanwhile the log grows and gets rotated
+    appendText(m_filePath, "three\n");
+    std::filesystem::rename(m_filePath, m_dirPath / "app_25082025_100000.log");
+    appendText(m_filePath, "four\n");
+
+    m_lines.clear();
+    auto checkpoint = LogFollower::loadCheckpoint(checkpointFile);
+    EXPECT_EQ(static_cast<std::uint64_t>(8), checkpoint.offset);
+    LogFollower follower(m_filePath, getCollector(), checkpoint);
+    ASSERT_TRUE(follower.start());
+    EXPECT_EQ((std::vector<std::string>{ "three", "four" }), waitForLines(2));
+
+    EXPECT_EQ(LogFollower::Checkpoint(), LogFollower::loadCheckpoint(m_dirPath / "missing.ckpt"));
+}
+
+TEST_F(LogFollowerTests, testFollowFileOps)
+{
+    std::uintmax_t maxFileSize = 4096;
+    std::vector<std::string> expLines;
+    {
+        FileOps fileOps(maxFileSize, "app", m_dirPath.string(), ".log");
+        LogFollower follower(fileOps, getCollector(), LogFollower::Checkpoint(), std::chrono::milliseconds(50));
+        ASSERT_TRUE(follower.start());
+        for (auto cnt = 0; cnt < 200; ++cnt)
+        {
+            expLines.push_back(std::to_string(cnt) + " " + generateRandomText(100));
+            fileOps.append(expLines.back());
+        }
+        fileOps.flushAndWait();
+        EXPECT_EQ(expLines, waitForLines(expLines.size()));
+    }
+    // It did rotate
+    EXPECT_GT(std::distance(std::filesystem::directory_iterator(m_dirPath), std::filesystem::directory_iterator()), 1);
+}
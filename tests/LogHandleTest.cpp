@@ -0,0 +1,198 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="LogHandleTests.*"
+
+/*
+ * LogHandleTest.cpp
+ * Unit tests for LogHandle class using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the logger instances: handles with
+ * sinks of their own logging side by side from several threads, the
+ * default instance behind the LOG_* macros, and the LOG_*_ON macros.
+ */
+
+#include "LOGGER_MACROS.hpp"
+#include "BatchSinkOps.hpp"
+#include "CommonFunc.hpp"
+
+#include <future>
+#include <thread>
+
+using namespace logger;
+
+class LogHandleTests : public CommonTestDataGenerator
+{
+    public:
+        /**
+         * @brief Make a LogHandle over a BatchSinkOps with a TextSink
+         */
+        static std::unique_ptr<LogHandle> makeHandle()
+        {
+            return std::make_unique<LogHandle>(std::make_unique<BatchSinkOps>(std::make_unique<TextSink>()));
+        }
+
+        /**
+         * @brief Get the texts the sink of a handle made by makeHandle() got so far
+         */
+        static std::vector<std::string> getTexts(LogHandle& handle)
+        {
+            handle.flushAndWait();
+            auto& ops = dynamic_cast<BatchSinkOps&>(handle.getOps());
+            return dynamic_cast<TextSink&>(ops.getSink()).getTexts();
+        }
+};
+
+TEST_F(LogHandleTests, testRecordsRendered)
+{
+    auto handle = makeHandle();
+    handle->log(__FILE__, __PRETTY_FUNCTION__, __LINE__, LOG_TYPE::LOG_WARN, "Pool of {} exhausted", 8);
+    handle->logKv(__FILE__, __PRETTY_FUNCTION__, __LINE__, LOG_TYPE::LOG_INFO, "Request done", kv("status", 200));
+
+    auto texts = getTexts(*handle);
+    ASSERT_EQ(2u, texts.size());
+    EXPECT_NE(texts[0].find("| LogHandleTest.cpp"), std::string::npos) << texts[0];
+    EXPECT_NE(texts[0].find("|WARN>"), std::string::npos) << texts[0];
+    EXPECT_TRUE(texts[0].ends_with("Pool of 8 exhausted")) << texts[0];
+    EXPECT_TRUE(texts[1].ends_with("Request done status=200")) << texts[1];
+}
+
+TEST_F(LogHandleTests, testIndependentInstances)
+{
+    constexpr size_t threadCnt = 4;
+    constexpr size_t msgCnt = 500;
+    std::vector<std::unique_ptr<LogHandle>> handles;
+    for (size_t idx = 0; idx < threadCnt; ++idx)
+        handles.push_back(makeHandle());
+
+    std::vector<std::thread> threads;
+    for (size_t idx = 0; idx < threadCnt; ++idx)
+    {
+        threads.emplace_back([&handle = *handles[idx], idx]()
+        {
+            for (size_t msgNo = 0; msgNo < msgCnt; ++msgNo)
+                LOG_INFO_ON(handle, "Pipeline {} message {}", idx, msgNo);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    // Each handle got its own messages, all of them and in order
+    for (size_t idx = 0; idx < threadCnt; ++idx)
+    {
+        auto texts = getTexts(*handles[idx]);
+        ASSERT_EQ(msgCnt, texts.size());
+        for (size_t msgNo = 0; msgNo < msgCnt; ++msgNo)
+        {
+            EXPECT_TRUE(texts[msgNo].ends_with("Pipeline " + std::to_string(idx) + " message " + std::to_string(msgNo)))
+                << texts[msgNo];
+        }
+    }
+}
+
+TEST_F(LogHandleTests, testLevelCheckedBeforeArguments)
+{
+    auto handle = makeHandle();
+    handle->getOps().setLevelThreshold(LOG_TYPE::LOG_WARN);
+    size_t evaluatedCnt = 0;
+    auto evaluate = [&evaluatedCnt]() { return ++evaluatedCnt; };
+    LOG_INFO_ON(*handle, "Dropped {}", evaluate());
+    // A single statement, as the branch of an if
+    if (evaluatedCnt == 0)
+        LOG_ERR_ON(*handle, "Kept {}", evaluate());
+    else
+        LOG_WARN_ON(*handle, "Never {}", evaluate());
+    EXPECT_EQ(1u, evaluatedCnt);
+
+    auto texts = getTexts(*handle);
+    ASSERT_EQ(1u, texts.size());
+    EXPECT_TRUE(texts[0].ends_with("Kept 1")) << texts[0];
+}
+
+TEST_F(LogHandleTests, testFatalWaitedForOutsideFormatter)
+{
+    /**
+     * @brief Holds up the records until it gets opened
+     */
+    class GatedSink : public TextSink
+    {
+        public:
+            void consume(std::span<const LogRecord> records) override
+            {
+                m_entered = true;
+                while (!m_open)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                TextSink::consume(records);
+            }
+
+            bool isEntered() const  { return m_entered; }
+            void open()             { m_open = true; }
+
+        private:
+            std::atomic_bool m_entered = false;
+            std::atomic_bool m_open = false;
+    };
+
+    auto pSink = std::make_unique<GatedSink>();
+    auto& sink = *pSink;
+    LogHandle handle(std::make_unique<BatchSinkOps>(std::move(pSink)));
+    std::thread fatalThread([&handle]()
+    {
+        handle.log(__FILE__, __PRETTY_FUNCTION__, __LINE__, LOG_TYPE::LOG_FATAL, "Going down");
+    });
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!sink.isEntered() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_TRUE(sink.isEntered());
+
+    // The other threads keep logging while the fatal one waits for the sink
+    auto other = std::async(std::launch::async, [&handle]()
+    {
+        handle.log(__FILE__, __PRETTY_FUNCTION__, __LINE__, LOG_TYPE::LOG_INFO, "Still logging");
+    });
+    EXPECT_EQ(std::future_status::ready, other.wait_for(std::chrono::seconds(2)));
+    sink.open();
+    fatalThread.join();
+
+    // Written before the fatal call returned
+    auto texts = sink.getTexts();
+    ASSERT_FALSE(texts.empty());
+    EXPECT_TRUE(texts[0].ends_with("Going down")) << texts[0];
+    other.get();
+}
+
+TEST_F(LogHandleTests, testDefaultInstance)
+{
+    // The sink the LOG_* macros write to
+    EXPECT_EQ(&LogHandle::getDefault().getOps(), &loggingOps);
+    EXPECT_EQ(&LogHandle::getDefault().getOps(), &Logger::buildLoggingOpsObject());
+
+    // A handle of one's own out of the settings, with sinks of its own
+    LoggerConfig config;
+    config.consoleLevel = LOG_TYPE::LOG_ERR;
+    LogHandle handle(config);
+    EXPECT_NE(&handle.getOps(), &loggingOps);
+    EXPECT_EQ(LOG_TYPE::LOG_ERR, handle.getOps().getLevelThreshold());
+    EXPECT_FALSE(handle.isEnabled(LOG_TYPE::LOG_WARN));
+
+    EXPECT_THROW(LogHandle(std::unique_ptr<LoggingOps>()), std::invalid_argument);
+}
@@ -0,0 +1,78 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="LogLineTests.*"
+
+/*
+ * LogLineTest.cpp
+ * Unit tests for the LogLine parser using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the LogLine struct, parsing the prefixes
+ * the Logger writes as well as lines which are not log records.
+ */
+
+#include "LogLine.hpp"
+#include "CommonFunc.hpp"
+
+using namespace logger;
+
+class LogLineTests : public CommonTestDataGenerator
+{
+};
+
+TEST_F(LogLineTests, testParsePrefix)
+{
+    LogLine logLine;
+    ASSERT_TRUE(LogLine::parse("|20250825_155051| 140245563983680| LoggerTest.cpp      |   84|INF>> [Class : func] Hello | world", logLine));
+    EXPECT_EQ("20250825_155051", logLine.timestamp);
+    EXPECT_EQ("140245563983680", logLine.threadId);
+    EXPECT_EQ("LoggerTest.cpp", logLine.fileName);
+    EXPECT_EQ(static_cast<size_t>(84), logLine.lineNo);
+    EXPECT_EQ(LOG_TYPE::LOG_INFO, logLine.logType);
+    EXPECT_EQ(">>", logLine.marker);
+    EXPECT_EQ("[Class : func] Hello | world", logLine.message);
+
+    ASSERT_TRUE(LogLine::parse("|20250825_155051| 0x16bd8f000| ProducerConsumer.cpp|   31|ASRT<< ", logLine));
+    EXPECT_EQ("0x16bd8f000", logLine.threadId);
+    EXPECT_EQ(LOG_TYPE::LOG_ASSERT, logLine.logType);
+    EXPECT_EQ("<<", logLine.marker);
+    EXPECT_TRUE(logLine.message.empty());
+
+    ASSERT_TRUE(LogLine::parse("|20250825_155051|          7| a.cpp               | 1234|FATAL> boom", logLine));
+    EXPECT_EQ("7", logLine.threadId);
+    EXPECT_EQ(static_cast<size_t>(1234), logLine.lineNo);
+    EXPECT_EQ(LOG_TYPE::LOG_FATAL, logLine.logType);
+    EXPECT_EQ("boom", logLine.message);
+}
+
+TEST_F(LogLineTests, testParseNonRecords)
+{
+    LogLine logLine;
+    EXPECT_FALSE(LogLine::parse("", logLine));
+    EXPECT_FALSE(LogLine::parse("a continuation line", logLine));
+    EXPECT_FALSE(LogLine::parse("|20250825_155051| 7| a.cpp| 12", logLine));
+    EXPECT_FALSE(LogLine::parse("|20250825_155051| 7| a.cpp| 1x|INF> msg", logLine));
+    EXPECT_FALSE(LogLine::parse("|20250825_155051| 7| a.cpp| 12|NOPE> msg", logLine));
+    EXPECT_FALSE(LogLine::parse("|| 7| a.cpp| 12|INF> msg", logLine));
+    EXPECT_TRUE(LogLine::parse("|20250825_155051| 7| a.cpp| 12|DEFAULT> msg", logLine));
+    EXPECT_EQ(LOG_TYPE::LOG_DEFAULT, logLine.logType);
+}
@@ -0,0 +1,263 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="LogSamplerTests.*"
+
+/*
+ * LogSamplerTest.cpp
+ * Unit tests for the per callsite samplers using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for EveryN, FirstN, EveryInterval and
+ * TokenBucket, alone and hammered by several threads, the suppressed
+ * counts appended to the records, and the LOG_EVERY_N and co. macros, with
+ * literal and variable arguments.
+ */
+
+#include "LOGGER_MACROS.hpp"
+#include "BatchSinkOps.hpp"
+#include "CommonFunc.hpp"
+
+#include <thread>
+
+using namespace logger;
+
+class LogSamplerTests : public CommonTestDataGenerator
+{
+    public:
+        /**
+         * @brief Call a sampler a number of times
+         *
+         * @param [in] sampler The sampler
+         * @param [in] callCnt The number of calls
+         * @return std::vector<std::pair<size_t, uint64_t>> The calls let through,
+         *         each as its index along with the suppressed count it got
+         */
+        template<typename Sampler>
+        static std::vector<std::pair<size_t, uint64_t>> callSampler(Sampler& sampler, const size_t callCnt)
+        {
+            std::vector<std::pair<size_t, uint64_t>> passed;
+            for (size_t idx = 0; idx < callCnt; ++idx)
+            {
+                uint64_t suppressed = UINT64_MAX;
+                if (sampler.shouldLog(suppressed))
+                    passed.emplace_back(idx, suppressed);
+                else
+                    EXPECT_EQ(UINT64_MAX, suppressed);
+            }
+            return passed;
+        }
+
+        /**
+         * @brief Hammer a sampler from several threads, then let one more call
+         * through once it calmed down, so that it reports what was left
+         *
+         * @param [in] sampler The sampler
+         * @param [in] calmDown How long it takes to let a call through again
+         * @return std::pair<uint64_t, uint64_t> The calls let through and the
+         *         sum of the suppressed counts they got
+         */
+        template<typename Sampler>
+        static std::pair<uint64_t, uint64_t> hammerSampler(Sampler& sampler, const std::chrono::milliseconds calmDown)
+        {
+            std::atomic<uint64_t> passedCnt(0);
+            std::atomic<uint64_t> suppressedSum(0);
+            auto call = [&]()
+            {
+                uint64_t suppressed = 0;
+                if (sampler.shouldLog(suppressed))
+                {
+                    ++passedCnt;
+                    suppressedSum += suppressed;
+                }
+            };
+
+            std::vector<std::thread> threads;
+            for (size_t thrd = 0; thrd < threadCnt; ++thrd)
+            {
+                threads.emplace_back([&call]()
+                {
+                    for (size_t idx = 0; idx < callsPerThread; ++idx)
+                        call();
+                });
+            }
+            for (auto& thread : threads)
+                thread.join();
+
+            std::this_thread::sleep_for(calmDown);
+            call();
+            return { passedCnt.load(), suppressedSum.load() };
+        }
+
+        static constexpr size_t threadCnt = 4;
+        static constexpr size_t callsPerThread = 20000;
+};
+
+TEST_F(LogSamplerTests, testEveryN)
+{
+    EveryN everyThird(3);
+    std::vector<std::pair<size_t, uint64_t>> expected = { {0, 0}, {3, 2}, {6, 2}, {9, 2} };
+    EXPECT_EQ(expected, callSampler(everyThird, 11));
+
+    // 0 is taken as 1, everything gets through
+    EveryN everyOne(0);
+    EXPECT_EQ(5u, callSampler(everyOne, 5).size());
+}
+
+TEST_F(LogSamplerTests, testFirstN)
+{
+    FirstN firstTwo(2);
+    std::vector<std::pair<size_t, uint64_t>> expected = { {0, 0}, {1, 0} };
+    EXPECT_EQ(expected, callSampler(firstTwo, 10));
+
+    FirstN none(0);
+    EXPECT_TRUE(callSampler(none, 10).empty());
+}
+
+TEST_F(LogSamplerTests, testEveryInterval)
+{
+    EveryInterval everyInterval(std::chrono::milliseconds(200));
+    std::vector<std::pair<size_t, uint64_t>> expected = { {0, 0} };
+    EXPECT_EQ(expected, callSampler(everyInterval, 6));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    uint64_t suppressed = 0;
+    EXPECT_TRUE(everyInterval.shouldLog(suppressed));
+    EXPECT_EQ(5u, suppressed);
+    EXPECT_FALSE(everyInterval.shouldLog(suppressed));
+}
+
+TEST_F(LogSamplerTests, testTokenBucket)
+{
+    // One token every 100 ms, three at once at most
+    TokenBucket tokenBucket(10, 3);
+    std::vector<std::pair<size_t, uint64_t>> expected = { {0, 0}, {1, 0}, {2, 0} };
+    EXPECT_EQ(expected, callSampler(tokenBucket, 8));
+
+    // One token back, not a burst
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    uint64_t suppressed = 0;
+    EXPECT_TRUE(tokenBucket.shouldLog(suppressed));
+    EXPECT_EQ(5u, suppressed);
+    EXPECT_FALSE(tokenBucket.shouldLog(suppressed));
+
+    // The whole burst back
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    EXPECT_EQ(3u, callSampler(tokenBucket, 10).size());
+}
+
+TEST_F(LogSamplerTests, testConcurrentCallsAccountedFor)
+{
+    constexpr uint64_t totalCalls = threadCnt * callsPerThread + 1;
+
+    EveryN everyN(7);
+    auto [everyNPassed, everyNSuppressed] = hammerSampler(everyN, std::chrono::milliseconds(0));
+    EXPECT_EQ((totalCalls + 6) / 7, everyNPassed);
+
+    // Every call is either let through or reported by a later one let through
+    EveryInterval everyInterval(std::chrono::milliseconds(1));
+    auto [intervalPassed, intervalSuppressed] = hammerSampler(everyInterval, std::chrono::milliseconds(5));
+    EXPECT_EQ(totalCalls, intervalPassed + intervalSuppressed);
+
+    TokenBucket tokenBucket(1000, 10);
+    auto [bucketPassed, bucketSuppressed] = hammerSampler(tokenBucket, std::chrono::milliseconds(5));
+    EXPECT_EQ(totalCalls, bucketPassed + bucketSuppressed);
+    EXPECT_LT(bucketPassed, totalCalls);
+}
+
+TEST_F(LogSamplerTests, testSuppressedCountAppended)
+{
+    auto ops = std::make_shared<BatchSinkOps>(std::make_unique<TextSink>());
+    EveryN everyThird(3);
+    for (size_t idx = 0; idx < 7; ++idx)
+    {
+        uint64_t suppressed = 0;
+        if (everyThird.shouldLog(suppressed))
+            logSampledTo(*ops, __FILE__, __PRETTY_FUNCTION__, __LINE__, LOG_TYPE::LOG_WARN, suppressed, "Call {}", idx);
+    }
+    ops->flushAndWait();
+
+    auto texts = dynamic_cast<TextSink&>(ops->getSink()).getTexts();
+    ASSERT_EQ(3u, texts.size());
+    EXPECT_TRUE(texts[0].ends_with("Call 0")) << texts[0];
+    EXPECT_TRUE(texts[1].ends_with("Call 3 suppressed=2")) << texts[1];
+    EXPECT_TRUE(texts[2].ends_with("Call 6 suppressed=2")) << texts[2];
+}
+
+TEST_F(LogSamplerTests, testSuppressedCallsNotFormatted)
+{
+    size_t evaluatedCnt = 0;
+    auto evaluate = [&evaluatedCnt]() { return ++evaluatedCnt; };
+
+    for (size_t idx = 0; idx < 10; ++idx)
+        LOG_EVERY_N(LOG_TYPE::LOG_INFO, 4, "Every 4th call, evaluated {} times", evaluate());
+    EXPECT_EQ(3u, evaluatedCnt);
+
+    evaluatedCnt = 0;
+    for (size_t idx = 0; idx < 10; ++idx)
+        LOG_FIRST_N(LOG_TYPE::LOG_INFO, 2, "First 2 calls, evaluated {} times", evaluate());
+    EXPECT_EQ(2u, evaluatedCnt);
+
+    evaluatedCnt = 0;
+    for (size_t idx = 0; idx < 10; ++idx)
+        LOG_EVERY_MS(LOG_TYPE::LOG_INFO, 60000, "Once a minute, evaluated {} times", evaluate());
+    EXPECT_EQ(1u, evaluatedCnt);
+
+    evaluatedCnt = 0;
+    for (size_t idx = 0; idx < 10; ++idx)
+    {
+        // A single statement, as the branch of an if
+        if (idx < 10)
+            LOG_RATE_LIMITED(LOG_TYPE::LOG_INFO, 0.01, 2, "Rate limited, evaluated {} times", evaluate());
+        else
+            LOG_EVERY_N(LOG_TYPE::LOG_INFO, 1, "Never evaluated {} times", evaluate());
+    }
+    EXPECT_EQ(2u, evaluatedCnt);
+}
+
+TEST_F(LogSamplerTests, testMacrosWithVariableArguments)
+{
+    size_t evaluatedCnt = 0;
+    auto evaluate = [&evaluatedCnt]() { return ++evaluatedCnt; };
+    int count = 4;
+    int intervalMs = 60000;
+    int perSecond = 1;
+    int burst = 2;
+
+    for (size_t idx = 0; idx < 10; ++idx)
+        LOG_EVERY_N(LOG_TYPE::LOG_INFO, count, "Every {}th call, evaluated {} times", count, evaluate());
+    EXPECT_EQ(3u, evaluatedCnt);
+
+    evaluatedCnt = 0;
+    for (size_t idx = 0; idx < 10; ++idx)
+        LOG_FIRST_N(LOG_TYPE::LOG_INFO, count, "First {} calls, evaluated {} times", count, evaluate());
+    EXPECT_EQ(4u, evaluatedCnt);
+
+    evaluatedCnt = 0;
+    for (size_t idx = 0; idx < 10; ++idx)
+        LOG_EVERY_MS(LOG_TYPE::LOG_WARN, intervalMs, "Once every {} ms, evaluated {} times", intervalMs, evaluate());
+    EXPECT_EQ(1u, evaluatedCnt);
+
+    evaluatedCnt = 0;
+    for (size_t idx = 0; idx < 10; ++idx)
+        LOG_RATE_LIMITED(LOG_TYPE::LOG_INFO, perSecond, burst, "Rate limited, evaluated {} times", evaluate());
+    EXPECT_EQ(2u, evaluatedCnt);
+}
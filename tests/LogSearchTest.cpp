@@ -0,0 +1,223 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="LogSearchTests.*"
+
+/*
+ * LogSearchTest.cpp
+ * Unit tests for LogSearch functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the LogSearch class, over a log file and
+ * its rotated archives: discovery of the archives, literal and regex matching,
+ * the filters on the log prefix and the time stamp ordering of the results.
+ */
+
+#include "LogSearch.hpp"
+#include "CommonFunc.hpp"
+
+#include <regex>
+#include <fstream>
+
+using namespace logger;
+
+class LogSearchTests : public CommonTestDataGenerator
+{
+    public:
+        void SetUp() override
+        {
+            m_dirPath = std::filesystem::current_path() / generateRandomFileName("tmp_", "_search");
+            std::filesystem::create_directories(m_dirPath);
+            m_baseFile = m_dirPath / "app.log";
+
+            // Archives are written older first, with their modification times set accordingly
+            auto now = std::filesystem::file_time_type::clock::now();
+            writeLog(m_dirPath / "app_25082025_100000.log", now - std::chrono::hours(3),
+            {
+                "|20250825_090000|          1| a.cpp               |   10|INF>  [A : run] started",
+                "|20250825_093000|          2| a.cpp               |   20|ERR>  [A : run] timeout while connecting",
+                "  continuation of the timeout",
+            });
+            writeLog(m_dirPath / "app_25082025_110000.log", now - std::chrono::hours(2),
+            {
+                "|20250825_103000|          1| b.cpp               |   30|WARN> [B : run] Timeout is near",
+                "|20250825_104500|          2| b.cpp               |   40|DBG>  [B : run] retrying",
+            });
+            writeLog(m_dirPath / "app_25082025_110000_1.log", now - std::chrono::hours(1),
+            {
+                "|20250825_105900|          1| b.cpp               |   50|FATAL> [B : run] timeout again",
+            });
+            writeLog(m_baseFile, now,
+            {
+                "|20250825_110500|          2| c.cpp               |   60|INF>  [C : run] done",
+                "|20250825_120000|          1| c.cpp               |   70|ERR>  [C : run] late timeout",
+            });
+            // Neither of these is an archive of app.log
+            writeLog(m_dirPath / "other_25082025_100000.log", now, { "|20250825_090000| 1| a.cpp| 1|ERR> timeout" });
+            writeLog(m_dirPath / "app_backup.log", now, { "|20250825_090000| 1| a.cpp| 1|ERR> timeout" });
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(m_dirPath);
+        }
+
+        /**
+         * @brief Write the lines into a new file and set its modification time
+         *
+         * @param file The file to be written
+         * @param writeTime Its modification time
+         * @param lines The lines to be written
+         */
+        static void writeLog(const std::filesystem::path& file,
+                             const std::filesystem::file_time_type writeTime,
+                             const std::vector<std::string>& lines)
+        {
+            {
+                std::ofstream ofile(file, std::ios::binary | std::ios::trunc);
+                for (const auto& line : lines)
+                    ofile << line << '\n';
+            }
+            std::filesystem::last_write_time(file, writeTime);
+        }
+
+        /**
+         * @brief Get the time stamps of the matches
+         */
+        static std::vector<std::string> getTimestamps(const std::vector<SearchMatch>& matches)
+        {
+            std::vector<std::string> timestamps;
+            for (const auto& match : matches)
+                timestamps.push_back(match.timestamp);
+            return timestamps;
+        }
+
+    protected:
+        std::filesystem::path m_dirPath;
+        std::filesystem::path m_baseFile;
+};
+
+TEST_F(LogSearchTests, testDiscoverFiles)
+{
+    auto files = LogSearch::discoverFiles(m_baseFile);
+    std::vector<std::filesystem::path> expFiles =
+    {
+        m_dirPath / "app_25082025_100000.log",
+        m_dirPath / "app_25082025_110000.log",
+        m_dirPath / "app_25082025_110000_1.log",
+        m_baseFile
+    };
+    EXPECT_EQ(expFiles, files);
+
+    EXPECT_TRUE(LogSearch::discoverFiles(m_dirPath / "missing.log").empty());
+}
+
+TEST_F(LogSearchTests, testDiscoverFilesOfTheSameModificationTime)
+{
+    // Rotated faster than the file system tells the times apart
+    auto baseFile = m_dirPath / "fast.log";
+    auto writeTime = std::filesystem::file_time_type::clock::now();
+    std::vector<std::filesystem::path> expFiles;
+    for (auto name : { "fast_31122025_235959.log", "fast_31122025_235959_2.log", "fast_31122025_235959_10.log",
+                       "fast_01012026_000000.log", "fast_01012026_000000_1.log" })
+    {
+        expFiles.push_back(m_dirPath / name);
+        writeLog(expFiles.back(), writeTime, { "|20251231_235959| 1| a.cpp| 1|INF> rotated" });
+    }
+    writeLog(baseFile, writeTime, { "|20260101_000000| 1| a.cpp| 1|INF> current" });
+    expFiles.push_back(baseFile);
+    EXPECT_EQ(expFiles, LogSearch::discoverFiles(baseFile));
+}
+
+TEST_F(LogSearchTests, testLiteralAndRegexSearch)
+{
+    for (size_t threadCnt : { 1, 4 })
+    {
+        SearchQuery query;
+        query.pattern = "timeout";
+        auto matches = LogSearch(query, threadCnt).search(m_baseFile);
+        std::vector<std::string> expTimestamps = { "20250825_093000", "20250825_093000", "20250825_105900", "20250825_120000" };
+        EXPECT_EQ(expTimestamps, getTimestamps(matches));
+        ASSERT_EQ(static_cast<size_t>(4), matches.size());
+        // The continuation line carries the time stamp of its record
+        EXPECT_EQ(m_dirPath / "app_25082025_100000.log", matches[1].file);
+        EXPECT_EQ(static_cast<size_t>(3), matches[1].lineNo);
+        EXPECT_EQ("  continuation of the timeout", matches[1].line);
+        EXPECT_EQ(m_baseFile, matches[3].file);
+        EXPECT_EQ(static_cast<size_t>(2), matches[3].lineNo);
+
+        query.ignoreCase = true;
+        EXPECT_EQ(static_cast<size_t>(5), LogSearch(query, threadCnt).search(m_baseFile).size());
+
+        query.pattern = R"(\] (late )?timeout (while|again))";
+        query.regex = true;
+        query.ignoreCase = false;
+        expTimestamps = { "20250825_093000", "20250825_105900" };
+        EXPECT_EQ(expTimestamps, getTimestamps(LogSearch(query, threadCnt).search(m_baseFile)));
+    }
+
+    SearchQuery query;
+    query.pattern = "(unbalanced";
+    query.regex = true;
+    EXPECT_THROW(LogSearch{query}, std::regex_error);
+    // Taken literally unless asked for a regex
+    query.regex = false;
+    EXPECT_TRUE(LogSearch(query).search(m_baseFile).empty());
+}
+
+TEST_F(LogSearchTests, testPrefixFilters)
+{
+    SearchQuery query;
+    query.levels = { LOG_TYPE::LOG_ERR, LOG_TYPE::LOG_FATAL };
+    auto matches = LogSearch(query).search(m_baseFile);
+    std::vector<std::string> expTimestamps = { "20250825_093000", "20250825_093000", "20250825_105900", "20250825_120000" };
+    EXPECT_EQ(expTimestamps, getTimestamps(matches));
+
+    query.levels.clear();
+    query.since = "20250825_100000";
+    query.until = "20250825_11";
+    expTimestamps = { "20250825_103000", "20250825_104500", "20250825_105900", "20250825_110500" };
+    EXPECT_EQ(expTimestamps, getTimestamps(LogSearch(query).search(m_baseFile)));
+
+    query.threadId = "2";
+    expTimestamps = { "20250825_104500", "20250825_110500" };
+    EXPECT_EQ(expTimestamps, getTimestamps(LogSearch(query).search(m_baseFile)));
+
+    query = SearchQuery();
+    query.pattern = "timeout";
+    query.threadId = "1";
+    query.levels = { LOG_TYPE::LOG_ERR };
+    expTimestamps = { "20250825_120000" };
+    EXPECT_EQ(expTimestamps, getTimestamps(LogSearch(query).search(m_baseFile)));
+}
+
+TEST_F(LogSearchTests, testMaxResults)
+{
+    SearchQuery query;
+    query.maxResults = 3;
+    auto matches = LogSearch(query, 4).search(m_baseFile);
+    std::vector<std::string> expTimestamps = { "20250825_090000", "20250825_093000", "20250825_093000" };
+    EXPECT_EQ(expTimestamps, getTimestamps(matches));
+
+    // An empty query matches every line of every file
+    query.maxResults = 0;
+    EXPECT_EQ(static_cast<size_t>(8), LogSearch(query).search(m_baseFile).size());
+}
@@ -0,0 +1,311 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="LoggerConfigTests.*"
+
+/*
+ * LoggerConfigTest.cpp
+ * Unit tests for LoggerConfig functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the LoggerConfig struct: the parsing of
+ * the settings, the config file, the environment overriding it and the
+ * LoggingOps objects made out of the settings.
+ */
+
+#include "LoggerConfig.hpp"
+#include "Logger.hpp"
+#include "ConsoleOps.hpp"
+#include "FileOps.hpp"
+#include "MultiSinkOps.hpp"
+#include "CoalescingOps.hpp"
+#include "BatchSinkOps.hpp"
+#include "CommonFunc.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <filesystem>
+
+using namespace logger;
+
+class LoggerConfigTests : public CommonTestDataGenerator
+{
+    public:
+        void SetUp() override
+        {
+            m_configFile = generateRandomFileName("tmp_", ".conf");
+        }
+
+        void TearDown() override
+        {
+            for (auto name : { "FILE_SIZE", "LOG_FILE_NAME", "CONSOLE_LOG_LEVEL" })
+                ::unsetenv((std::string(LoggerConfig::ENV_PREFIX) + name).c_str());
+            ::unsetenv(LoggerConfig::CONFIG_FILE_ENV.data());
+
+            std::error_code ec;
+            std::filesystem::remove(m_configFile, ec);
+            for (const auto& file : m_logFiles)
+                std::filesystem::remove(file, ec);
+        }
+
+        /**
+         * @brief Write the config file
+         *
+         * @param [in] content The content of the file
+         */
+        void writeConfigFile(const std::string_view content)
+        {
+            std::ofstream file(m_configFile, std::ios::trunc);
+            file << content;
+        }
+
+    protected:
+        std::string m_configFile;
+        std::vector<std::filesystem::path> m_logFiles;
+};
+
+TEST_F(LoggerConfigTests, testParseFileSize)
+{
+    EXPECT_EQ(LoggerConfig::parseFileSize("1024"), 1024u);
+    EXPECT_EQ(LoggerConfig::parseFileSize("512B"), 512u);
+    EXPECT_EQ(LoggerConfig::parseFileSize("4k"), 4u * 1024);
+    EXPECT_EQ(LoggerConfig::parseFileSize(" 20MB "), 20u * 1024 * 1024);
+    EXPECT_EQ(LoggerConfig::parseFileSize("2Gb"), 2ull * 1024 * 1024 * 1024);
+
+    for (auto invalid : { "", "MB", "-1", "10TB", "1.5MB", "99999999999999999999" })
+        EXPECT_FALSE(LoggerConfig::parseFileSize(invalid)) << invalid;
+}
+
+TEST_F(LoggerConfigTests, testSet)
+{
+    LoggerConfig config;
+    EXPECT_TRUE(config.set("file_logging", "Yes"));
+    EXPECT_TRUE(config.fileLogging);
+    EXPECT_TRUE(config.set("CONSOLE_LOGGING", "true"));
+    EXPECT_TRUE(config.consoleLogging);
+    EXPECT_TRUE(config.set("CONSOLE_STDERR", "on"));
+    EXPECT_TRUE(config.consoleStderr);
+    EXPECT_TRUE(config.set("FILE_SIZE", "8MB"));
+    EXPECT_EQ(config.fileSize, 8u * 1024 * 1024);
+    EXPECT_TRUE(config.set("LOG_FILE_PATH", "/var/log"));
+    EXPECT_EQ(config.filePath, "/var/log");
+    EXPECT_TRUE(config.set("LOG_FILE_NAME", "App"));
+    EXPECT_EQ(config.fileName, "App");
+    EXPECT_TRUE(config.set("LOG_FILE_EXTN", "txt"));
+    EXPECT_EQ(config.fileExtn, ".txt");
+    EXPECT_TRUE(config.set("FILE_LOG_LEVEL", "warn"));
+    EXPECT_EQ(config.fileLevel, LOG_TYPE::LOG_WARN);
+    EXPECT_TRUE(config.set("CONSOLE_LOG_LEVEL", "ERR"));
+    EXPECT_EQ(config.consoleLevel, LOG_TYPE::LOG_ERR);
+    EXPECT_TRUE(config.set("FILE_LOG_FORMAT", "JSON"));
+    EXPECT_EQ(config.fileFormat, LoggerConfig::FileFormat::JSON);
+
+    // Unknown names and invalid values leave the settings as they are
+    EXPECT_FALSE(config.set("FILE_LOGGIN", "yes"));
+    EXPECT_FALSE(config.set("FILE_LOGGING", "maybe"));
+    EXPECT_TRUE(config.fileLogging);
+    EXPECT_FALSE(config.set("FILE_SIZE", "0"));
+    EXPECT_FALSE(config.set("FILE_SIZE", "lots"));
+    EXPECT_EQ(config.fileSize, 8u * 1024 * 1024);
+    EXPECT_FALSE(config.set("FILE_LOG_LEVEL", "VERBOSE"));
+    EXPECT_EQ(config.fileLevel, LOG_TYPE::LOG_WARN);
+    EXPECT_FALSE(config.set("FILE_LOG_FORMAT", "xml"));
+    EXPECT_EQ(config.fileFormat, LoggerConfig::FileFormat::JSON);
+}
+
+TEST_F(LoggerConfigTests, testReloadableSettings)
+{
+    LoggerConfig config;
+    EXPECT_TRUE(config.set("BATCH_SIZE", "64"));
+    EXPECT_EQ(config.maxBatchSize, 64u);
+    EXPECT_FALSE(config.set("BATCH_SIZE", "0"));
+    EXPECT_TRUE(config.set("BATCH_LATENCY_MS", "20"));
+    EXPECT_EQ(config.maxLatency, std::chrono::milliseconds(20));
+    EXPECT_FALSE(config.set("BATCH_LATENCY_MS", "20s"));
+    EXPECT_TRUE(config.set("WATCH_CONFIG", "yes"));
+    EXPECT_TRUE(config.watchConfig);
+    EXPECT_TRUE(config.set("RELOAD_ON_SIGHUP", "yes"));
+    EXPECT_TRUE(config.reloadOnSighup);
+    EXPECT_TRUE(config.set("COALESCE_WINDOW_MS", "5000"));
+    EXPECT_EQ(config.coalesceWindow, std::chrono::milliseconds(5000));
+    EXPECT_FALSE(config.set("COALESCE_WINDOW_MS", "-1"));
+    EXPECT_TRUE(config.set("SHED_BACKLOG_MS", "250"));
+    EXPECT_EQ(config.maxBacklogDelay, std::chrono::milliseconds(250));
+    EXPECT_EQ(config.priorityLevel, LOG_TYPE::LOG_ERR);
+    EXPECT_TRUE(config.set("PRIORITY_LEVEL", "fatal"));
+    EXPECT_EQ(config.priorityLevel, LOG_TYPE::LOG_FATAL);
+    EXPECT_FALSE(config.set("PRIORITY_LEVEL", "URGENT"));
+    EXPECT_EQ(config.ioThreadCnt, IoExecutor::defaultThreadCount);
+    EXPECT_TRUE(config.set("IO_THREADS", "4"));
+    EXPECT_EQ(config.ioThreadCnt, 4u);
+    EXPECT_FALSE(config.set("IO_THREADS", "0"));
+    EXPECT_EQ(config.ioThreadCnt, 4u);
+    EXPECT_TRUE(config.set("IO_THREAD_CPUS", "2, 3"));
+    EXPECT_EQ(config.ioThreads.cpus, std::vector<int>({ 2, 3 }));
+    EXPECT_FALSE(config.set("IO_THREAD_CPUS", "2,x"));
+    EXPECT_TRUE(config.set("IO_THREAD_SCHED", "fifo:50"));
+    EXPECT_EQ(config.ioThreads.schedPolicy, SchedPolicy::FIFO);
+    EXPECT_EQ(config.ioThreads.schedPriority, 50);
+    EXPECT_FALSE(config.set("IO_THREAD_SCHED", "RR"));
+    EXPECT_FALSE(config.set("IO_THREAD_SCHED", "BATCH:5"));
+    EXPECT_TRUE(config.set("IO_THREAD_SCHED", "BATCH"));
+    EXPECT_EQ(config.ioThreads.schedPolicy, SchedPolicy::BATCH);
+    EXPECT_TRUE(config.set("IO_THREAD_NICE", "-5"));
+    EXPECT_EQ(config.ioThreads.niceLevel, -5);
+    EXPECT_FALSE(config.set("IO_THREAD_NICE", "20"));
+    EXPECT_TRUE(config.set("IO_WAIT", "spin:200"));
+    EXPECT_EQ(config.ioThreads.waitStrategy, WaitStrategy::SPIN_THEN_PARK);
+    EXPECT_EQ(config.ioThreads.spinTime, std::chrono::microseconds(200));
+    EXPECT_TRUE(config.set("IO_WAIT", "BUSY_POLL"));
+    EXPECT_EQ(config.ioThreads.waitStrategy, WaitStrategy::BUSY_POLL);
+    EXPECT_FALSE(config.set("IO_WAIT", "BUSY_POLL:5"));
+
+    // The logger names keep their case, the last level set wins
+    EXPECT_TRUE(config.set("LEVEL.Db.Pool", "warn"));
+    EXPECT_TRUE(config.set("level.net", "OFF"));
+    EXPECT_TRUE(config.set("LEVEL.Db.Pool", "ERR"));
+    EXPECT_FALSE(config.set("LEVEL.cache", "LOUD"));
+    ASSERT_EQ(config.loggerLevels.size(), 2u);
+    EXPECT_EQ(config.loggerLevels[0].first, "Db.Pool");
+    EXPECT_EQ(config.loggerLevels[0].second, LOG_TYPE::LOG_ERR);
+    EXPECT_EQ(config.loggerLevels[1].first, "net");
+    EXPECT_FALSE(config.loggerLevels[1].second);
+}
+
+TEST_F(LoggerConfigTests, testApplyFile)
+{
+    writeConfigFile("# Where the log goes\n"
+                    "\n"
+                    "FILE_LOGGING = yes\n"
+                    "LOG_FILE_NAME=\"My App.log\"\n"
+                    "  FILE_SIZE=16KB  \n"
+                    "FILE_LOG_LEVEL=VERBOSE\n"   // Invalid, skipped
+                    "NOT A SETTING\n");
+    LoggerConfig config;
+    EXPECT_EQ(config.applyFile(m_configFile), 3u);
+    EXPECT_TRUE(config.fileLogging);
+    EXPECT_EQ(config.fileName, "My App.log");
+    EXPECT_EQ(config.fileSize, 16u * 1024);
+    EXPECT_EQ(config.fileLevel, LOG_TYPE::LOG_DEFAULT);
+
+    EXPECT_EQ(config.applyFile("tmp_no_such_file.conf"), 0u);
+    EXPECT_TRUE(config.fileLogging);
+}
+
+TEST_F(LoggerConfigTests, testEnvironmentOverridesConfigFile)
+{
+    writeConfigFile("FILE_SIZE=16KB\nLOG_FILE_NAME=FromFile.log\n");
+    ::setenv(LoggerConfig::CONFIG_FILE_ENV.data(), m_configFile.c_str(), 1);
+    ::setenv("LOGGER_FILE_SIZE", "32KB", 1);
+    ::setenv("LOGGER_CONSOLE_LOG_LEVEL", "NONSENSE", 1);
+
+    auto defaults = LoggerConfig::getCompiledDefaults();
+    auto config = LoggerConfig::load();
+    EXPECT_EQ(config.fileSize, 32u * 1024);
+    EXPECT_EQ(config.fileName, "FromFile.log");
+    EXPECT_EQ(config.consoleLevel, defaults.consoleLevel);
+    EXPECT_EQ(config.fileLogging, defaults.fileLogging);
+}
+
+TEST_F(LoggerConfigTests, testLoadIsCheap)
+{
+    writeConfigFile("FILE_LOGGING=yes\nFILE_SIZE=16KB\nLOG_FILE_NAME=App.log\nFILE_LOG_FORMAT=json\n");
+    ::setenv(LoggerConfig::CONFIG_FILE_ENV.data(), m_configFile.c_str(), 1);
+    ::setenv("LOGGER_LOG_FILE_NAME", "Other.log", 1);
+
+    constexpr int loadCnt = 100;
+    auto start = std::chrono::steady_clock::now();
+    for (int cnt = 0; cnt < loadCnt; ++cnt)
+        EXPECT_EQ(LoggerConfig::load().fileName, "Other.log");
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed / loadCnt, std::chrono::milliseconds(1));
+}
+
+TEST_F(LoggerConfigTests, testMakeLoggingOps)
+{
+    LoggerConfig config;
+    config.consoleLevel = LOG_TYPE::LOG_IMP;
+    auto pLoggingOps = Logger::makeLoggingOps(config);
+    ASSERT_NE(dynamic_cast<ConsoleOps*>(pLoggingOps.get()), nullptr);
+    EXPECT_EQ(pLoggingOps->getLevelThreshold(), LOG_TYPE::LOG_IMP);
+
+    config.fileLogging = true;
+    config.fileName = generateRandomFileName("tmp_", "");
+    config.fileExtn = ".jsonl";
+    config.fileFormat = LoggerConfig::FileFormat::JSON;
+    config.fileLevel = LOG_TYPE::LOG_WARN;
+    m_logFiles.push_back(config.fileName + config.fileExtn);
+    pLoggingOps = Logger::makeLoggingOps(config);
+    ASSERT_NE(dynamic_cast<BatchSinkOps*>(pLoggingOps.get()), nullptr);
+    EXPECT_EQ(pLoggingOps->getLevelThreshold(), LOG_TYPE::LOG_WARN);
+    pLoggingOps.reset();
+    EXPECT_TRUE(std::filesystem::exists(m_logFiles.back()));
+
+    config.fileFormat = LoggerConfig::FileFormat::TEXT;
+    config.consoleLogging = true;
+    pLoggingOps = Logger::makeLoggingOps(config);
+    EXPECT_NE(dynamic_cast<MultiSinkOps*>(pLoggingOps.get()), nullptr);
+
+    // The repeats collapsed in front of the sinks, which still get their settings
+    config.coalesceWindow = std::chrono::milliseconds(1000);
+    pLoggingOps = Logger::makeLoggingOps(config);
+    auto pCoalescingOps = dynamic_cast<CoalescingOps*>(pLoggingOps.get());
+    ASSERT_NE(pCoalescingOps, nullptr);
+    EXPECT_EQ(pCoalescingOps->getWindow(), std::chrono::milliseconds(1000));
+    EXPECT_NE(dynamic_cast<MultiSinkOps*>(&pCoalescingOps->getSink()), nullptr);
+
+    config.coalesceWindow = std::chrono::milliseconds(0);
+    config.maxBatchSize = 32;
+    config.maxBacklogDelay = std::chrono::milliseconds(500);
+    Logger::applySettings(*pLoggingOps, config);
+    EXPECT_EQ(pCoalescingOps->getWindow(), std::chrono::milliseconds(0));
+    EXPECT_EQ(dynamic_cast<MultiSinkOps&>(pCoalescingOps->getSink()).getSink(0).getMaxBatchSize(), 32u);
+    EXPECT_EQ(dynamic_cast<MultiSinkOps&>(pCoalescingOps->getSink()).getSink(0).getLoadShedding(), std::chrono::milliseconds(500));
+    EXPECT_EQ(dynamic_cast<MultiSinkOps&>(pCoalescingOps->getSink()).getSink(1).getPriorityLevel(), LOG_TYPE::LOG_ERR);
+}
+
+TEST_F(LoggerConfigTests, testMakeLoggingOpsFallsBackToText)
+{
+    LoggerConfig config;
+    config.fileLogging = true;
+    config.fileName = generateRandomFileName("tmp_", "");
+    config.fileExtn = ".bin";
+    config.fileFormat = LoggerConfig::FileFormat::BINARY;
+    m_logFiles.push_back(config.fileName + config.fileExtn);
+    // Not a binary log, it is not to be appended binary records to
+    {
+        std::ofstream textLog(m_logFiles.back());
+        textLog << "A text log\n";
+    }
+    auto pLoggingOps = Logger::makeLoggingOps(config);
+    ASSERT_NE(dynamic_cast<FileOps*>(pLoggingOps.get()), nullptr);
+    auto exceptions = pLoggingOps->getAllExceptions();
+    ASSERT_EQ(1u, exceptions.size());
+    try
+    {
+        std::rethrow_exception(exceptions.front());
+    }
+    catch(const std::runtime_error& excp)
+    {
+        EXPECT_NE(std::string::npos, std::string(excp.what()).find("is not a binary log")) << excp.what();
+    }
+}
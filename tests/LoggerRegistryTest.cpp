@@ -0,0 +1,273 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="LoggerRegistryTests.*"
+
+/*
+ * LoggerRegistryTest.cpp
+ * Unit tests for LoggerRegistry and NamedLogger using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the named loggers: the levels inherited
+ * down the hierarchy, silenced and reset, the sinks the loggers are routed
+ * to and released once replaced, the names refused, and the LOG_*_TO macros.
+ */
+
+#include "LOGGER_MACROS.hpp"
+#include "BatchSinkOps.hpp"
+#include "CommonFunc.hpp"
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace logger;
+
+namespace
+{
+    /**
+     * @brief A BatchSinkOps whose commit of a critical record waits to be let go
+     */
+    class SlowCommitOps : public BatchSinkOps
+    {
+        public:
+            SlowCommitOps()
+                : BatchSinkOps(std::make_unique<TextSink>())
+                , m_committing()
+                , m_release()
+                , m_releaseFuture(m_release.get_future().share())
+            {
+            }
+
+            void commitCritical() override
+            {
+                m_committing.set_value();
+                m_releaseFuture.wait();
+                BatchSinkOps::commitCritical();
+            }
+
+            void waitForCommit()                { m_committing.get_future().wait();     }
+            void releaseCommit()                { m_release.set_value();                }
+
+        private:
+            std::promise<void> m_committing;
+            std::promise<void> m_release;
+            std::shared_future<void> m_releaseFuture;
+    };
+};
+
+class LoggerRegistryTests : public CommonTestDataGenerator
+{
+    public:
+        /**
+         * @brief Make a BatchSinkOps with a TextSink
+         */
+        static std::shared_ptr<BatchSinkOps> makeOps()
+        {
+            return std::make_shared<BatchSinkOps>(std::make_unique<TextSink>());
+        }
+
+        /**
+         * @brief Get the texts a BatchSinkOps made by makeOps() got so far
+         */
+        static std::vector<std::string> getTexts(BatchSinkOps& ops)
+        {
+            ops.flushAndWait();
+            return dynamic_cast<TextSink&>(ops.getSink()).getTexts();
+        }
+};
+
+TEST_F(LoggerRegistryTests, testHierarchicalLevels)
+{
+    auto rootOps = makeOps();
+    LoggerRegistry registry(*rootOps);
+    auto& pool = registry.get("db.pool");
+    EXPECT_EQ("db.pool", pool.getName());
+    // The root, "db" and "db.pool"
+    EXPECT_EQ(3u, registry.getLoggerCount());
+    EXPECT_EQ(&pool, &registry.get("db.pool"));
+    EXPECT_TRUE(pool.isEnabled(LOG_TYPE::LOG_DBG));
+
+    registry.setLevel("db", LOG_TYPE::LOG_WARN);
+    EXPECT_FALSE(pool.isEnabled(LOG_TYPE::LOG_INFO));
+    EXPECT_TRUE(pool.isEnabled(LOG_TYPE::LOG_WARN));
+    EXPECT_TRUE(registry.get("net").isEnabled(LOG_TYPE::LOG_DBG));
+    // Created after the level got set, it inherits it all the same
+    EXPECT_FALSE(registry.get("db.cache.lru").isEnabled(LOG_TYPE::LOG_IMP));
+
+    // A level of its own wins over the inherited one, whichever way
+    registry.setLevel("db.pool", LOG_TYPE::LOG_DBG);
+    EXPECT_TRUE(pool.isEnabled(LOG_TYPE::LOG_DBG));
+    registry.setLevel("", LOG_TYPE::LOG_ERR);
+    EXPECT_TRUE(pool.isEnabled(LOG_TYPE::LOG_DBG));
+    EXPECT_FALSE(registry.get("db.cache").isEnabled(LOG_TYPE::LOG_IMP));
+    EXPECT_FALSE(registry.get("net").isEnabled(LOG_TYPE::LOG_WARN));
+
+    registry.resetLevel("db.pool");
+    EXPECT_FALSE(pool.isEnabled(LOG_TYPE::LOG_INFO));
+    registry.resetLevel("db");
+    registry.resetLevel("");
+    EXPECT_TRUE(pool.isEnabled(LOG_TYPE::LOG_DBG));
+}
+
+TEST_F(LoggerRegistryTests, testSilence)
+{
+    auto rootOps = makeOps();
+    LoggerRegistry registry(*rootOps);
+    auto& http = registry.get("net.http");
+    registry.silence("net");
+    for (auto logType : { LOG_TYPE::LOG_DBG, LOG_TYPE::LOG_INFO, LOG_TYPE::LOG_WARN,
+                          LOG_TYPE::LOG_ERR, LOG_TYPE::LOG_FATAL, LOG_TYPE::LOG_DEFAULT })
+        EXPECT_FALSE(http.isEnabled(logType));
+    EXPECT_TRUE(registry.get("db").isEnabled(LOG_TYPE::LOG_INFO));
+
+    registry.resetLevel("net");
+    EXPECT_TRUE(http.isEnabled(LOG_TYPE::LOG_INFO));
+}
+
+TEST_F(LoggerRegistryTests, testRoutingToSinks)
+{
+    auto rootOps = makeOps();
+    auto netOps = makeOps();
+    LoggerRegistry registry(*rootOps);
+    auto& http = registry.get("net.http");
+    auto& db = registry.get("db");
+    EXPECT_EQ(rootOps.get(), &http.getOps());
+
+    registry.setOps("net", netOps);
+    EXPECT_EQ(netOps.get(), &http.getOps());
+    EXPECT_EQ(rootOps.get(), &db.getOps());
+    http.getOps().writeRecord(LOG_TYPE::LOG_INFO, "To net");
+    db.getOps().writeRecord(LOG_TYPE::LOG_INFO, "To root");
+    EXPECT_EQ(std::vector<std::string>{ "To net" }, getTexts(*netOps));
+    EXPECT_EQ(std::vector<std::string>{ "To root" }, getTexts(*rootOps));
+
+    // Back to the sink of the parent, the one replaced is released
+    std::weak_ptr<BatchSinkOps> weakNetOps = netOps;
+    netOps.reset();
+    registry.setOps("net", nullptr);
+    EXPECT_EQ(rootOps.get(), &http.getOps());
+    EXPECT_TRUE(weakNetOps.expired());
+}
+
+TEST_F(LoggerRegistryTests, testSinkReplacedWhileLogging)
+{
+    auto rootOps = makeOps();
+    LoggerRegistry registry(*rootOps);
+    auto& http = registry.get("net.http");
+    std::atomic_bool done = false;
+    std::vector<std::thread> loggers;
+    for (auto idx = 0; idx < 4; ++idx)
+    {
+        loggers.emplace_back([&http, &done]()
+        {
+            while (!done)
+                logger::log_to(http, __FILE__, __PRETTY_FUNCTION__, __LINE__, LOG_TYPE::LOG_INFO, "Record {}", 1);
+        });
+    }
+    // Each sink replaced gets released, no logging call being left on its way to it
+    std::vector<std::weak_ptr<BatchSinkOps>> replacedOps;
+    for (auto cnt = 0; cnt < 50; ++cnt)
+    {
+        auto netOps = makeOps();
+        replacedOps.push_back(netOps);
+        registry.setOps("net", std::move(netOps));
+    }
+    registry.setOps("net", nullptr);
+    done = true;
+    for (auto& thread : loggers)
+        thread.join();
+    for (const auto& weakOps : replacedOps)
+        EXPECT_TRUE(weakOps.expired());
+}
+
+TEST_F(LoggerRegistryTests, testCommitHoldsNoOtherLoggingCall)
+{
+    SlowCommitOps rootOps;
+    LoggerRegistry registry(rootOps);
+    auto& db = registry.get("db");
+    std::thread errThread([&db]()
+    {
+        logger::log_to(db, __FILE__, __PRETTY_FUNCTION__, __LINE__, LOG_TYPE::LOG_ERR, "Disk {}", "full");
+    });
+    rootOps.waitForCommit();
+    // Formatted and queued while the error is still being committed
+    auto infoDone = std::async(std::launch::async, [&db]()
+    {
+        logger::log_to(db, __FILE__, __PRETTY_FUNCTION__, __LINE__, LOG_TYPE::LOG_INFO, "Still {}", "logging");
+    });
+    EXPECT_EQ(std::future_status::ready, infoDone.wait_for(std::chrono::seconds(5)));
+    rootOps.releaseCommit();
+    errThread.join();
+    infoDone.get();
+
+    auto texts = getTexts(rootOps);
+    ASSERT_EQ(2u, texts.size());
+    EXPECT_TRUE(texts[0].ends_with("Disk full")) << texts[0];
+    EXPECT_TRUE(texts[1].ends_with("Still logging")) << texts[1];
+}
+
+TEST_F(LoggerRegistryTests, testInvalidNames)
+{
+    auto rootOps = makeOps();
+    LoggerRegistry registry(*rootOps);
+    for (auto name : { ".net", "net.", "db..pool", "." })
+    {
+        EXPECT_THROW(registry.get(name), std::invalid_argument) << name;
+        EXPECT_THROW(registry.setLevel(name, LOG_TYPE::LOG_ERR), std::invalid_argument) << name;
+    }
+    EXPECT_EQ(1u, registry.getLoggerCount());
+}
+
+TEST_F(LoggerRegistryTests, testMacrosThroughSharedRegistry)
+{
+    auto& registry = LoggerRegistry::getShared();
+    // The same every time, the call sites keep the logger they looked up first
+    const std::string name = "test.registry.macros";
+    auto ops = makeOps();
+    registry.setOps(name, ops);
+    registry.setLevel(name, LOG_TYPE::LOG_WARN);
+
+    auto evaluated = 0;
+    for (auto cnt = 0; cnt < 3; ++cnt)
+    {
+        // Below the level the arguments are not even evaluated
+        LOG_INFO_TO(name, "Dropped {}", ++evaluated);
+        // A single statement, as the branch of an if
+        if (cnt >= 0)
+            LOG_WARN_TO(name, "Kept {}", cnt);
+        else
+            LOG_ERR_TO(name, "Never {}", cnt);
+    }
+    EXPECT_EQ(0, evaluated);
+    registry.silence(name);
+    LOG_ERR_TO(name, "Silenced");
+    registry.resetLevel(name);
+    LOG_IMP_TO(name, "Back");
+
+    auto texts = getTexts(*ops);
+    ASSERT_EQ(4u, texts.size());
+    for (auto cnt = 0; cnt < 3; ++cnt)
+        EXPECT_TRUE(texts[cnt].ends_with("Kept " + std::to_string(cnt))) << texts[cnt];
+    EXPECT_NE(std::string::npos, texts[3].find("|IMP>"));
+    EXPECT_TRUE(texts[3].ends_with("Back"));
+    registry.setOps(name, nullptr);
+}
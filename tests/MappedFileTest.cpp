@@ -0,0 +1,142 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="MappedFileTests.*"
+
+/*
+ * MappedFileTest.cpp
+ * Unit tests for MappedFile functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the MappedFile class, covering the line
+ * iterator, whole file mapping and the chunked (streaming) mode.
+ */
+
+#include "MappedFile.hpp"
+#include "CommonFunc.hpp"
+
+#include <fstream>
+
+using namespace logger;
+
+class MappedFileTests : public CommonTestDataGenerator
+{
+    public:
+        /**
+         * @brief Write the lines, each followed by a new line, into a new file
+         *
+         * @param file The file to be written
+         * @param lines The lines to be written
+         * @param lastNewLine Whether the last line gets a new line as well
+         */
+        static void writeLines(const std::filesystem::path& file,
+                               const std::vector<std::string>& lines,
+                               const bool lastNewLine = true)
+        {
+            std::ofstream ofile(file, std::ios::binary | std::ios::trunc);
+            for (size_t idx = 0; idx < lines.size(); ++idx)
+            {
+                ofile << lines[idx];
+                if (lastNewLine || idx + 1 < lines.size())
+                    ofile << '\n';
+            }
+        }
+};
+
+TEST_F(MappedFileTests, testLineIterator)
+{
+    std::vector<std::string_view> lines;
+    for (auto line : MappedFile::LineRange("first\n\nthird\nlast"))
+        lines.push_back(line);
+
+    std::vector<std::string_view> expLines = { "first", "", "third", "last" };
+    EXPECT_EQ(expLines, lines);
+
+    lines.clear();
+    for (auto line : MappedFile::LineRange("only\n"))
+        lines.push_back(line);
+    EXPECT_EQ(std::vector<std::string_view>{ "only" }, lines);
+
+    auto emptyRange = MappedFile::LineRange("");
+    EXPECT_TRUE(emptyRange.begin() == emptyRange.end());
+}
+
+TEST_F(MappedFileTests, testMapWholeFile)
+{
+    auto file = std::filesystem::current_path() / generateRandomFileName();
+    std::vector<std::string> dataQueue;
+    for (auto cnt = 0; cnt < 500; ++cnt)
+        dataQueue.push_back(generateRandomText(cnt % 200));
+    writeLines(file, dataQueue, false);
+    {
+        MappedFile mappedFile(file);
+        EXPECT_EQ(std::filesystem::file_size(file), mappedFile.size());
+        size_t idx = 0;
+        for (auto line : mappedFile.lines())
+        {
+            ASSERT_LT(idx, dataQueue.size());
+            EXPECT_EQ(dataQueue[idx++], line);
+        }
+        EXPECT_EQ(dataQueue.size(), idx);
+
+        // Moving hands the mapping over
+        MappedFile movedFile(std::move(mappedFile));
+        EXPECT_EQ(static_cast<size_t>(0), mappedFile.size());
+        EXPECT_EQ(std::filesystem::file_size(file), movedFile.size());
+    }
+    std::filesystem::remove(file);
+    EXPECT_THROW(MappedFile{file}, std::runtime_error);
+
+    // An empty file maps to an empty view
+    std::ofstream(file).close();
+    MappedFile emptyFile(file);
+    EXPECT_TRUE(emptyFile.view().empty());
+    EXPECT_TRUE(emptyFile.lines().begin() == emptyFile.lines().end());
+    std::filesystem::remove(file);
+}
+
+TEST_F(MappedFileTests, testForEachLineChunked)
+{
+    auto file = std::filesystem::current_path() / generateRandomFileName();
+    std::vector<std::string> dataQueue;
+    for (auto cnt = 0; cnt < 2000; ++cnt)
+        dataQueue.push_back(generateRandomText(cnt % 97));
+    // A line longer than the window has to come out whole as well
+    dataQueue.push_back(generateRandomText(20000));
+    for (auto cnt = 0; cnt < 100; ++cnt)
+        dataQueue.push_back(generateRandomText(50));
+    writeLines(file, dataQueue);
+
+    // The smallest window there can be, i.e. a page
+    size_t idx = 0;
+    auto lineCnt = MappedFile::forEachLine(file, [&](std::string_view line)
+    {
+        EXPECT_EQ(dataQueue[idx++], line);
+        return true;
+    }, 1);
+    EXPECT_EQ(dataQueue.size(), lineCnt);
+    EXPECT_EQ(dataQueue.size(), idx);
+
+    // Stop half way through
+    lineCnt = MappedFile::forEachLine(file, [](std::string_view) { return false; });
+    EXPECT_EQ(static_cast<size_t>(1), lineCnt);
+    std::filesystem::remove(file);
+}
@@ -0,0 +1,207 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="MmapFileOpsTests.*"
+
+/*
+ * MmapFileOpsTest.cpp
+ * Unit tests for MmapFileOps functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the MmapFileOps class, covering writing into
+ * the mapped segment, truncation on close, segment roll over and the sync policies.
+ */
+
+#include "MmapFileOps.hpp"
+#include "CommonFunc.hpp"
+
+using namespace logger;
+
+class MmapFileOpsTests : public CommonTestDataGenerator
+{
+    public:
+        /**
+         * @brief Read all the lines of a file
+         *
+         * @param file The file to be read
+         * @return std::vector<std::string> The lines of the file
+         */
+        static std::vector<std::string> readLines(const std::filesystem::path& file)
+        {
+            std::vector<std::string> lines;
+            std::ifstream ifile(file, std::ios::binary);
+            std::string line;
+            while (std::getline(ifile, line))
+                lines.emplace_back(line);
+
+            return lines;
+        }
+};
+
+TEST_F(MmapFileOpsTests, testWriteAndTruncateOnClose)
+{
+    std::uintmax_t segmentSize = 1024 * 1024;
+    std::uintmax_t maxTextSize = 255;
+    auto fileName = generateRandomFileName();
+    std::vector<std::string> dataQueue;
+    std::filesystem::path filePathObj;
+    {
+        MmapFileOps file(segmentSize, fileName);
+        filePathObj = file.getFilePathObj();
+        for (auto cnt = 0; cnt < 100; ++cnt)
+        {
+            auto text = generateRandomText(maxTextSize);
+            file.write(text);
+            dataQueue.push_back(text);
+        }
+    }
+    ASSERT_TRUE(FileOps::fileExists(filePathObj));
+    // The preallocated tail must have been given back
+    EXPECT_EQ(static_cast<std::uintmax_t>(100 * (maxTextSize + 1)), std::filesystem::file_size(filePathObj));
+    auto lines = readLines(filePathObj);
+    ASSERT_EQ(dataQueue.size(), lines.size());
+    for (size_t idx = 0; idx < lines.size(); ++idx)
+        EXPECT_EQ(dataQueue[idx], lines[idx]);
+
+    ASSERT_TRUE(FileOps::removeFile(filePathObj));
+}
+
+TEST_F(MmapFileOpsTests, testCloseAndReopenSegment)
+{
+    std::uintmax_t segmentSize = 1024 * 1024;
+    std::uintmax_t maxTextSize = 100;
+    auto fileName = generateRandomFileName();
+    std::vector<std::string> dataQueue;
+    std::filesystem::path filePathObj;
+    {
+        MmapFileOps file(segmentSize, fileName);
+        filePathObj = file.getFilePathObj();
+        auto text = generateRandomText(maxTextSize);
+        file.write(text);
+        dataQueue.push_back(text);
+        file.closeSegment();
+        text = generateRandomText(maxTextSize);
+        file.write(text);
+        dataQueue.push_back(text);
+    }
+    {
+        // A new object must carry on after the data written by the earlier one
+        MmapFileOps file(segmentSize, fileName);
+        auto text = generateRandomText(maxTextSize);
+        file.write(text);
+        dataQueue.push_back(text);
+    }
+    auto lines = readLines(filePathObj);
+    ASSERT_EQ(dataQueue.size(), lines.size());
+    for (size_t idx = 0; idx < lines.size(); ++idx)
+        EXPECT_EQ(dataQueue[idx], lines[idx]);
+
+    ASSERT_TRUE(FileOps::removeFile(filePathObj));
+}
+
+TEST_F(MmapFileOpsTests, testSegmentRollOver)
+{
+    std::uintmax_t segmentSize = 8 * 1024;
+    std::uintmax_t maxTextSize = 1023;
+    auto filePath = std::filesystem::current_path() / generateRandomText(8);
+    std::filesystem::create_directory(filePath);
+    std::vector<std::string> dataQueue;
+    {
+        MmapFileOps file(segmentSize, "Segment.log", filePath.string());
+        for (auto cnt = 0; cnt < 40; ++cnt)
+        {
+            auto text = generateRandomText(maxTextSize);
+            file.write(text);
+            dataQueue.push_back(text);
+        }
+    }
+    // 40KB worth of data into 8KB segments, i.e. each one holding 8 lines
+    size_t segmentCnt = 0;
+    size_t lineCnt = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(filePath))
+    {
+        ++segmentCnt;
+        EXPECT_LE(std::filesystem::file_size(entry.path()), segmentSize);
+        lineCnt += readLines(entry.path()).size();
+    }
+    EXPECT_EQ(static_cast<size_t>(5), segmentCnt);
+    EXPECT_EQ(dataQueue.size(), lineCnt);
+    std::filesystem::remove_all(filePath);
+}
+
+TEST_F(MmapFileOpsTests, testSyncPolicies)
+{
+    std::uintmax_t segmentSize = 64 * 1024;
+    std::uintmax_t maxTextSize = 128;
+    for (auto policy : { MmapSyncPolicy::NONE, MmapSyncPolicy::ASYNC, MmapSyncPolicy::SYNC, MmapSyncPolicy::RANGE })
+    {
+        auto fileName = generateRandomFileName();
+        std::vector<std::string> dataQueue;
+        std::filesystem::path filePathObj;
+        {
+            MmapFileOps file(segmentSize, fileName, "", "", policy);
+            EXPECT_EQ(policy, file.getSyncPolicy());
+            filePathObj = file.getFilePathObj();
+            for (auto cnt = 0; cnt < 300; ++cnt)
+            {
+                auto text = generateRandomText(maxTextSize);
+                file.write(text);
+                dataQueue.push_back(text);
+            }
+            EXPECT_TRUE(file.getAllExceptions().empty());
+        }
+        auto lines = readLines(filePathObj);
+        ASSERT_EQ(dataQueue.size(), lines.size());
+        EXPECT_EQ(dataQueue.back(), lines.back());
+        ASSERT_TRUE(FileOps::removeFile(filePathObj));
+    }
+}
+
+TEST_F(MmapFileOpsTests, testPerBatchDurability)
+{
+    std::uintmax_t segmentSize = 64 * 1024;
+    std::uintmax_t maxTextSize = 128;
+    auto fileName = generateRandomFileName();
+    std::filesystem::path filePathObj;
+    {
+        // Each batch msync'ed, whatever the sync policy of the segment
+        MmapFileOps file(segmentSize, fileName);
+        file.setDurabilityPolicy(DurabilityPolicy::PER_BATCH);
+        filePathObj = file.getFilePathObj();
+        for (auto cnt = 0; cnt < 100; ++cnt)
+            file.write(generateRandomText(maxTextSize));
+        file.flushAndWait();
+        auto stats = file.getSyncStats();
+        EXPECT_GE(stats.syncCount, static_cast<size_t>(1));
+        EXPECT_LE(stats.syncCount, static_cast<size_t>(100));
+        EXPECT_EQ(static_cast<size_t>(0), stats.failedCount);
+        EXPECT_TRUE(file.getAllExceptions().empty());
+
+        // Back to the segment policy, nothing synced per batch any more
+        file.setDurabilityPolicy(DurabilityPolicy::NO_SYNC);
+        for (auto cnt = 0; cnt < 100; ++cnt)
+            file.write(generateRandomText(maxTextSize));
+        file.flushAndWait();
+        EXPECT_EQ(stats.syncCount, file.getSyncStats().syncCount);
+    }
+    EXPECT_EQ(static_cast<size_t>(200), readLines(filePathObj).size());
+    ASSERT_TRUE(FileOps::removeFile(filePathObj));
+}
@@ -0,0 +1,183 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="MultiSinkOpsTests.*"
+
+/*
+ * MultiSinkOpsTest.cpp
+ * Unit tests for MultiSinkOps functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the MultiSinkOps class: the fan out of
+ * the records to several sinks, the level threshold of each of them and the
+ * severity order of the log types the thresholds are based on.
+ */
+
+#include "MultiSinkOps.hpp"
+#include "FileOps.hpp"
+#include "CommonFunc.hpp"
+
+#include <array>
+#include <set>
+
+using namespace logger;
+
+class MultiSinkOpsTests : public CommonTestDataGenerator
+{
+    public:
+        void TearDown() override
+        {
+            for (size_t idx = 0; idx < m_multiSinkOps.getSinkCount(); ++idx)
+            {
+                auto& fileOps = dynamic_cast<FileOps&>(m_multiSinkOps.getSink(idx));
+                EXPECT_TRUE(fileOps.deleteFile());
+            }
+        }
+
+        /**
+         * @brief Add a file sink with a random file name
+         *
+         * @param [in] threshold The level threshold of the sink
+         * @return FileOps& The sink added
+         */
+        FileOps& addFileSink(const LOG_TYPE threshold = LOG_TYPE::LOG_DEFAULT)
+        {
+            auto& sink = m_multiSinkOps.addSink(std::make_unique<FileOps>(1024 * 1000, generateRandomFileName()), threshold);
+            return dynamic_cast<FileOps&>(sink);
+        }
+
+        /**
+         * @brief Read all the lines of a file sink
+         */
+        static std::vector<std::string> readLines(FileOps& fileOps)
+        {
+            std::vector<std::string> lines;
+            auto mappedFile = fileOps.mapFile();
+            for (auto line : mappedFile.lines())
+                lines.emplace_back(line);
+            return lines;
+        }
+
+    protected:
+        MultiSinkOps m_multiSinkOps;
+        static constexpr std::array<LOG_TYPE, 7> m_logTypes = { LOG_TYPE::LOG_DBG, LOG_TYPE::LOG_INFO, LOG_TYPE::LOG_IMP,
+                                                                LOG_TYPE::LOG_WARN, LOG_TYPE::LOG_ERR, LOG_TYPE::LOG_ASSERT,
+                                                                LOG_TYPE::LOG_FATAL };
+};
+
+TEST_F(MultiSinkOpsTests, testSeverityOrder)
+{
+    for (size_t idx = 1; idx < m_logTypes.size(); ++idx)
+    {
+        EXPECT_LT(getLogTypeSeverity(m_logTypes[idx - 1]), getLogTypeSeverity(m_logTypes[idx]));
+        EXPECT_TRUE(isLogTypeAtLeast(m_logTypes[idx], m_logTypes[idx - 1]));
+        EXPECT_FALSE(isLogTypeAtLeast(m_logTypes[idx - 1], m_logTypes[idx]));
+    }
+    for (auto logType : m_logTypes)
+        EXPECT_TRUE(isLogTypeAtLeast(logType, LOG_TYPE::LOG_DEFAULT));
+}
+
+TEST_F(MultiSinkOpsTests, testFanOutWithThresholds)
+{
+    auto& allFile = addFileSink();
+    auto& warnFile = addFileSink(LOG_TYPE::LOG_WARN);
+    ASSERT_EQ(2, m_multiSinkOps.getSinkCount());
+    EXPECT_EQ(LOG_TYPE::LOG_DEFAULT, allFile.getLevelThreshold());
+    EXPECT_EQ(LOG_TYPE::LOG_WARN, warnFile.getLevelThreshold());
+
+    // The errors take the priority lane, each lane keeping the order of its records
+    std::vector<std::string> expAll[2];
+    std::vector<std::string> expWarn[2];
+    std::set<std::string> priorityTexts;
+    for (auto cnt = 0; cnt < 50; ++cnt)
+    {
+        for (auto logType : m_logTypes)
+        {
+            auto text = generateRandomText(100);
+            m_multiSinkOps.writeRecord(logType, text);
+            auto priority = isLogTypeAtLeast(logType, LOG_TYPE::LOG_ERR);
+            if (priority)
+                priorityTexts.insert(text);
+            expAll[priority].push_back(text);
+            if (isLogTypeAtLeast(logType, LOG_TYPE::LOG_WARN))
+                expWarn[priority].push_back(text);
+        }
+    }
+    m_multiSinkOps.flushAndWait();
+    auto splitByLane = [&priorityTexts](const std::vector<std::string>& lines)
+    {
+        std::array<std::vector<std::string>, 2> lanes;
+        for (const auto& line : lines)
+            lanes[priorityTexts.contains(line)].push_back(line);
+        return lanes;
+    };
+    auto allLanes = splitByLane(readLines(allFile));
+    auto warnLanes = splitByLane(readLines(warnFile));
+    for (auto lane : { 0, 1 })
+    {
+        EXPECT_EQ(expAll[lane], allLanes[lane]);
+        EXPECT_EQ(expWarn[lane], warnLanes[lane]);
+    }
+}
+
+TEST_F(MultiSinkOpsTests, testOwnThreshold)
+{
+    auto& allFile = addFileSink();
+    auto& infoFile = addFileSink(LOG_TYPE::LOG_INFO);
+    m_multiSinkOps.setLevelThreshold(LOG_TYPE::LOG_ERR);
+
+    std::vector<std::string> expLines;
+    for (auto logType : m_logTypes)
+    {
+        auto text = generateRandomText(100);
+        m_multiSinkOps.writeRecord(logType, text);
+        if (isLogTypeAtLeast(logType, LOG_TYPE::LOG_ERR))
+            expLines.push_back(text);
+    }
+    m_multiSinkOps.flushAndWait();
+    EXPECT_EQ(expLines, readLines(allFile));
+    EXPECT_EQ(expLines, readLines(infoFile));
+}
+
+TEST_F(MultiSinkOpsTests, testWriteWithoutLogType)
+{
+    auto& allFile = addFileSink();
+    auto& fatalFile = addFileSink(LOG_TYPE::LOG_FATAL);
+    std::vector<std::string> expLines;
+    for (auto cnt = 0; cnt < 10; ++cnt)
+    {
+        auto text = generateRandomText(100);
+        m_multiSinkOps << text;
+        expLines.push_back(text);
+    }
+    m_multiSinkOps.flushAndWait();
+    // Not filtered, as there is no log type to filter on
+    EXPECT_EQ(expLines, readLines(allFile));
+    EXPECT_EQ(expLines, readLines(fatalFile));
+}
+
+TEST_F(MultiSinkOpsTests, testInvalidSinks)
+{
+    EXPECT_THROW(m_multiSinkOps.addSink(nullptr), std::invalid_argument);
+    EXPECT_THROW(m_multiSinkOps.getSink(0), std::out_of_range);
+    EXPECT_EQ(0, m_multiSinkOps.getSinkCount());
+    EXPECT_EQ("MultiSinkOps", m_multiSinkOps.getClassId());
+}
@@ -0,0 +1,157 @@
+//leaks --atExit --list -- ./bin/TestLogger_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="ReverseReaderTests.*"
+
+/*
+ * ReverseReaderTest.cpp
+ * Unit tests for ReverseReader functions using Google Test framework.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file contains unit tests for the ReverseReader class: lines across
+ * block boundaries, the edge cases of the first and last lines, records with
+ * continuation lines and the bytes read for the tail of a big file.
+ */
+
+#include "ReverseReader.hpp"
+#include "CommonFunc.hpp"
+
+#include <fstream>
+#include <algorithm>
+
+using namespace logger;
+
+class ReverseReaderTests : public CommonTestDataGenerator
+{
+    public:
+        void SetUp() override
+        {
+            m_file = std::filesystem::current_path() / generateRandomFileName();
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove(m_file);
+        }
+
+        /**
+         * @brief Write the text into the file, as is
+         */
+        void writeText(const std::string& text)
+        {
+            std::ofstream ofile(m_file, std::ios::binary | std::ios::trunc);
+            ofile << text;
+        }
+
+        /**
+         * @brief Read all the lines backwards
+         *
+         * @return std::vector<std::string> The lines, the last one first
+         */
+        std::vector<std::string> readAllBackwards(const size_t blockSize)
+        {
+            ReverseReader reader(m_file, blockSize);
+            std::vector<std::string> lines;
+            std::string line;
+            while (reader.prevLine(line))
+                lines.push_back(line);
+            EXPECT_FALSE(reader.prevLine(line));
+            return lines;
+        }
+
+    protected:
+        std::filesystem::path m_file;
+};
+
+TEST_F(ReverseReaderTests, testPrevLine)
+{
+    using Lines = std::vector<std::string>;
+    for (size_t blockSize : { 1, 2, 3, 7, 4096 })
+    {
+        writeText("");
+        EXPECT_EQ(Lines(), readAllBackwards(blockSize));
+        writeText("\n");
+        EXPECT_EQ(Lines{ "" }, readAllBackwards(blockSize));
+        writeText("only");
+        EXPECT_EQ(Lines{ "only" }, readAllBackwards(blockSize));
+        writeText("first\nsecond\n");
+        EXPECT_EQ((Lines{ "second", "first" }), readAllBackwards(blockSize));
+        writeText("\nfirst\n\nlast line, no new line");
+        EXPECT_EQ((Lines{ "last line, no new line", "", "first", "" }), readAllBackwards(blockSize));
+    }
+
+    // Lines longer than the blocks, of every length around them
+    Lines lines;
+    std::string text;
+    for (size_t len = 0; len < 300; ++len)
+    {
+        lines.push_back(generateRandomText(len));
+        text += lines.back() + '\n';
+    }
+    writeText(text);
+    auto backwards = readAllBackwards(64);
+    std::reverse(backwards.begin(), backwards.end());
+    EXPECT_EQ(lines, backwards);
+
+    EXPECT_THROW(ReverseReader(m_file.string() + "_missing"), std::runtime_error);
+}
+
+TEST_F(ReverseReaderTests, testLastRecords)
+{
+    writeText("not a record\n"
+              "|20250825_090000|          1| a.cpp               |   10|INF>  [A : run] one\n"
+              "|20250825_093000|          2| a.cpp               |   20|ERR>  [A : run] two\n"
+              "  continued\n"
+              "  and again\n"
+              "|20250825_100000|          1| a.cpp               |   30|WARN> [A : run] three\n");
+
+    ReverseReader reader(m_file, 16);
+    std::vector<std::string> expRecords =
+    {
+        "|20250825_093000|          2| a.cpp               |   20|ERR>  [A : run] two\n  continued\n  and again",
+        "|20250825_100000|          1| a.cpp               |   30|WARN> [A : run] three"
+    };
+    EXPECT_EQ(expRecords, reader.lastRecords(2));
+    EXPECT_EQ(static_cast<size_t>(4), ReverseReader(m_file).lastRecords(10).size());
+    EXPECT_EQ((std::vector<std::string>{ "  and again", "|20250825_100000|          1| a.cpp               |   30|WARN> [A : run] three" }),
+              ReverseReader(m_file).lastLines(2));
+
+    EXPECT_EQ(expRecords, ReverseReader(m_file).recordsSince("20250825_093000"));
+    EXPECT_EQ(static_cast<size_t>(3), ReverseReader(m_file).recordsSince("20250825_09").size());
+    EXPECT_TRUE(ReverseReader(m_file).recordsSince("20250826").empty());
+}
+
+TEST_F(ReverseReaderTests, testTailOfBigFile)
+{
+    std::string text;
+    const std::string line = "|20250825_090000|          1| a.cpp               |   10|INF>  [A : run] " + std::string(100, 'x') + '\n';
+    while (text.size() < 8 * 1024 * 1024)
+        text += line;
+    writeText(text);
+
+    ReverseReader reader(m_file);
+    auto lines = reader.lastLines(200);
+    ASSERT_EQ(static_cast<size_t>(200), lines.size());
+    EXPECT_EQ(line.substr(0, line.size() - 1), lines.front());
+    // Only the blocks holding the lines returned are read
+    EXPECT_LE(reader.getBytesRead(), 200 * line.size() + ReverseReader::defaultBlockSize);
+    EXPECT_EQ(text.size(), reader.getFileSize());
+}
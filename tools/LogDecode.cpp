@@ -0,0 +1,64 @@
+/*
+ * LogDecode.cpp
+ *
+ * Renders a binary log written by BinaryFileSink as the text lines the Logger
+ * would have written, e.g. to be piped into LogGrep or less.
+ *
+ * Usage: ./bin/LogDecode <binary log file> [more files...]
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "BinaryLogDecoder.hpp"
+
+#include <iostream>
+
+using namespace logger;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <binary log file> [more files...]" << std::endl;
+        return 2;
+    }
+
+    try
+    {
+        for (int idx = 1; idx < argc; ++idx)
+        {
+            BinaryLogDecoder::forEachLine(argv[idx], [](std::string_view line)
+            {
+                std::cout << line << '\n';
+                return std::cout.good();
+            });
+        }
+        std::cout.flush();
+        return 0;
+    }
+    catch(const std::exception& excp)
+    {
+        std::cerr << argv[0] << ": " << excp.what() << std::endl;
+        return 1;
+    }
+}
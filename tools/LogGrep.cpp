@@ -0,0 +1,137 @@
+/*
+ * LogGrep.cpp
+ *
+ * Searches a log file written by the Logger along with its rotated archives,
+ * printing the matching lines in time stamp order.
+ *
+ * Usage: ./bin/LogGrep [options] <pattern> <log file>
+ *   -e          The pattern is a regex (ECMAScript)
+ *   -i          Ignore case
+ *   -l <types>  Comma separated log types to keep, e.g. ERR,FATAL
+ *   -s <time>   Oldest time stamp to keep, e.g. 20250825_155051
+ *   -u <time>   Newest time stamp to keep, a prefix like 20250825 takes in the whole day
+ *   -t <tid>    Thread id to keep
+ *   -j <cnt>    Number of files searched at a time (default: hardware threads)
+ *   -m <cnt>    Print at most these many lines
+ *   -n          Prefix every line with its file name and line number
+ * An empty pattern ("") matches every line.
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Swarnendu RC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "LogSearch.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <cstring>
+
+using namespace logger;
+
+namespace
+{
+    void printUsage(const char* progName)
+    {
+        std::cerr << "Usage: " << progName << " [-e] [-i] [-n] [-l types] [-s since] [-u until]"
+                  << " [-t tid] [-j threads] [-m max] <pattern> <log file>" << std::endl;
+    }
+
+    /**
+     * @brief Parse a comma separated list of log types, e.g. "ERR,FATAL"
+     */
+    std::vector<LOG_TYPE> parseLevels(const std::string& levelsStr)
+    {
+        std::vector<LOG_TYPE> levels;
+        std::istringstream iss(levelsStr);
+        std::string level;
+        while (std::getline(iss, level, ','))
+        {
+            auto logType = Logger::convertStringToLogTypeEnum(level);
+            if (logType == LOG_TYPE::LOG_DEFAULT && level != "DEFAULT")
+                throw std::invalid_argument("Unknown log type " + level);
+            levels.push_back(logType);
+        }
+        return levels;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    SearchQuery query;
+    size_t threadCnt = 0;
+    auto printLocation = false;
+    std::vector<std::string> positionals;
+    try
+    {
+        for (int idx = 1; idx < argc; ++idx)
+        {
+            std::string arg = argv[idx];
+            auto needsValue = (arg == "-l" || arg == "-s" || arg == "-u" || arg == "-t" || arg == "-j" || arg == "-m");
+            if (needsValue && idx + 1 >= argc)
+                throw std::invalid_argument("Missing value of " + arg);
+
+            if (arg == "-e")
+                query.regex = true;
+            else if (arg == "-i")
+                query.ignoreCase = true;
+            else if (arg == "-n")
+                printLocation = true;
+            else if (arg == "-l")
+                query.levels = parseLevels(argv[++idx]);
+            else if (arg == "-s")
+                query.since = argv[++idx];
+            else if (arg == "-u")
+                query.until = argv[++idx];
+            else if (arg == "-t")
+                query.threadId = argv[++idx];
+            else if (arg == "-j")
+                threadCnt = std::stoul(argv[++idx]);
+            else if (arg == "-m")
+                query.maxResults = std::stoul(argv[++idx]);
+            else
+                positionals.push_back(arg);
+        }
+        if (positionals.size() != 2)
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+
+        query.pattern = positionals[0];
+        LogSearch logSearch(query, threadCnt);
+        auto matches = logSearch.search(positionals[1]);
+        for (const auto& match : matches)
+        {
+            if (printLocation)
+                std::cout << match.file.filename().string() << ":" << match.lineNo << ":";
+            std::cout << match.line << '\n';
+        }
+        std::cout.flush();
+        return matches.empty() ? 1 : 0;     // As grep does
+    }
+    catch(const std::exception& excp)
+    {
+        std::cerr << argv[0] << ": " << excp.what() << std::endl;
+        printUsage(argv[0]);
+        return 2;
+    }
+}